@@ -2,6 +2,7 @@
 #include "GameScene/GameScene.h"
 #include "ResultScene/ResultScene.h"
 #include "SelectScene/SelectScene.h"
+#include "StressScene/StressScene.h"
 #include "TitleScene/TitleScene.h"
 #include "imgui/imgui.h"
 #include <cassert>
@@ -42,18 +43,42 @@ bool App::Init() {
   pipeObj_ = pm_.CreateFromFiles("object3d", L"Shader/Object3D.VS.hlsl",
                                  L"Shader/Object3D.PS.hlsl",
                                  InputLayoutType::Object3D);
+  // 圧縮頂点用（Model3D::SetVertexFormat で Compact / Quantized にしたモデル）
+  pm_.CreateFromFiles("object3d_compact", L"Shader/Object3D.VS.hlsl",
+                      L"Shader/Object3D.PS.hlsl",
+                      InputLayoutType::Object3DCompact);
+  pm_.CreateFromFiles("object3d_quantized", L"Shader/Object3D.VS.hlsl",
+                      L"Shader/Object3D.PS.hlsl",
+                      InputLayoutType::Object3DQuantized);
+  // インスタンス描画用（InstancedRenderer、行列は StructuredBuffer から）
+  // バケットの頂点形式ごとに切り替える（Object3DPipelineKey の名前）
+  pm_.CreateFromFiles("object3d_instanced", L"Shader/Object3D.VS.hlsl",
+                      L"Shader/Object3D.PS.hlsl", InputLayoutType::Object3D,
+                      true);
+  pm_.CreateFromFiles("object3d_instanced_compact", L"Shader/Object3D.VS.hlsl",
+                      L"Shader/Object3D.PS.hlsl",
+                      InputLayoutType::Object3DCompact, true);
+  pm_.CreateFromFiles("object3d_instanced_quantized",
+                      L"Shader/Object3D.VS.hlsl", L"Shader/Object3D.PS.hlsl",
+                      InputLayoutType::Object3DQuantized, true);
+  // スプライトのまとめ描き用（SpriteBatch、頂点は画面座標と色）
+  pm_.CreateFromFiles("sprite", L"Shader/Object3D.VS.hlsl",
+                      L"Shader/Object3D.PS.hlsl", InputLayoutType::Sprite);
 
   // ===== SceneContext の紐づけ =====
   sceneCtx_.core = &core_;
   sceneCtx_.input = input_.get();
   sceneCtx_.app = &appConfig_;
   sceneCtx_.imgui = &imgui_;
+  sceneCtx_.pipelines = &pm_;
+  sceneCtx_.renderQueue = &renderQueue_;
 
   // ===== シーン登録 =====
   sceneMgr_.Register(std::make_unique<TitleScene>());
   sceneMgr_.Register(std::make_unique<SelectScene>());
   sceneMgr_.Register(std::make_unique<GameScene>());
   sceneMgr_.Register(std::make_unique<ResultScene>());
+  sceneMgr_.Register(std::make_unique<StressScene>());
 
   // ===== 最初のシーンへ即時遷移 =====
 #ifdef _DEBUG
@@ -98,6 +123,9 @@ void App::Update() {
   ImGui::SameLine();
   if (ImGui::Button("Go Result"))
     sceneMgr_.RequestChange("Result");
+  ImGui::SameLine();
+  if (ImGui::Button("Go Stress"))
+    sceneMgr_.RequestChange("Stress");
   ImGui::End();
 
   input_->Update();
@@ -61,6 +61,7 @@ private:
   // === シーン管理 ===
   Scene::SceneManager sceneMgr_;
   SceneContext sceneCtx_;
+  RenderQueue renderQueue_; // シーンが Submit した描画を並べ替えて描く
 
   // Win32
   MSG msg_{};
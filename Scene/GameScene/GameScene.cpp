@@ -9,7 +9,9 @@ void GameScene::OnEnter(SceneContext &ctx) {
   auto &srvHeap = ctx.core->SRV();
 
   // TextureManager 初期化
-  texMgr_.Init(device, &srvHeap);
+  texMgr_.Init(device, &srvHeap, &ctx.core->Uploader());
+  // ModelManager 初期化（同じモデルのメッシュを共有）
+  modelMgr_.Init(device);
 
    // ===== Camera =====
   camera_.Initialize(ctx.input, Vector3{0.0f, 0.0f, -5.0f},
@@ -19,7 +21,8 @@ void GameScene::OnEnter(SceneContext &ctx) {
   // モデル初期化
   teapot = new Model3D();
   teapot->Initialize(device);
-  teapot->LoadObjGeometryLikeFunction("Resources", "teapot.obj");
+  teapot->EnableMeshlets();
+  teapot->LoadObjGeometryLikeFunction(modelMgr_, "Resources", "teapot.obj");
   tx_teapot = texMgr_.LoadID("Resources/uvChecker.png", true);
   teapot->SetTexture(texMgr_.GetSrv(tx_teapot));
 }
@@ -30,6 +33,10 @@ void GameScene::OnExit(SceneContext &) {
     teapot = nullptr;
   }
   tx_teapot = -1;
+  // メッシュを借りているモデルを消してから
+  modelMgr_.Term();
+  // SRV はヒープへ返す（次のシーンで使い回す）
+  texMgr_.Term();
 }
 
 
@@ -48,17 +55,55 @@ void GameScene::Update(SceneManager &sm, SceneContext &ctx) {
   if (ImGui::Button("<- Back Select")) {
     sm.RequestChange("Select");
   }
+  // 頂点キャッシュ最適化の効果
+  const MeshOptimizeReport &mesh = teapot->GetMeshOptimizeReport();
+  ImGui::Text("teapot ACMR %.3f -> %.3f / ATVR %.3f -> %.3f",
+              mesh.before.acmr, mesh.after.acmr, mesh.before.atvr,
+              mesh.after.atvr);
+  const Model3D::MeshLoadStats &load = teapot->GetMeshLoadStats();
+  ImGui::Text("teapot load %.2f ms (%s)", load.milliseconds,
+              load.fromCache ? "cg2mesh" : "obj");
+  ImGui::Text("shared meshes %zu (teapot refs %u)", modelMgr_.GetMeshCount(),
+              modelMgr_.GetRefCount(teapot->GetMesh()));
+  // 画面上の大きさで選んだ LOD
+  const uint32_t lod = teapot->GetCurrentLod();
+  ImGui::Text("teapot LOD %u / %u (%u tris)", lod, teapot->GetLodCount(),
+              teapot->GetLodTriangleCount(lod));
+  ImGui::SliderFloat("LOD threshold (px)", &lodThreshold_, 0.25f, 8.0f);
+  teapot->SetLodThreshold(lodThreshold_);
+  // メッシュレットの埋まり具合と、前フレームのカメラでの CPU カリング
+  // （描画には使わない確認用なので、チェックを入れたときだけ毎フレーム回す）
+  const MeshletStats &meshlet = teapot->GetMeshletStats();
+  ImGui::Text("teapot meshlets %u (fill v %.0f%% / t %.0f%%, cone %.0f%%)",
+              meshlet.meshletCount, meshlet.vertexFill * 100.0f,
+              meshlet.triangleFill * 100.0f,
+              meshlet.coneCullableRatio * 100.0f);
+  ImGui::Checkbox("meshlet CPU culling", &meshletCullEnabled_);
+  if (meshletCullEnabled_) {
+    ImGui::Text("  culled frustum %u / backface %u, tris %u / %u (%.1f us)",
+                meshletCull_.frustumCulled, meshletCull_.backfaceCulled,
+                meshletCull_.visibleTriangles, meshletCull_.totalTriangles,
+                meshletCull_.microseconds);
+  }
   ImGui::End();
 
 
   camera_.DrawImGui();
   camera_.Update();
   CameraMatrices mats = camera_.GetMatrices();
+  frustum_ = MakeFrustum(Multiply(mats.view, mats.proj));
 
   teapot->Update(mats.view, mats.proj);
+  teapot->SelectLod(mats.view, mats.proj, float(ctx.app->height));
+  if (meshletCullEnabled_) {
+    meshletCull_ = teapot->CullMeshlets(mats.view, mats.proj);
+  }
 }
 
 void GameScene::Render(SceneContext &, ID3D12GraphicsCommandList *cl) {
 
-  teapot->Draw(cl);
+  // 視錐台の外なら描画しない
+  if (IsVisible(frustum_, teapot->GetWorldBoundingSphere())) {
+    teapot->Draw(cl);
+  }
 }
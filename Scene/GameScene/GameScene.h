@@ -1,9 +1,11 @@
 #pragma once
 #include "Scene.h"
 #include "model3D/model3D.h"
+#include "Model3D/ModelManager.h"
 #include <dinput.h>
 #include "Texture/TextureManager/TextureManager.h"
 #include "Camera/CameraController.h"
+#include "Math/Frustum.h"
 
 class GameScene final : public Scene {
 public:
@@ -17,10 +19,17 @@ public:
 private:
   // テクスチャ
   TextureManager texMgr_;
+  // モデル（メッシュの共有）
+  ModelManager modelMgr_;
 
   Model3D *teapot = nullptr;
   int tx_teapot = -1;
+  float lodThreshold_ = 1.0f; // LOD の許容誤差（ピクセル）
+  MeshletCullStats meshletCull_{}; // メッシュレットのカリング結果
+  bool meshletCullEnabled_ = false; // CPU カリングを回すか（デバッグ表示用）
   
   // カメラ
   CameraController camera_;
+  // 今フレームの視錐台（Update で更新、Render でカリングに使う）
+  Frustum frustum_{};
 };
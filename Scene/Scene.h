@@ -11,6 +11,8 @@ class Input;
 class DebugCamera;
 class MainCamera;
 class ImGuiManager;
+class PipelineManager;
+class RenderQueue;
 
 // シーンが使う共有コンテキスト
 struct SceneContext {
@@ -19,6 +21,10 @@ struct SceneContext {
   const AppConfig *app = nullptr;
   ImGuiManager *imgui =
       nullptr; // ImGuiウィンドウを出すだけなら不要だが念のため
+  PipelineManager *pipelines = nullptr; // 圧縮頂点の PSO へ切り替える場合
+  // Render 中に Submit した DrawPacket は SceneManager::Render の最後に
+  // 並べ替えて描く
+  RenderQueue *renderQueue = nullptr;
 };
 
 // シーン基底クラス
@@ -1,5 +1,6 @@
 #pragma once
 #include "Scene.h"
+#include "RenderQueue/RenderQueue.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -35,8 +36,13 @@ public:
   }
 
   void Render(SceneContext &ctx, ID3D12GraphicsCommandList *cl) {
+    if (ctx.renderQueue)
+      ctx.renderQueue->Begin();
     if (current_)
       current_->Render(ctx, cl);
+    // シーンが積んだものを並べ替えて描く（直接 Draw した分はもう積まれている）
+    if (ctx.renderQueue)
+      ctx.renderQueue->Execute(cl);
   }
 
   const std::string &CurrentName() const { return currentName_; }
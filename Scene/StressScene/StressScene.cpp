@@ -0,0 +1,258 @@
+#include "StressScene.h"
+#include "Input/Input.h"
+#include "SceneManager.h"
+#include "PipelineManager.h"
+#include "RenderQueue/RenderQueue.h"
+#include "imgui/imgui.h"
+#include "Dx12Core.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 並べる間隔
+constexpr float kSpacing = 2.5f;
+constexpr int kMaxModels = 4096;
+constexpr int kSphereCount = 256;
+constexpr int kMaxSprites = 8192;
+// 同じテクスチャを続けて描く枚数（切り替えごとに 1 ドローコール）
+constexpr int kSpriteRun = 256;
+
+// 番号から色相を回した色
+Vector4 HueColor(int index) {
+  const float h = float(index % 64) / 64.0f * 6.0f;
+  const float x = 1.0f - std::abs(std::fmod(h, 2.0f) - 1.0f);
+  const int i = int(h);
+  const float rgb[6][3] = {{1, x, 0}, {x, 1, 0}, {0, 1, x},
+                           {0, x, 1}, {x, 0, 1}, {1, 0, x}};
+  return {rgb[i][0], rgb[i][1], rgb[i][2], 1.0f};
+}
+
+} // namespace
+
+void StressScene::OnEnter(SceneContext &ctx) {
+  device_ = ctx.core->GetDevice();
+  upload_ = &ctx.core->Upload();
+  srvHeap_ = &ctx.core->SRV();
+  uploader_ = &ctx.core->Uploader();
+  texMgr_.Init(device_, srvHeap_, uploader_);
+  modelMgr_.Init(device_);
+  tx_checker_ = texMgr_.LoadID("Resources/uvChecker.png", true);
+  tx_ball_ = texMgr_.LoadID("Resources/monsterBall.png", true);
+
+  camera_.Initialize(ctx.input, Vector3{0.0f, 10.0f, -60.0f},
+                     Vector3{0.2f, 0.0f, 0.0f}, 0.45f,
+                     float(ctx.app->width) / ctx.app->height, 0.1f, 500.0f);
+
+  instanced_ = new InstancedRenderer();
+  instanced_->Initialize(device_, kMaxModels + kSphereCount);
+
+  // 球は 1 つだけ作り、置き場所だけ増やす
+  sphere_ = new Sphere();
+  sphere_->Initialize(device_, 0.5f, 16, 16);
+  sphere_->SetTexture(texMgr_.GetSrv(tx_checker_));
+  sphereTransforms_.clear();
+  for (int i = 0; i < kSphereCount; ++i) {
+    const float x = float(i % 16 - 8) * kSpacing;
+    const float z = float(i / 16 - 8) * kSpacing;
+    sphereTransforms_.push_back({{1, 1, 1}, {0, 0, 0}, {x, -6.0f, z}});
+  }
+
+  sprites_ = new SpriteBatch();
+  sprites_->Initialize(device_, upload_, float(ctx.app->width),
+                       float(ctx.app->height), kMaxSprites);
+
+  Rebuild_(modelCount_);
+}
+
+void StressScene::OnExit(SceneContext &) {
+  Clear_();
+  delete sphere_;
+  sphere_ = nullptr;
+  delete instanced_;
+  instanced_ = nullptr;
+  delete sprites_;
+  sprites_ = nullptr;
+  modelMgr_.Term();
+  // SRV はヒープへ返す（次のシーンで使い回す）
+  texMgr_.Term();
+  tx_checker_ = -1;
+  tx_ball_ = -1;
+}
+
+void StressScene::Clear_() {
+  for (Model3D *model : models_) {
+    delete model;
+  }
+  models_.clear();
+}
+
+void StressScene::Rebuild_(int count) {
+  Clear_();
+  const int side = int(std::ceil(std::sqrt(float(count))));
+  for (int i = 0; i < count; ++i) {
+    Model3D *model = new Model3D();
+    // CB はリングから切り出す（1 体ごとのコミット済みリソースを作らない）
+    model->UseUploadRing(upload_);
+    model->Initialize(device_);
+    // 2 体目以降は解析もアップロードもしない（参照数が増えるだけ）
+    model->LoadObjGeometryLikeFunction(modelMgr_, "Resources", "teapot.obj");
+    // テクスチャは 2 種類を交互に（並べ替えでまとまる様子を見る）
+    model->SetTexture(texMgr_.GetSrv(i % 2 ? tx_ball_ : tx_checker_));
+    model->Mat()->color = HueColor(i);
+    model->T().translation = {float(i % side - side / 2) * kSpacing, 0.0f,
+                              float(i / side - side / 2) * kSpacing};
+    models_.push_back(model);
+  }
+}
+
+void StressScene::Update(SceneManager &sm, SceneContext &ctx) {
+  if (ctx.input && ctx.input->IsKeyTrigger(DIK_BACK)) {
+    sm.RequestChange("Select");
+  }
+
+  ImGui::Begin("Stress");
+  int count = modelCount_;
+  if (ImGui::SliderInt("teapots", &count, 1, kMaxModels) &&
+      count != modelCount_) {
+    modelCount_ = count;
+    Rebuild_(modelCount_);
+  }
+  int mode = static_cast<int>(mode_);
+  ImGui::RadioButton("individual", &mode, int(DrawMode::Individual));
+  ImGui::SameLine();
+  ImGui::RadioButton("queue", &mode, int(DrawMode::Queue));
+  ImGui::SameLine();
+  ImGui::RadioButton("instanced", &mode, int(DrawMode::Instanced));
+  mode_ = static_cast<DrawMode>(mode);
+  ImGui::Text("draw calls %u (shared meshes %zu)", drawCalls_,
+              modelMgr_.GetMeshCount());
+  if (mode_ == DrawMode::Instanced) {
+    const InstancedRenderer::Stats &stats = instanced_->GetStats();
+    ImGui::Text("instances %u in %u buckets (pso %u)", stats.instances,
+                stats.buckets, stats.pipelineChanges);
+  } else {
+    if (mode_ == DrawMode::Queue && ctx.renderQueue) {
+      const RenderQueue::Stats &queue = ctx.renderQueue->GetStats();
+      ImGui::Text("sort %.1f us (%u packets, %u rejected)",
+                  queue.sortMicroseconds, queue.packets,
+                  queue.rejectedPackets);
+      ImGui::Text("pso %u, cbv %u, table %u, buffers %u, elided %u",
+                  queue.pipelineChanges, queue.cbvBinds, queue.tableBinds,
+                  queue.bufferBinds, queue.elidedBinds);
+    }
+    const RingAllocator::Stats &ring = upload_->GetStats();
+    ImGui::Text("upload ring %.1f / %.1f KiB (peak %.1f), %u allocs",
+                ring.frameBytes / 1024.0, ring.capacity / 1024.0,
+                ring.peakUsedBytes / 1024.0, ring.frameAllocations);
+    if (ring.frameOverflows > 0) {
+      ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "overflow %u",
+                         ring.frameOverflows);
+    }
+  }
+  const DescriptorAllocator::Stats &srv = srvHeap_->GetStats();
+  ImGui::Text("srv heap %u / %u (pending free %u, free ranges %u)",
+              srv.persistentUsed, srv.persistentCapacity, srv.pendingFree,
+              srv.freeRanges);
+  const UploadManager::Stats &copy = uploader_->GetStats();
+  ImGui::Text("copy queue %u batches (last %u uploads, %.1f KiB)",
+              copy.batches, copy.lastBatchUploads,
+              copy.lastBatchBytes / 1024.0);
+  ImGui::SliderInt("sprites", &spriteCount_, 0, kMaxSprites);
+  if (spriteCount_ > 0) {
+    const SpriteBatch::Stats &sprite = sprites_->GetStats();
+    ImGui::Text("sprites %u in %u draws, expand %.1f us", sprite.sprites,
+                sprite.drawCalls, sprite.expandMicroseconds);
+    if (sprite.dropped > 0) {
+      ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "sprites dropped %u",
+                         sprite.dropped);
+    }
+  }
+  ImGui::End();
+
+  camera_.DrawImGui();
+  camera_.Update();
+  const CameraMatrices mats = camera_.GetMatrices();
+
+  for (Model3D *model : models_) {
+    model->T().rotation.y += 0.01f;
+  }
+
+  spriteTime_ += 1.0f / 60.0f;
+  view_ = mats.view;
+  if (mode_ == DrawMode::Instanced) {
+    // 同じメッシュ・テクスチャは 1 つのバケットにまとまる
+    instanced_->Begin();
+    for (size_t i = 0; i < models_.size(); ++i) {
+      instanced_->Add(*models_[i], HueColor(int(i)));
+    }
+    for (const Transform &transform : sphereTransforms_) {
+      instanced_->Add(*sphere_, transform);
+    }
+    instanced_->End(mats.view, mats.proj);
+  } else {
+    Model3D::UpdateBatch(models_.data(), models_.size(), mats.view,
+                         mats.proj);
+  }
+}
+
+void StressScene::Render(SceneContext &ctx, ID3D12GraphicsCommandList *cl) {
+  RenderModels_(ctx, cl);
+  RenderSprites_(ctx, cl);
+}
+
+void StressScene::RenderModels_(SceneContext &ctx,
+                                ID3D12GraphicsCommandList *cl) {
+  if (mode_ == DrawMode::Instanced) {
+    // PSO は頂点形式ごとに InstancedRenderer が切り替える
+    instanced_->Draw(cl, *ctx.pipelines);
+    drawCalls_ = instanced_->GetStats().drawCalls;
+    return;
+  }
+
+  if (mode_ == DrawMode::Queue && ctx.renderQueue) {
+    // 描くのは SceneManager::Render の最後（数は前フレームの結果）
+    // PSO は頂点形式ごとに Model3D::Submit が選ぶ
+    ctx.renderQueue->SetDepthRange(0.1f, 500.0f);
+    for (Model3D *model : models_) {
+      model->Submit(*ctx.renderQueue, *ctx.pipelines, view_);
+    }
+    drawCalls_ = ctx.renderQueue->GetStats().draws;
+    return;
+  }
+
+  drawCalls_ = 0;
+  for (Model3D *model : models_) {
+    model->Draw(cl);
+    drawCalls_ += uint32_t(model->GetSubmeshCount());
+  }
+}
+
+void StressScene::RenderSprites_(SceneContext &ctx,
+                                 ID3D12GraphicsCommandList *cl) {
+  if (spriteCount_ <= 0)
+    return;
+
+  // 画面の左上から敷き詰めて、それぞれその場で回す
+  const float size = 24.0f;
+  const int columns = (std::max)(1, int(ctx.app->width / size));
+  const D3D12_GPU_DESCRIPTOR_HANDLE checker = texMgr_.GetSrv(tx_checker_);
+  const D3D12_GPU_DESCRIPTOR_HANDLE ball = texMgr_.GetSrv(tx_ball_);
+
+  sprites_->Begin();
+  for (int i = 0; i < spriteCount_; ++i) {
+    SpriteDraw sprite;
+    sprite.position = {(float(i % columns) + 0.5f) * size,
+                       (float(i / columns) + 0.5f) * size};
+    sprite.size = {size * 0.8f, size * 0.8f};
+    sprite.anchor = {0.5f, 0.5f};
+    sprite.rotation = spriteTime_ + float(i) * 0.05f;
+    sprite.color = HueColor(i);
+    sprites_->Draw((i / kSpriteRun) % 2 ? ball : checker, sprite);
+  }
+
+  GraphicsPipeline *pipeline = ctx.pipelines->Get("sprite");
+  cl->SetGraphicsRootSignature(pipeline->Root());
+  cl->SetPipelineState(pipeline->PSO());
+  sprites_->End(cl);
+}
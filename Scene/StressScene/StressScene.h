@@ -0,0 +1,66 @@
+#pragma once
+#include "Scene.h"
+#include "model3D/model3D.h"
+#include "Model3D/ModelManager.h"
+#include "Sphere/Sphere.h"
+#include "Instancing/InstancedRenderer.h"
+#include "SpriteBatch/SpriteBatch.h"
+#include "Texture/TextureManager/TextureManager.h"
+#include "Camera/CameraController.h"
+#include <vector>
+
+class UploadRing;
+class DescriptorHeap;
+class UploadManager;
+
+// 同じモデルを大量に置いて、1 体ずつの描画とインスタンス描画を比べるシーン
+class StressScene final : public Scene {
+public:
+  const char *Name() const override { return "Stress"; }
+  void OnEnter(SceneContext &ctx) override;
+  void OnExit(SceneContext &) override;
+
+  void Update(SceneManager &sm, SceneContext &ctx) override;
+  void Render(SceneContext &ctx, ID3D12GraphicsCommandList *cl) override;
+
+private:
+  enum class DrawMode {
+    Individual, // 1 体ずつ Draw
+    Queue,      // RenderQueue に積んで並べ替え、同じ状態は積み直さない
+    Instanced,  // InstancedRenderer でまとめて描く
+  };
+
+  // モデルを count 体に並べ直す（メッシュは ModelManager で共有）
+  void Rebuild_(int count);
+  void Clear_();
+  void RenderModels_(SceneContext &ctx, ID3D12GraphicsCommandList *cl);
+  void RenderSprites_(SceneContext &ctx, ID3D12GraphicsCommandList *cl);
+
+  ID3D12Device *device_ = nullptr;
+  UploadRing *upload_ = nullptr; // 1 体ずつ描くときの CB（Dx12Core のもの）
+  DescriptorHeap *srvHeap_ = nullptr; // 使用数の表示用
+  UploadManager *uploader_ = nullptr; // テクスチャの転送（Dx12Core のもの）
+  TextureManager texMgr_;
+  ModelManager modelMgr_;
+  int tx_checker_ = -1;
+  int tx_ball_ = -1;
+
+  // 1 体ずつ描く / インスタンス描画の両方で使う
+  std::vector<Model3D *> models_;
+  int modelCount_ = 256;
+  // 球はインスタンス描画だけ（1 つの球を transform を変えて置く）
+  Sphere *sphere_ = nullptr;
+  std::vector<Transform> sphereTransforms_;
+
+  InstancedRenderer *instanced_ = nullptr;
+  DrawMode mode_ = DrawMode::Instanced;
+  uint32_t drawCalls_ = 0; // 前フレーム
+  Matrix4x4 view_{};       // Queue で奥行きを求める用
+
+  // 手前に重ねるスプライト（SpriteBatch でまとめ描き）
+  SpriteBatch *sprites_ = nullptr;
+  int spriteCount_ = 1024;
+  float spriteTime_ = 0.0f;
+
+  CameraController camera_;
+};
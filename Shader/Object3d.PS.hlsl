@@ -34,6 +34,7 @@ PixelShaderOutput main(VertexShaderOutput input)
     float4 uv = mul(float4(input.texcoord, 0.0f, 1.0f), gMaterial.uvTransform);
     float2 transformedUV = uv.xy;
     float4 textureColor = gTexture.Sample(gSampler, transformedUV);
+    float4 materialColor = gMaterial.color * input.color;
 
     if (gMaterial.lightingMode != 0)
     {
@@ -49,7 +50,7 @@ PixelShaderOutput main(VertexShaderOutput input)
             lighting = lighting * lighting;
         }
         output.color =
-        gMaterial.color
+        materialColor
         * textureColor
         * gDirectionalLight.color
         * lighting
@@ -57,7 +58,7 @@ PixelShaderOutput main(VertexShaderOutput input)
     }
     else
     {
-        output.color = gMaterial.color * textureColor;
+        output.color = materialColor * textureColor;
     }
 
     return output;
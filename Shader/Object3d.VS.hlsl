@@ -5,18 +5,80 @@ struct TransformationMatrix {
     float4x4 World;
 };
 
+#if defined(INSTANCED)
+// InstanceBatch.h の InstanceData と対応（ルート SRV でバケットの先頭を指す）
+struct InstanceData {
+    float4x4 WVP;
+    float4x4 World;
+    float4 color;
+};
+StructuredBuffer<InstanceData> gInstances : register(t0, space1);
+#else
 ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
+#endif
 
+// 入力レイアウトは PipelineManager::GetInputLayout と対応
+#if defined(VERTEX_SPRITE)
+// SpriteBatch：画面座標（px、WVP は直交投影）/ UV / RGBA8 の頂点色
+struct VertexShaderInput {
+    float2 position : POSITION0;
+    float2 texcoord : TEXCOORD0;
+    float4 color : COLOR0;
+};
+#elif defined(VERTEX_QUANTIZED)
+// unorm16 位置（scale/offset は CPU 側で WVP に掛けてある）/ half2 UV / 八面体法線
+struct VertexShaderInput {
+    float4 position : POSITION0;
+    float2 texcoord : TEXCOORD0;
+    float2 normal : NORMAL0;
+};
+#elif defined(VERTEX_COMPACT)
+// float3 位置 / half2 UV / 八面体法線
+struct VertexShaderInput {
+    float3 position : POSITION0;
+    float2 texcoord : TEXCOORD0;
+    float2 normal : NORMAL0;
+};
+#else
 struct VertexShaderInput {
     float4 position : POSITION0;
     float2 texcoord : TEXCOORD0;
     float3 normal : NORMAL0;
 };
+#endif
+
+// 八面体エンコードの復元（VertexFormat.cpp の DecodeOctahedral と同じ式）
+float3 DecodeOctahedral(float2 e) {
+    float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy -= (step(0.0f, n.xy) * 2.0f - 1.0f) * t;
+    return normalize(n);
+}
 
-VertexShaderOutput main(VertexShaderInput input) {
+VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID) {
     VertexShaderOutput output;
-    output.position = mul(input.position, gTransformationMatrix.WVP);
+#if defined(INSTANCED)
+    float4x4 wvp = gInstances[instanceId].WVP;
+    float4x4 world = gInstances[instanceId].World;
+    output.color = gInstances[instanceId].color;
+#else
+    float4x4 wvp = gTransformationMatrix.WVP;
+    float4x4 world = gTransformationMatrix.World;
+    output.color = float4(1.0f, 1.0f, 1.0f, 1.0f);
+#endif
+#if defined(VERTEX_SPRITE)
+    float4 position = float4(input.position, 0.0f, 1.0f);
+    float3 normal = float3(0.0f, 0.0f, -1.0f);
+    output.color *= input.color;
+#elif defined(VERTEX_QUANTIZED) || defined(VERTEX_COMPACT)
+    float4 position = float4(input.position.xyz, 1.0f);
+    float3 normal = DecodeOctahedral(input.normal);
+#else
+    float4 position = input.position;
+    float3 normal = input.normal;
+#endif
+    output.position = mul(position, wvp);
     output.texcoord = input.texcoord;
-    output.normal = normalize(mul(input.normal, (float3x3) gTransformationMatrix.World));
+    output.normal = normalize(mul(normal, (float3x3) world));
     return output;
 }
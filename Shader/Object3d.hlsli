@@ -2,4 +2,5 @@ struct VertexShaderOutput {
     float4 position : SV_POSITION;
     float2 texcoord : TEXCOORD0;
     float3 normal : NORMAL0;
+    float4 color : COLOR0; // インスタンス / スプライト頂点ごとの色（他は白）
 };
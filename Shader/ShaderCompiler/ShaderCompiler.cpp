@@ -52,8 +52,21 @@ CompiledShader ShaderCompiler::Compile(const ShaderDesc &desc) const {
   // 行番号を含むPDB名抑制（任意）
   args.push_back(L"-Qstrip_reflect"); // 最小化したい場合
 
-  // マクロ定義
-  std::vector<DxcDefine> defs = desc.defines; // コピー（必要なら外で保持）
+  // マクロ定義（-D NAME=VALUE。文字列は Compile が終わるまで保持する）
+  std::vector<std::wstring> defineArgs;
+  defineArgs.reserve(desc.defines.size());
+  for (const DxcDefine &d : desc.defines) {
+    std::wstring arg = d.Name;
+    if (d.Value) {
+      arg += L"=";
+      arg += d.Value;
+    }
+    defineArgs.push_back(std::move(arg));
+  }
+  for (const std::wstring &arg : defineArgs) {
+    args.push_back(L"-D");
+    args.push_back(arg.c_str());
+  }
   DxcBuffer src{};
   src.Ptr = srcBlob->GetBufferPointer();
   src.Size = srcBlob->GetBufferSize();
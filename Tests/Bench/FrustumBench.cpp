@@ -0,0 +1,69 @@
+#include "Framework/Bench.h"
+#include "Math/Frustum.h"
+#include "Math/Math.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// 境界 4096 個の視錐台カリング。IsVisible を回すスカラー版と
+// 一括版（SoA / AoS）を比べる
+CG2_BENCH(FrustumBench)(cg2bench::Runner &r) {
+  constexpr size_t kCount = 4096;
+  std::mt19937 rng(10);
+  std::uniform_real_distribution<float> xy(-40.0f, 40.0f);
+  std::uniform_real_distribution<float> z(-10.0f, 60.0f);
+  std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+  std::vector<SphereData> spheres(kCount);
+  std::vector<AABB> aabbs(kCount);
+  SphereBoundsSoA sphereSoA;
+  AABBBoundsSoA aabbSoA;
+  for (size_t i = 0; i < kCount; ++i) {
+    const Vector3 c = {xy(rng), xy(rng) * 0.6f, z(rng)};
+    spheres[i].center = c;
+    spheres[i].radius = size(rng);
+    sphereSoA.Push(spheres[i]);
+    const float h = size(rng);
+    aabbs[i].min = {c.x - h, c.y - h, c.z - h};
+    aabbs[i].max = {c.x + h, c.y + h, c.z + h};
+    aabbSoA.Push(aabbs[i]);
+  }
+  const Matrix4x4 view =
+      MakeLookAt(Vector3{0, 0, 0}, Vector3{0, 0, 1}, Vector3{0, 1, 0});
+  const Matrix4x4 proj =
+      MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.5f, 50.0f);
+  const Frustum frustum = MakeFrustum(Multiply(view, proj));
+  std::vector<uint32_t> visible(kCount);
+
+  auto scalar = [&](const auto &shapes) {
+    size_t n = 0;
+    for (size_t i = 0; i < kCount; ++i) {
+      if (IsVisible(frustum, shapes[i])) {
+        visible[n++] = uint32_t(i);
+      }
+    }
+    cg2bench::DoNotOptimize(n);
+  };
+  const std::string count = " x" + std::to_string(kCount);
+  const double bytes = double(kCount * sizeof(float) * 4);
+
+  r.Run("Frustum/Spheres scalar" + count, [&] { scalar(spheres); },
+        double(kCount));
+  r.Run("Frustum/Spheres SoA" + count, [&] {
+    cg2bench::DoNotOptimize(CullSpheres(frustum, sphereSoA, visible.data()));
+  }, double(kCount), bytes);
+  r.Run("Frustum/Spheres AoS" + count, [&] {
+    cg2bench::DoNotOptimize(
+        CullSpheres(frustum, spheres.data(), kCount, visible.data()));
+  }, double(kCount));
+
+  r.Run("Frustum/AABBs scalar" + count, [&] { scalar(aabbs); },
+        double(kCount));
+  r.Run("Frustum/AABBs SoA" + count, [&] {
+    cg2bench::DoNotOptimize(CullAABBs(frustum, aabbSoA, visible.data()));
+  }, double(kCount), bytes * 1.5);
+  r.Run("Frustum/AABBs AoS" + count, [&] {
+    cg2bench::DoNotOptimize(
+        CullAABBs(frustum, aabbs.data(), kCount, visible.data()));
+  }, double(kCount));
+}
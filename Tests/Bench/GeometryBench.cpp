@@ -0,0 +1,86 @@
+#include "Framework/Bench.h"
+#include "ObjLoader/ObjLoader.h"
+#include "Sphere/SphereGeometry.h"
+#include <string>
+
+namespace {
+
+// n × n の格子を三角形で並べた OBJ（v / vt / vn / f を全部使う）
+std::string MakeGridObj(int n) {
+  std::string text;
+  text.reserve(size_t(n + 1) * size_t(n + 1) * 64 + size_t(n) * n * 80);
+  for (int y = 0; y <= n; ++y) {
+    for (int x = 0; x <= n; ++x) {
+      text += "v " + std::to_string(x * 0.125f) + " " +
+              std::to_string((x ^ y) * 0.001f) + " " +
+              std::to_string(y * 0.125f) + "\n";
+      text += "vt " + std::to_string(float(x) / n) + " " +
+              std::to_string(float(y) / n) + "\n";
+    }
+  }
+  text += "vn 0 1 0\n";
+  for (int y = 0; y < n; ++y) {
+    for (int x = 0; x < n; ++x) {
+      const int a = y * (n + 1) + x + 1;
+      const int b = a + 1, c = a + n + 1, d = c + 1;
+      auto corner = [&](int i) {
+        return std::to_string(i) + "/" + std::to_string(i) + "/1";
+      };
+      text += "f " + corner(a) + " " + corner(b) + " " + corner(d) + "\n";
+      text += "f " + corner(a) + " " + corner(d) + " " + corner(c) + "\n";
+    }
+  }
+  return text;
+}
+
+} // namespace
+
+CG2_BENCH(SphereBench)(cg2bench::Runner &r) {
+  std::vector<VertexData> vertices;
+  std::vector<uint16_t> indices;
+  BuildSphereGeometry(1.0f, 32, 32, vertices, indices);
+  const double vertexCount = double(vertices.size());
+  r.Run("Sphere/Build 32x32", [&] {
+    BuildSphereGeometry(1.0f, 32, 32, vertices, indices);
+    cg2bench::DoNotOptimize(vertices.data());
+  }, vertexCount);
+}
+
+CG2_BENCH(ObjParseBench)(cg2bench::Runner &r) {
+  // 1 チャンク 1 MiB 以上なので、4 ワーカーに分かれるよう 4 MiB を超える量
+  // （--quick でも逐次版を 2 回測るだけにならないように）
+  const std::string text = MakeGridObj(r.Quick() ? 192 : 256);
+  ModelData probe;
+  ParseObj(text, ".", probe);
+  const double triangles = double(probe.vertices.size() / 3);
+
+  r.Run("Obj/Parse (1 worker)", [&] {
+    ModelData model;
+    ParseObj(text, ".", model, 1);
+    cg2bench::DoNotOptimize(model.vertices.data());
+  }, triangles, double(text.size()));
+  r.Run("Obj/Parse (4 workers)", [&] {
+    ModelData model;
+    ParseObj(text, ".", model, 4);
+    cg2bench::DoNotOptimize(model.vertices.data());
+  }, triangles, double(text.size()));
+}
+
+// 数百万三角形の OBJ（約 160 MB）。重いので --quick では走らせない
+CG2_BENCH(ObjParseLargeBench)(cg2bench::Runner &r) {
+  if (r.Quick())
+    return;
+  const std::string text = MakeGridObj(1024); // 2,097,152 三角形
+  const double triangles = 2.0 * 1024 * 1024;
+
+  r.Run("Obj/Parse 2M tris (1 worker)", [&] {
+    ModelData model;
+    ParseObj(text, ".", model, 1);
+    cg2bench::DoNotOptimize(model.vertices.data());
+  }, triangles, double(text.size()));
+  r.Run("Obj/Parse 2M tris (4 workers)", [&] {
+    ModelData model;
+    ParseObj(text, ".", model, 4);
+    cg2bench::DoNotOptimize(model.vertices.data());
+  }, triangles, double(text.size()));
+}
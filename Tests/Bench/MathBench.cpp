@@ -0,0 +1,41 @@
+#include "Framework/Bench.h"
+#include "Math/Math.h"
+
+namespace {
+
+constexpr Matrix4x4 kBenchA = {{{3.2f, 0.7f, -1.1f, 0.0f},
+                                {0.4f, 2.5f, 0.9f, 0.0f},
+                                {-0.6f, 1.3f, 1.8f, 0.0f},
+                                {5.0f, -2.0f, 7.5f, 1.0f}}};
+constexpr Matrix4x4 kBenchB = {{{0.5f, -1.5f, 2.0f, 0.25f},
+                                {1.0f, 0.0f, -0.5f, 3.0f},
+                                {2.5f, 1.5f, 0.75f, -1.0f},
+                                {-0.25f, 4.0f, 1.0f, 2.0f}}};
+
+} // namespace
+
+// 行列 1 個あたりの基本演算（実行時に選ばれた実装）
+CG2_BENCH(MathCoreBench)(cg2bench::Runner &r) {
+  Matrix4x4 a = kBenchA;
+  Matrix4x4 b = kBenchB;
+  r.Run("Math/Multiply", [&] {
+    cg2bench::DoNotOptimize(a);
+    cg2bench::DoNotOptimize(Multiply(a, b));
+  }, 1.0, sizeof(Matrix4x4) * 3);
+  r.Run("Math/Inverse", [&] {
+    cg2bench::DoNotOptimize(a);
+    cg2bench::DoNotOptimize(Inverse(a));
+  }, 1.0, sizeof(Matrix4x4) * 2);
+  r.Run("Math/Transpose", [&] {
+    cg2bench::DoNotOptimize(b);
+    cg2bench::DoNotOptimize(Transpose(b));
+  }, 1.0, sizeof(Matrix4x4) * 2);
+
+  Vector3 scale = {2.0f, 0.5f, 1.5f};
+  Vector3 rotate = {0.3f, -1.2f, 2.1f};
+  Vector3 translate = {-4.0f, 0.5f, 10.0f};
+  r.Run("Math/MakeAffineMatrix(Euler)", [&] {
+    cg2bench::DoNotOptimize(rotate);
+    cg2bench::DoNotOptimize(MakeAffineMatrix(scale, rotate, translate));
+  }, 1.0);
+}
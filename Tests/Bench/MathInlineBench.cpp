@@ -0,0 +1,111 @@
+#include "Framework/Bench.h"
+#include "Math/Math.h"
+#include <random>
+#include <vector>
+
+// Math.h の constexpr inline 化の効果を見る。比較相手は最初の実装と同じく
+// 別の翻訳単位にある（インライン化されない）呼び出し
+#if defined(_MSC_VER)
+#define CG2_BENCH_NOINLINE __declspec(noinline)
+#else
+#define CG2_BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace outofline {
+
+CG2_BENCH_NOINLINE Vector3 Add(const Vector3 &a, const Vector3 &b) {
+  return ::Add(a, b);
+}
+CG2_BENCH_NOINLINE Vector3 Subtract(const Vector3 &a, const Vector3 &b) {
+  return ::Subtract(a, b);
+}
+CG2_BENCH_NOINLINE Vector3 Cross(const Vector3 &a, const Vector3 &b) {
+  return ::Cross(a, b);
+}
+CG2_BENCH_NOINLINE float Dot(const Vector3 &a, const Vector3 &b) {
+  return ::Dot(a, b);
+}
+CG2_BENCH_NOINLINE Matrix4x4 MakeScaleMatrix(const Vector3 &s) {
+  return ::MakeScaleMatrix(s);
+}
+CG2_BENCH_NOINLINE Matrix4x4 MakeTranslateMatrix(const Vector3 &t) {
+  return ::MakeTranslateMatrix(t);
+}
+CG2_BENCH_NOINLINE Matrix4x4 Multiply(const Matrix4x4 &a, const Matrix4x4 &b) {
+  return MathScalar::Multiply(a, b);
+}
+CG2_BENCH_NOINLINE Matrix4x4 MakeOrthographicMatrix(float l, float t, float r,
+                                                    float b, float n, float f) {
+  return ::MakeOrthographicMatrix(l, t, r, b, n, f);
+}
+
+} // namespace outofline
+
+namespace {
+
+std::vector<Vector3> MakeVectors(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  std::vector<Vector3> v(count);
+  for (Vector3 &e : v) {
+    e = {dist(rng), dist(rng), dist(rng)};
+  }
+  return v;
+}
+
+} // namespace
+
+// 要素ごとに Add → Subtract → Cross → Dot（1024 要素）
+CG2_BENCH(MathInlineVectorBench)(cg2bench::Runner &r) {
+  constexpr size_t kCount = 1024;
+  const std::vector<Vector3> a = MakeVectors(kCount, 1);
+  const std::vector<Vector3> b = MakeVectors(kCount, 2);
+  std::vector<float> out(kCount);
+
+  r.Run("MathInline/VectorChain(out-of-line) x1024", [&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      const Vector3 s = outofline::Add(a[i], b[i]);
+      const Vector3 d = outofline::Subtract(a[i], b[i]);
+      out[i] = outofline::Dot(outofline::Cross(s, d), a[i]);
+    }
+    cg2bench::DoNotOptimize(out.data());
+  }, double(kCount));
+  r.Run("MathInline/VectorChain(inline) x1024", [&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      const Vector3 s = a[i] + b[i];
+      const Vector3 d = a[i] - b[i];
+      out[i] = Dot(Cross(s, d), a[i]);
+    }
+    cg2bench::DoNotOptimize(out.data());
+  }, double(kCount));
+}
+
+// Scale * Translate の組み立てと、スプライトの直交投影
+CG2_BENCH(MathInlineMatrixBench)(cg2bench::Runner &r) {
+  Vector3 scale = {2.0f, 3.0f, 1.0f};
+  Vector3 translate = {100.0f, 50.0f, 0.0f};
+
+  r.Run("MathInline/ScaleTranslate(out-of-line)", [&] {
+    cg2bench::DoNotOptimize(scale);
+    cg2bench::DoNotOptimize(outofline::Multiply(
+        outofline::MakeScaleMatrix(scale),
+        outofline::MakeTranslateMatrix(translate)));
+  }, 1.0);
+  r.Run("MathInline/ScaleTranslate(inline)", [&] {
+    cg2bench::DoNotOptimize(scale);
+    cg2bench::DoNotOptimize(MakeScaleMatrix(scale) *
+                            MakeTranslateMatrix(translate));
+  }, 1.0);
+
+  float width = 1280.0f, height = 720.0f;
+  r.Run("MathInline/Orthographic(out-of-line)", [&] {
+    cg2bench::DoNotOptimize(width);
+    cg2bench::DoNotOptimize(outofline::MakeOrthographicMatrix(
+        0.0f, 0.0f, width, height, 0.0f, 100.0f));
+  }, 1.0);
+  r.Run("MathInline/Orthographic(constexpr)", [&] {
+    static constexpr Matrix4x4 kProj =
+        MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 100.0f);
+    cg2bench::DoNotOptimize(kProj);
+  }, 1.0);
+}
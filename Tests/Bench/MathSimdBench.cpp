@@ -0,0 +1,52 @@
+#include "Framework/Bench.h"
+#include "Math/Math.h"
+#include "Math/MathSimd.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// レベルごとの Multiply / Inverse / Transpose（行列 1024 個の配列を回す）
+CG2_BENCH(MathSimdBench)(cg2bench::Runner &r) {
+  constexpr size_t kCount = 1024;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<Matrix4x4> src(kCount), dst(kCount);
+  for (Matrix4x4 &m : src) {
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        m.m[i][j] = dist(rng) + (i == j ? 4.0f : 0.0f);
+      }
+    }
+  }
+  const Matrix4x4 rhs = src[kCount / 2];
+
+  const SimdLevel saved = GetSimdLevel();
+  for (SimdLevel level :
+       {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+    if (level > DetectSimdLevel())
+      continue;
+    SetSimdLevel(level);
+    const std::string prefix = std::string("MathSimd/") + SimdLevelName(level);
+    const double bytes = double(kCount * sizeof(Matrix4x4) * 2);
+
+    r.Run(prefix + "/Multiply x1024", [&] {
+      for (size_t i = 0; i < kCount; ++i) {
+        dst[i] = Multiply(src[i], rhs);
+      }
+      cg2bench::DoNotOptimize(dst.data());
+    }, double(kCount), bytes);
+    r.Run(prefix + "/Inverse x1024", [&] {
+      for (size_t i = 0; i < kCount; ++i) {
+        dst[i] = Inverse(src[i]);
+      }
+      cg2bench::DoNotOptimize(dst.data());
+    }, double(kCount), bytes);
+    r.Run(prefix + "/Transpose x1024", [&] {
+      for (size_t i = 0; i < kCount; ++i) {
+        dst[i] = Transpose(src[i]);
+      }
+      cg2bench::DoNotOptimize(dst.data());
+    }, double(kCount), bytes);
+  }
+  SetSimdLevel(saved);
+}
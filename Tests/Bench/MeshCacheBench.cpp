@@ -0,0 +1,104 @@
+#include "Framework/Bench.h"
+#include "Math/Frustum.h"
+#include "Mesh/MeshCache.h"
+#include "Mesh/MeshWeld.h"
+#include "ObjLoader/ObjLoader.h"
+#include "Unit/MeshGrid.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+// 格子を v / vt / vn / f の OBJ として書く
+void WriteGridObj(const std::string &path, uint32_t n) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(n, 0.05f, vertices, indices);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  for (const VertexData &v : vertices) {
+    file << "v " << v.position.x << ' ' << v.position.y << ' ' << v.position.z
+         << "\nvt " << v.texcoord.x << ' ' << v.texcoord.y << '\n';
+  }
+  file << "vn 0 1 0\n";
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    file << 'f';
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t index = indices[i + k] + 1;
+      file << ' ' << index << '/' << index << "/1";
+    }
+    file << '\n';
+  }
+}
+
+// ModelMesh::Load のキャッシュがないときと同じ手順（GPU への転送を除く）
+bool BuildAndWriteCache(const std::string &directory, const std::string &name,
+                        const std::string &cachePath) {
+  ModelData model;
+  if (!LoadObjFile(directory, name, model)) {
+    return false;
+  }
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  WeldVertices(model.vertices.data(), model.vertices.size(), vertices,
+               indices);
+  std::vector<MeshSubset> subsets = {{0, uint32_t(indices.size()), -1}};
+
+  MeshCacheData mesh;
+  mesh.optimizeReport =
+      OptimizeMesh(vertices, indices, subsets.data(), subsets.size());
+  mesh.vertexData = vertices.data();
+  mesh.vertexCount = uint32_t(vertices.size());
+  std::vector<float> lodErrors;
+  mesh.subsetCount = uint32_t(subsets.size());
+  mesh.lodCount = BuildLodChain(vertices.data(), vertices.size(), indices,
+                                subsets, MeshLodSettings{}, lodErrors);
+  mesh.lodErrors = lodErrors.data();
+  std::vector<uint16_t> indices16;
+  if (FitsIndex16(vertices.size())) {
+    PackIndices16(indices.data(), indices.size(), indices16);
+    mesh.indices = indices16.data();
+    mesh.indexSize = sizeof(uint16_t);
+  } else {
+    mesh.indices = indices.data();
+  }
+  mesh.indexCount = uint32_t(indices.size());
+  mesh.subsets = subsets.data();
+  mesh.bounds = ComputeAABB(vertices.data(), vertices.size());
+  mesh.boundingSphere = ComputeBoundingSphere(vertices.data(), vertices.size());
+  return WriteMeshCache(directory + "/" + cachePath, directory + "/" + name,
+                        mesh);
+}
+
+} // namespace
+
+// キャッシュなし（OBJ の解析・溶接・最適化・LOD・書き出し）と
+// キャッシュあり（マップして確かめるだけ）の読み込み
+CG2_BENCH(MeshCacheBench)(cg2bench::Runner &r) {
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "cg2_bench_meshcache";
+  std::filesystem::create_directories(dir);
+  const std::string directory = dir.string();
+  const std::string name = "grid.obj";
+  const uint32_t n = r.Quick() ? 32 : 256;
+  WriteGridObj(directory + "/" + name, n);
+  const std::string cachePath = "grid.cg2mesh";
+  const double triangles = double(n) * n * 2;
+  const std::string size = std::to_string(n * n * 2) + " tris";
+
+  r.Run("MeshCache/Cold load " + size, [&] {
+    cg2bench::DoNotOptimize(BuildAndWriteCache(directory, name, cachePath));
+  }, triangles);
+
+  BuildAndWriteCache(directory, name, cachePath);
+  r.Run("MeshCache/Warm load " + size, [&] {
+    MeshCacheFile file;
+    const bool ok =
+        file.Open(directory + "/" + cachePath, directory + "/" + name);
+    cg2bench::DoNotOptimize(ok);
+    cg2bench::DoNotOptimize(file.Data().vertexData);
+  }, triangles);
+
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+}
@@ -0,0 +1,31 @@
+#include "Framework/Bench.h"
+#include "Mesh/MeshSimplify.h"
+#include "Unit/MeshGrid.h"
+#include <string>
+
+// 1 回の簡略化（×0.25）と LOD の連鎖
+CG2_BENCH(MeshSimplifyBench)(cg2bench::Runner &r) {
+  // 707 × 707 × 2 ≒ 100 万三角形
+  const uint32_t n = r.Quick() ? 64 : 707;
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(n, 0.05f, vertices, indices);
+  const double triangles = double(indices.size() / 3);
+  const std::string size = std::to_string(indices.size() / 3) + " tris";
+
+  std::vector<uint32_t> simplified;
+  r.Run("MeshSimplify/x0.25 " + size, [&] {
+    SimplifyMesh(vertices.data(), vertices.size(), indices.data(),
+                 indices.size(), indices.size() / 4, 1.0f, simplified);
+    cg2bench::DoNotOptimize(simplified.data());
+  }, triangles);
+
+  r.Run("MeshSimplify/LodChain " + size, [&] {
+    std::vector<uint32_t> lodIndices = indices;
+    std::vector<MeshSubset> subsets = {{0, uint32_t(indices.size()), 0}};
+    std::vector<float> errors;
+    BuildLodChain(vertices.data(), vertices.size(), lodIndices, subsets,
+                  MeshLodSettings{}, errors);
+    cg2bench::DoNotOptimize(lodIndices.data());
+  }, triangles);
+}
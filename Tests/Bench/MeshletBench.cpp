@@ -0,0 +1,57 @@
+#include "Framework/Bench.h"
+#include "Math/Frustum.h"
+#include "Math/Math.h"
+#include "Mesh/Meshlet.h"
+#include "Sphere/SphereGeometry.h"
+#include "Unit/MeshGrid.h"
+#include <string>
+
+CG2_BENCH(MeshletBuildBench)(cg2bench::Runner &r) {
+  const uint32_t n = r.Quick() ? 64 : 707;
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(n, 0.05f, vertices, indices);
+  const double triangles = double(indices.size() / 3);
+
+  r.Run("Meshlet/Build " + std::to_string(indices.size() / 3) + " tris", [&] {
+    MeshletData data;
+    BuildMeshlets(vertices.data(), vertices.size(), indices.data(),
+                  indices.size(), data);
+    cg2bench::DoNotOptimize(data.meshlets.data());
+  }, triangles);
+}
+
+// 決まったカメラで球を CPU カリングし、視錐台 / 法線コーンで落ちた三角形数を
+// 名前に入れて出す（球の右側は画面外、奥の半球は裏向き）
+CG2_BENCH(MeshletCullBench)(cg2bench::Runner &r) {
+  const uint32_t slices = r.Quick() ? 48 : 128;
+  std::vector<VertexData> vertices;
+  std::vector<uint16_t> indices16;
+  BuildSphereGeometry(1.0f, slices, slices, vertices, indices16);
+  const std::vector<uint32_t> indices(indices16.begin(), indices16.end());
+  MeshletData data;
+  BuildMeshlets(vertices.data(), vertices.size(), indices.data(),
+                indices.size(), data);
+
+  const Vector3 eye = {0.0f, 0.5f, -3.0f};
+  const Matrix4x4 view = MakeLookAt(eye, Vector3{0.7f, 0.0f, 0.0f},
+                                    Vector3{0.0f, 1.0f, 0.0f});
+  const Matrix4x4 proj = MakePerspectiveFovMatrix(0.6f, 16.0f / 9.0f, 0.1f,
+                                                  100.0f);
+  const Frustum frustum = MakeFrustum(Multiply(view, proj));
+  std::vector<uint32_t> visible(data.Size());
+  MeshletCullStats stats;
+  CullMeshlets(data, frustum, eye, visible.data(), &stats);
+
+  const std::string name =
+      "Meshlet/Cull " + std::to_string(stats.totalTriangles) + " tris (" +
+      std::to_string(data.Size()) + " meshlets, frustum -" +
+      std::to_string(stats.frustumCulledTriangles) + ", cone -" +
+      std::to_string(stats.backfaceCulledTriangles) + ", visible " +
+      std::to_string(stats.visibleTriangles) + ")";
+  r.Run(name, [&] {
+    const size_t count =
+        CullMeshlets(data, frustum, eye, visible.data(), nullptr);
+    cg2bench::DoNotOptimize(count);
+  }, double(data.Size()));
+}
@@ -0,0 +1,93 @@
+#include "Framework/Bench.h"
+#include "Math/Math.h"
+#include "Math/MathSimd.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+// 最初の実装：S * Rx * Ry * Rz * T を 4x4 の積 5 回で組む
+Matrix4x4 MakeAffineThreeMatrix(const Vector3 &scale, const Vector3 &rotate,
+                                const Vector3 &translate) {
+  const Matrix4x4 rotateXYZ = MathScalar::Multiply(
+      MathScalar::Multiply(MakeRotateMatrix(X, rotate.x),
+                           MakeRotateMatrix(Y, rotate.y)),
+      MakeRotateMatrix(Z, rotate.z));
+  return MathScalar::Multiply(
+      MathScalar::Multiply(MakeScaleMatrix(scale), rotateXYZ),
+      MakeTranslateMatrix(translate));
+}
+
+struct Inputs {
+  std::vector<Vector3> scale, euler, translate;
+  std::vector<Quaternion> quaternion;
+};
+
+Inputs MakeInputs(size_t count) {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> dist(-3.0f, 3.0f);
+  Inputs in;
+  for (size_t i = 0; i < count; ++i) {
+    in.scale.push_back({1.0f + dist(rng) * 0.1f, 1.0f, 1.0f - dist(rng) * 0.1f});
+    in.euler.push_back({dist(rng), dist(rng), dist(rng)});
+    in.translate.push_back({dist(rng) * 10.0f, dist(rng), dist(rng) * 10.0f});
+    in.quaternion.push_back(MakeQuaternionFromEuler(in.euler.back()));
+  }
+  return in;
+}
+
+} // namespace
+
+// ワールド行列の組み立て（1024 個）：三行列の積 / 閉じた形（オイラー角・四元数）
+CG2_BENCH(AffineCompositionBench)(cg2bench::Runner &r) {
+  constexpr size_t kCount = 1024;
+  const Inputs in = MakeInputs(kCount);
+  std::vector<Matrix4x4> out(kCount);
+  const double bytes = double(kCount * sizeof(Matrix4x4));
+
+  r.Run("Affine/ThreeMatrix(Euler) x1024", [&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      out[i] = MakeAffineThreeMatrix(in.scale[i], in.euler[i], in.translate[i]);
+    }
+    cg2bench::DoNotOptimize(out.data());
+  }, double(kCount), bytes);
+  r.Run("Affine/ClosedForm(Euler) x1024", [&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      out[i] = MakeAffineMatrix(in.scale[i], in.euler[i], in.translate[i]);
+    }
+    cg2bench::DoNotOptimize(out.data());
+  }, double(kCount), bytes);
+  r.Run("Affine/ClosedForm(Quaternion) x1024", [&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      out[i] =
+          MakeAffineMatrix(in.scale[i], in.quaternion[i], in.translate[i]);
+    }
+    cg2bench::DoNotOptimize(out.data());
+  }, double(kCount), bytes);
+}
+
+// 姿勢の補間（1024 組）
+CG2_BENCH(QuaternionInterpolationBench)(cg2bench::Runner &r) {
+  constexpr size_t kCount = 1024;
+  const Inputs in = MakeInputs(kCount + 1);
+  std::vector<Quaternion> out(kCount);
+
+  r.Run("Quaternion/Slerp x1024", [&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      out[i] = Slerp(in.quaternion[i], in.quaternion[i + 1], 0.3f);
+    }
+    cg2bench::DoNotOptimize(out.data());
+  }, double(kCount));
+  r.Run("Quaternion/Nlerp x1024", [&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      out[i] = Nlerp(in.quaternion[i], in.quaternion[i + 1], 0.3f);
+    }
+    cg2bench::DoNotOptimize(out.data());
+  }, double(kCount));
+  r.Run("Quaternion/MakeFromEuler x1024", [&] {
+    for (size_t i = 0; i < kCount; ++i) {
+      out[i] = MakeQuaternionFromEuler(in.euler[i]);
+    }
+    cg2bench::DoNotOptimize(out.data());
+  }, double(kCount));
+}
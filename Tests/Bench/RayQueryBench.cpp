@@ -0,0 +1,101 @@
+#include "Framework/Bench.h"
+#include "Math/MathSimd.h"
+#include "Math/RayQuery.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// 形状 1024 個に対する最近交差。単体判定を回すスカラー版と、
+// レベルごとの一括判定（RaycastClosest）の本/秒を比べる
+CG2_BENCH(RayQueryBench)(cg2bench::Runner &r) {
+  constexpr size_t kShapes = 1024;
+  constexpr size_t kRays = 64;
+  std::mt19937 rng(8);
+  std::uniform_real_distribution<float> pos(-20.0f, 20.0f);
+  std::uniform_real_distribution<float> size(0.1f, 1.0f);
+
+  std::vector<SphereData> spheres(kShapes);
+  std::vector<AABB> aabbs(kShapes);
+  std::vector<Vector3> triangles(kShapes * 3);
+  SphereBoundsSoA sphereSoA;
+  AABBBoundsSoA aabbSoA;
+  TriangleSoA triangleSoA;
+  for (size_t i = 0; i < kShapes; ++i) {
+    const Vector3 c = {pos(rng), pos(rng), pos(rng)};
+    spheres[i].center = c;
+    spheres[i].radius = size(rng);
+    sphereSoA.Push(spheres[i]);
+    const float h = size(rng);
+    aabbs[i].min = {c.x - h, c.y - h, c.z - h};
+    aabbs[i].max = {c.x + h, c.y + h, c.z + h};
+    aabbSoA.Push(aabbs[i]);
+    for (int k = 0; k < 3; ++k) {
+      triangles[i * 3 + k] = {c.x + pos(rng) * 0.05f, c.y + pos(rng) * 0.05f,
+                              c.z + pos(rng) * 0.05f};
+    }
+    triangleSoA.Push(triangles[i * 3], triangles[i * 3 + 1],
+                     triangles[i * 3 + 2]);
+  }
+  std::vector<RayQuery> rays(kRays);
+  for (RayQuery &q : rays) {
+    q = MakeRayQuery(Ray{{0.0f, 0.0f, -40.0f},
+                         {pos(rng) * 0.02f, pos(rng) * 0.02f, 1.0f}});
+  }
+
+  // スカラー版：単体判定を先頭から回して最も近いものを残す
+  auto scalar = [&](auto &&cast) {
+    int sum = 0;
+    for (const RayQuery &q : rays) {
+      int best = -1;
+      RayHit bestHit, hit;
+      for (size_t i = 0; i < kShapes; ++i) {
+        if (cast(q, i, &hit) && (best < 0 || hit.t < bestHit.t)) {
+          best = int(i);
+          bestHit = hit;
+        }
+      }
+      sum += best;
+    }
+    cg2bench::DoNotOptimize(sum);
+  };
+  const std::string count = " x" + std::to_string(kShapes);
+  r.Run("RayQuery/Scalar/Spheres" + count, [&] {
+    scalar([&](const RayQuery &q, size_t i, RayHit *hit) {
+      return Raycast(q, spheres[i], hit);
+    });
+  }, double(kRays));
+  r.Run("RayQuery/Scalar/AABBs" + count, [&] {
+    scalar([&](const RayQuery &q, size_t i, RayHit *hit) {
+      return Raycast(q, aabbs[i], hit);
+    });
+  }, double(kRays));
+  r.Run("RayQuery/Scalar/Triangles" + count, [&] {
+    scalar([&](const RayQuery &q, size_t i, RayHit *hit) {
+      return Raycast(q, triangles[i * 3], triangles[i * 3 + 1],
+                     triangles[i * 3 + 2], hit);
+    });
+  }, double(kRays));
+
+  // 一括判定（Scalar レベルでも SSE2 の経路になるので SSE2 から）
+  const SimdLevel saved = GetSimdLevel();
+  for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2}) {
+    if (level > DetectSimdLevel())
+      continue;
+    SetSimdLevel(level);
+    const std::string prefix = std::string("RayQuery/") + SimdLevelName(level);
+    auto packet = [&](const auto &soa) {
+      int sum = 0;
+      RayHit hit;
+      for (const RayQuery &q : rays) {
+        sum += RaycastClosest(q, soa, &hit);
+      }
+      cg2bench::DoNotOptimize(sum);
+    };
+    r.Run(prefix + "/Spheres" + count, [&] { packet(sphereSoA); },
+          double(kRays));
+    r.Run(prefix + "/AABBs" + count, [&] { packet(aabbSoA); }, double(kRays));
+    r.Run(prefix + "/Triangles" + count, [&] { packet(triangleSoA); },
+          double(kRays));
+  }
+  SetSimdLevel(saved);
+}
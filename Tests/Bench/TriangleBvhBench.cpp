@@ -0,0 +1,69 @@
+#include "Framework/Bench.h"
+#include "Math/TriangleBvh.h"
+#include "Unit/MeshGrid.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// 起伏のある格子へ上からレイを落とすピッキング。BVH と全三角形の線形探索、
+// それに BVH の構築（1 / 4 スレッド）
+CG2_BENCH(TriangleBvhBench)(cg2bench::Runner &r) {
+  const uint32_t n = r.Quick() ? 32 : 256;
+  std::vector<VertexData> grid;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(n, 0.1f, grid, indices);
+  std::vector<Vector3> positions;
+  positions.reserve(grid.size());
+  for (const VertexData &v : grid) {
+    positions.push_back({v.position.x, v.position.y, v.position.z});
+  }
+  const size_t triangles = indices.size() / 3;
+  const std::string size = " " + std::to_string(triangles) + " tris";
+
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+  std::vector<RayQuery> rays(256);
+  for (RayQuery &q : rays) {
+    q = MakeRayQuery(Ray{{dist(rng), 2.0f, dist(rng)},
+                         {dist(rng) * 0.2f, -1.0f, dist(rng) * 0.2f}});
+  }
+
+  for (uint32_t workers : {1u, 4u}) {
+    r.Run("TriangleBvh/Build" + size + " (" + std::to_string(workers) +
+              (workers == 1 ? " worker)" : " workers)"),
+          [&] {
+            TriangleBvh bvh;
+            bvh.Build(positions.data(), indices.data(), triangles, workers);
+            cg2bench::DoNotOptimize(bvh.NodeCount());
+          },
+          double(triangles));
+  }
+
+  // どちらも 1 回 1 本（ns/op がそのまま 1 本あたりの時間）
+  TriangleBvh bvh;
+  bvh.Build(positions.data(), indices.data(), triangles);
+  size_t next = 0;
+  r.Run("TriangleBvh/Pick BVH" + size, [&] {
+    const RayQuery &q = rays[next++ % rays.size()];
+    uint32_t triangle = 0;
+    bvh.RaycastClosest(q, nullptr, &triangle);
+    cg2bench::DoNotOptimize(triangle);
+  }, 1.0);
+
+  next = 0;
+  r.Run("TriangleBvh/Pick linear" + size, [&] {
+    const RayQuery &q = rays[next++ % rays.size()];
+    float bestT = q.tMax;
+    size_t best = 0;
+    RayHit hit;
+    for (size_t t = 0; t < triangles; ++t) {
+      if (Raycast(q, positions[indices[t * 3]], positions[indices[t * 3 + 1]],
+                  positions[indices[t * 3 + 2]], &hit) &&
+          hit.t < bestT) {
+        bestT = hit.t;
+        best = t;
+      }
+    }
+    cg2bench::DoNotOptimize(best);
+  }, 1.0);
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//==================================
+// 最小のマイクロベンチマーク
+//==================================
+// CG2_BENCH(名前)(cg2bench::Runner &r) { r.Run("カーネル名", ...); } で登録する。
+// Run は 1 回分の処理を、合計時間が目標に届くまで回数を増やして計り、
+// ns/op と処理量（items/s, MB/s）を出す。結果は --json で書き出せる。
+
+namespace cg2bench {
+
+// 結果を捨てられないようにする（最適化で消されないように）
+template <class T> inline void DoNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+struct Result {
+  std::string name;
+  uint64_t iterations = 0;
+  double nsPerOp = 0.0;
+  double itemsPerSecond = 0.0; // itemsPerOp が 0 なら 0
+  double bytesPerSecond = 0.0; // bytesPerOp が 0 なら 0
+};
+
+class Runner {
+public:
+  // quick: 回数を抑える（ctest の動作確認用）
+  explicit Runner(bool quick, const char *filter)
+      : quick_(quick), filter_(filter) {}
+
+  // fn を 1 op として計る。items / bytes は 1 op あたりの処理量
+  template <class Fn>
+  void Run(const std::string &name, Fn &&fn, double itemsPerOp = 0.0,
+           double bytesPerOp = 0.0) {
+    if (!Matches_(name))
+      return;
+    using Clock = std::chrono::steady_clock;
+    const double targetNs = quick_ ? 2.0e6 : 2.0e8;
+
+    fn(); // 温める
+    uint64_t iterations = 1;
+    double elapsedNs = 0.0;
+    for (;;) {
+      const auto start = Clock::now();
+      for (uint64_t i = 0; i < iterations; ++i) {
+        fn();
+      }
+      elapsedNs =
+          std::chrono::duration<double, std::nano>(Clock::now() - start)
+              .count();
+      if (elapsedNs >= targetNs || iterations >= (1ull << 40))
+        break;
+      // 目標に届くだけ増やす（1 回で大きく外さないよう最大 10 倍）
+      const double scale =
+          elapsedNs > 0.0 ? targetNs * 1.2 / elapsedNs : 10.0;
+      iterations = uint64_t(double(iterations) * (scale > 10.0 ? 10.0 : scale)) + 1;
+    }
+
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = elapsedNs / double(iterations);
+    if (itemsPerOp > 0.0)
+      result.itemsPerSecond = itemsPerOp * 1.0e9 / result.nsPerOp;
+    if (bytesPerOp > 0.0)
+      result.bytesPerSecond = bytesPerOp * 1.0e9 / result.nsPerOp;
+    Report_(result);
+    results_.push_back(result);
+  }
+
+  bool Quick() const { return quick_; }
+  const std::vector<Result> &Results() const { return results_; }
+  bool WriteJson(const std::string &path) const;
+
+private:
+  bool Matches_(const std::string &name) const;
+  void Report_(const Result &result) const;
+
+  bool quick_ = false;
+  const char *filter_ = nullptr;
+  std::vector<Result> results_;
+};
+
+struct BenchCase {
+  const char *name;
+  void (*fn)(Runner &);
+};
+std::vector<BenchCase> &Registry();
+
+struct Registrar {
+  Registrar(const char *name, void (*fn)(Runner &)) {
+    Registry().push_back({name, fn});
+  }
+};
+
+} // namespace cg2bench
+
+#define CG2_BENCH(name)                                                        \
+  static void name(::cg2bench::Runner &);                                      \
+  static ::cg2bench::Registrar name##_registrar(#name, name);                  \
+  static void name
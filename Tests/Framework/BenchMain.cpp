@@ -0,0 +1,76 @@
+#include "Bench.h"
+#include <cstdio>
+#include <cstring>
+
+namespace cg2bench {
+
+std::vector<BenchCase> &Registry() {
+  static std::vector<BenchCase> registry;
+  return registry;
+}
+
+bool Runner::Matches_(const std::string &name) const {
+  return !filter_ || name.find(filter_) != std::string::npos;
+}
+
+void Runner::Report_(const Result &result) const {
+  std::printf("%-44s %12.1f ns/op", result.name.c_str(), result.nsPerOp);
+  if (result.itemsPerSecond > 0.0)
+    std::printf(" %10.2f M items/s", result.itemsPerSecond / 1.0e6);
+  if (result.bytesPerSecond > 0.0)
+    std::printf(" %10.1f MB/s", result.bytesPerSecond / 1.0e6);
+  std::printf("\n");
+}
+
+bool Runner::WriteJson(const std::string &path) const {
+  FILE *file = std::fopen(path.c_str(), "w");
+  if (!file)
+    return false;
+  std::fprintf(file, "{\n  \"quick\": %s,\n  \"results\": [\n",
+               quick_ ? "true" : "false");
+  for (size_t i = 0; i < results_.size(); ++i) {
+    const Result &r = results_[i];
+    std::fprintf(file,
+                 "    {\"name\": \"%s\", \"iterations\": %llu, "
+                 "\"ns_per_op\": %.3f, \"items_per_second\": %.1f, "
+                 "\"bytes_per_second\": %.1f}%s\n",
+                 r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+                 r.nsPerOp, r.itemsPerSecond, r.bytesPerSecond,
+                 i + 1 < results_.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  std::fclose(file);
+  return true;
+}
+
+} // namespace cg2bench
+
+// 使い方: cg2_bench [--quick] [--json 出力先] [--filter 名前の一部]
+int main(int argc, char **argv) {
+  bool quick = false;
+  const char *jsonPath = nullptr;
+  const char *filter = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--quick")) {
+      quick = true;
+    } else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+      jsonPath = argv[++i];
+    } else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      std::printf("usage: %s [--quick] [--json path] [--filter text]\n",
+                  argv[0]);
+      return 2;
+    }
+  }
+
+  cg2bench::Runner runner(quick, filter);
+  for (const cg2bench::BenchCase &bench : cg2bench::Registry()) {
+    bench.fn(runner);
+  }
+  if (jsonPath && !runner.WriteJson(jsonPath)) {
+    std::printf("failed to write %s\n", jsonPath);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//==================================
+// 最小のテスト登録（外部ライブラリなし）
+//==================================
+// CG2_TEST(名前) { ... } で登録し、CHECK 系は失敗しても続けて数える。
+// 本体は TestMain.cpp（引数の文字列を名前に含むテストだけ走らせる）。
+
+namespace cg2test {
+
+struct TestCase {
+  const char *name;
+  void (*fn)();
+};
+
+std::vector<TestCase> &Registry();
+
+struct Registrar {
+  Registrar(const char *name, void (*fn)()) {
+    Registry().push_back({name, fn});
+  }
+};
+
+// 今走っているテストの失敗を記録する
+void ReportFailure(const char *file, int line, const char *expr,
+                   const char *detail = nullptr);
+
+// |a - b| <= absTol + relTol * max(|a|, |b|)
+inline bool Near(double a, double b, double absTol, double relTol = 0.0) {
+  const double diff = std::fabs(a - b);
+  const double scale = std::fmax(std::fabs(a), std::fabs(b));
+  return diff <= absTol + relTol * scale;
+}
+
+} // namespace cg2test
+
+#define CG2_TEST(name)                                                         \
+  static void name();                                                          \
+  static ::cg2test::Registrar name##_registrar(#name, name);                   \
+  static void name()
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond))                                                               \
+      ::cg2test::ReportFailure(__FILE__, __LINE__, #cond);                     \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                         \
+  do {                                                                         \
+    if (!((a) == (b)))                                                         \
+      ::cg2test::ReportFailure(__FILE__, __LINE__, #a " == " #b);              \
+  } while (0)
+
+// 絶対誤差で比べる（値も出す）
+#define CHECK_NEAR(a, b, tol)                                                  \
+  do {                                                                         \
+    const double cg2_a_ = double(a), cg2_b_ = double(b);                       \
+    if (!::cg2test::Near(cg2_a_, cg2_b_, double(tol))) {                       \
+      char cg2_detail_[128];                                                   \
+      std::snprintf(cg2_detail_, sizeof(cg2_detail_), "%.9g vs %.9g", cg2_a_,  \
+                    cg2_b_);                                                   \
+      ::cg2test::ReportFailure(__FILE__, __LINE__, #a " ~= " #b, cg2_detail_); \
+    }                                                                          \
+  } while (0)
@@ -0,0 +1,50 @@
+#include "TestFramework.h"
+#include <cstring>
+
+namespace cg2test {
+
+namespace {
+const char *gCurrent = nullptr;
+int gFailures = 0; // 今のテストの失敗数
+} // namespace
+
+std::vector<TestCase> &Registry() {
+  static std::vector<TestCase> registry;
+  return registry;
+}
+
+void ReportFailure(const char *file, int line, const char *expr,
+                   const char *detail) {
+  ++gFailures;
+  // 同じ箇所がループで何度も落ちたときに出力が埋まらないよう最初の数件だけ
+  if (gFailures <= 8) {
+    std::printf("  %s:%d: %s: CHECK(%s)%s%s\n", file, line, gCurrent, expr,
+                detail ? " " : "", detail ? detail : "");
+  }
+}
+
+} // namespace cg2test
+
+// 使い方: cg2_tests [名前の一部]
+int main(int argc, char **argv) {
+  using namespace cg2test;
+  const char *filter = argc > 1 ? argv[1] : nullptr;
+
+  int run = 0, failed = 0;
+  for (const TestCase &test : Registry()) {
+    if (filter && !std::strstr(test.name, filter))
+      continue;
+    gCurrent = test.name;
+    gFailures = 0;
+    test.fn();
+    ++run;
+    if (gFailures > 0) {
+      ++failed;
+      std::printf("[FAIL] %s (%d)\n", test.name, gFailures);
+    } else {
+      std::printf("[ OK ] %s\n", test.name);
+    }
+  }
+  std::printf("%d tests, %d failed\n", run, failed);
+  return failed == 0 ? 0 : 1;
+}
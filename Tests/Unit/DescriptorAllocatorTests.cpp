@@ -0,0 +1,216 @@
+#include "DescriptorHeap/DescriptorAllocator.h"
+#include "Framework/TestFramework.h"
+#include <random>
+#include <vector>
+
+// RingAllocatorTests と同じく、GPU の代わりに完了値を手で進めて確かめる
+
+// Free した番号はそのフレームのフェンスが完了するまで使い回さない
+CG2_TEST(DescriptorAllocatorReusesAfterFence) {
+  DescriptorAllocator alloc;
+  alloc.Init(8);
+  alloc.BeginFrame(0);
+  const DescriptorHandle a = alloc.Allocate(3);
+  const DescriptorHandle b = alloc.Allocate(5);
+  CHECK_EQ(a.index, 0u);
+  CHECK_EQ(b.index, 3u);
+  CHECK_EQ(alloc.CountOf(a), 3u);
+  CHECK_EQ(alloc.GetStats().persistentUsed, 8u);
+
+  alloc.Free(a);
+  CHECK_EQ(alloc.GetStats().pendingFree, 3u);
+  // 満杯のまま：解放待ちの番号は出てこない
+  CHECK(!alloc.Allocate(1));
+  CHECK_EQ(alloc.GetStats().failedAllocations, 1u);
+  alloc.EndFrame(1);
+
+  alloc.BeginFrame(0); // まだ GPU が読んでいるかもしれない
+  CHECK(!alloc.Allocate(1));
+  CHECK_EQ(alloc.GetStats().failedAllocations, 2u);
+  alloc.EndFrame(2);
+
+  alloc.BeginFrame(1);
+  CHECK_EQ(alloc.GetStats().pendingFree, 0u);
+  CHECK_EQ(alloc.GetStats().persistentUsed, 5u);
+  const DescriptorHandle c = alloc.Allocate(2);
+  CHECK_EQ(c.index, 0u);
+  CHECK(c.generation != a.generation);
+  CHECK_EQ(alloc.GetStats().persistentPeak, 8u);
+}
+
+// 戻った範囲は隣の空きとつながり、先頭一致で切り出される
+CG2_TEST(DescriptorAllocatorCoalescesFreeRanges) {
+  DescriptorAllocator alloc;
+  alloc.Init(6);
+  alloc.BeginFrame(0);
+  DescriptorHandle h[6];
+  for (uint32_t i = 0; i < 6; ++i) {
+    h[i] = alloc.Allocate(1);
+    CHECK_EQ(h[i].index, i);
+  }
+  // 順不同に解放し、違うフレームで戻す
+  alloc.Free(h[3]);
+  alloc.Free(h[1]);
+  alloc.EndFrame(1);
+  alloc.BeginFrame(1);
+  CHECK_EQ(alloc.GetStats().freeRanges, 2u);
+  CHECK_EQ(alloc.GetStats().largestFreeRange, 1u);
+  alloc.Free(h[2]);
+  alloc.EndFrame(2);
+  alloc.BeginFrame(2);
+  CHECK_EQ(alloc.GetStats().freeRanges, 1u);
+  CHECK_EQ(alloc.GetStats().largestFreeRange, 3u);
+
+  CHECK_EQ(alloc.Allocate(2).index, 1u);
+  CHECK_EQ(alloc.Allocate(1).index, 3u);
+  CHECK_EQ(alloc.GetStats().freeRanges, 0u);
+  CHECK(!alloc.Allocate(1));
+}
+
+// 解放済み・世代違いのハンドルは無効で、Free しても今の持ち主を壊さない
+CG2_TEST(DescriptorAllocatorRejectsStaleHandles) {
+  DescriptorAllocator alloc;
+  alloc.Init(4);
+  alloc.BeginFrame(0);
+  const DescriptorHandle a = alloc.Allocate(2);
+  CHECK(alloc.IsValid(a));
+
+  alloc.Free(a);
+  CHECK(!alloc.IsValid(a)); // 戻る前でもすぐ無効
+  CHECK_EQ(alloc.CountOf(a), 0u);
+  alloc.Free(a); // 二重解放
+  CHECK_EQ(alloc.GetStats().staleFrees, 1u);
+  CHECK_EQ(alloc.GetStats().pendingFree, 2u);
+  alloc.EndFrame(1);
+  alloc.BeginFrame(1);
+
+  // 同じ番号が別の持ち主に渡っても、古いハンドルとは区別できる
+  const DescriptorHandle b = alloc.Allocate(2);
+  CHECK_EQ(b.index, a.index);
+  CHECK(alloc.IsValid(b));
+  CHECK(!alloc.IsValid(a));
+  alloc.Free(a);
+  CHECK_EQ(alloc.GetStats().staleFrees, 2u);
+  CHECK(alloc.IsValid(b));
+  CHECK_EQ(alloc.GetStats().pendingFree, 0u);
+
+  // 無効なハンドル・範囲外の番号は数えない / 通さない
+  alloc.Free(DescriptorHandle{});
+  CHECK_EQ(alloc.GetStats().staleFrees, 2u);
+  CHECK(!alloc.IsValid(DescriptorHandle{}));
+  CHECK(!alloc.IsValid(DescriptorHandle{100, b.generation}));
+  // 範囲の途中の番号はハンドルではない
+  CHECK(!alloc.IsValid(DescriptorHandle{b.index + 1, b.generation}));
+}
+
+// 一時領域は常駐領域の後ろの番号で、フレームのフェンスが完了すると先頭から使い直す
+CG2_TEST(DescriptorAllocatorTransientResetsPerFrame) {
+  DescriptorAllocator alloc;
+  alloc.Init(4, 8);
+  alloc.BeginFrame(0);
+  CHECK_EQ(alloc.AllocateTransient(5), 4u);
+  CHECK_EQ(alloc.AllocateTransient(3), 9u);
+  CHECK_EQ(alloc.AllocateTransient(1), DescriptorAllocator::kInvalidIndex);
+  alloc.EndFrame(1);
+  CHECK_EQ(alloc.GetStats().transientFrameUsed, 8u);
+  CHECK_EQ(alloc.GetStats().transientFrameOverflows, 1u);
+
+  // フレーム 1 を GPU が読み終えるまでは空かない
+  alloc.BeginFrame(0);
+  CHECK_EQ(alloc.AllocateTransient(1), DescriptorAllocator::kInvalidIndex);
+  alloc.EndFrame(2);
+  CHECK_EQ(alloc.GetStats().transientFrameOverflows, 1u);
+
+  alloc.BeginFrame(1);
+  CHECK_EQ(alloc.AllocateTransient(8), 4u);
+  alloc.EndFrame(3);
+  CHECK_EQ(alloc.GetStats().transientFrameUsed, 8u);
+  CHECK_EQ(alloc.GetStats().transientFrameOverflows, 0u);
+
+  // 一時領域の出入りは常駐領域に影響しない
+  CHECK_EQ(alloc.GetStats().persistentUsed, 0u);
+  CHECK_EQ(alloc.Allocate(4).index, 0u);
+}
+
+// GPU が数フレーム遅れて進む想定で確保・解放を繰り返し、生きている範囲
+// どうし・解放待ちの範囲と重ならないことを毎回確かめる
+CG2_TEST(DescriptorAllocatorNeverReusesInFlight) {
+  struct Live {
+    DescriptorHandle handle;
+    uint32_t count;
+  };
+  struct Pending {
+    uint64_t fence;
+    uint32_t begin;
+    uint32_t end;
+  };
+  constexpr uint32_t kCapacity = 256;
+  DescriptorAllocator alloc;
+  alloc.Init(kCapacity);
+  std::mt19937 rng(24);
+  std::vector<Live> live;
+  std::vector<Pending> pending;
+  uint64_t completed = 0;
+  uint32_t failed = 0;
+
+  for (uint64_t fence = 1; fence <= 1000; ++fence) {
+    const uint64_t lag = rng() % 4;
+    if (fence > lag + 1 && fence - lag - 1 > completed) {
+      completed = fence - lag - 1;
+    }
+    alloc.BeginFrame(completed);
+    std::erase_if(pending,
+                  [&](const Pending &p) { return p.fence <= completed; });
+
+    const uint32_t frees = rng() % 6;
+    for (uint32_t i = 0; i < frees && !live.empty(); ++i) {
+      const size_t pick = rng() % live.size();
+      const Live victim = live[pick];
+      live.erase(live.begin() + pick);
+      alloc.Free(victim.handle);
+      CHECK(!alloc.IsValid(victim.handle));
+      pending.push_back({fence, victim.handle.index,
+                         victim.handle.index + victim.count});
+    }
+
+    const uint32_t allocations = rng() % 6;
+    for (uint32_t i = 0; i < allocations; ++i) {
+      const uint32_t count = 1 + rng() % 16;
+      const DescriptorHandle handle = alloc.Allocate(count);
+      if (!handle) {
+        ++failed;
+        continue;
+      }
+      const uint32_t begin = handle.index;
+      const uint32_t end = begin + count;
+      CHECK(end <= kCapacity);
+      for (const Live &other : live) {
+        CHECK(end <= other.handle.index ||
+              begin >= other.handle.index + other.count);
+      }
+      for (const Pending &p : pending) {
+        CHECK(end <= p.begin || begin >= p.end);
+      }
+      live.push_back({handle, count});
+    }
+    alloc.EndFrame(fence);
+
+    for (const Live &l : live) {
+      CHECK(alloc.IsValid(l.handle));
+      CHECK_EQ(alloc.CountOf(l.handle), l.count);
+    }
+  }
+  CHECK_EQ(alloc.GetStats().failedAllocations, failed);
+  CHECK_EQ(alloc.GetStats().staleFrees, 0u);
+
+  // 全部解放して回収すれば 1 つの空き範囲に戻る
+  for (const Live &l : live) {
+    alloc.Free(l.handle);
+  }
+  alloc.EndFrame(1001);
+  alloc.BeginFrame(~0ull);
+  CHECK_EQ(alloc.GetStats().persistentUsed, 0u);
+  CHECK_EQ(alloc.GetStats().pendingFree, 0u);
+  CHECK_EQ(alloc.GetStats().freeRanges, 1u);
+  CHECK_EQ(alloc.GetStats().largestFreeRange, kCapacity);
+}
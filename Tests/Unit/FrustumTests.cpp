@@ -0,0 +1,159 @@
+#include "Framework/TestFramework.h"
+#include "Math/Frustum.h"
+#include "MathRandom.h"
+#include <vector>
+
+namespace {
+
+// 原点から +Z を向くカメラ（fov 0.8, 16:9, near 0.5, far 50）
+Frustum MakeTestFrustum() {
+  const Matrix4x4 view =
+      MakeLookAt(Vector3{0, 0, 0}, Vector3{0, 0, 1}, Vector3{0, 1, 0});
+  const Matrix4x4 proj =
+      MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.5f, 50.0f);
+  return MakeFrustum(Multiply(view, proj));
+}
+
+// 視錐台の内外・境界付近にまたがる大きさと位置
+SphereData RandomSphere(std::mt19937 &rng) {
+  SphereData sphere;
+  sphere.center = {mathrandom::Uniform(rng, -40.0f, 40.0f),
+                   mathrandom::Uniform(rng, -25.0f, 25.0f),
+                   mathrandom::Uniform(rng, -10.0f, 60.0f)};
+  sphere.radius = mathrandom::Uniform(rng, 0.0f, 4.0f);
+  return sphere;
+}
+
+AABB RandomAABB(std::mt19937 &rng) {
+  const SphereData s = RandomSphere(rng);
+  const Vector3 half = mathrandom::UniformVector(rng, 0.0f, 4.0f);
+  AABB aabb;
+  aabb.min = Subtract(s.center, half);
+  aabb.max = Add(s.center, half);
+  return aabb;
+}
+
+template <class Shape>
+std::vector<uint32_t> ScalarVisible(const Frustum &frustum,
+                                    const std::vector<Shape> &shapes) {
+  std::vector<uint32_t> visible;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    if (IsVisible(frustum, shapes[i])) {
+      visible.push_back(uint32_t(i));
+    }
+  }
+  return visible;
+}
+
+// 一括版の結果を個数分だけ取り出す
+std::vector<uint32_t> Take(const std::vector<uint32_t> &buffer, size_t count) {
+  return std::vector<uint32_t>(buffer.begin(), buffer.begin() + count);
+}
+
+const size_t kCounts[] = {0, 1, 3, 4, 5, 7, 8, 9, 1000};
+
+} // namespace
+
+// 球：SoA 版・AoS 版とも、端数を含むどの個数でも IsVisible を順に回した結果と一致する
+CG2_TEST(FrustumCullSpheresMatchScalar) {
+  const Frustum frustum = MakeTestFrustum();
+  std::mt19937 rng(71);
+  size_t visibleTotal = 0;
+  for (size_t count : kCounts) {
+    for (int trial = 0; trial < 20; ++trial) {
+      std::vector<SphereData> spheres(count);
+      SphereBoundsSoA soa;
+      for (SphereData &s : spheres) {
+        s = RandomSphere(rng);
+        soa.Push(s);
+      }
+      const std::vector<uint32_t> expected = ScalarVisible(frustum, spheres);
+      visibleTotal += expected.size();
+
+      std::vector<uint32_t> visible(count);
+      CHECK(Take(visible, CullSpheres(frustum, soa, visible.data())) ==
+            expected);
+      CHECK(Take(visible, CullSpheres(frustum, spheres.data(), count,
+                                      visible.data())) == expected);
+    }
+  }
+  // 見える・見えないの両方が十分混ざっている
+  CHECK(visibleTotal > 1000);
+  CHECK(visibleTotal < 15000);
+}
+
+// AABB：同上
+CG2_TEST(FrustumCullAABBsMatchScalar) {
+  const Frustum frustum = MakeTestFrustum();
+  std::mt19937 rng(72);
+  size_t visibleTotal = 0;
+  for (size_t count : kCounts) {
+    for (int trial = 0; trial < 20; ++trial) {
+      std::vector<AABB> aabbs(count);
+      AABBBoundsSoA soa;
+      for (AABB &a : aabbs) {
+        a = RandomAABB(rng);
+        soa.Push(a);
+      }
+      const std::vector<uint32_t> expected = ScalarVisible(frustum, aabbs);
+      visibleTotal += expected.size();
+
+      std::vector<uint32_t> visible(count);
+      CHECK(Take(visible, CullAABBs(frustum, soa, visible.data())) ==
+            expected);
+      CHECK(Take(visible, CullAABBs(frustum, aabbs.data(), count,
+                                    visible.data())) == expected);
+    }
+  }
+  CHECK(visibleTotal > 1000);
+  CHECK(visibleTotal < 15000);
+}
+
+// MakeFrustum：カメラの前の点は見え、後ろ・遠すぎ・近すぎ・画角の外は見えない
+CG2_TEST(FrustumMakeFrustumFrontAndBehind) {
+  const Frustum frustum = MakeTestFrustum();
+  for (const Plane &plane : frustum.planes) {
+    CHECK_NEAR(Length(plane.normal), 1.0f, 1e-5f);
+  }
+
+  auto point = [](float x, float y, float z) {
+    SphereData sphere;
+    sphere.center = {x, y, z};
+    sphere.radius = 0.0f;
+    return sphere;
+  };
+  CHECK(IsVisible(frustum, point(0, 0, 1)));
+  CHECK(IsVisible(frustum, point(0, 0, 49)));
+  CHECK(IsVisible(frustum, point(1, -1, 10)));
+  CHECK(!IsVisible(frustum, point(0, 0, -1)));  // 後ろ
+  CHECK(!IsVisible(frustum, point(0, 0, -20))); // 後ろ（遠く）
+  CHECK(!IsVisible(frustum, point(0, 0, 0.25f))); // near より手前
+  CHECK(!IsVisible(frustum, point(0, 0, 51)));    // far より奥
+  CHECK(!IsVisible(frustum, point(20, 0, 10)));   // 右の外
+  CHECK(!IsVisible(frustum, point(-20, 0, 10)));  // 左の外
+  CHECK(!IsVisible(frustum, point(0, 10, 10)));   // 上の外
+  CHECK(!IsVisible(frustum, point(0, -10, 10)));  // 下の外
+
+  // 後ろにあっても半径が near 面まで届けば見える扱い
+  SphereData big = point(0, 0, -1);
+  big.radius = 1.6f;
+  CHECK(IsVisible(frustum, big));
+
+  // 向きを変えたカメラでも同じ：+X を向くと +X の点だけが見える
+  const Matrix4x4 view =
+      MakeLookAt(Vector3{5, 0, 0}, Vector3{6, 0, 0}, Vector3{0, 1, 0});
+  const Matrix4x4 proj =
+      MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.5f, 50.0f);
+  const Frustum side = MakeFrustum(Multiply(view, proj));
+  CHECK(IsVisible(side, point(15, 0, 0)));
+  CHECK(!IsVisible(side, point(-5, 0, 0)));
+  CHECK(!IsVisible(side, point(5, 0, 10)));
+
+  AABB box;
+  box.min = {14, -1, -1};
+  box.max = {16, 1, 1};
+  CHECK(IsVisible(side, box));
+  box.min = {-6, -1, -1};
+  box.max = {-4, 1, 1};
+  CHECK(!IsVisible(side, box));
+}
@@ -0,0 +1,295 @@
+#include "Framework/TestFramework.h"
+#include "ObjLoader/ObjLoader.h"
+#include "Sphere/SphereGeometry.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+CG2_TEST(SphereCountsAndIndices) {
+  std::vector<VertexData> vertices;
+  std::vector<uint16_t> indices;
+  BuildSphereGeometry(1.0f, 16, 16, vertices, indices);
+
+  // 極 2 つ + 中間リング (stacks - 1) 本 × (slices + 1) 頂点
+  CHECK_EQ(vertices.size(), size_t(2 + 15 * 17));
+  // 極ファン 2 × slices + 中間帯 (stacks - 2) × slices × 2 三角形
+  CHECK_EQ(indices.size(), size_t(3 * (2 * 16 + 14 * 16 * 2)));
+  for (uint16_t index : indices) {
+    CHECK(index < vertices.size());
+  }
+}
+
+CG2_TEST(SphereVerticesOnRadius) {
+  const float radius = 2.5f;
+  std::vector<VertexData> vertices;
+  std::vector<uint16_t> indices;
+  BuildSphereGeometry(radius, 12, 8, vertices, indices);
+
+  CHECK_NEAR(vertices.front().position.y, radius, 0.0f);
+  CHECK_NEAR(vertices.back().position.y, -radius, 0.0f);
+  CHECK_NEAR(vertices.back().texcoord.y, 1.0f, 0.0f);
+  for (const VertexData &v : vertices) {
+    const float len = std::sqrt(v.position.x * v.position.x +
+                                v.position.y * v.position.y +
+                                v.position.z * v.position.z);
+    CHECK_NEAR(len, radius, 1e-5f);
+    CHECK_NEAR(v.position.w, 1.0f, 0.0f);
+    // 法線は位置を正規化したもの
+    CHECK_NEAR(v.normal.x, v.position.x / radius, 1e-6f);
+    CHECK_NEAR(v.normal.y, v.position.y / radius, 1e-6f);
+    CHECK_NEAR(v.normal.z, v.position.z / radius, 1e-6f);
+    CHECK(v.texcoord.x >= 0.0f && v.texcoord.x <= 1.0f);
+    CHECK(v.texcoord.y >= 0.0f && v.texcoord.y <= 1.0f);
+  }
+}
+
+// 全部の三角形が同じ巻き順（外から見て左手系の時計回り）
+CG2_TEST(SphereWindingFacesOutward) {
+  std::vector<VertexData> vertices;
+  std::vector<uint16_t> indices;
+  BuildSphereGeometry(1.0f, 16, 16, vertices, indices);
+
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    const Vector4 &a = vertices[indices[i + 0]].position;
+    const Vector4 &b = vertices[indices[i + 1]].position;
+    const Vector4 &c = vertices[indices[i + 2]].position;
+    const float e1x = b.x - a.x, e1y = b.y - a.y, e1z = b.z - a.z;
+    const float e2x = c.x - a.x, e2y = c.y - a.y, e2z = c.z - a.z;
+    const float nx = e1y * e2z - e1z * e2y;
+    const float ny = e1z * e2x - e1x * e2z;
+    const float nz = e1x * e2y - e1y * e2x;
+    const float area2 = nx * nx + ny * ny + nz * nz;
+    if (area2 < 1e-12f)
+      continue; // 継ぎ目の縮退三角形
+    const float cx = a.x + b.x + c.x, cy = a.y + b.y + c.y,
+                cz = a.z + b.z + c.z;
+    // 式の上での e1 × e2 が外を向く
+    CHECK(nx * cx + ny * cy + nz * cz > 0.0f);
+  }
+}
+
+// x 反転・v 反転・巻き順反転と、負の番号の解決
+CG2_TEST(ObjParseConvertsToLeftHanded) {
+  const char *text = "v 1 2 3\n"
+                     "v 4 5 6\n"
+                     "v 7 8 9\n"
+                     "vt 0.25 0.75\n"
+                     "vn 1 0 0\n"
+                     "f 1/1/1 2/1/1 3/1/1\n"
+                     "f -3/-1/-1 -2/-1/-1 -1/-1/-1\n";
+  ModelData model;
+  CHECK(ParseObj(text, ".", model));
+  CHECK_EQ(model.vertices.size(), size_t(6));
+  if (model.vertices.size() != 6)
+    return;
+
+  // 巻き順を反転するので 3 番目の頂点が先頭に来る
+  CHECK_NEAR(model.vertices[0].position.x, -7.0f, 0.0f);
+  CHECK_NEAR(model.vertices[0].position.y, 8.0f, 0.0f);
+  CHECK_NEAR(model.vertices[0].position.z, 9.0f, 0.0f);
+  CHECK_NEAR(model.vertices[2].position.x, -1.0f, 0.0f);
+  CHECK_NEAR(model.vertices[0].position.w, 1.0f, 0.0f);
+  CHECK_NEAR(model.vertices[0].texcoord.x, 0.25f, 0.0f);
+  CHECK_NEAR(model.vertices[0].texcoord.y, 0.25f, 0.0f);
+  CHECK_NEAR(model.vertices[0].normal.x, -1.0f, 0.0f);
+
+  // 相対番号の面は同じ三角形になる
+  for (int i = 0; i < 3; ++i) {
+    CHECK_NEAR(model.vertices[3 + i].position.x, model.vertices[i].position.x,
+               0.0f);
+    CHECK_NEAR(model.vertices[3 + i].position.y, model.vertices[i].position.y,
+               0.0f);
+  }
+}
+
+namespace {
+
+// テストごとの作業ディレクトリ（抜けるときに消す）
+class TempDir {
+public:
+  explicit TempDir(const char *name) {
+    path_ = std::filesystem::temp_directory_path() /
+            (std::string("cg2_tests_") + name);
+    std::filesystem::remove_all(path_);
+    std::filesystem::create_directories(path_);
+  }
+  ~TempDir() {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+  }
+  std::string Path() const { return path_.string(); }
+  std::string File(const char *name) const { return (path_ / name).string(); }
+
+private:
+  std::filesystem::path path_;
+};
+
+// 8 × 8 の格子を blocks 個並べた OBJ。面は相対番号（たまに絶対番号）で、
+// 17 面ごとに usemtl / g を切り替える（チャンクの境目をまたぐ）
+std::string MakeChunkedObj(int blocks) {
+  constexpr int kGrid = 8;
+  constexpr int kVerts = (kGrid + 1) * (kGrid + 1);
+  std::string text = "mtllib parallel.mtl\n";
+  text.reserve(size_t(blocks) * 11000);
+  int face = 0;
+  int switches = 0;
+  for (int b = 0; b < blocks; ++b) {
+    for (int y = 0; y <= kGrid; ++y) {
+      for (int x = 0; x <= kGrid; ++x) {
+        text += "v " + std::to_string(b * 8 + x) + ".5 " +
+                std::to_string((x * 7 + y * 3 + b) % 11) + " " +
+                std::to_string(y) + ".25\n";
+        text += "vt " + std::to_string(x) + "e-1 " + std::to_string(y) +
+                "e-1\n";
+        text += "vn " + std::to_string(x - 4) + " 1 " +
+                std::to_string(4 - y) + "\n";
+      }
+    }
+    const int first = b * kVerts + 1; // このブロックの先頭（絶対番号）
+    for (int y = 0; y < kGrid; ++y) {
+      for (int x = 0; x < kGrid; ++x) {
+        const int a = y * (kGrid + 1) + x;
+        const int corners[2][3] = {{a, a + 1, a + kGrid + 2},
+                                   {a, a + kGrid + 2, a + kGrid + 1}};
+        for (const auto &tri : corners) {
+          if (++face % 17 == 0) {
+            ++switches;
+            text += (switches % 3 == 0)
+                        ? "g group" + std::to_string(switches) + "\n"
+                        : "usemtl mat" + std::to_string(switches % 4) + "\n";
+          }
+          text += "f";
+          for (int k : tri) {
+            // 偶数行は末尾からの相対、奇数行は絶対番号
+            const int index = (y % 2 == 0) ? k - kVerts : first + k;
+            const std::string i = std::to_string(index);
+            text += " " + i + "/" + i + "/" + i;
+          }
+          text += "\n";
+        }
+      }
+    }
+  }
+  return text;
+}
+
+// 全頂点の全成分と部分メッシュが一致するか
+void CheckSameModel(const ModelData &a, const ModelData &b) {
+  CHECK_EQ(a.vertices.size(), b.vertices.size());
+  if (a.vertices.size() != b.vertices.size())
+    return;
+  size_t mismatches = 0;
+  for (size_t i = 0; i < a.vertices.size(); ++i) {
+    const VertexData &u = a.vertices[i];
+    const VertexData &v = b.vertices[i];
+    if (u.position.x != v.position.x || u.position.y != v.position.y ||
+        u.position.z != v.position.z || u.position.w != v.position.w ||
+        u.texcoord.x != v.texcoord.x || u.texcoord.y != v.texcoord.y ||
+        u.normal.x != v.normal.x || u.normal.y != v.normal.y ||
+        u.normal.z != v.normal.z) {
+      ++mismatches;
+    }
+  }
+  CHECK_EQ(mismatches, size_t(0));
+
+  CHECK_EQ(a.subsets.size(), b.subsets.size());
+  if (a.subsets.size() != b.subsets.size())
+    return;
+  for (size_t i = 0; i < a.subsets.size(); ++i) {
+    CHECK_EQ(a.subsets[i].indexStart, b.subsets[i].indexStart);
+    CHECK_EQ(a.subsets[i].indexCount, b.subsets[i].indexCount);
+    CHECK_EQ(a.subsets[i].materialIndex, b.subsets[i].materialIndex);
+  }
+  CHECK_EQ(a.materials.size(), b.materials.size());
+  CHECK(a.material.textureFilePath == b.material.textureFilePath);
+}
+
+} // namespace
+
+// 並列に読んでも逐次と同じ結果（チャンクに分かれる大きさで確かめる）
+CG2_TEST(ObjParallelMatchesSerial) {
+  TempDir dir("obj_parallel");
+  {
+    std::ofstream mtl(dir.File("parallel.mtl"), std::ios::binary);
+    mtl << "newmtl mat0\nmap_Kd a.png\n"
+           "newmtl mat1\nmap_Kd b.png\n"
+           "newmtl mat2\n"
+           "newmtl mat3\nmap_Kd d.png\n";
+  }
+
+  // 1 チャンク 1 MiB 以上なので、4 ワーカーに分かれるよう 4 MiB を超える量
+  const std::string text = MakeChunkedObj(480);
+  CHECK(text.size() > (size_t(4) << 20));
+
+  ModelData serial;
+  CHECK(ParseObj(text, dir.Path(), serial, 1));
+  CHECK_EQ(serial.vertices.size(), size_t(480) * 128 * 3);
+  CHECK_EQ(serial.materials.size(), size_t(4));
+  CHECK(serial.subsets.size() > 1000);
+  // 最初の面は相対番号 (-81, -80, -71)。巻き順を反転して x も反転する
+  CHECK_EQ(serial.vertices[0].position.x, -1.5f);
+  CHECK_EQ(serial.vertices[1].position.x, -1.5f);
+  CHECK_EQ(serial.vertices[2].position.x, -0.5f);
+  CHECK_EQ(serial.vertices[2].position.z, 0.25f);
+  bool sawNoMaterial = false, sawMaterial = false;
+  for (const MeshSubset &subset : serial.subsets) {
+    sawNoMaterial |= subset.materialIndex < 0;
+    sawMaterial |= subset.materialIndex >= 0;
+  }
+  CHECK(sawNoMaterial && sawMaterial);
+
+  for (uint32_t workers : {2u, 3u, 4u}) {
+    ModelData parallel;
+    CHECK(ParseObj(text, dir.Path(), parallel, workers));
+    CheckSameModel(serial, parallel);
+  }
+}
+
+// 2 つ目の mtllib の newmtl より前の map_Kd は、前のライブラリの
+// マテリアルを上書きしない（どこにも付けない）
+CG2_TEST(ObjMaterialLibraryIgnoresAttributesBeforeNewmtl) {
+  TempDir dir("obj_mtllib");
+  {
+    std::ofstream first(dir.File("first.mtl"), std::ios::binary);
+    first << "map_Kd stray0.png\n"
+             "newmtl a\nmap_Kd a.png\n"
+             "newmtl b\nmap_Kd b.png\n";
+    std::ofstream second(dir.File("second.mtl"), std::ios::binary);
+    second << "map_Kd stray1.png\n"
+              "newmtl c\n"
+              "newmtl d\nmap_Kd d.png\n";
+  }
+
+  std::vector<MaterialData> materials;
+  CHECK(LoadMaterialLibrary(dir.Path(), "first.mtl", materials));
+  CHECK(LoadMaterialLibrary(dir.Path(), "second.mtl", materials));
+  CHECK_EQ(materials.size(), size_t(4));
+  if (materials.size() != 4)
+    return;
+  CHECK(materials[0].name == "a");
+  CHECK(materials[0].textureFilePath == dir.Path() + "/a.png");
+  CHECK(materials[1].name == "b");
+  CHECK(materials[1].textureFilePath == dir.Path() + "/b.png");
+  CHECK(materials[2].name == "c");
+  CHECK(materials[2].textureFilePath.empty());
+  CHECK(materials[3].textureFilePath == dir.Path() + "/d.png");
+
+  // OBJ から 2 つのライブラリを読んでも同じ
+  const std::string text = "mtllib first.mtl\nmtllib second.mtl\n"
+                           "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+                           "usemtl b\nf 1 2 3\n"
+                           "usemtl c\nf 1 2 3\n";
+  ModelData model;
+  CHECK(ParseObj(text, dir.Path(), model));
+  CHECK_EQ(model.subsets.size(), size_t(2));
+  if (model.subsets.size() != 2)
+    return;
+  const int b = model.subsets[0].materialIndex;
+  const int c = model.subsets[1].materialIndex;
+  CHECK(b >= 0 && c >= 0);
+  if (b >= 0 && c >= 0) {
+    CHECK(model.materials[b].textureFilePath == dir.Path() + "/b.png");
+    CHECK(model.materials[c].textureFilePath.empty());
+  }
+}
@@ -0,0 +1,130 @@
+#include "Framework/TestFramework.h"
+#include "Instancing/InstanceBatch.h"
+#include "Math/Math.h"
+#include "MathRandom.h"
+#include <vector>
+
+namespace {
+
+bool MatrixNear(const Matrix4x4 &a, const Matrix4x4 &b, float tolerance) {
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      if (!cg2test::Near(a.m[i][j], b.m[i][j], tolerance, tolerance)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Transform RandomTransform(std::mt19937 &rng) {
+  Transform transform{};
+  transform.scale = mathrandom::UniformVector(rng, 0.5f, 2.0f);
+  transform.rotation = mathrandom::UniformVector(rng, -3.0f, 3.0f);
+  transform.translation = mathrandom::UniformVector(rng, -10.0f, 10.0f);
+  return transform;
+}
+
+} // namespace
+
+// 同じキーは 1 つのバケットにまとまり、中は追加順。頂点形式が先に並ぶ
+CG2_TEST(InstanceBatchBucketsByKey) {
+  const int meshA = 0, meshB = 0;
+  const InstanceBucketKey keys[] = {
+      {VertexFormat::Quantized, &meshA, 0, 7},
+      {VertexFormat::Standard, &meshB, 0, 7},
+      {VertexFormat::Standard, &meshA, 1, 7},
+      {VertexFormat::Compact, &meshA, 0, 7},
+      {VertexFormat::Standard, &meshA, 0, 9},
+  };
+  constexpr uint32_t kKeyCount = 5;
+
+  std::mt19937 rng(3);
+  InstanceBatch batch;
+  // キーを交互に 4 周（色の x に追加順を入れておく）
+  std::vector<uint32_t> keyOf;
+  for (uint32_t round = 0; round < 4; ++round) {
+    for (uint32_t k = 0; k < kKeyCount; ++k) {
+      const float index = float(keyOf.size());
+      CHECK_EQ(batch.Add(keys[k], RandomTransform(rng), {index, 0, 0, 1}),
+               uint32_t(keyOf.size()));
+      keyOf.push_back(k);
+    }
+  }
+  batch.Build(MakeIdentity4x4());
+
+  const std::vector<InstanceBucket> &buckets = batch.Buckets();
+  const std::vector<InstanceData> &instances = batch.Instances();
+  CHECK_EQ(buckets.size(), size_t(kKeyCount));
+  CHECK_EQ(instances.size(), keyOf.size());
+
+  uint32_t next = 0;
+  for (size_t b = 0; b < buckets.size(); ++b) {
+    const InstanceBucket &bucket = buckets[b];
+    CHECK_EQ(bucket.firstInstance, next);
+    CHECK_EQ(bucket.instanceCount, 4u);
+    CHECK(bucket.key == keys[keyOf[bucket.firstSubmission]]);
+    // 最初に追加したもの（1 周目）
+    CHECK(bucket.firstSubmission < kKeyCount);
+    for (uint32_t i = 0; i < bucket.instanceCount; ++i) {
+      const uint32_t submission = uint32_t(instances[next + i].color.x);
+      CHECK(keys[keyOf[submission]] == bucket.key);
+      if (i > 0) {
+        CHECK(instances[next + i].color.x > instances[next + i - 1].color.x);
+      }
+    }
+    if (b > 0) {
+      CHECK(int(buckets[b - 1].key.vertexFormat) <=
+            int(bucket.key.vertexFormat));
+    }
+    next += bucket.instanceCount;
+  }
+  // 形式が違えば同じメッシュでも別のバケット（別の PSO）
+  CHECK(buckets.front().key.vertexFormat == VertexFormat::Standard);
+  CHECK(buckets.back().key.vertexFormat == VertexFormat::Quantized);
+}
+
+// 行列は追加した Transform から作ったもので、preTransform は WVP の前に掛かる
+CG2_TEST(InstanceBatchPacksMatrices) {
+  std::mt19937 rng(11);
+  const Matrix4x4 viewProj =
+      Multiply(MakeLookAt(Vector3{0, 5, -10}, Vector3{0, 0, 0},
+                          Vector3{0, 1, 0}),
+               MakePerspectiveFovMatrix(0.8f, 1.5f, 0.1f, 100.0f));
+  Matrix4x4 dequantize = MakeIdentity4x4();
+  dequantize.m[0][0] = 2.0f;
+  dequantize.m[3][1] = -1.0f;
+
+  const int meshA = 0, meshB = 0;
+  InstanceBatch batch;
+  std::vector<Transform> transforms;
+  for (uint32_t i = 0; i < 37; ++i) {
+    transforms.push_back(RandomTransform(rng));
+    const bool quantized = i % 3 == 0;
+    InstanceBucketKey key;
+    key.vertexFormat =
+        quantized ? VertexFormat::Quantized : VertexFormat::Standard;
+    key.geometry = quantized ? &meshA : &meshB;
+    batch.Add(key, transforms.back(), {float(i), 0, 0, 1},
+              quantized ? &dequantize : nullptr);
+  }
+  batch.Build(viewProj, 3);
+
+  for (const InstanceData &instance : batch.Instances()) {
+    const uint32_t i = uint32_t(instance.color.x);
+    const Matrix4x4 world = MakeAffineMatrix(transforms[i]);
+    Matrix4x4 wvp = Multiply(world, viewProj);
+    if (i % 3 == 0) {
+      wvp = Multiply(dequantize, wvp);
+    }
+    CHECK(MatrixNear(instance.World, world, 1e-4f));
+    CHECK(MatrixNear(instance.WVP, wvp, 1e-4f));
+  }
+
+  // Clear で空になり、次のフレームは 0 から
+  batch.Clear();
+  CHECK_EQ(batch.Size(), size_t(0));
+  batch.Build(viewProj);
+  CHECK(batch.Buckets().empty());
+  CHECK(batch.Instances().empty());
+}
@@ -0,0 +1,93 @@
+#include "Framework/TestFramework.h"
+#include "Math/Math.h"
+#include "MathRandom.h"
+
+namespace {
+
+constexpr int kSamples = 2000;
+
+// 行列全体の最大要素に対する誤差（平行移動が大きい行は相対で見る）
+float MaxAbs(const Matrix4x4 &m) {
+  float result = 0.0f;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      result = std::fmax(result, std::fabs(m.m[i][j]));
+    }
+  }
+  return result;
+}
+
+// M * Inv(M) ≈ I（平行移動の行は |t| に比例した丸めを許す）
+void CheckIdentity(const Matrix4x4 &m, const Matrix4x4 &inv, float tol) {
+  const Matrix4x4 product = MathScalar::Multiply(m, inv);
+  const float scale = std::fmax(1.0f, MaxAbs(m)) * std::fmax(1.0f, MaxAbs(inv));
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      CHECK_NEAR(product.m[i][j], i == j ? 1.0f : 0.0f, tol * scale);
+    }
+  }
+}
+
+void CheckAgree(const Matrix4x4 &actual, const Matrix4x4 &expected,
+                float tol) {
+  const float scale = std::fmax(1.0f, MaxAbs(expected));
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      CHECK_NEAR(actual.m[i][j], expected.m[i][j], tol * scale);
+    }
+  }
+}
+
+} // namespace
+
+CG2_TEST(InverseAffineMatchesGeneral) {
+  std::mt19937 rng(21);
+  for (int n = 0; n < kSamples; ++n) {
+    const Matrix4x4 m = mathrandom::Affine(rng);
+    const Matrix4x4 inv = InverseAffine(m);
+    CheckIdentity(m, inv, 2e-6f);
+    CheckAgree(inv, MathScalar::Inverse(m), 2e-6f);
+    // 4 列目はそのまま (0,0,0,1)
+    CHECK_EQ(inv.m[0][3], 0.0f);
+    CHECK_EQ(inv.m[1][3], 0.0f);
+    CHECK_EQ(inv.m[2][3], 0.0f);
+    CHECK_EQ(inv.m[3][3], 1.0f);
+  }
+}
+
+CG2_TEST(InverseRigidMatchesGeneral) {
+  std::mt19937 rng(22);
+  for (int n = 0; n < kSamples; ++n) {
+    const Matrix4x4 m = mathrandom::Rigid(rng);
+    const Matrix4x4 inv = InverseRigid(m);
+    CheckIdentity(m, inv, 2e-6f);
+    CheckAgree(inv, MathScalar::Inverse(m), 2e-6f);
+    CheckAgree(inv, InverseAffine(m), 2e-6f);
+  }
+}
+
+// MakeLookAt はカメラのワールド行列の剛体逆行列
+CG2_TEST(LookAtIsRigidInverseOfCamera) {
+  std::mt19937 rng(23);
+  for (int n = 0; n < kSamples; ++n) {
+    const Vector3 eye = mathrandom::UniformVector(rng, -50.0f, 50.0f);
+    const Vector3 target = mathrandom::UniformVector(rng, -50.0f, 50.0f);
+    if (Length(Subtract(target, eye)) < 1e-2f)
+      continue;
+    const Vector3 up = {0.0f, 1.0f, 0.0f};
+    const Vector3 z = Normalize(Subtract(target, eye));
+    if (std::fabs(Dot(z, up)) > 0.999f)
+      continue; // 真上・真下は up と平行で定まらない
+    const Matrix4x4 view = MakeLookAt(eye, target, up);
+    const Matrix4x4 cameraWorld = InverseRigid(view);
+
+    CheckAgree(view, MathScalar::Inverse(cameraWorld), 2e-6f);
+    // カメラ位置は原点へ、注視点は +Z 上へ移る
+    const Vector3 eyeView = Vector3Transform(eye, view);
+    CHECK_NEAR(Length(eyeView), 0.0f, 1e-4f);
+    const Vector3 targetView = Vector3Transform(target, view);
+    CHECK_NEAR(targetView.x, 0.0f, 1e-3f);
+    CHECK_NEAR(targetView.y, 0.0f, 1e-3f);
+    CHECK(targetView.z > 0.0f);
+  }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Math/MathTypes.h"
+
+//==================================
+// 最初の Math.cpp（スカラー・三行列合成）で計算した値
+//==================================
+// 最適化した実装がこれから外れていないかを MathTests で確かめる。
+// 入力は MathTests.cpp の kInputA / kInputB と各呼び出しの引数。
+
+namespace baseline {
+
+constexpr Matrix4x4 kMultiplyAB = {{
+    {-0.450000048f, -6.45000029f, 5.22500038f, 4.00000000f},
+    {4.94999981f, 0.749999881f, 0.224999964f, 6.69999981f},
+    {5.50000000f, 3.59999990f, -0.500000119f, 1.94999981f},
+    {19.0000000f, 7.75000000f, 17.6250000f, -10.2500000f}
+}};
+constexpr Matrix4x4 kInverseA = {{
+    {0.440942824f, -0.356197059f, 0.447563618f, 0.00000000f},
+    {-0.166843235f, 0.675317824f, -0.439618677f, 0.00000000f},
+    {0.267478824f, -0.606461883f, 1.02224576f, 0.00000000f},
+    {-4.54449129f, 7.68008566f, -10.7838993f, 1.00000012f}
+}};
+constexpr Matrix4x4 kInverseB = {{
+    {-0.0103275776f, 0.187187344f, 0.314991117f, -0.121994510f},
+    {-0.133613035f, -0.0782636702f, 0.0751976743f, 0.171695977f},
+    {0.393738896f, -0.136517674f, -0.00903663039f, 0.151040822f},
+    {0.0690656751f, 0.248184592f, -0.106503144f, 0.0658383071f}
+}};
+constexpr Matrix4x4 kTransposeB = {{
+    {0.500000000f, 1.00000000f, 2.50000000f, -0.250000000f},
+    {-1.50000000f, 0.00000000f, 1.50000000f, 4.00000000f},
+    {2.00000000f, -0.500000000f, 0.750000000f, 1.00000000f},
+    {0.250000000f, 3.00000000f, -1.00000000f, 2.00000000f}
+}};
+constexpr Matrix4x4 kAffine0 = {{
+    {1.00000000f, 0.00000000f, 0.00000000f, 0.00000000f},
+    {0.00000000f, 1.00000000f, 0.00000000f, 0.00000000f},
+    {0.00000000f, 0.00000000f, 1.00000000f, 0.00000000f},
+    {1.00000000f, 2.00000000f, 3.00000000f, 1.00000000f}
+}};
+constexpr Matrix4x4 kAffine1 = {{
+    {-0.365869701f, 0.625581145f, 1.86407816f, 0.00000000f},
+    {-0.342801243f, -0.360028565f, 0.0535420142f, 0.00000000f},
+    {1.05692446f, -0.929128408f, 0.519260347f, 0.00000000f},
+    {-4.00000000f, 0.500000000f, 10.0000000f, 1.00000000f}
+}};
+constexpr Matrix4x4 kAffine2 = {{
+    {0.0704466328f, -0.0297843572f, -0.0644217655f, 0.00000000f},
+    {-0.905357242f, -2.84173870f, 0.323803604f, 0.00000000f},
+    {-0.642380357f, 0.118379459f, -0.757188082f, 0.00000000f},
+    {100.000000f, -50.0000000f, 0.250000000f, 1.00000000f}
+}};
+constexpr Matrix4x4 kPerspective = {{
+    {2.45766950f, 0.00000000f, 0.00000000f, 0.00000000f},
+    {0.00000000f, 4.36919022f, 0.00000000f, 0.00000000f},
+    {0.00000000f, 0.00000000f, 1.00100100f, 1.00000000f},
+    {0.00000000f, 0.00000000f, -0.100100100f, 0.00000000f}
+}};
+constexpr Matrix4x4 kOrthographic = {{
+    {0.00156250002f, 0.00000000f, 0.00000000f, 0.00000000f},
+    {0.00000000f, -0.00277777785f, 0.00000000f, 0.00000000f},
+    {0.00000000f, 0.00000000f, 0.00999999978f, 0.00000000f},
+    {-1.00000000f, 1.00000000f, -0.00000000f, 1.00000000f}
+}};
+constexpr Matrix4x4 kViewport = {{
+    {640.000000f, 0.00000000f, 0.00000000f, 0.00000000f},
+    {0.00000000f, -360.000000f, 0.00000000f, 0.00000000f},
+    {0.00000000f, 0.00000000f, 1.00000000f, 0.00000000f},
+    {640.000000f, 360.000000f, 0.00000000f, 1.00000000f}
+}};
+constexpr Vector3 kTransformed = {-0.670164943f, 0.0974512771f, -1.48500764f};
+constexpr Vector3 kNormalized = {0.230769232f, -0.307692319f, 0.923076928f};
+constexpr Vector3 kCrossed = {2.50000000f, -14.0000000f, 8.50000000f};
+
+} // namespace baseline
@@ -0,0 +1,50 @@
+#pragma once
+#include "Math/Math.h"
+#include <random>
+
+//==================================
+// テスト用の乱数行列（シード固定で再現できる）
+//==================================
+namespace mathrandom {
+
+inline float Uniform(std::mt19937 &rng, float lo, float hi) {
+  return std::uniform_real_distribution<float>(lo, hi)(rng);
+}
+
+inline Vector3 UniformVector(std::mt19937 &rng, float lo, float hi) {
+  return {Uniform(rng, lo, hi), Uniform(rng, lo, hi), Uniform(rng, lo, hi)};
+}
+
+inline Quaternion UnitQuaternion(std::mt19937 &rng) {
+  return Normalize(Quaternion{Uniform(rng, -1.0f, 1.0f),
+                              Uniform(rng, -1.0f, 1.0f),
+                              Uniform(rng, -1.0f, 1.0f),
+                              Uniform(rng, 0.1f, 1.0f)});
+}
+
+// 対角を強めた一般の行列（逆行列の条件数を抑える）
+inline Matrix4x4 General(std::mt19937 &rng) {
+  Matrix4x4 m{};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      m.m[i][j] = Uniform(rng, -1.0f, 1.0f);
+    }
+    m.m[i][i] += (m.m[i][i] < 0.0f ? -4.0f : 4.0f);
+  }
+  return m;
+}
+
+// 拡縮（非一様）・回転・平行移動
+inline Matrix4x4 Affine(std::mt19937 &rng) {
+  Vector3 scale = UniformVector(rng, 0.25f, 4.0f);
+  return MakeAffineMatrix(scale, UnitQuaternion(rng),
+                          UniformVector(rng, -100.0f, 100.0f));
+}
+
+// 回転・平行移動のみ
+inline Matrix4x4 Rigid(std::mt19937 &rng) {
+  return MakeAffineMatrix(Vector3{1.0f, 1.0f, 1.0f}, UnitQuaternion(rng),
+                          UniformVector(rng, -100.0f, 100.0f));
+}
+
+} // namespace mathrandom
@@ -0,0 +1,127 @@
+#include "Framework/TestFramework.h"
+#include "Math/Math.h"
+#include "Math/MathSimd.h"
+#include "MathRandom.h"
+
+namespace {
+
+constexpr int kSamples = 2000;
+
+// 要素ごとに |a - b| <= tol * max(1, |b|)
+bool MatrixNear(const Matrix4x4 &actual, const Matrix4x4 &expected,
+                float tol) {
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      const float scale = std::fmax(1.0f, std::fabs(expected.m[i][j]));
+      if (!cg2test::Near(actual.m[i][j], expected.m[i][j], tol * scale))
+        return false;
+    }
+  }
+  return true;
+}
+
+// 行列全体の大きさ（最大要素）に対する誤差で比べる（逆行列用）
+bool MatrixNormNear(const Matrix4x4 &actual, const Matrix4x4 &expected,
+                    float tol) {
+  float scale = 1.0f;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      scale = std::fmax(scale, std::fabs(expected.m[i][j]));
+    }
+  }
+  return MatrixNear(actual, expected, tol * scale);
+}
+
+// 積の要素ごとに sum_k |a_ik||b_kj| に対する誤差で比べる
+// （打ち消し合って小さくなった要素でも丸めの上限で見る）
+bool ProductNear(const Matrix4x4 &actual, const Matrix4x4 &a,
+                 const Matrix4x4 &b, float tol) {
+  const Matrix4x4 expected = MathScalar::Multiply(a, b);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      float bound = 0.0f;
+      for (int k = 0; k < 4; ++k) {
+        bound += std::fabs(a.m[i][k]) * std::fabs(b.m[k][j]);
+      }
+      if (!cg2test::Near(actual.m[i][j], expected.m[i][j], tol * bound))
+        return false;
+    }
+  }
+  return true;
+}
+
+bool MatrixEqual(const Matrix4x4 &a, const Matrix4x4 &b) {
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      if (a.m[i][j] != b.m[i][j])
+        return false;
+    }
+  }
+  return true;
+}
+
+// テストの間だけレベルを切り替え、抜けるときに戻す
+class ScopedSimdLevel {
+public:
+  explicit ScopedSimdLevel(SimdLevel level) : saved_(GetSimdLevel()) {
+    SetSimdLevel(level);
+  }
+  ~ScopedSimdLevel() { SetSimdLevel(saved_); }
+
+private:
+  SimdLevel saved_;
+};
+
+} // namespace
+
+// SSE2 の積はスカラー版と加算順が同じなのでビット一致
+CG2_TEST(SimdSse2MultiplyBitExact) {
+  std::mt19937 rng(1);
+  for (int n = 0; n < kSamples; ++n) {
+    const Matrix4x4 a = mathrandom::General(rng);
+    const Matrix4x4 b = mathrandom::General(rng);
+    CHECK(MatrixEqual(MathSSE2::Multiply(a, b), MathScalar::Multiply(a, b)));
+    CHECK(MatrixEqual(MathSSE2::Transpose(a), MathScalar::Transpose(a)));
+  }
+}
+
+// AVX2 は FMA の丸め分だけずれる
+CG2_TEST(SimdAvx2MultiplyWithinTolerance) {
+  if (DetectSimdLevel() < SimdLevel::AVX2)
+    return; // この CPU では選ばれない
+  std::mt19937 rng(2);
+  for (int n = 0; n < kSamples; ++n) {
+    const Matrix4x4 a = mathrandom::General(rng);
+    const Matrix4x4 b = mathrandom::Affine(rng);
+    CHECK(ProductNear(MathAVX2::Multiply(a, b), a, b, 1e-6f));
+  }
+}
+
+// 2x2 ブロック分解はスカラー版（余因子）と計算順が違う
+CG2_TEST(SimdSse2InverseWithinTolerance) {
+  std::mt19937 rng(3);
+  for (int n = 0; n < kSamples; ++n) {
+    const Matrix4x4 m =
+        (n & 1) ? mathrandom::General(rng) : mathrandom::Affine(rng);
+    CHECK(MatrixNormNear(MathSSE2::Inverse(m), MathScalar::Inverse(m), 1e-5f));
+  }
+}
+
+// SetSimdLevel で切り替えた実装が Multiply / Inverse から呼ばれる
+CG2_TEST(SimdDispatchFollowsLevel) {
+  const SimdLevel detected = DetectSimdLevel();
+  std::mt19937 rng(4);
+  const Matrix4x4 a = mathrandom::General(rng);
+  const Matrix4x4 b = mathrandom::General(rng);
+
+  for (SimdLevel level :
+       {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+    ScopedSimdLevel scoped(level);
+    // 対応していないレベルは検出したレベルに丸められる
+    CHECK(GetSimdLevel() <= detected);
+    CHECK(MatrixEqual(Multiply(a, b), GetMatrixKernels().multiply(a, b)));
+    CHECK(MatrixEqual(Inverse(a), GetMatrixKernels().inverse(a)));
+    CHECK(ProductNear(Multiply(a, b), a, b, 1e-6f));
+    CHECK(MatrixNormNear(Inverse(a), MathScalar::Inverse(a), 1e-5f));
+  }
+}
@@ -0,0 +1,135 @@
+#include "Framework/TestFramework.h"
+#include "Math/Math.h"
+#include "Math/MathSimd.h"
+#include "MathBaseline.h"
+#include "MathRandom.h"
+
+namespace {
+
+// MathBaseline.h を作ったときの入力
+constexpr Matrix4x4 kInputA = {{{3.2f, 0.7f, -1.1f, 0.0f},
+                                {0.4f, 2.5f, 0.9f, 0.0f},
+                                {-0.6f, 1.3f, 1.8f, 0.0f},
+                                {5.0f, -2.0f, 7.5f, 1.0f}}};
+constexpr Matrix4x4 kInputB = {{{0.5f, -1.5f, 2.0f, 0.25f},
+                                {1.0f, 0.0f, -0.5f, 3.0f},
+                                {2.5f, 1.5f, 0.75f, -1.0f},
+                                {-0.25f, 4.0f, 1.0f, 2.0f}}};
+
+// 要素ごとに |a - b| <= tol * max(1, |b|)
+void CheckMatrixNear(const Matrix4x4 &actual, const Matrix4x4 &expected,
+                     float tol) {
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      const float scale = std::fmax(1.0f, std::fabs(expected.m[i][j]));
+      CHECK_NEAR(actual.m[i][j], expected.m[i][j], tol * scale);
+    }
+  }
+}
+
+void CheckVectorNear(const Vector3 &actual, const Vector3 &expected,
+                     float tol) {
+  CHECK_NEAR(actual.x, expected.x, tol);
+  CHECK_NEAR(actual.y, expected.y, tol);
+  CHECK_NEAR(actual.z, expected.z, tol);
+}
+
+} // namespace
+
+// スカラー版は最初の実装と同じ計算順なので、ほぼ一致する
+CG2_TEST(MathScalarMatchesBaseline) {
+  CheckMatrixNear(MathScalar::Multiply(kInputA, kInputB),
+                  baseline::kMultiplyAB, 1e-6f);
+  CheckMatrixNear(MathScalar::Inverse(kInputA), baseline::kInverseA, 1e-6f);
+  CheckMatrixNear(MathScalar::Inverse(kInputB), baseline::kInverseB, 1e-6f);
+  CheckMatrixNear(MathScalar::Transpose(kInputB), baseline::kTransposeB, 0.0f);
+}
+
+// 実行時に選ばれた実装（SSE2 / AVX2）は丸めの差だけ許す
+CG2_TEST(MathDispatchMatchesBaseline) {
+  CheckMatrixNear(Multiply(kInputA, kInputB), baseline::kMultiplyAB, 1e-5f);
+  CheckMatrixNear(Inverse(kInputA), baseline::kInverseA, 1e-5f);
+  CheckMatrixNear(Inverse(kInputB), baseline::kInverseB, 1e-5f);
+  CheckMatrixNear(Transpose(kInputB), baseline::kTransposeB, 0.0f);
+}
+
+// 閉じた形の合成は三行列の積と丸めが違うだけ
+CG2_TEST(MathAffineMatchesBaseline) {
+  CheckMatrixNear(MakeAffineMatrix(Vector3{1, 1, 1}, Vector3{0, 0, 0},
+                                   Vector3{1, 2, 3}),
+                  baseline::kAffine0, 0.0f);
+  CheckMatrixNear(MakeAffineMatrix(Vector3{2.0f, 0.5f, 1.5f},
+                                   Vector3{0.3f, -1.2f, 2.1f},
+                                   Vector3{-4.0f, 0.5f, 10.0f}),
+                  baseline::kAffine1, 2e-6f);
+  CheckMatrixNear(MakeAffineMatrix(Vector3{0.1f, 3.0f, 1.0f},
+                                   Vector3{3.0f, 0.7f, -0.4f},
+                                   Vector3{100.0f, -50.0f, 0.25f}),
+                  baseline::kAffine2, 2e-6f);
+}
+
+CG2_TEST(MathProjectionMatchesBaseline) {
+  CheckMatrixNear(MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f),
+                  baseline::kPerspective, 1e-6f);
+  CheckMatrixNear(MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f,
+                                         100.0f),
+                  baseline::kOrthographic, 1e-6f);
+  CheckMatrixNear(MakeViewportMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f),
+                  baseline::kViewport, 0.0f);
+}
+
+CG2_TEST(MathVectorMatchesBaseline) {
+  CheckVectorNear(Vector3Transform({1.5f, -2.0f, 0.5f},
+                                   MathScalar::Multiply(kInputA, kInputB)),
+                  baseline::kTransformed, 1e-6f);
+  CheckVectorNear(Normalize(Vector3{3.0f, -4.0f, 12.0f}), baseline::kNormalized,
+                  1e-7f);
+  CheckVectorNear(Cross({1.0f, 2.0f, 3.0f}, {-4.0f, 0.5f, 2.0f}),
+                  baseline::kCrossed, 0.0f);
+}
+
+// 四元数の閉じた形はオイラー角の閉じた形と同じ回転になり、Slerp の端点は入力
+CG2_TEST(MathQuaternionMatchesEuler) {
+  std::mt19937 rng(5);
+  for (int n = 0; n < 500; ++n) {
+    const Vector3 scale = mathrandom::UniformVector(rng, 0.25f, 4.0f);
+    const Vector3 euler = mathrandom::UniformVector(rng, -3.0f, 3.0f);
+    const Vector3 translate = mathrandom::UniformVector(rng, -10.0f, 10.0f);
+    CheckMatrixNear(
+        MakeAffineMatrix(scale, MakeQuaternionFromEuler(euler), translate),
+        MakeAffineMatrix(scale, euler, translate), 2e-5f);
+
+    const Quaternion q0 = mathrandom::UnitQuaternion(rng);
+    const Quaternion q1 = mathrandom::UnitQuaternion(rng);
+    const float sign = Dot(q0, q1) < 0.0f ? -1.0f : 1.0f;
+    const Quaternion end = Slerp(q0, q1, 1.0f);
+    CHECK_NEAR(Slerp(q0, q1, 0.0f).w, q0.w, 1e-5f);
+    CHECK_NEAR(end.x, sign * q1.x, 1e-5f);
+    CHECK_NEAR(end.w, sign * q1.w, 1e-5f);
+    CHECK_NEAR(Norm(Slerp(q0, q1, 0.37f)), 1.0f, 1e-5f);
+  }
+}
+
+// constexpr で畳んだ値は実行時に作った値と同じ
+CG2_TEST(MathConstexprMatchesRuntime) {
+  static constexpr Matrix4x4 kOrtho =
+      MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 100.0f);
+  static constexpr Matrix4x4 kScaleTranslate =
+      MakeScaleMatrix({2.0f, 3.0f, 1.0f}) *
+      MakeTranslateMatrix({100.0f, 50.0f, 0.0f});
+  static constexpr Vector3 kCross =
+      Cross(Vector3{1.0f, 2.0f, 3.0f}, Vector3{-4.0f, 0.5f, 2.0f});
+  static_assert(kOrtho.m[3][3] == 1.0f);
+  static_assert(kScaleTranslate.m[3][0] == 100.0f);
+
+  volatile float w = 1280.0f, h = 720.0f;
+  CheckMatrixNear(kOrtho, MakeOrthographicMatrix(0.0f, 0.0f, w, h, 0.0f, 100.0f),
+                  0.0f);
+  CheckMatrixNear(kOrtho, baseline::kOrthographic, 1e-6f);
+  volatile float sx = 2.0f;
+  CheckMatrixNear(kScaleTranslate,
+                  Multiply(MakeScaleMatrix({sx, 3.0f, 1.0f}),
+                           MakeTranslateMatrix({100.0f, 50.0f, 0.0f})),
+                  0.0f);
+  CheckVectorNear(kCross, baseline::kCrossed, 0.0f);
+}
@@ -0,0 +1,189 @@
+#include "Framework/TestFramework.h"
+#include "Mesh/MeshCache.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+// テストごとの作業ディレクトリ（抜けるときに消す）
+class TempDir {
+public:
+  explicit TempDir(const char *name) {
+    path_ = std::filesystem::temp_directory_path() /
+            (std::string("cg2_tests_") + name);
+    std::filesystem::remove_all(path_);
+    std::filesystem::create_directories(path_);
+  }
+  ~TempDir() {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+  }
+  std::string File(const char *name) const { return (path_ / name).string(); }
+
+private:
+  std::filesystem::path path_;
+};
+
+void WriteText(const std::string &path, const char *text) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << text;
+}
+
+// 四角形 1 枚（4 頂点・2 三角形）
+struct QuadMesh {
+  VertexData vertices[4] = {
+      {{0, 0, 0, 1}, {0, 1}, {0, 0, -1}},
+      {{0, 1, 0, 1}, {0, 0}, {0, 0, -1}},
+      {{1, 0, 0, 1}, {1, 1}, {0, 0, -1}},
+      {{1, 1, 0, 1}, {1, 0}, {0, 0, -1}},
+  };
+  uint16_t indices[6] = {0, 1, 2, 1, 3, 2};
+  MeshSubset subset = {0, 6, -1};
+  std::vector<uint8_t> encoded;
+
+  MeshCacheData Data(VertexFormat format) {
+    MeshCacheData data;
+    data.vertexFormat = format;
+    EncodeVertices(vertices, 4, format, encoded, &data.quantization);
+    data.vertexData = encoded.data();
+    data.vertexCount = 4;
+    data.indices = indices;
+    data.indexCount = 6;
+    data.indexSize = sizeof(uint16_t);
+    data.subsets = &subset;
+    data.subsetCount = 1;
+    data.lodCount = 1;
+    data.bounds = {{0, 0, 0}, {1, 1, 0}};
+    return data;
+  }
+};
+
+} // namespace
+
+// 中身を変える設定が違えば別のファイル名になる
+CG2_TEST(MeshCachePathSeparatesSettings) {
+  const MeshLodSettings lod{};
+  MeshLodSettings fewer = lod;
+  fewer.lodCount = 2;
+  const std::string standard = MakeMeshCachePath(
+      "dir/teapot.obj", HashMeshCacheSettings(VertexFormat::Standard, lod));
+  const std::string compact = MakeMeshCachePath(
+      "dir/teapot.obj", HashMeshCacheSettings(VertexFormat::Compact, lod));
+  const std::string lod2 = MakeMeshCachePath(
+      "dir/teapot.obj", HashMeshCacheSettings(VertexFormat::Standard, fewer));
+  CHECK(standard != compact);
+  CHECK(standard != lod2);
+  CHECK(standard ==
+        MakeMeshCachePath("dir/teapot.obj",
+                          HashMeshCacheSettings(VertexFormat::Standard, lod)));
+  CHECK(standard.rfind("dir/teapot.", 0) == 0);
+  CHECK(standard.size() > 8 &&
+        standard.compare(standard.size() - 8, 8, ".cg2mesh") == 0);
+}
+
+// 詰めた VB はそのまま書かれ、そのまま読める（Quantized は scale/offset も）
+CG2_TEST(MeshCacheKeepsEncodedVertices) {
+  TempDir dir("encoded");
+  const std::string source = dir.File("quad.obj");
+  WriteText(source, "v 0 0 0\n");
+
+  for (VertexFormat format :
+       {VertexFormat::Standard, VertexFormat::Compact, VertexFormat::Quantized}) {
+    QuadMesh quad;
+    const MeshCacheData data = quad.Data(format);
+    const std::string cache = MakeMeshCachePath(
+        source, HashMeshCacheSettings(format, MeshLodSettings{}));
+    CHECK(WriteMeshCache(cache, source, data));
+
+    MeshCacheFile file;
+    CHECK(file.Open(cache, source));
+    const MeshCacheData &read = file.Data();
+    CHECK(read.vertexFormat == format);
+    CHECK_EQ(read.vertexCount, 4u);
+    CHECK(std::memcmp(read.vertexData, quad.encoded.data(),
+                      quad.encoded.size()) == 0);
+    CHECK_EQ(read.quantization.scale.x, data.quantization.scale.x);
+    CHECK_EQ(read.quantization.offset.y, data.quantization.offset.y);
+    CHECK_EQ(read.indexCount, 6u);
+    CHECK(std::memcmp(read.indices, quad.indices, sizeof(quad.indices)) == 0);
+  }
+}
+
+// 頂点数を超えるインデックスを含むファイルは読まない
+CG2_TEST(MeshCacheRejectsOutOfRangeIndex) {
+  TempDir dir("index");
+  const std::string source = dir.File("quad.obj");
+  WriteText(source, "v 0 0 0\n");
+
+  for (uint32_t indexSize : {2u, 4u}) {
+    QuadMesh quad;
+    MeshCacheData data = quad.Data(VertexFormat::Standard);
+    uint32_t indices32[6] = {0, 1, 2, 1, 3, 2};
+    if (indexSize == 4) {
+      data.indices = indices32;
+      data.indexSize = 4;
+    }
+    const std::string cache = dir.File("quad.cg2mesh");
+    CHECK(WriteMeshCache(cache, source, data));
+    MeshCacheFile file;
+    CHECK(file.Open(cache, source));
+    file.Close();
+
+    // 最後のインデックスを頂点数（4）にする
+    quad.indices[5] = 4;
+    indices32[5] = 4;
+    CHECK(WriteMeshCache(cache, source, data));
+    CHECK(!file.Open(cache, source));
+  }
+}
+
+// 元ファイルの中身が変われば読まない
+CG2_TEST(MeshCacheRejectsChangedSource) {
+  TempDir dir("source");
+  const std::string source = dir.File("quad.obj");
+  WriteText(source, "v 0 0 0\n");
+  QuadMesh quad;
+  const std::string cache = dir.File("quad.cg2mesh");
+  CHECK(WriteMeshCache(cache, source, quad.Data(VertexFormat::Standard)));
+
+  MeshCacheFile file;
+  CHECK(file.Open(cache, source));
+  file.Close();
+  WriteText(source, "v 1 0 0\n"); // 大きさは同じ
+  std::filesystem::last_write_time(
+      source, std::filesystem::last_write_time(source) +
+                  std::chrono::seconds(5));
+  CHECK(!file.Open(cache, source));
+}
+
+// 触っただけ（中身は同じ）なら読み、時刻を書き直して次からはハッシュを見ない
+CG2_TEST(MeshCacheRestampsTouchedSource) {
+  TempDir dir("restamp");
+  const std::string source = dir.File("quad.obj");
+  WriteText(source, "v 0 0 0\n");
+  QuadMesh quad;
+  const std::string cache = dir.File("quad.cg2mesh");
+  CHECK(WriteMeshCache(cache, source, quad.Data(VertexFormat::Standard)));
+
+  const auto touched =
+      std::filesystem::last_write_time(source) + std::chrono::seconds(5);
+  std::filesystem::last_write_time(source, touched);
+  MeshCacheFile file;
+  CHECK(file.Open(cache, source));
+  CHECK_EQ(file.Data().indexCount, 6u);
+  CHECK(std::memcmp(file.Data().indices, quad.indices,
+                    sizeof(quad.indices)) == 0);
+  file.Close();
+
+  // 時刻をそのままに中身だけ変えても、書き直した時刻と一致するので
+  // ハッシュは取らない（= 書き直されている）
+  WriteText(source, "v 1 0 0\n");
+  std::filesystem::last_write_time(source, touched);
+  CHECK(file.Open(cache, source));
+  file.Close();
+
+  // 時刻が変われば改めて中身を見る
+  std::filesystem::last_write_time(source, touched + std::chrono::seconds(5));
+  CHECK(!file.Open(cache, source));
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "struct.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// テスト用の格子メッシュ（簡略化・メッシュレットなど）
+//==================================
+namespace meshgrid {
+
+// n × n の格子（XZ 平面、1 辺 1）を高さ amplitude の波で曲げたもの。
+// 縁は開いている。三角形は表が +Y を向く
+inline void MakeWavyGrid(uint32_t n, float amplitude,
+                         std::vector<VertexData> &vertices,
+                         std::vector<uint32_t> &indices) {
+  vertices.clear();
+  indices.clear();
+  vertices.reserve(size_t(n + 1) * (n + 1));
+  indices.reserve(size_t(n) * n * 6);
+  for (uint32_t z = 0; z <= n; ++z) {
+    for (uint32_t x = 0; x <= n; ++x) {
+      const float u = float(x) / float(n);
+      const float v = float(z) / float(n);
+      const float y =
+          amplitude * std::sin(u * 6.2831853f) * std::cos(v * 6.2831853f);
+      vertices.push_back({{u, y, v, 1.0f}, {u, v}, {0.0f, 1.0f, 0.0f}});
+    }
+  }
+  for (uint32_t z = 0; z < n; ++z) {
+    for (uint32_t x = 0; x < n; ++x) {
+      const uint32_t a = z * (n + 1) + x;
+      const uint32_t b = a + 1, c = a + n + 1, d = c + 1;
+      indices.insert(indices.end(), {a, c, b, b, c, d});
+    }
+  }
+}
+
+} // namespace meshgrid
@@ -0,0 +1,189 @@
+#include "Framework/TestFramework.h"
+#include "Mesh/MeshOptimize.h"
+#include "MeshGrid.h"
+#include "Sphere/SphereGeometry.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+
+namespace {
+
+// 三角形の順番を入れ替えた格子（キャッシュにまったく当たらない入力）
+void MakeShuffledGrid(uint32_t n, std::vector<VertexData> &vertices,
+                      std::vector<uint32_t> &indices) {
+  meshgrid::MakeWavyGrid(n, 0.1f, vertices, indices);
+  std::vector<std::array<uint32_t, 3>> triangles(indices.size() / 3);
+  for (size_t t = 0; t < triangles.size(); ++t) {
+    triangles[t] = {indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2]};
+  }
+  std::mt19937 rng(14);
+  std::shuffle(triangles.begin(), triangles.end(), rng);
+  for (size_t t = 0; t < triangles.size(); ++t) {
+    std::copy(triangles[t].begin(), triangles[t].end(), &indices[t * 3]);
+  }
+}
+
+// 三角形を位置の組で表し、巻き順を保ったまま先頭が最小になるよう回して並べる
+// （頂点の並び替えや三角形の順番に左右されない比較用）
+using TriangleKey = std::array<float, 9>;
+template <class Index>
+std::vector<TriangleKey> TriangleSet(const std::vector<VertexData> &vertices,
+                                     const Index *indices, size_t indexCount) {
+  std::vector<TriangleKey> set;
+  for (size_t i = 0; i + 2 < indexCount; i += 3) {
+    std::array<std::array<float, 3>, 3> corner;
+    for (int k = 0; k < 3; ++k) {
+      const Vector4 &p = vertices[indices[i + k]].position;
+      corner[k] = {p.x, p.y, p.z};
+    }
+    const int first = int(std::min_element(corner.begin(), corner.end()) -
+                          corner.begin());
+    TriangleKey key;
+    for (int k = 0; k < 3; ++k) {
+      std::copy(corner[(first + k) % 3].begin(), corner[(first + k) % 3].end(),
+                key.begin() + k * 3);
+    }
+    set.push_back(key);
+  }
+  std::sort(set.begin(), set.end());
+  return set;
+}
+
+} // namespace
+
+// シャッフルした格子で ACMR が大きく下がり、三角形は変わらない
+CG2_TEST(MeshOptimizeImprovesShuffledGrid) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  MakeShuffledGrid(60, vertices, indices);
+  const std::vector<TriangleKey> before =
+      TriangleSet(vertices, indices.data(), indices.size());
+
+  const MeshOptimizeReport report = OptimizeMesh(vertices, indices);
+  CHECK(report.before.acmr > 2.5f);
+  CHECK(report.after.acmr < 0.8f);
+  CHECK(report.after.atvr < report.before.atvr);
+  CHECK_EQ(vertices.size(), size_t(61 * 61));
+  CHECK(TriangleSet(vertices, indices.data(), indices.size()) == before);
+
+  // 頂点フェッチ：最初に使われる順に並ぶ
+  uint32_t next = 0;
+  for (uint32_t index : indices) {
+    CHECK(index <= next);
+    if (index == next)
+      ++next;
+  }
+}
+
+// 同じ入力なら同じ出力
+CG2_TEST(MeshOptimizeIsDeterministic) {
+  std::vector<VertexData> v1, v2;
+  std::vector<uint32_t> i1, i2;
+  MakeShuffledGrid(40, v1, i1);
+  MakeShuffledGrid(40, v2, i2);
+  OptimizeMesh(v1, i1);
+  OptimizeMesh(v2, i2);
+  CHECK(i1 == i2);
+  CHECK(std::memcmp(v1.data(), v2.data(), v1.size() * sizeof(VertexData)) ==
+        0);
+}
+
+// 16bit 版は 32bit 版と同じ並びになる
+CG2_TEST(MeshOptimize16MatchesIndex32) {
+  std::vector<VertexData> v32, v16;
+  std::vector<uint32_t> i32;
+  MakeShuffledGrid(40, v32, i32);
+  v16 = v32;
+  std::vector<uint16_t> i16(i32.begin(), i32.end());
+
+  const MeshOptimizeReport r32 = OptimizeMesh(v32, i32);
+  const MeshOptimizeReport r16 = OptimizeMesh(v16, i16);
+  CHECK_EQ(r32.after.acmr, r16.after.acmr);
+  CHECK_EQ(i32.size(), i16.size());
+  bool same = i32.size() == i16.size();
+  for (size_t i = 0; same && i < i32.size(); ++i) {
+    same = i32[i] == i16[i];
+  }
+  CHECK(same);
+
+  // 球（16bit で作られる）も三角形を保ったまま良くなる
+  std::vector<VertexData> vertices;
+  std::vector<uint16_t> indices;
+  BuildSphereGeometry(1.0f, 32, 32, vertices, indices);
+  const std::vector<TriangleKey> before =
+      TriangleSet(vertices, indices.data(), indices.size());
+  const MeshOptimizeReport report = OptimizeMesh(vertices, indices);
+  CHECK(report.after.acmr <= report.before.acmr);
+  CHECK(TriangleSet(vertices, indices.data(), indices.size()) == before);
+}
+
+// 部分メッシュ付き：三角形は自分の範囲から出ない
+CG2_TEST(MeshOptimizeKeepsSubsetRanges) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  MakeShuffledGrid(40, vertices, indices);
+  const uint32_t third = uint32_t(indices.size() / 9) * 3;
+  const MeshSubset subsets[3] = {
+      {0, third, 0},
+      {third, third, 1},
+      {third * 2, uint32_t(indices.size()) - third * 2, 2}};
+
+  std::vector<std::vector<TriangleKey>> before;
+  for (const MeshSubset &s : subsets) {
+    before.push_back(
+        TriangleSet(vertices, indices.data() + s.indexStart, s.indexCount));
+  }
+  const MeshOptimizeReport report =
+      OptimizeMesh(vertices, indices, subsets, 3);
+  CHECK(report.after.acmr < report.before.acmr);
+  for (size_t i = 0; i < 3; ++i) {
+    CHECK(TriangleSet(vertices, indices.data() + subsets[i].indexStart,
+                      subsets[i].indexCount) == before[i]);
+  }
+}
+
+// 重ね描き：外側の球のまとまりが内側の球より先に描かれる
+CG2_TEST(MeshOptimizeOverdrawDrawsOuterFirst) {
+  std::vector<VertexData> inner, outer;
+  std::vector<uint16_t> innerIndices, outerIndices;
+  BuildSphereGeometry(0.3f, 16, 16, inner, innerIndices);
+  BuildSphereGeometry(1.0f, 16, 16, outer, outerIndices);
+
+  // 内側を先に置く
+  std::vector<VertexData> vertices = inner;
+  vertices.insert(vertices.end(), outer.begin(), outer.end());
+  std::vector<uint32_t> indices(innerIndices.begin(), innerIndices.end());
+  for (uint16_t i : outerIndices) {
+    indices.push_back(uint32_t(inner.size()) + i);
+  }
+  const std::vector<TriangleKey> before =
+      TriangleSet(vertices, indices.data(), indices.size());
+
+  OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+  const VertexCacheStats cached =
+      AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+  OptimizeOverdraw(vertices, indices.data(), indices.size());
+  const VertexCacheStats reordered =
+      AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+  CHECK(TriangleSet(vertices, indices.data(), indices.size()) == before);
+  size_t lastOuter = 0, firstInner = indices.size();
+  for (size_t t = 0; t < indices.size(); t += 3) {
+    if (indices[t] < inner.size()) {
+      firstInner = std::min(firstInner, t);
+    } else {
+      lastOuter = t;
+    }
+  }
+  CHECK(lastOuter < firstInner);
+  // キャッシュ効率はほとんど落ちない
+  CHECK(reordered.acmr <= cached.acmr * 1.1f);
+
+  // 同じ入力なら同じ出力
+  std::vector<uint32_t> again = indices;
+  OptimizeOverdraw(vertices, again.data(), again.size());
+  std::vector<uint32_t> twice = indices;
+  OptimizeOverdraw(vertices, twice.data(), twice.size());
+  CHECK(again == twice);
+}
@@ -0,0 +1,136 @@
+#include "Framework/TestFramework.h"
+#include "Mesh/MeshSimplify.h"
+#include "MeshGrid.h"
+#include <algorithm>
+#include <set>
+
+namespace {
+
+// 三角形の向き（XZ 平面へ落とした面積の符号。格子は +Y 向き）
+float FacingY(const std::vector<VertexData> &vertices, const uint32_t *tri) {
+  const Vector4 &a = vertices[tri[0]].position;
+  const Vector4 &b = vertices[tri[1]].position;
+  const Vector4 &c = vertices[tri[2]].position;
+  return (b.z - a.z) * (c.x - a.x) - (b.x - a.x) * (c.z - a.z);
+}
+
+bool OnBorder(const VertexData &v) {
+  const Vector4 &p = v.position;
+  return p.x == 0.0f || p.x == 1.0f || p.z == 0.0f || p.z == 1.0f;
+}
+
+} // namespace
+
+// 平らな格子は誤差 0 のまま目標まで減り、裏返る面も出ない
+CG2_TEST(MeshSimplifyFlatGridReachesTarget) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(32, 0.0f, vertices, indices);
+
+  std::vector<uint32_t> simplified;
+  float error = -1.0f;
+  const size_t target = indices.size() / 4;
+  SimplifyMesh(vertices.data(), vertices.size(), indices.data(),
+               indices.size(), target, 1e-4f, simplified, &error);
+  CHECK(simplified.size() <= target);
+  CHECK(simplified.size() > 0);
+  CHECK(simplified.size() % 3 == 0);
+  CHECK_NEAR(error, 0.0f, 1e-6f);
+  for (size_t t = 0; t < simplified.size(); t += 3) {
+    CHECK(FacingY(vertices, &simplified[t]) > 0.0f);
+  }
+}
+
+// 誤差の上限を守る（曲がった格子では目標に届かずに止まる）
+CG2_TEST(MeshSimplifyRespectsErrorLimit) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(48, 0.1f, vertices, indices);
+
+  for (float limit : {1e-3f, 1e-2f}) {
+    std::vector<uint32_t> simplified;
+    float error = -1.0f;
+    SimplifyMesh(vertices.data(), vertices.size(), indices.data(),
+                 indices.size(), 0, limit, simplified, &error);
+    CHECK(error <= limit);
+    CHECK(simplified.size() < indices.size());
+    CHECK(simplified.size() > 0);
+    for (uint32_t i : simplified) {
+      CHECK(i < vertices.size());
+    }
+  }
+
+  // 上限が大きいほど減る
+  std::vector<uint32_t> loose, tight;
+  SimplifyMesh(vertices.data(), vertices.size(), indices.data(),
+               indices.size(), 0, 1e-2f, loose);
+  SimplifyMesh(vertices.data(), vertices.size(), indices.data(),
+               indices.size(), 0, 1e-3f, tight);
+  CHECK(loose.size() < tight.size());
+}
+
+// lockBorder なら縁の頂点は 1 つも消えない
+CG2_TEST(MeshSimplifyLockBorderKeepsBorder) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(24, 0.0f, vertices, indices);
+
+  std::vector<uint32_t> simplified;
+  SimplifyMesh(vertices.data(), vertices.size(), indices.data(),
+               indices.size(), indices.size() / 8, 1.0f, simplified, nullptr,
+               true);
+  CHECK(simplified.size() < indices.size() / 2);
+  const std::set<uint32_t> used(simplified.begin(), simplified.end());
+  for (uint32_t v = 0; v < vertices.size(); ++v) {
+    if (OnBorder(vertices[v])) {
+      CHECK(used.count(v) == 1);
+    }
+  }
+}
+
+// 同じ入力なら同じ出力
+CG2_TEST(MeshSimplifyIsDeterministic) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(32, 0.05f, vertices, indices);
+  std::vector<uint32_t> a, b;
+  SimplifyMesh(vertices.data(), vertices.size(), indices.data(),
+               indices.size(), indices.size() / 4, 1.0f, a);
+  SimplifyMesh(vertices.data(), vertices.size(), indices.data(),
+               indices.size(), indices.size() / 4, 1.0f, b);
+  CHECK(a == b);
+}
+
+// LOD は段ごとに減り、誤差は増えていく。部分メッシュの並びは [LOD][部分]
+CG2_TEST(MeshSimplifyLodChain) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(32, 0.05f, vertices, indices);
+  const uint32_t half = uint32_t(indices.size() / 2);
+  std::vector<MeshSubset> subsets = {{0, half, 0}, {half, half, 1}};
+
+  MeshLodSettings settings;
+  settings.lodCount = 4;
+  settings.maxError = 0.05f;
+  std::vector<float> errors;
+  const uint32_t lodCount = BuildLodChain(vertices.data(), vertices.size(),
+                                          indices, subsets, settings, errors);
+  CHECK(lodCount >= 2);
+  CHECK(lodCount <= settings.lodCount);
+  CHECK_EQ(errors.size(), size_t(lodCount));
+  CHECK_EQ(subsets.size(), size_t(lodCount) * 2);
+  CHECK_EQ(errors[0], 0.0f);
+  for (uint32_t lod = 1; lod < lodCount; ++lod) {
+    CHECK(errors[lod] >= errors[lod - 1]);
+    CHECK(errors[lod] <= settings.maxError + 1e-6f);
+    for (uint32_t s = 0; s < 2; ++s) {
+      const MeshSubset &now = subsets[lod * 2 + s];
+      const MeshSubset &before = subsets[(lod - 1) * 2 + s];
+      CHECK(now.indexCount < before.indexCount);
+      CHECK_EQ(now.materialIndex, int32_t(s));
+      CHECK(size_t(now.indexStart) + now.indexCount <= indices.size());
+    }
+  }
+  CHECK_EQ(SelectLod(errors.data(), lodCount, 0.0f, 1.0f), lodCount - 1);
+  CHECK_EQ(SelectLod(errors.data(), lodCount, 1e9f, 1.0f), 0u);
+}
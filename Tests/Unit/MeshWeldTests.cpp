@@ -0,0 +1,113 @@
+#include "Framework/TestFramework.h"
+#include "Mesh/MeshWeld.h"
+#include "MeshGrid.h"
+#include <cstring>
+
+namespace {
+
+// インデックス付きのメッシュを三角形リスト（頂点の重複あり）に戻す
+std::vector<VertexData> ExpandToSoup(const std::vector<VertexData> &vertices,
+                                     const std::vector<uint32_t> &indices) {
+  std::vector<VertexData> soup;
+  soup.reserve(indices.size());
+  for (uint32_t index : indices) {
+    soup.push_back(vertices[index]);
+  }
+  return soup;
+}
+
+bool SameBits(const VertexData &a, const VertexData &b) {
+  return std::memcmp(&a, &b, sizeof(VertexData)) == 0;
+}
+
+} // namespace
+
+// 格子の三角形リストは格子の頂点数まで減り、インデックスで元に戻せる
+CG2_TEST(MeshWeldRebuildsGrid) {
+  std::vector<VertexData> grid;
+  std::vector<uint32_t> gridIndices;
+  meshgrid::MakeWavyGrid(20, 0.1f, grid, gridIndices);
+  const std::vector<VertexData> soup = ExpandToSoup(grid, gridIndices);
+
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  WeldVertices(soup.data(), soup.size(), vertices, indices);
+  CHECK_EQ(vertices.size(), size_t(21 * 21));
+  CHECK_EQ(indices.size(), soup.size());
+
+  size_t mismatches = 0;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (indices[i] >= vertices.size() || !SameBits(vertices[indices[i]], soup[i]))
+      ++mismatches;
+  }
+  CHECK_EQ(mismatches, size_t(0));
+
+  // 頂点は最初に出てきた順
+  uint32_t next = 0;
+  for (uint32_t index : indices) {
+    CHECK(index <= next);
+    if (index == next)
+      ++next;
+  }
+}
+
+// UV や法線が違えば位置が同じでもまとめない（ビット単位の比較）
+CG2_TEST(MeshWeldKeepsSeams) {
+  const VertexData a = {{1, 2, 3, 1}, {0, 0}, {0, 1, 0}};
+  VertexData uvSeam = a;
+  uvSeam.texcoord.x = 1.0f;
+  VertexData normalSeam = a;
+  normalSeam.normal = {0, -1, 0};
+  VertexData negativeZero = a;
+  negativeZero.texcoord.y = -0.0f;
+  const VertexData soup[] = {a, uvSeam, a, normalSeam, negativeZero, uvSeam};
+
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  WeldVertices(soup, 6, vertices, indices);
+  CHECK_EQ(vertices.size(), size_t(4));
+  const uint32_t expected[] = {0, 1, 0, 2, 3, 1};
+  CHECK(indices.size() == 6 &&
+        std::memcmp(indices.data(), expected, sizeof(expected)) == 0);
+
+  // 空の入力
+  WeldVertices(soup, 0, vertices, indices);
+  CHECK(vertices.empty());
+  CHECK(indices.empty());
+}
+
+// 16bit に入るのは頂点数 65536 まで（番号は 0xFFFF まで）
+CG2_TEST(MeshWeldIndex16Boundary) {
+  CHECK(FitsIndex16(0));
+  CHECK(FitsIndex16(0xFFFF));
+  CHECK(FitsIndex16(0x10000));
+  CHECK(!FitsIndex16(0x10001));
+
+  const uint32_t indices[] = {0, 1, 0x7FFF, 0x8000, 0xFFFE, 0xFFFF};
+  std::vector<uint16_t> packed;
+  PackIndices16(indices, 6, packed);
+  CHECK_EQ(packed.size(), size_t(6));
+  for (size_t i = 0; i < packed.size(); ++i) {
+    CHECK_EQ(uint32_t(packed[i]), indices[i]);
+  }
+
+  // 255 × 255 の格子はちょうど 65536 頂点、256 × 256 は入らない
+  std::vector<VertexData> grid;
+  std::vector<uint32_t> gridIndices;
+  meshgrid::MakeWavyGrid(255, 0.1f, grid, gridIndices);
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> welded;
+  const std::vector<VertexData> soup = ExpandToSoup(grid, gridIndices);
+  WeldVertices(soup.data(), soup.size(), vertices, welded);
+  CHECK_EQ(vertices.size(), size_t(0x10000));
+  CHECK(FitsIndex16(vertices.size()));
+  PackIndices16(welded.data(), welded.size(), packed);
+  bool same = packed.size() == welded.size();
+  for (size_t i = 0; same && i < welded.size(); ++i) {
+    same = packed[i] == welded[i];
+  }
+  CHECK(same);
+
+  meshgrid::MakeWavyGrid(256, 0.1f, grid, gridIndices);
+  CHECK(!FitsIndex16(grid.size()));
+}
@@ -0,0 +1,163 @@
+#include "Framework/TestFramework.h"
+#include "Math/Math.h"
+#include "Mesh/Meshlet.h"
+#include "MeshGrid.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+
+using Triangle = std::array<uint32_t, 3>;
+
+// 塊から三角形を VB の番号へ戻す（順番は問わないので並べて返す）
+std::vector<Triangle> Decode(const MeshletData &data, size_t first,
+                             size_t last) {
+  std::vector<Triangle> triangles;
+  for (size_t m = first; m < last; ++m) {
+    const Meshlet &meshlet = data.meshlets[m];
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+      Triangle tri;
+      for (int k = 0; k < 3; ++k) {
+        const uint8_t local =
+            data.triangles[meshlet.triangleOffset + t * 3 + k];
+        tri[k] = data.vertices[meshlet.vertexOffset + local];
+      }
+      triangles.push_back(tri);
+    }
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+std::vector<Triangle> Sorted(const uint32_t *indices, size_t indexCount) {
+  std::vector<Triangle> triangles;
+  for (size_t i = 0; i < indexCount; i += 3) {
+    triangles.push_back({indices[i], indices[i + 1], indices[i + 2]});
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+void CheckLimits(const MeshletData &data, uint32_t maxVertices,
+                 uint32_t maxTriangles) {
+  for (const Meshlet &meshlet : data.meshlets) {
+    CHECK(meshlet.vertexCount >= 3);
+    CHECK(meshlet.vertexCount <= maxVertices);
+    CHECK(meshlet.triangleCount >= 1);
+    CHECK(meshlet.triangleCount <= maxTriangles);
+    for (uint32_t i = 0; i < meshlet.triangleCount * 3; ++i) {
+      CHECK(data.triangles[meshlet.triangleOffset + i] < meshlet.vertexCount);
+    }
+  }
+  CHECK_EQ(data.bounds.size(), data.meshlets.size());
+}
+
+// 四角形を x 方向に並べる（島どうしは頂点を共有しない）
+void MakeIslands(uint32_t count, std::vector<VertexData> &vertices,
+                 std::vector<uint32_t> &indices) {
+  for (uint32_t i = 0; i < count; ++i) {
+    const float x = float(i) * 0.05f; // 隣の島と少し重なる
+    const uint32_t base = uint32_t(vertices.size());
+    vertices.push_back({{x, 0, 0, 1}, {0, 0}, {0, 1, 0}});
+    vertices.push_back({{x, 0, 0.1f, 1}, {0, 1}, {0, 1, 0}});
+    vertices.push_back({{x + 0.1f, 0, 0, 1}, {1, 0}, {0, 1, 0}});
+    vertices.push_back({{x + 0.1f, 0, 0.1f, 1}, {1, 1}, {0, 1, 0}});
+    indices.insert(indices.end(),
+                   {base, base + 1, base + 2, base + 2, base + 1, base + 3});
+  }
+}
+
+} // namespace
+
+// すべての三角形がちょうど 1 回ずつ、上限を守って塊に入る
+CG2_TEST(MeshletCoversEveryTriangleOnce) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(40, 0.1f, vertices, indices);
+
+  for (uint32_t maxVertices : {64u, 32u}) {
+    MeshletData data;
+    BuildMeshlets(vertices.data(), vertices.size(), indices.data(),
+                  indices.size(), data, maxVertices, 64);
+    CheckLimits(data, maxVertices, 64);
+    CHECK(Decode(data, 0, data.Size()) ==
+          Sorted(indices.data(), indices.size()));
+
+    const MeshletStats stats = AnalyzeMeshlets(data, maxVertices, 64);
+    CHECK_EQ(stats.triangleCount, uint32_t(indices.size() / 3));
+    // 格子なら塊はそれなりに埋まる
+    CHECK(stats.vertexFill > 0.5f);
+  }
+}
+
+// 塊は部分メッシュをまたがない
+CG2_TEST(MeshletKeepsSubsetsApart) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(24, 0.0f, vertices, indices);
+  const uint32_t split = uint32_t(indices.size() / 3 / 3) * 3;
+  const MeshSubset subsets[2] = {
+      {0, split, 0}, {split, uint32_t(indices.size()) - split, 1}};
+
+  MeshletData data;
+  BuildMeshlets(vertices.data(), vertices.size(), indices.data(), subsets, 2,
+                data);
+  CheckLimits(data, kMeshletMaxVertices, kMeshletMaxTriangles);
+  CHECK_EQ(data.subsetMeshletStart.size(), size_t(3));
+  CHECK_EQ(data.subsetMeshletStart.back(), uint32_t(data.Size()));
+  for (int s = 0; s < 2; ++s) {
+    CHECK(Decode(data, data.subsetMeshletStart[s],
+                 data.subsetMeshletStart[s + 1]) ==
+          Sorted(indices.data() + subsets[s].indexStart,
+                 subsets[s].indexCount));
+  }
+}
+
+// つながっていない島も近ければ同じ塊にまとめる
+CG2_TEST(MeshletJoinsNearbyIslands) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  MakeIslands(200, vertices, indices);
+
+  MeshletData data;
+  BuildMeshlets(vertices.data(), vertices.size(), indices.data(),
+                indices.size(), data);
+  CheckLimits(data, kMeshletMaxVertices, kMeshletMaxTriangles);
+  CHECK(Decode(data, 0, data.Size()) == Sorted(indices.data(), indices.size()));
+  CHECK(data.Size() < 200);
+}
+
+// 平らな格子を表から見ればすべて見え、裏から見ればすべて法線コーンで落ちる
+CG2_TEST(MeshletConeCullsBackside) {
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  meshgrid::MakeWavyGrid(32, 0.0f, vertices, indices);
+  MeshletData data;
+  BuildMeshlets(vertices.data(), vertices.size(), indices.data(),
+                indices.size(), data);
+
+  const Matrix4x4 proj = MakePerspectiveFovMatrix(1.5f, 1.0f, 0.1f, 10.0f);
+  std::vector<uint32_t> visible(data.Size());
+  for (float y : {2.0f, -2.0f}) {
+    const Vector3 eye = {0.5f, y, 0.5f};
+    const Matrix4x4 view =
+        MakeLookAt(eye, Vector3{0.5f, 0.0f, 0.5f}, Vector3{0.0f, 0.0f, 1.0f});
+    MeshletCullStats stats;
+    const size_t count = CullMeshlets(data, MakeFrustum(Multiply(view, proj)),
+                                      eye, visible.data(), &stats);
+    CHECK_EQ(stats.frustumCulled, 0u);
+    CHECK_EQ(stats.totalTriangles, uint32_t(indices.size() / 3));
+    CHECK_EQ(stats.frustumCulledTriangles, 0u);
+    if (y > 0.0f) {
+      CHECK_EQ(count, data.Size());
+      CHECK_EQ(stats.visibleTriangles, stats.totalTriangles);
+      CHECK_EQ(stats.backfaceCulledTriangles, 0u);
+    } else {
+      CHECK_EQ(count, size_t(0));
+      CHECK_EQ(stats.backfaceCulled, uint32_t(data.Size()));
+      CHECK_EQ(stats.backfaceCulledTriangles, stats.totalTriangles);
+    }
+    CHECK(std::is_sorted(visible.begin(), visible.begin() + count));
+  }
+}
@@ -0,0 +1,205 @@
+#include "Framework/TestFramework.h"
+#include "Math/MathSimd.h"
+#include "Math/RayQuery.h"
+#include "MathRandom.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Triangle {
+  Vector3 v0, v1, v2;
+};
+
+// 形状ごとの作成・SoA への追加・単体判定をそろえる
+SphereData RandomShape(std::mt19937 &rng, SphereData *) {
+  SphereData sphere;
+  sphere.center = mathrandom::UniformVector(rng, -4.0f, 4.0f);
+  sphere.radius = mathrandom::Uniform(rng, 0.1f, 1.5f);
+  return sphere;
+}
+
+AABB RandomShape(std::mt19937 &rng, AABB *) {
+  const Vector3 center = mathrandom::UniformVector(rng, -4.0f, 4.0f);
+  const Vector3 half = mathrandom::UniformVector(rng, 0.05f, 1.5f);
+  AABB aabb;
+  aabb.min = Subtract(center, half);
+  aabb.max = Add(center, half);
+  return aabb;
+}
+
+Triangle RandomShape(std::mt19937 &rng, Triangle *) {
+  const Vector3 center = mathrandom::UniformVector(rng, -4.0f, 4.0f);
+  return {Add(center, mathrandom::UniformVector(rng, -1.5f, 1.5f)),
+          Add(center, mathrandom::UniformVector(rng, -1.5f, 1.5f)),
+          Add(center, mathrandom::UniformVector(rng, -1.5f, 1.5f))};
+}
+
+void Push(SphereBoundsSoA &soa, const SphereData &s) { soa.Push(s); }
+void Push(AABBBoundsSoA &soa, const AABB &a) { soa.Push(a); }
+void Push(TriangleSoA &soa, const Triangle &t) { soa.Push(t.v0, t.v1, t.v2); }
+
+Vector3 Center(const SphereData &s) { return s.center; }
+Vector3 Center(const AABB &a) { return Multiply(Add(a.min, a.max), 0.5f); }
+Vector3 Center(const Triangle &t) {
+  return Multiply(Add(Add(t.v0, t.v1), t.v2), 1.0f / 3.0f);
+}
+
+bool CastOne(const RayQuery &q, const SphereData &s, RayHit *hit) {
+  return Raycast(q, s, hit);
+}
+bool CastOne(const RayQuery &q, const AABB &a, RayHit *hit) {
+  return Raycast(q, a, hit);
+}
+bool CastOne(const RayQuery &q, const Triangle &t, RayHit *hit) {
+  return Raycast(q, t.v0, t.v1, t.v2, hit);
+}
+
+// 単体判定を先頭から順に回す（等距離なら先に見つけた小さい番号）
+template <class Shape>
+int LinearClosest(const RayQuery &q, const std::vector<Shape> &shapes,
+                  RayHit &outHit) {
+  int best = -1;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    RayHit hit;
+    if (CastOne(q, shapes[i], &hit) && (best < 0 || hit.t < outHit.t)) {
+      best = int(i);
+      outHit = hit;
+    }
+  }
+  return best;
+}
+
+bool SameHit(const RayHit &a, const RayHit &b) {
+  return a.t == b.t && a.distance == b.distance &&
+         std::memcmp(&a.point, &b.point, sizeof(Vector3)) == 0 &&
+         std::memcmp(&a.normal, &b.normal, sizeof(Vector3)) == 0;
+}
+
+// この CPU で試せる一括判定のレベル（Scalar でも SSE2 の経路を通る）
+std::vector<SimdLevel> PacketLevels() {
+  std::vector<SimdLevel> levels = {SimdLevel::SSE2};
+  if (DetectSimdLevel() >= SimdLevel::AVX2) {
+    levels.push_back(SimdLevel::AVX2);
+  }
+  return levels;
+}
+
+RayQuery RandomQuery(std::mt19937 &rng, const Vector3 &target, int kind) {
+  const Vector3 origin = mathrandom::UniformVector(rng, -8.0f, 8.0f);
+  const Vector3 aim = Add(target, mathrandom::UniformVector(rng, -0.5f, 0.5f));
+  const Vector3 diff = Subtract(aim, origin);
+  switch (kind) {
+  case 0:
+    return MakeRayQuery(Ray{origin, diff});
+  case 1:
+    return MakeRayQuery(Segment{origin, diff});
+  default:
+    return MakeRayQuery(Line{origin, diff});
+  }
+}
+
+// 1〜37 個の形状を 200 組作り、一括判定が線形探索と番号・交点まで一致するか
+// 数える。1/4 の確率で前の形状を複製して等距離の交差も混ぜる
+template <class Shape, class SoA> size_t CountPacketMismatches(uint32_t seed) {
+  std::mt19937 rng(seed);
+  const std::vector<SimdLevel> levels = PacketLevels();
+  const SimdLevel saved = GetSimdLevel();
+  size_t mismatches = 0;
+  for (int packet = 0; packet < 200; ++packet) {
+    const size_t count = 1 + packet % 37;
+    std::vector<Shape> shapes;
+    SoA soa;
+    for (size_t i = 0; i < count; ++i) {
+      if (i > 0 && rng() % 4 == 0) {
+        shapes.push_back(shapes[rng() % i]);
+      } else {
+        shapes.push_back(RandomShape(rng, static_cast<Shape *>(nullptr)));
+      }
+      Push(soa, shapes.back());
+    }
+    for (int ray = 0; ray < 12; ++ray) {
+      const RayQuery q = RandomQuery(rng, Center(shapes[rng() % count]), ray % 3);
+      RayHit expectedHit;
+      const int expected = LinearClosest(q, shapes, expectedHit);
+      for (SimdLevel level : levels) {
+        SetSimdLevel(level);
+        RayHit hit;
+        const int index = RaycastClosest(q, soa, &hit);
+        if (index != expected || (index >= 0 && !SameHit(hit, expectedHit))) {
+          ++mismatches;
+        }
+        // outHit なしでも番号は同じ
+        if (RaycastClosest(q, soa) != expected) {
+          ++mismatches;
+        }
+      }
+    }
+  }
+  SetSimdLevel(saved);
+  return mismatches;
+}
+
+} // namespace
+
+// 球：端数を含むどの個数でも一括判定は線形探索と一致する
+CG2_TEST(RayQuerySpheresMatchLinear) {
+  CHECK_EQ((CountPacketMismatches<SphereData, SphereBoundsSoA>(81)), size_t(0));
+}
+
+// AABB：同上
+CG2_TEST(RayQueryAABBsMatchLinear) {
+  CHECK_EQ((CountPacketMismatches<AABB, AABBBoundsSoA>(82)), size_t(0));
+}
+
+// 三角形：同上
+CG2_TEST(RayQueryTrianglesMatchLinear) {
+  CHECK_EQ((CountPacketMismatches<Triangle, TriangleSoA>(83)), size_t(0));
+}
+
+// 等距離の 2 個はブロックの内外・端数のどこにあっても小さい番号が勝つ
+CG2_TEST(RayQueryTiesPickLowerIndex) {
+  const RayQuery q = MakeRayQuery(Ray{{0, 0, -10}, {0, 0, 1}});
+  SphereData hitSphere;
+  hitSphere.center = {0, 0, 0};
+  hitSphere.radius = 1.0f;
+  SphereData missSphere;
+  missSphere.center = {5, 5, 0};
+  missSphere.radius = 1.0f;
+  const Triangle hitTriangle = {{-1, -1, 0}, {1, -1, 0}, {0, 1, 0}};
+  const Triangle missTriangle = {{4, 4, 0}, {6, 4, 0}, {5, 6, 0}};
+
+  const SimdLevel saved = GetSimdLevel();
+  size_t mismatches = 0;
+  for (SimdLevel level : PacketLevels()) {
+    SetSimdLevel(level);
+    for (size_t count = 2; count <= 17; ++count) {
+      for (size_t first = 0; first < count; ++first) {
+        for (size_t second = first + 1; second < count; ++second) {
+          SphereBoundsSoA spheres;
+          AABBBoundsSoA aabbs;
+          TriangleSoA triangles;
+          for (size_t i = 0; i < count; ++i) {
+            const bool hit = i == first || i == second;
+            spheres.Push(hit ? hitSphere : missSphere);
+            AABB aabb;
+            aabb.min = hit ? Vector3{-1, -1, -1} : Vector3{4, 4, -1};
+            aabb.max = hit ? Vector3{1, 1, 1} : Vector3{6, 6, 1};
+            aabbs.Push(aabb);
+            const Triangle &t = hit ? hitTriangle : missTriangle;
+            triangles.Push(t.v0, t.v1, t.v2);
+          }
+          mismatches += RaycastClosest(q, spheres) != int(first);
+          mismatches += RaycastClosest(q, aabbs) != int(first);
+          mismatches += RaycastClosest(q, triangles) != int(first);
+        }
+      }
+    }
+    // 空の列は -1
+    CHECK_EQ(RaycastClosest(q, SphereBoundsSoA{}), -1);
+    CHECK_EQ(RaycastClosest(q, AABBBoundsSoA{}), -1);
+    CHECK_EQ(RaycastClosest(q, TriangleSoA{}), -1);
+  }
+  SetSimdLevel(saved);
+  CHECK_EQ(mismatches, size_t(0));
+}
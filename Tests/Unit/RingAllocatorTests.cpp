@@ -0,0 +1,168 @@
+#include "Framework/TestFramework.h"
+#include "UploadRing/RingAllocator.h"
+#include <deque>
+#include <random>
+#include <vector>
+
+// フェンス値はただの数値なので、GPU の代わりに完了値を手で進めて確かめる
+
+// 順に切り出され、境界に揃い、フレームの統計が閉じたときに出る
+CG2_TEST(RingAllocatorAllocatesInOrder) {
+  RingAllocator ring;
+  ring.Init(1024);
+  ring.BeginFrame(0);
+  CHECK_EQ(ring.Allocate(10, 1), uint64_t(0));
+  CHECK_EQ(ring.Allocate(16, 256), uint64_t(256));
+  CHECK_EQ(ring.Allocate(0, 4), uint64_t(272)); // 0 バイトも 1 バイト扱い
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(273));
+  ring.EndFrame(1);
+
+  const RingAllocator::Stats &stats = ring.GetStats();
+  CHECK_EQ(stats.frameAllocations, 3u);
+  CHECK_EQ(stats.frameBytes, uint64_t(273));
+  CHECK_EQ(stats.framesInFlight, 1u);
+  CHECK_EQ(stats.frameOverflows, 0u);
+
+  // 何も切り出さないフレームは回収待ちに積まない
+  ring.BeginFrame(0);
+  ring.EndFrame(2);
+  CHECK_EQ(ring.GetStats().framesInFlight, 1u);
+  CHECK_EQ(ring.GetStats().frameBytes, uint64_t(0));
+}
+
+// 完了したフレームだけが戻り、全部戻れば先頭から使い直す
+CG2_TEST(RingAllocatorReclaimsCompletedFrames) {
+  RingAllocator ring;
+  ring.Init(1000);
+  for (uint64_t fence = 1; fence <= 3; ++fence) {
+    ring.BeginFrame(0);
+    CHECK(ring.Allocate(100, 1) != RingAllocator::kInvalidOffset);
+    ring.EndFrame(fence);
+  }
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(300));
+  CHECK_EQ(ring.GetStats().framesInFlight, 3u);
+
+  ring.BeginFrame(1);
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(200));
+  CHECK_EQ(ring.GetStats().framesInFlight, 2u);
+  ring.BeginFrame(1); // 同じ値なら何も起きない
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(200));
+
+  ring.BeginFrame(3);
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(0));
+  CHECK_EQ(ring.GetStats().framesInFlight, 0u);
+  CHECK_EQ(ring.Allocate(50, 1), uint64_t(0));
+  CHECK_EQ(ring.GetStats().peakUsedBytes, uint64_t(300));
+}
+
+// 末尾に入らなければ回収済みの先頭へ回り、末尾の余りはそのフレームの分になる
+CG2_TEST(RingAllocatorWrapsAround) {
+  RingAllocator ring;
+  ring.Init(1024);
+  ring.BeginFrame(0);
+  CHECK_EQ(ring.Allocate(600, 1), uint64_t(0));
+  ring.EndFrame(1);
+  ring.BeginFrame(0);
+  CHECK_EQ(ring.Allocate(300, 1), uint64_t(600));
+  ring.EndFrame(2);
+
+  // フレーム 1 の [0, 600) だけ戻る。[600, 900) はまだ使用中
+  ring.BeginFrame(1);
+  CHECK_EQ(ring.Allocate(200, 1), uint64_t(0));
+  CHECK_EQ(ring.Allocate(300, 1), uint64_t(200));
+  // [500, 600) しか残っていない
+  CHECK_EQ(ring.Allocate(200, 1), RingAllocator::kInvalidOffset);
+  CHECK_EQ(ring.Allocate(100, 1), uint64_t(500));
+  ring.EndFrame(3);
+  // 124（末尾の余り）+ 600
+  CHECK_EQ(ring.GetStats().frameBytes, uint64_t(724));
+  CHECK_EQ(ring.GetStats().frameOverflows, 1u);
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(1024));
+
+  // 満杯：何も入らない
+  ring.BeginFrame(1);
+  CHECK_EQ(ring.Allocate(1, 1), RingAllocator::kInvalidOffset);
+  // フレーム 2 が戻れば [600, 1024) の余りも含めて空く
+  ring.BeginFrame(2);
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(724));
+  CHECK_EQ(ring.Allocate(400, 1), RingAllocator::kInvalidOffset);
+  ring.BeginFrame(3);
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(0));
+  CHECK_EQ(ring.Allocate(1024, 1), uint64_t(0));
+}
+
+// 入らない切り出しは溢れとして数え、容量より大きいものは回収しても入らない
+CG2_TEST(RingAllocatorCountsOverflows) {
+  RingAllocator ring;
+  ring.Init(256);
+  ring.BeginFrame(0);
+  CHECK_EQ(ring.Allocate(257, 1), RingAllocator::kInvalidOffset);
+  CHECK_EQ(ring.Allocate(200, 1), uint64_t(0));
+  CHECK_EQ(ring.Allocate(64, 64), RingAllocator::kInvalidOffset);
+  CHECK_EQ(ring.Allocate(56, 1), uint64_t(200));
+  ring.EndFrame(1);
+  CHECK_EQ(ring.GetStats().frameOverflows, 2u);
+  CHECK_EQ(ring.GetStats().totalOverflows, uint64_t(2));
+
+  ring.BeginFrame(0);
+  CHECK_EQ(ring.Allocate(1, 1), RingAllocator::kInvalidOffset);
+  ring.EndFrame(2);
+  CHECK_EQ(ring.GetStats().frameOverflows, 1u);
+  CHECK_EQ(ring.GetStats().totalOverflows, uint64_t(3));
+}
+
+// GPU が数フレーム遅れて進む想定で切り出し続け、使用中の範囲と
+// 重ならないこと・境界・使用量を毎回確かめる
+CG2_TEST(RingAllocatorNeverOverlapsInFlight) {
+  struct Range {
+    uint64_t fence;
+    uint64_t begin;
+    uint64_t end;
+  };
+  constexpr uint64_t kCapacity = 4096;
+  RingAllocator ring;
+  ring.Init(kCapacity);
+  std::mt19937 rng(5);
+  std::deque<Range> live;
+  uint64_t completed = 0;
+  uint32_t overflows = 0;
+
+  for (uint64_t fence = 1; fence <= 2000; ++fence) {
+    // GPU は 0〜3 フレーム遅れ
+    const uint64_t lag = rng() % 4;
+    if (fence > lag + 1 && fence - lag - 1 > completed) {
+      completed = fence - lag - 1;
+    }
+    ring.BeginFrame(completed);
+    while (!live.empty() && live.front().fence <= completed) {
+      live.pop_front();
+    }
+
+    const uint32_t count = rng() % 8;
+    for (uint32_t i = 0; i < count; ++i) {
+      const uint64_t size = 1 + rng() % 700;
+      const uint64_t alignment = uint64_t(1) << (rng() % 9);
+      const uint64_t offset = ring.Allocate(size, alignment);
+      if (offset == RingAllocator::kInvalidOffset) {
+        ++overflows;
+        continue;
+      }
+      CHECK_EQ(offset % alignment, uint64_t(0));
+      CHECK(offset + size <= kCapacity);
+      for (const Range &range : live) {
+        CHECK(offset + size <= range.begin || offset >= range.end);
+      }
+      live.push_back({fence, offset, offset + size});
+      CHECK(ring.GetStats().usedBytes <= kCapacity);
+    }
+    ring.EndFrame(fence);
+  }
+  CHECK_EQ(ring.GetStats().totalOverflows, uint64_t(overflows));
+  // 容量に対して多めに切り出しているので、溢れも回り込みも起きている
+  CHECK(overflows > 0);
+  CHECK_EQ(ring.GetStats().peakUsedBytes, kCapacity);
+
+  ring.BeginFrame(~0ull);
+  CHECK_EQ(ring.GetStats().usedBytes, uint64_t(0));
+  CHECK_EQ(ring.GetStats().framesInFlight, 0u);
+}
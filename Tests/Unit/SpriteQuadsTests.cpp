@@ -0,0 +1,85 @@
+#include "Framework/TestFramework.h"
+#include "MathRandom.h"
+#include "SpriteBatch/SpriteQuads.h"
+#include <cstring>
+
+namespace {
+
+SpriteDraw RandomSprite(std::mt19937 &rng) {
+  SpriteDraw sprite;
+  sprite.position = {mathrandom::Uniform(rng, 0.0f, 1280.0f),
+                     mathrandom::Uniform(rng, 0.0f, 720.0f)};
+  sprite.size = {mathrandom::Uniform(rng, 4.0f, 200.0f),
+                 mathrandom::Uniform(rng, 4.0f, 200.0f)};
+  sprite.rotation = mathrandom::Uniform(rng, -6.0f, 6.0f);
+  sprite.anchor = {mathrandom::Uniform(rng, 0.0f, 1.0f),
+                   mathrandom::Uniform(rng, 0.0f, 1.0f)};
+  sprite.uvMin = {mathrandom::Uniform(rng, 0.0f, 0.5f),
+                  mathrandom::Uniform(rng, 0.0f, 0.5f)};
+  sprite.uvMax = {mathrandom::Uniform(rng, 0.5f, 1.0f),
+                  mathrandom::Uniform(rng, 0.5f, 1.0f)};
+  sprite.color = {mathrandom::Uniform(rng, 0.0f, 1.0f),
+                  mathrandom::Uniform(rng, 0.0f, 1.0f),
+                  mathrandom::Uniform(rng, 0.0f, 1.0f), 1.0f};
+  return sprite;
+}
+
+} // namespace
+
+// 端数を含むどの枚数でもスカラー版（std::sin / std::cos）と誤差内で一致する
+CG2_TEST(SpriteQuadsMatchScalar) {
+  std::mt19937 rng(31);
+  for (size_t count = 1; count <= 11; ++count) {
+    SpriteQuadsSoA quads;
+    for (size_t n = 0; n < count; ++n) {
+      quads.Push(RandomSprite(rng));
+    }
+    std::vector<SpriteVertex> fast(count * kSpriteVerticesPerQuad);
+    std::vector<SpriteVertex> scalar(fast.size());
+    ExpandSpriteQuads(quads, 0, count, fast.data());
+    ExpandSpriteQuadsScalar(quads, 0, count, scalar.data());
+    for (size_t v = 0; v < fast.size(); ++v) {
+      // 位置は px なので、大きさ 200 程度の回転で 1e-3 px まで
+      CHECK_NEAR(fast[v].position.x, scalar[v].position.x, 1e-3f);
+      CHECK_NEAR(fast[v].position.y, scalar[v].position.y, 1e-3f);
+      CHECK_EQ(fast[v].texcoord.x, scalar[v].texcoord.x);
+      CHECK_EQ(fast[v].texcoord.y, scalar[v].texcoord.y);
+      CHECK_EQ(fast[v].color, scalar[v].color);
+    }
+  }
+}
+
+// 同じスプライトは並びのどこにあっても（端数でも）同じビット列になる
+CG2_TEST(SpriteQuadsTailMatchesBlock) {
+  std::mt19937 rng(32);
+  for (size_t count = 5; count <= 7; ++count) {
+    const SpriteDraw sprite = RandomSprite(rng);
+    SpriteQuadsSoA quads;
+    for (size_t n = 0; n < count; ++n) {
+      quads.Push(sprite);
+    }
+    std::vector<SpriteVertex> out(count * kSpriteVerticesPerQuad);
+    ExpandSpriteQuads(quads, 0, count, out.data());
+    for (size_t n = 4; n < count; ++n) {
+      CHECK(std::memcmp(&out[n * kSpriteVerticesPerQuad], &out[0],
+                        kSpriteVerticesPerQuad * sizeof(SpriteVertex)) == 0);
+    }
+  }
+}
+
+// begin がずれていても out は begin からの相対で書かれる
+CG2_TEST(SpriteQuadsSubRange) {
+  std::mt19937 rng(33);
+  SpriteQuadsSoA quads;
+  for (size_t n = 0; n < 10; ++n) {
+    quads.Push(RandomSprite(rng));
+  }
+  std::vector<SpriteVertex> whole(10 * kSpriteVerticesPerQuad);
+  ExpandSpriteQuads(quads, 0, 10, whole.data());
+
+  // 3..9 は 4 枚 + 端数 2 枚。3 と 7 は whole では別の 4 枚組に入る
+  std::vector<SpriteVertex> part(6 * kSpriteVerticesPerQuad);
+  ExpandSpriteQuads(quads, 3, 9, part.data());
+  CHECK(std::memcmp(part.data(), &whole[3 * kSpriteVerticesPerQuad],
+                    part.size() * sizeof(SpriteVertex)) == 0);
+}
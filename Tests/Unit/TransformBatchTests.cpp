@@ -0,0 +1,170 @@
+#include "Framework/TestFramework.h"
+#include "Math/Math.h"
+#include "Math/SimdSinCos.h"
+#include "Math/TransformBatch.h"
+#include "MathRandom.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+
+Transform RandomTransform(std::mt19937 &rng, bool quaternion) {
+  Transform t;
+  t.scale = mathrandom::UniformVector(rng, 0.25f, 4.0f);
+  t.rotation = mathrandom::UniformVector(rng, -6.0f, 6.0f);
+  t.translation = mathrandom::UniformVector(rng, -50.0f, 50.0f);
+  t.useQuaternion = quaternion;
+  if (quaternion) {
+    t.quaternion = mathrandom::UnitQuaternion(rng);
+  }
+  return t;
+}
+
+// MakeAffineMatrix と Multiply で 1 個ずつ作った結果と比べる
+void CheckAgainstReference(const Transform *transforms, size_t count,
+                           const Matrix4x4 &viewProj,
+                           const TransformationMatrix *out, float tol) {
+  for (size_t n = 0; n < count; ++n) {
+    const Matrix4x4 world = MakeAffineMatrix(transforms[n]);
+    const Matrix4x4 wvp = MathScalar::Multiply(world, viewProj);
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        CHECK_NEAR(out[n].World.m[i][j], world.m[i][j],
+                   tol * std::fmax(1.0f, std::fabs(world.m[i][j])));
+        CHECK_NEAR(out[n].WVP.m[i][j], wvp.m[i][j],
+                   tol * std::fmax(1.0f, std::fabs(wvp.m[i][j])));
+      }
+    }
+  }
+}
+
+Matrix4x4 TestViewProj() {
+  return MathScalar::Multiply(
+      MakeLookAt({3.0f, 4.0f, -10.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}),
+      MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 100.0f));
+}
+
+} // namespace
+
+// 端数を含むどの個数でも 1 個ずつの計算と一致する（オイラー角・四元数・混在）
+CG2_TEST(TransformBatchMatchesReference) {
+  std::mt19937 rng(11);
+  const Matrix4x4 viewProj = TestViewProj();
+  for (size_t count = 1; count <= 11; ++count) {
+    for (int mode = 0; mode < 3; ++mode) {
+      std::vector<Transform> transforms;
+      for (size_t n = 0; n < count; ++n) {
+        const bool quaternion = mode == 1 || (mode == 2 && (n % 3 == 1));
+        transforms.push_back(RandomTransform(rng, quaternion));
+      }
+      std::vector<TransformationMatrix> out(count);
+      ComputeTransformationMatrices(transforms.data(), count, viewProj,
+                                    out.data());
+      CheckAgainstReference(transforms.data(), count, viewProj, out.data(),
+                            2e-5f);
+    }
+  }
+}
+
+// 同じ Transform は並びのどこにあっても（端数でも）同じビット列になる
+CG2_TEST(TransformBatchTailMatchesBlock) {
+  std::mt19937 rng(12);
+  const Matrix4x4 viewProj = TestViewProj();
+  for (int quaternion = 0; quaternion < 2; ++quaternion) {
+    const Transform t = RandomTransform(rng, quaternion != 0);
+    std::vector<Transform> transforms(7, t);
+    std::vector<TransformationMatrix> out(transforms.size());
+    ComputeTransformationMatrices(transforms.data(), transforms.size(),
+                                  viewProj, out.data());
+    for (size_t n = 4; n < out.size(); ++n) {
+      CHECK(std::memcmp(&out[n], &out[0], sizeof(TransformationMatrix)) == 0);
+    }
+  }
+}
+
+// 四元数は Get / Set で往復しても変わらない（オイラー角を経由しない）
+CG2_TEST(TransformBatchKeepsQuaternion) {
+  std::mt19937 rng(13);
+  TransformBatchSoA soa;
+  const Transform t = RandomTransform(rng, true);
+  soa.Push(t);
+  const Transform back = soa.Get(0);
+  CHECK(back.useQuaternion);
+  CHECK_EQ(back.quaternion.x, t.quaternion.x);
+  CHECK_EQ(back.quaternion.y, t.quaternion.y);
+  CHECK_EQ(back.quaternion.z, t.quaternion.z);
+  CHECK_EQ(back.quaternion.w, t.quaternion.w);
+}
+
+// 並列に分けても結果は同じ
+CG2_TEST(TransformBatchWorkersMatchSerial) {
+  std::mt19937 rng(14);
+  const Matrix4x4 viewProj = TestViewProj();
+  std::vector<Transform> transforms;
+  for (int n = 0; n < 4099; ++n) {
+    transforms.push_back(RandomTransform(rng, (n & 1) != 0));
+  }
+  std::vector<TransformationMatrix> serial(transforms.size()),
+      parallel(transforms.size());
+  ComputeTransformationMatrices(transforms.data(), transforms.size(), viewProj,
+                                serial.data(), 1);
+  ComputeTransformationMatrices(transforms.data(), transforms.size(), viewProj,
+                                parallel.data(), 4);
+  CHECK(std::memcmp(serial.data(), parallel.data(),
+                    serial.size() * sizeof(TransformationMatrix)) == 0);
+}
+
+#if CG2_SIMD_SSE2
+
+namespace {
+
+void SinCos4Scalar(const float in[4], float outSin[4], float outCos[4]) {
+  __m128 s, c;
+  SimdMath::SinCos4(_mm_loadu_ps(in), s, c);
+  _mm_storeu_ps(outSin, s);
+  _mm_storeu_ps(outCos, c);
+}
+
+} // namespace
+
+CG2_TEST(SinCos4Accuracy) {
+  std::mt19937 rng(15);
+  for (int n = 0; n < 10000; ++n) {
+    float x[4], s[4], c[4];
+    for (float &v : x) {
+      v = mathrandom::Uniform(rng, -1000.0f, 1000.0f);
+    }
+    SinCos4Scalar(x, s, c);
+    for (int k = 0; k < 4; ++k) {
+      CHECK_NEAR(s[k], std::sin(double(x[k])), 2e-6);
+      CHECK_NEAR(c[k], std::cos(double(x[k])), 2e-6);
+    }
+  }
+}
+
+// 整数変換が溢れる大きさでも [-1,1] に収まり、NaN / inf は NaN
+CG2_TEST(SinCos4LargeArguments) {
+  const float inf = std::numeric_limits<float>::infinity();
+  const float huge[] = {1.0e10f, -3.0e15f, 1.0e30f, -3.4e38f,
+                        2.0e9f,  -1.4e10f, 8.4e6f,  -6.0e7f};
+  for (int base = 0; base < 8; base += 4) {
+    float s[4], c[4];
+    SinCos4Scalar(&huge[base], s, c);
+    for (int k = 0; k < 4; ++k) {
+      CHECK(std::fabs(s[k]) <= 1.0f + 1e-6f);
+      CHECK(std::fabs(c[k]) <= 1.0f + 1e-6f);
+      CHECK_NEAR(s[k] * s[k] + c[k] * c[k], 1.0f, 1e-5f);
+    }
+  }
+  const float special[4] = {inf, -inf, std::numeric_limits<float>::quiet_NaN(),
+                            0.0f};
+  float s[4], c[4];
+  SinCos4Scalar(special, s, c);
+  for (int k = 0; k < 3; ++k) {
+    CHECK(std::isnan(s[k]) && std::isnan(c[k]));
+  }
+  CHECK_EQ(s[3], 0.0f);
+  CHECK_EQ(c[3], 1.0f);
+}
+
+#endif // CG2_SIMD_SSE2
@@ -0,0 +1,191 @@
+#include "Framework/TestFramework.h"
+#include "Math/TriangleBvh.h"
+#include "MathRandom.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// 散らばった小さめの三角形 count 個（頂点は三角形ごとに別、indices は
+// 三角形の順を入れ替えたもの）
+void MakeTriangleCloud(std::mt19937 &rng, size_t count,
+                       std::vector<Vector3> &vertices,
+                       std::vector<uint32_t> &indices) {
+  vertices.clear();
+  for (size_t t = 0; t < count; ++t) {
+    const Vector3 center = mathrandom::UniformVector(rng, -10.0f, 10.0f);
+    for (int k = 0; k < 3; ++k) {
+      vertices.push_back(
+          Add(center, mathrandom::UniformVector(rng, -0.8f, 0.8f)));
+    }
+  }
+  std::vector<uint32_t> order(count);
+  std::iota(order.begin(), order.end(), 0u);
+  std::shuffle(order.begin(), order.end(), rng);
+  indices.clear();
+  for (uint32_t t : order) {
+    for (uint32_t k = 0; k < 3; ++k) {
+      indices.push_back(t * 3 + k);
+    }
+  }
+}
+
+// 全三角形を単体判定で回す（等距離なら小さい番号）
+int LinearClosest(const RayQuery &q, const std::vector<Vector3> &vertices,
+                  const std::vector<uint32_t> &indices, RayHit &outHit) {
+  int best = -1;
+  for (size_t t = 0; t * 3 < indices.size(); ++t) {
+    RayHit hit;
+    if (Raycast(q, vertices[indices[t * 3]], vertices[indices[t * 3 + 1]],
+                vertices[indices[t * 3 + 2]], &hit) &&
+        (best < 0 || hit.t < outHit.t)) {
+      best = int(t);
+      outHit = hit;
+    }
+  }
+  return best;
+}
+
+// 半分は三角形の重心付近を狙い、残りは適当な向き。Ray / Segment / Line を混ぜる
+std::vector<RayQuery> MakeQueries(std::mt19937 &rng, size_t count,
+                                  const std::vector<Vector3> &vertices) {
+  std::vector<RayQuery> queries;
+  for (size_t i = 0; i < count; ++i) {
+    const Vector3 origin = mathrandom::UniformVector(rng, -14.0f, 14.0f);
+    Vector3 diff;
+    if (i % 2 == 0) {
+      const size_t v = (rng() % (vertices.size() / 3)) * 3;
+      const Vector3 centroid = Multiply(
+          Add(Add(vertices[v], vertices[v + 1]), vertices[v + 2]), 1.0f / 3.0f);
+      diff = Subtract(centroid, origin);
+    } else {
+      diff = mathrandom::UniformVector(rng, -1.0f, 1.0f);
+    }
+    switch (i % 3) {
+    case 0:
+      queries.push_back(MakeRayQuery(Ray{origin, diff}));
+      break;
+    case 1:
+      queries.push_back(MakeRayQuery(Segment{origin, diff}));
+      break;
+    default:
+      queries.push_back(MakeRayQuery(Line{origin, diff}));
+      break;
+    }
+  }
+  return queries;
+}
+
+// BVH の結果が線形探索と一致しない数。等距離で別の三角形を返した場合は、
+// その三角形も同じ t で当たっていれば一致とみなす
+size_t CountMismatches(const TriangleBvh &bvh,
+                       const std::vector<RayQuery> &queries,
+                       const std::vector<Vector3> &vertices,
+                       const std::vector<uint32_t> &indices, size_t &hits) {
+  size_t mismatches = 0;
+  hits = 0;
+  for (const RayQuery &q : queries) {
+    RayHit expectedHit;
+    const int expected = LinearClosest(q, vertices, indices, expectedHit);
+    RayHit hit;
+    uint32_t triangle = ~0u;
+    const bool found = bvh.RaycastClosest(q, &hit, &triangle);
+    if (found != (expected >= 0) || bvh.RaycastAny(q) != found ||
+        bvh.RaycastClosest(q) != found) {
+      ++mismatches;
+      continue;
+    }
+    if (!found) {
+      continue;
+    }
+    ++hits;
+    if (hit.t != expectedHit.t || triangle * 3 >= indices.size()) {
+      ++mismatches;
+    } else if (triangle != uint32_t(expected)) {
+      RayHit tie;
+      if (!Raycast(q, vertices[indices[triangle * 3]],
+                   vertices[indices[triangle * 3 + 1]],
+                   vertices[indices[triangle * 3 + 2]], &tie) ||
+          tie.t != hit.t) {
+        ++mismatches;
+      }
+    } else if (std::memcmp(&hit.normal, &expectedHit.normal,
+                           sizeof(Vector3)) != 0 ||
+               std::memcmp(&hit.point, &expectedHit.point,
+                           sizeof(Vector3)) != 0) {
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+} // namespace
+
+// 三角形 5000 個・レイ 2000 本で、最近交差と遮蔽判定が線形探索と一致する
+// （1 スレッド構築・4 スレッド構築・インデックスなしの三角形リスト）
+CG2_TEST(TriangleBvhMatchesLinear) {
+  std::mt19937 rng(91);
+  std::vector<Vector3> vertices;
+  std::vector<uint32_t> indices;
+  MakeTriangleCloud(rng, 5000, vertices, indices);
+  const std::vector<RayQuery> queries = MakeQueries(rng, 2000, vertices);
+
+  TriangleBvh serial;
+  serial.Build(vertices.data(), indices.data(), 5000, 1);
+  CHECK_EQ(serial.TriangleCount(), size_t(5000));
+  size_t hits = 0;
+  CHECK_EQ(CountMismatches(serial, queries, vertices, indices, hits),
+           size_t(0));
+  // 半分近くは当たる入力になっている
+  CHECK(hits > 800);
+
+  TriangleBvh parallel;
+  parallel.Build(vertices.data(), indices.data(), 5000, 4);
+  CHECK_EQ(parallel.TriangleCount(), size_t(5000));
+  CHECK_EQ(parallel.NodeCount(), serial.NodeCount());
+  CHECK_EQ(CountMismatches(parallel, queries, vertices, indices, hits),
+           size_t(0));
+
+  // indices == nullptr：頂点を 3 個ずつ読む
+  std::vector<Vector3> soup;
+  for (uint32_t index : indices) {
+    soup.push_back(vertices[index]);
+  }
+  std::vector<uint32_t> identity(indices.size());
+  std::iota(identity.begin(), identity.end(), 0u);
+  TriangleBvh list;
+  list.Build(soup.data(), nullptr, 5000, 4);
+  CHECK_EQ(CountMismatches(list, queries, soup, identity, hits), size_t(0));
+
+  // 全体の AABB はすべての頂点を囲む
+  const AABB bounds = serial.Bounds();
+  size_t outside = 0;
+  for (const Vector3 &v : vertices) {
+    outside += v.x < bounds.min.x || v.y < bounds.min.y ||
+               v.z < bounds.min.z || v.x > bounds.max.x ||
+               v.y > bounds.max.y || v.z > bounds.max.z;
+  }
+  CHECK_EQ(outside, size_t(0));
+}
+
+// 空の BVH は何にも当たらない
+CG2_TEST(TriangleBvhEmpty) {
+  TriangleBvh bvh;
+  const RayQuery q = MakeRayQuery(Ray{{0, 0, -5}, {0, 0, 1}});
+  CHECK(bvh.Empty());
+  CHECK(!bvh.RaycastClosest(q));
+  CHECK(!bvh.RaycastAny(q));
+
+  const Vector3 triangle[3] = {{-1, -1, 0}, {1, -1, 0}, {0, 1, 0}};
+  bvh.Build(triangle, nullptr, 1);
+  RayHit hit;
+  uint32_t index = ~0u;
+  CHECK(bvh.RaycastClosest(q, &hit, &index));
+  CHECK_EQ(index, 0u);
+  CHECK_NEAR(hit.t, 5.0f, 1e-6f);
+  bvh.Clear();
+  CHECK(bvh.Empty());
+  CHECK(!bvh.RaycastAny(q));
+}
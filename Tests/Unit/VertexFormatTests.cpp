@@ -0,0 +1,159 @@
+#include "Framework/TestFramework.h"
+#include "Math/Math.h"
+#include "MathRandom.h"
+#include "VertexFormat/VertexFormat.h"
+#include <limits>
+
+// half → float → half は NaN 以外の全ビット列で元に戻る
+CG2_TEST(HalfRoundTripExhaustive) {
+  for (uint32_t bits = 0; bits <= 0xFFFFu; ++bits) {
+    const uint16_t half = uint16_t(bits);
+    const bool nan = (half & 0x7C00u) == 0x7C00u && (half & 0x03FFu) != 0;
+    const float value = HalfToFloat(half);
+    if (nan) {
+      CHECK(std::isnan(value));
+      CHECK(std::isnan(HalfToFloat(FloatToHalf(value))));
+      continue;
+    }
+    CHECK_EQ(FloatToHalf(value), half);
+  }
+}
+
+// float → half の誤差：正規化数は相対 2^-11、非正規化数は絶対 2^-25 以内
+CG2_TEST(HalfEncodeErrorBound) {
+  std::mt19937 rng(31);
+  for (int n = 0; n < 200000; ++n) {
+    const float exponent = mathrandom::Uniform(rng, -26.0f, 15.9f);
+    const float sign = (n & 1) ? -1.0f : 1.0f;
+    const float value = sign * std::exp2(exponent);
+    const float decoded = HalfToFloat(FloatToHalf(value));
+    const float err = std::fabs(decoded - value);
+    if (std::fabs(value) >= 6.103515625e-5f) {
+      CHECK(err <= std::fabs(value) * 0x1p-11f);
+    } else {
+      CHECK(err <= 0x1p-25f);
+    }
+  }
+  // 範囲外・特殊値
+  CHECK_EQ(FloatToHalf(65504.0f), uint16_t(0x7BFF));
+  CHECK_EQ(FloatToHalf(65520.0f), uint16_t(0x7C00));
+  CHECK_EQ(FloatToHalf(1.0e6f), uint16_t(0x7C00));
+  CHECK_EQ(FloatToHalf(-std::numeric_limits<float>::infinity()),
+           uint16_t(0xFC00));
+  CHECK_EQ(FloatToHalf(-0.0f), uint16_t(0x8000));
+  CHECK(std::isnan(HalfToFloat(
+      FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+// unorm16 / snorm16 は量子化幅の半分以内、範囲外はクランプ
+CG2_TEST(NormEncodeErrorBound) {
+  std::mt19937 rng(32);
+  for (int n = 0; n < 100000; ++n) {
+    const float u = mathrandom::Uniform(rng, 0.0f, 1.0f);
+    CHECK(std::fabs(Unorm16ToFloat(FloatToUnorm16(u)) - u) <=
+          0.5f / 65535.0f + 1e-7f);
+    const float s = mathrandom::Uniform(rng, -1.0f, 1.0f);
+    CHECK(std::fabs(Snorm16ToFloat(FloatToSnorm16(s)) - s) <=
+          0.5f / 32767.0f + 1e-7f);
+  }
+  CHECK_EQ(FloatToUnorm16(1.5f), uint16_t(65535));
+  CHECK_EQ(FloatToUnorm16(-0.5f), uint16_t(0));
+  CHECK_EQ(FloatToSnorm16(2.0f), int16_t(32767));
+  CHECK_EQ(FloatToSnorm16(-2.0f), int16_t(-32767));
+  CHECK_EQ(Snorm16ToFloat(-32768), -1.0f);
+}
+
+// 八面体 snorm16：単位長で戻り、誤差は 1e-4（約 0.006 度）以内
+CG2_TEST(OctahedralRoundTripErrorBound) {
+  std::mt19937 rng(33);
+  float worst = 0.0f;
+  for (int n = 0; n < 200000; ++n) {
+    const Vector3 normal =
+        Normalize(mathrandom::UniformVector(rng, -1.0f, 1.0f));
+    int16_t encoded[2];
+    EncodeOctahedral(normal, encoded);
+    const Vector3 decoded = DecodeOctahedral(encoded);
+    CHECK_NEAR(Length(decoded), 1.0f, 1e-6f);
+    worst = std::fmax(worst, Length(Subtract(decoded, normal)));
+  }
+  CHECK(worst <= 1e-4f);
+
+  // 軸・下半球の折り返しの境目
+  const Vector3 axes[] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0},
+                          {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+  for (const Vector3 &axis : axes) {
+    int16_t encoded[2];
+    EncodeOctahedral(axis, encoded);
+    const Vector3 decoded = DecodeOctahedral(encoded);
+    CHECK_NEAR(decoded.x, axis.x, 1e-6f);
+    CHECK_NEAR(decoded.y, axis.y, 1e-6f);
+    CHECK_NEAR(decoded.z, axis.z, 1e-6f);
+  }
+}
+
+// 配列単位：Compact は位置が一致、Quantized は AABB の量子化幅の半分以内。
+// 復元行列を掛けた unorm 位置は Decode と同じ場所になる
+CG2_TEST(VertexArrayRoundTrip) {
+  std::mt19937 rng(34);
+  std::vector<VertexData> vertices(1000);
+  for (VertexData &v : vertices) {
+    const Vector3 p = mathrandom::UniformVector(rng, -20.0f, 35.0f);
+    v.position = {p.x, p.y * 0.1f, p.z, 1.0f};
+    v.texcoord = {mathrandom::Uniform(rng, 0.0f, 1.0f),
+                  mathrandom::Uniform(rng, 0.0f, 1.0f)};
+    v.normal = Normalize(mathrandom::UniformVector(rng, -1.0f, 1.0f));
+  }
+
+  for (VertexFormat format :
+       {VertexFormat::Standard, VertexFormat::Compact, VertexFormat::Quantized}) {
+    std::vector<uint8_t> encoded;
+    VertexQuantization quantization;
+    EncodeVertices(vertices.data(), vertices.size(), format, encoded,
+                   &quantization);
+    CHECK_EQ(encoded.size(), VertexStride(format) * vertices.size());
+    std::vector<VertexData> decoded;
+    DecodeVertices(encoded.data(), vertices.size(), format, quantization,
+                   decoded);
+    CHECK_EQ(decoded.size(), vertices.size());
+    if (decoded.size() != vertices.size())
+      continue;
+
+    const Matrix4x4 dequantize = MakeDequantizeMatrix(quantization);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      const VertexData &a = vertices[i];
+      const VertexData &b = decoded[i];
+      switch (format) {
+      case VertexFormat::Standard:
+      case VertexFormat::Compact:
+        CHECK_EQ(b.position.x, a.position.x);
+        CHECK_EQ(b.position.y, a.position.y);
+        CHECK_EQ(b.position.z, a.position.z);
+        break;
+      case VertexFormat::Quantized: {
+        CHECK_NEAR(b.position.x, a.position.x,
+                   quantization.scale.x * (0.5f / 65535.0f) + 1e-5f);
+        CHECK_NEAR(b.position.y, a.position.y,
+                   quantization.scale.y * (0.5f / 65535.0f) + 1e-5f);
+        CHECK_NEAR(b.position.z, a.position.z,
+                   quantization.scale.z * (0.5f / 65535.0f) + 1e-5f);
+        // VS と同じく unorm の値に復元行列を掛ける
+        const VertexQuantized *q =
+            reinterpret_cast<const VertexQuantized *>(encoded.data()) + i;
+        const Vector3 unorm = {Unorm16ToFloat(q->position[0]),
+                               Unorm16ToFloat(q->position[1]),
+                               Unorm16ToFloat(q->position[2])};
+        const Vector3 restored = Vector3Transform(unorm, dequantize);
+        CHECK_NEAR(restored.x, b.position.x, 1e-4f);
+        CHECK_NEAR(restored.y, b.position.y, 1e-4f);
+        CHECK_NEAR(restored.z, b.position.z, 1e-4f);
+        break;
+      }
+      }
+      if (format != VertexFormat::Standard) {
+        CHECK_NEAR(b.texcoord.x, a.texcoord.x, 0x1p-11f);
+        CHECK_NEAR(b.texcoord.y, a.texcoord.y, 0x1p-11f);
+        CHECK(Length(Subtract(b.normal, a.normal)) <= 1e-4f);
+      }
+    }
+  }
+}
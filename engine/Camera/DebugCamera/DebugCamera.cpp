@@ -1,8 +1,8 @@
 // DebugCamera.cpp
 #include "DebugCamera.h"
-#include "Math/Math.h" // MakePerspectiveFovMatrix, MakeAffineMatrix, Inverse
+#include "Math/Math.h" // MakePerspectiveFovMatrix, MakeAffineMatrix, InverseRigid
 #include "Log/Log.h"       // Log::Debug
-#include <cmath>           // sinf, cosf
+#include <cmath>           // std::sin, std::cos
 #include <dinput.h>        // DIK_W など
 
 void DebugCamera::Initialize(Input *input, float fovY, float aspect,
@@ -17,9 +17,9 @@ void DebugCamera::Update() {
   // ── カメラの向きから Forward／Right を計算 ──
   float yaw = rotation_.y;   // Yaw（Y軸回転）
   float pitch = rotation_.x; // Pitch（X軸回転）
-  Vector3 forward = {std::sinf(yaw) * std::cosf(pitch), std::sinf(pitch),
-                     std::cosf(yaw) * std::cosf(pitch)};
-  Vector3 right = {std::cosf(yaw), 0.0f, -std::sinf(yaw)};
+  Vector3 forward = {std::sin(yaw) * std::cos(pitch), std::sin(pitch),
+                     std::cos(yaw) * std::cos(pitch)};
+  Vector3 right = {std::cos(yaw), 0.0f, -std::sin(yaw)};
   Vector3 up = {0.0f, 1.0f, 0.0f};
 
   // ── キー入力による相対移動 ──
@@ -82,7 +82,8 @@ void DebugCamera::Update() {
   // ── ビュー行列の再計算 ──
   Matrix4x4 world = MakeAffineMatrix({1, 1, 1}, // スケール固定
                                      rotation_, translation_);
-  view_ = Inverse(world);
+  // スケール 1 の回転+平行移動なので転置ベースの逆行列で十分
+  view_ = InverseRigid(world);
 }
 
 void DebugCamera::Reset() {
@@ -1,4 +1,5 @@
 #include "MainCamera.h"
+#include <cmath>
 
 void MainCamera::Initialize(const Vector3 &pos, const Vector3 &rot, float fovY,
                             float aspect, float nearZ, float farZ) {
@@ -13,8 +14,21 @@ void MainCamera::Initialize(const Vector3 &pos, const Vector3 &rot, float fovY,
 void MainCamera::Update() {
   // ----- ワールド行列を作成 -----
   // Transform からスケール・回転・並進を合成
-  Matrix4x4 world = MakeAffineMatrix(transform_.scale, transform_.rotation,
-                                     transform_.translation);
+  Matrix4x4 world = MakeAffineMatrix(transform_);
   // ----- ビュー行列はワールド行列の逆行列 -----
-  view_ = Inverse(world);
+  // アフィン行列なので 3x3 部分の逆 + 平行移動の逆で求める
+  view_ = InverseAffine(world);
+}
+
+void MainCamera::LookAt(const Vector3 &target) {
+  Vector3 dir = Subtract(target, transform_.translation);
+  float horizontal = std::sqrt(dir.x * dir.x + dir.z * dir.z);
+  if (horizontal == 0.0f && dir.y == 0.0f) {
+    return;
+  }
+  // 前方向 (cos(x)sin(y), -sin(x), cos(x)cos(y)) になる回転を逆算
+  transform_.rotation = {std::atan2(-dir.y, horizontal),
+                         std::atan2(dir.x, dir.z), 0.0f};
+  transform_.useQuaternion = false;
+  view_ = MakeLookAt(transform_.translation, target, {0.0f, 1.0f, 0.0f});
 }
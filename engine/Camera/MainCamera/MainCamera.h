@@ -25,6 +25,9 @@ public:
   void SetPosition(const Vector3 &pos) { transform_.translation = pos; }
   void SetRotation(const Vector3 &rot) { transform_.rotation = rot; }
 
+  /// 現在位置から target を向くように回転を設定（ロールは 0）
+  void LookAt(const Vector3 &target);
+
 private:
   Transform transform_; // scale, rotation, translation
                         // :contentReference[oaicite:1]{index=1}
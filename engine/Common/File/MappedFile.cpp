@@ -0,0 +1,110 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string &path) {
+  Close();
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    return false;
+  }
+  file_ = file;
+  size_ = size_t(size.QuadPart);
+  open_ = true;
+  if (size_ == 0) {
+    return true; // 空ファイルはマップできないので data_ なし
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    Close();
+    return false;
+  }
+  mapping_ = mapping;
+  data_ = static_cast<const uint8_t *>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!data_) {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_) {
+    CloseHandle(static_cast<HANDLE>(mapping_));
+  }
+  if (file_) {
+    CloseHandle(static_cast<HANDLE>(file_));
+  }
+  data_ = nullptr;
+  mapping_ = nullptr;
+  file_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::string &path) {
+  Close();
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st{};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+  fd_ = fd;
+  size_ = size_t(st.st_size);
+  open_ = true;
+  if (size_ == 0) {
+    return true;
+  }
+
+  void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (p == MAP_FAILED) {
+    Close();
+    return false;
+  }
+  data_ = static_cast<const uint8_t *>(p);
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    ::munmap(const_cast<uint8_t *>(data_), size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+  data_ = nullptr;
+  fd_ = -1;
+  size_ = 0;
+  open_ = false;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//==================================
+// 読み取り専用のメモリマップドファイル
+//==================================
+// Windows は CreateFileMapping / MapViewOfFile、それ以外は mmap。
+// 開いている間は Data() から Size() バイトをそのまま読める。
+
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile() { Close(); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // 開けなければ false（空ファイルは Size() == 0 で true）
+  bool Open(const std::string &path);
+  void Close();
+
+  bool IsOpen() const { return open_; }
+  const uint8_t *Data() const { return data_; }
+  size_t Size() const { return size_; }
+
+private:
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  bool open_ = false;
+#ifdef _WIN32
+  void *file_ = nullptr;    // HANDLE
+  void *mapping_ = nullptr; // HANDLE
+#else
+  int fd_ = -1;
+#endif
+};
@@ -0,0 +1,411 @@
+#include "Frustum.h"
+#include "Math.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ||             \
+    defined(__i386__)
+#define CG2_CULL_SSE2 1
+#include <emmintrin.h>
+#else
+#define CG2_CULL_SSE2 0
+#endif
+
+//==================================
+// 視錐台
+//==================================
+
+namespace {
+
+// a*x + b*y + c*z + d >= 0 を内側とする平面を正規化して Plane にする
+Plane MakePlane(float a, float b, float c, float d) {
+  float length = std::sqrt(a * a + b * b + c * c);
+  if (length == 0.0f) {
+    length = 1.0f;
+  }
+  Plane plane;
+  plane.normal = {a / length, b / length, c / length};
+  plane.distance = -d / length;
+  return plane;
+}
+
+float SignedDistance(const Plane &plane, float x, float y, float z) {
+  return plane.normal.x * x + plane.normal.y * y + plane.normal.z * z -
+         plane.distance;
+}
+
+} // namespace
+
+Frustum MakeFrustum(const Matrix4x4 &viewProj) {
+  // clip = v * M なので clip の各成分は M の列との内積になる
+  const Matrix4x4 &m = viewProj;
+  auto col = [&m](int c, int r) { return m.m[r][c]; };
+
+  Frustum frustum;
+  // 左: w + x >= 0 / 右: w - x >= 0
+  frustum.planes[0] = MakePlane(col(3, 0) + col(0, 0), col(3, 1) + col(0, 1),
+                                col(3, 2) + col(0, 2), col(3, 3) + col(0, 3));
+  frustum.planes[1] = MakePlane(col(3, 0) - col(0, 0), col(3, 1) - col(0, 1),
+                                col(3, 2) - col(0, 2), col(3, 3) - col(0, 3));
+  // 下: w + y >= 0 / 上: w - y >= 0
+  frustum.planes[2] = MakePlane(col(3, 0) + col(1, 0), col(3, 1) + col(1, 1),
+                                col(3, 2) + col(1, 2), col(3, 3) + col(1, 3));
+  frustum.planes[3] = MakePlane(col(3, 0) - col(1, 0), col(3, 1) - col(1, 1),
+                                col(3, 2) - col(1, 2), col(3, 3) - col(1, 3));
+  // 近: z >= 0（D3D）/ 遠: w - z >= 0
+  frustum.planes[4] =
+      MakePlane(col(2, 0), col(2, 1), col(2, 2), col(2, 3));
+  frustum.planes[5] = MakePlane(col(3, 0) - col(2, 0), col(3, 1) - col(2, 1),
+                                col(3, 2) - col(2, 2), col(3, 3) - col(2, 3));
+  return frustum;
+}
+
+bool IsVisible(const Frustum &frustum, const SphereData &sphere) {
+  for (const Plane &plane : frustum.planes) {
+    // NaN も外側扱い（SIMD 版の cmpge と揃える）
+    if (!(SignedDistance(plane, sphere.center.x, sphere.center.y,
+                         sphere.center.z) >= -sphere.radius)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsVisible(const Frustum &frustum, const AABB &aabb) {
+  for (const Plane &plane : frustum.planes) {
+    // 法線方向に最も進んだ頂点（p-vertex）が外側なら箱全体が外側
+    const float x = plane.normal.x >= 0.0f ? aabb.max.x : aabb.min.x;
+    const float y = plane.normal.y >= 0.0f ? aabb.max.y : aabb.min.y;
+    const float z = plane.normal.z >= 0.0f ? aabb.max.z : aabb.min.z;
+    if (!(SignedDistance(plane, x, y, z) >= 0.0f)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//==================================
+// 境界ボリューム
+//==================================
+
+AABB ComputeAABB(const VertexData *vertices, size_t count) {
+  AABB aabb;
+  if (count == 0) {
+    aabb.min = {0.0f, 0.0f, 0.0f};
+    aabb.max = {0.0f, 0.0f, 0.0f};
+    return aabb;
+  }
+  const Vector4 &p0 = vertices[0].position;
+  aabb.min = {p0.x, p0.y, p0.z};
+  aabb.max = {p0.x, p0.y, p0.z};
+  for (size_t i = 1; i < count; ++i) {
+    const Vector4 &p = vertices[i].position;
+    aabb.min.x = (std::min)(aabb.min.x, p.x);
+    aabb.min.y = (std::min)(aabb.min.y, p.y);
+    aabb.min.z = (std::min)(aabb.min.z, p.z);
+    aabb.max.x = (std::max)(aabb.max.x, p.x);
+    aabb.max.y = (std::max)(aabb.max.y, p.y);
+    aabb.max.z = (std::max)(aabb.max.z, p.z);
+  }
+  return aabb;
+}
+
+SphereData ComputeBoundingSphere(const VertexData *vertices, size_t count) {
+  const AABB aabb = ComputeAABB(vertices, count);
+
+  SphereData sphere;
+  sphere.center = Multiply(Add(aabb.min, aabb.max), 0.5f);
+  float radiusSq = 0.0f;
+  for (size_t i = 0; i < count; ++i) {
+    const Vector4 &p = vertices[i].position;
+    const Vector3 d = {p.x - sphere.center.x, p.y - sphere.center.y,
+                       p.z - sphere.center.z};
+    radiusSq = (std::max)(radiusSq, Dot(d, d));
+  }
+  sphere.radius = std::sqrt(radiusSq);
+  return sphere;
+}
+
+SphereData TransformSphere(const SphereData &sphere, const Matrix4x4 &matrix) {
+  float scaleSq = 0.0f;
+  for (int r = 0; r < 3; ++r) {
+    const Vector3 axis = {matrix.m[r][0], matrix.m[r][1], matrix.m[r][2]};
+    scaleSq = (std::max)(scaleSq, Dot(axis, axis));
+  }
+
+  SphereData result = sphere;
+  result.center = Vector3Transform(sphere.center, matrix);
+  result.radius = sphere.radius * std::sqrt(scaleSq);
+  return result;
+}
+
+AABB TransformAABB(const AABB &aabb, const Matrix4x4 &matrix) {
+  // 平行移動から始めて、各成分の寄与の min/max を足し込む（Arvo の方法）
+  AABB result = aabb;
+  float outMin[3] = {matrix.m[3][0], matrix.m[3][1], matrix.m[3][2]};
+  float outMax[3] = {matrix.m[3][0], matrix.m[3][1], matrix.m[3][2]};
+  const float inMin[3] = {aabb.min.x, aabb.min.y, aabb.min.z};
+  const float inMax[3] = {aabb.max.x, aabb.max.y, aabb.max.z};
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 3; ++c) {
+      const float a = inMin[r] * matrix.m[r][c];
+      const float b = inMax[r] * matrix.m[r][c];
+      outMin[c] += (std::min)(a, b);
+      outMax[c] += (std::max)(a, b);
+    }
+  }
+  result.min = {outMin[0], outMin[1], outMin[2]};
+  result.max = {outMax[0], outMax[1], outMax[2]};
+  return result;
+}
+
+float ProjectedSphereRadius(const SphereData &sphere, const Matrix4x4 &view,
+                            const Matrix4x4 &proj, float viewportHeight) {
+  const float halfHeight = viewportHeight * 0.5f;
+  if (proj.m[2][3] == 0.0f) {
+    return sphere.radius * proj.m[1][1] * halfHeight; // 正射影
+  }
+  // 透視：球に接する円錐の半角から（中心が画面中央でなくても近似として使う）
+  const Vector3 center = Vector3Transform(sphere.center, view);
+  const float distanceSq = Dot(center, center);
+  const float radiusSq = sphere.radius * sphere.radius;
+  if (distanceSq <= radiusSq) {
+    return std::numeric_limits<float>::max(); // カメラが球の中
+  }
+  return sphere.radius * proj.m[1][1] * halfHeight /
+         std::sqrt(distanceSq - radiusSq);
+}
+
+//==================================
+// SoA コンテナ
+//==================================
+
+void SphereBoundsSoA::Resize(size_t count) {
+  centerX.resize(count);
+  centerY.resize(count);
+  centerZ.resize(count);
+  radius.resize(count);
+}
+
+void SphereBoundsSoA::Set(size_t index, const SphereData &sphere) {
+  centerX[index] = sphere.center.x;
+  centerY[index] = sphere.center.y;
+  centerZ[index] = sphere.center.z;
+  radius[index] = sphere.radius;
+}
+
+void SphereBoundsSoA::Push(const SphereData &sphere) {
+  Resize(Size() + 1);
+  Set(Size() - 1, sphere);
+}
+
+void AABBBoundsSoA::Resize(size_t count) {
+  minX.resize(count);
+  minY.resize(count);
+  minZ.resize(count);
+  maxX.resize(count);
+  maxY.resize(count);
+  maxZ.resize(count);
+}
+
+void AABBBoundsSoA::Set(size_t index, const AABB &aabb) {
+  minX[index] = aabb.min.x;
+  minY[index] = aabb.min.y;
+  minZ[index] = aabb.min.z;
+  maxX[index] = aabb.max.x;
+  maxY[index] = aabb.max.y;
+  maxZ[index] = aabb.max.z;
+}
+
+void AABBBoundsSoA::Push(const AABB &aabb) {
+  Resize(Size() + 1);
+  Set(Size() - 1, aabb);
+}
+
+//==================================
+// 一括カリング
+//==================================
+
+namespace {
+
+#if CG2_CULL_SSE2
+
+// 平面を 4 レーンへ複製したもの
+struct PlaneSSE {
+  __m128 nx, ny, nz, d;
+  bool posX, posY, posZ; // AABB の p-vertex 選択用
+};
+
+void LoadPlanes(const Frustum &frustum, PlaneSSE out[6]) {
+  for (int p = 0; p < 6; ++p) {
+    const Plane &plane = frustum.planes[p];
+    out[p].nx = _mm_set1_ps(plane.normal.x);
+    out[p].ny = _mm_set1_ps(plane.normal.y);
+    out[p].nz = _mm_set1_ps(plane.normal.z);
+    out[p].d = _mm_set1_ps(plane.distance);
+    out[p].posX = plane.normal.x >= 0.0f;
+    out[p].posY = plane.normal.y >= 0.0f;
+    out[p].posZ = plane.normal.z >= 0.0f;
+  }
+}
+
+// スカラー版 SignedDistance と同じ演算順
+inline __m128 SignedDistance4(const PlaneSSE &plane, __m128 x, __m128 y,
+                              __m128 z) {
+  __m128 dist = _mm_add_ps(_mm_mul_ps(plane.nx, x), _mm_mul_ps(plane.ny, y));
+  dist = _mm_add_ps(dist, _mm_mul_ps(plane.nz, z));
+  return _mm_sub_ps(dist, plane.d);
+}
+
+// 4 球の可視ビット（bit k = レーン k）
+inline int SphereMask4(const PlaneSSE planes[6], __m128 cx, __m128 cy,
+                       __m128 cz, __m128 r) {
+  const __m128 negR = _mm_sub_ps(_mm_setzero_ps(), r);
+  __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+  for (int p = 0; p < 6; ++p) {
+    const __m128 dist = SignedDistance4(planes[p], cx, cy, cz);
+    inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, negR));
+  }
+  return _mm_movemask_ps(inside);
+}
+
+// 4 箱の可視ビット
+inline int AABBMask4(const PlaneSSE planes[6], __m128 minX, __m128 minY,
+                     __m128 minZ, __m128 maxX, __m128 maxY, __m128 maxZ) {
+  const __m128 zero = _mm_setzero_ps();
+  __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+  for (int p = 0; p < 6; ++p) {
+    const PlaneSSE &plane = planes[p];
+    const __m128 dist =
+        SignedDistance4(plane, plane.posX ? maxX : minX,
+                        plane.posY ? maxY : minY, plane.posZ ? maxZ : minZ);
+    inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, zero));
+  }
+  return _mm_movemask_ps(inside);
+}
+
+// 可視ビットの立っている番号を分岐なしで詰める
+inline size_t Compact4(int mask, uint32_t base, uint32_t *out, size_t n) {
+  for (uint32_t k = 0; k < 4; ++k) {
+    out[n] = base + k;
+    n += (mask >> k) & 1;
+  }
+  return n;
+}
+
+#endif // CG2_CULL_SSE2
+
+} // namespace
+
+size_t CullSpheres(const Frustum &frustum, const SphereBoundsSoA &spheres,
+                   uint32_t *outVisible) {
+  const size_t count = spheres.Size();
+  size_t n = 0;
+  size_t i = 0;
+#if CG2_CULL_SSE2
+  PlaneSSE planes[6];
+  LoadPlanes(frustum, planes);
+  for (; i + 4 <= count; i += 4) {
+    const int mask = SphereMask4(
+        planes, _mm_loadu_ps(&spheres.centerX[i]),
+        _mm_loadu_ps(&spheres.centerY[i]), _mm_loadu_ps(&spheres.centerZ[i]),
+        _mm_loadu_ps(&spheres.radius[i]));
+    n = Compact4(mask, uint32_t(i), outVisible, n);
+  }
+#endif
+  for (; i < count; ++i) {
+    SphereData sphere;
+    sphere.center = {spheres.centerX[i], spheres.centerY[i],
+                     spheres.centerZ[i]};
+    sphere.radius = spheres.radius[i];
+    if (IsVisible(frustum, sphere)) {
+      outVisible[n++] = uint32_t(i);
+    }
+  }
+  return n;
+}
+
+size_t CullAABBs(const Frustum &frustum, const AABBBoundsSoA &aabbs,
+                 uint32_t *outVisible) {
+  const size_t count = aabbs.Size();
+  size_t n = 0;
+  size_t i = 0;
+#if CG2_CULL_SSE2
+  PlaneSSE planes[6];
+  LoadPlanes(frustum, planes);
+  for (; i + 4 <= count; i += 4) {
+    const int mask = AABBMask4(
+        planes, _mm_loadu_ps(&aabbs.minX[i]), _mm_loadu_ps(&aabbs.minY[i]),
+        _mm_loadu_ps(&aabbs.minZ[i]), _mm_loadu_ps(&aabbs.maxX[i]),
+        _mm_loadu_ps(&aabbs.maxY[i]), _mm_loadu_ps(&aabbs.maxZ[i]));
+    n = Compact4(mask, uint32_t(i), outVisible, n);
+  }
+#endif
+  for (; i < count; ++i) {
+    AABB aabb;
+    aabb.min = {aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i]};
+    aabb.max = {aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i]};
+    if (IsVisible(frustum, aabb)) {
+      outVisible[n++] = uint32_t(i);
+    }
+  }
+  return n;
+}
+
+size_t CullSpheres(const Frustum &frustum, const SphereData *spheres,
+                   size_t count, uint32_t *outVisible) {
+  size_t n = 0;
+  size_t i = 0;
+#if CG2_CULL_SSE2
+  PlaneSSE planes[6];
+  LoadPlanes(frustum, planes);
+  for (; i + 4 <= count; i += 4) {
+    const SphereData *s = spheres + i;
+    const int mask = SphereMask4(
+        planes,
+        _mm_setr_ps(s[0].center.x, s[1].center.x, s[2].center.x,
+                    s[3].center.x),
+        _mm_setr_ps(s[0].center.y, s[1].center.y, s[2].center.y,
+                    s[3].center.y),
+        _mm_setr_ps(s[0].center.z, s[1].center.z, s[2].center.z,
+                    s[3].center.z),
+        _mm_setr_ps(s[0].radius, s[1].radius, s[2].radius, s[3].radius));
+    n = Compact4(mask, uint32_t(i), outVisible, n);
+  }
+#endif
+  for (; i < count; ++i) {
+    if (IsVisible(frustum, spheres[i])) {
+      outVisible[n++] = uint32_t(i);
+    }
+  }
+  return n;
+}
+
+size_t CullAABBs(const Frustum &frustum, const AABB *aabbs, size_t count,
+                 uint32_t *outVisible) {
+  size_t n = 0;
+  size_t i = 0;
+#if CG2_CULL_SSE2
+  PlaneSSE planes[6];
+  LoadPlanes(frustum, planes);
+  for (; i + 4 <= count; i += 4) {
+    const AABB *b = aabbs + i;
+    const int mask = AABBMask4(
+        planes,
+        _mm_setr_ps(b[0].min.x, b[1].min.x, b[2].min.x, b[3].min.x),
+        _mm_setr_ps(b[0].min.y, b[1].min.y, b[2].min.y, b[3].min.y),
+        _mm_setr_ps(b[0].min.z, b[1].min.z, b[2].min.z, b[3].min.z),
+        _mm_setr_ps(b[0].max.x, b[1].max.x, b[2].max.x, b[3].max.x),
+        _mm_setr_ps(b[0].max.y, b[1].max.y, b[2].max.y, b[3].max.y),
+        _mm_setr_ps(b[0].max.z, b[1].max.z, b[2].max.z, b[3].max.z));
+    n = Compact4(mask, uint32_t(i), outVisible, n);
+  }
+#endif
+  for (; i < count; ++i) {
+    if (IsVisible(frustum, aabbs[i])) {
+      outVisible[n++] = uint32_t(i);
+    }
+  }
+  return n;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "MathTypes.h"
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 視錐台とカリング
+//==================================
+// 平面は Plane（normal は視錐台の内側向き・正規化済み）で表し、
+// Dot(normal, p) - distance >= 0 を内側とする。
+// 一括版は 4 要素ずつ SSE2 で判定し、見えたものの番号だけを詰めて返す。
+
+struct Frustum {
+  // 0:左 1:右 2:下 3:上 4:近 5:遠
+  Plane planes[6];
+};
+
+// view * proj から 6 平面を取り出す（行ベクトル規約、D3D の z∈[0,1]）
+Frustum MakeFrustum(const Matrix4x4 &viewProj);
+
+// 単体判定（境界上は見えている扱い）
+bool IsVisible(const Frustum &frustum, const SphereData &sphere);
+bool IsVisible(const Frustum &frustum, const AABB &aabb);
+
+//==================================
+// 境界ボリューム
+//==================================
+
+// 頂点列を囲む AABB（count == 0 なら原点の点）
+AABB ComputeAABB(const VertexData *vertices, size_t count);
+// 頂点列を囲む球（中心は AABB の中心、半径は最遠頂点まで）
+SphereData ComputeBoundingSphere(const VertexData *vertices, size_t count);
+
+// 座標変換（半径は 3x3 部分の最大軸スケール倍なので非一様スケールでも内包する）
+SphereData TransformSphere(const SphereData &sphere, const Matrix4x4 &matrix);
+// 座標変換後の 8 頂点を囲む AABB
+AABB TransformAABB(const AABB &aabb, const Matrix4x4 &matrix);
+
+// 球の画面上の半径（ピクセル、viewportHeight は画面の高さ）。
+// カメラが球の中にあれば float の最大値
+float ProjectedSphereRadius(const SphereData &sphere, const Matrix4x4 &view,
+                            const Matrix4x4 &proj, float viewportHeight);
+
+//==================================
+// 一括カリング
+//==================================
+
+// 成分ごとに連続配置した境界球列
+struct SphereBoundsSoA {
+  std::vector<float> centerX, centerY, centerZ, radius;
+
+  size_t Size() const { return centerX.size(); }
+  void Resize(size_t count);
+  void Clear() { Resize(0); }
+
+  void Set(size_t index, const SphereData &sphere);
+  void Push(const SphereData &sphere);
+};
+
+// 成分ごとに連続配置した AABB 列
+struct AABBBoundsSoA {
+  std::vector<float> minX, minY, minZ;
+  std::vector<float> maxX, maxY, maxZ;
+
+  size_t Size() const { return minX.size(); }
+  void Resize(size_t count);
+  void Clear() { Resize(0); }
+
+  void Set(size_t index, const AABB &aabb);
+  void Push(const AABB &aabb);
+};
+
+// 見えている要素の番号を昇順で outVisible に詰め、その個数を返す
+// outVisible は要素数分の領域が必要
+size_t CullSpheres(const Frustum &frustum, const SphereBoundsSoA &spheres,
+                   uint32_t *outVisible);
+size_t CullAABBs(const Frustum &frustum, const AABBBoundsSoA &aabbs,
+                 uint32_t *outVisible);
+
+// AoS 版（4 個ずつレジスタへ詰め替えて同じ判定を行う）
+size_t CullSpheres(const Frustum &frustum, const SphereData *spheres,
+                   size_t count, uint32_t *outVisible);
+size_t CullAABBs(const Frustum &frustum, const AABB *aabbs, size_t count,
+                 uint32_t *outVisible);
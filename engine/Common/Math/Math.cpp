@@ -1,4 +1,5 @@
 #include "Math.h"
+#include "MathSimd.h"
 #include <assert.h>
 #include <cmath>
 #include <math.h>
@@ -7,46 +8,6 @@
 // Vector3 関連関数
 //==================================
 
-Vector3 Add(const Vector3 &v1, const Vector3 &v2) {
-  Vector3 result;
-
-  result.x = v1.x + v2.x;
-  result.y = v1.y + v2.y;
-  result.z = v1.z + v2.z;
-
-  return result;
-}
-
-Vector3 Subtract(const Vector3 &v1, const Vector3 &v2) {
-  Vector3 result;
-
-  result.x = v1.x - v2.x;
-  result.y = v1.y - v2.y;
-  result.z = v1.z - v2.z;
-
-  return result;
-}
-
-Vector3 Multiply(const Vector3 &v1, float scalar) {
-  Vector3 result;
-
-  result.x = v1.x * scalar;
-  result.y = v1.y * scalar;
-  result.z = v1.z * scalar;
-
-  return result;
-}
-
-float Dot(const Vector3 &v1, const Vector3 &v2) {
-  Vector3 result;
-
-  result.x = v1.x * v2.x;
-  result.y = v1.y * v2.y;
-  result.z = v1.z * v2.z;
-
-  return result.x + result.y + result.z;
-}
-
 float Length(const Vector3 &v) {
   float result;
 
@@ -72,124 +33,75 @@ Vector3 Normalize(const Vector3 &v) {
   return result;
 }
 
-Vector3 Vector3Transform(const Vector3 &vector, const Matrix4x4 &matrix) {
-  Vector3 result;
-
-  result.x = vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] +
-             vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0];
-
-  result.y = vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] +
-             vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1];
-
-  result.z = vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] +
-             vector.z * matrix.m[2][2] + 1.0f * matrix.m[3][2];
-
-  float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] +
-            vector.z * matrix.m[2][3] + 1.0f * matrix.m[3][3];
-
-  if (w == 0) {
-    w = 1.0f;
-  }
-
-  result.x /= w;
-  result.y /= w;
-  result.z /= w;
-
-  return result;
-}
-
-Vector3 project(const Vector3 &v1, const Vector3 &v2) {
-  float dot = Dot(v1, v2);
-  float lengthSq = Dot(v2, v2); // v2の長さの2乗
-
-  if (lengthSq == 0) {
-    return {0, 0, 0};
-  }
-
-  float scalar = dot / lengthSq;
-  Vector3 result = Multiply(v2, scalar);
-
-  return result;
-}
+//==================================
+// Matrix4x4 関連関数
+//==================================
 
-Vector3 closestPoint(const Vector3 &point, const Segment &segment) {
+Matrix4x4 Inverse(const Matrix4x4 &m) { return GetMatrixKernels().inverse(m); }
 
-  // 線分の始点
-  const Vector3 &a = segment.origin;
-  // 線分の終点
-  Vector3 b = Add(segment.origin, segment.diff);
+Matrix4x4 InverseAffine(const Matrix4x4 &m) {
+  // 3x3 部分の余因子展開
+  float c00 = m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1];
+  float c01 = m.m[0][2] * m.m[2][1] - m.m[0][1] * m.m[2][2];
+  float c02 = m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1];
+  float c10 = m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2];
+  float c11 = m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0];
+  float c12 = m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2];
+  float c20 = m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0];
+  float c21 = m.m[0][1] * m.m[2][0] - m.m[0][0] * m.m[2][1];
+  float c22 = m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0];
 
-  // abベクトル
-  Vector3 ab = Subtract(b, a);
-  // apベクトル
-  Vector3 ap = Subtract(point, a);
+  float det = m.m[0][0] * c00 + m.m[0][1] * c10 + m.m[0][2] * c20;
+  float invDet = 1.0f / det;
 
-  float abLenSq = Dot(ab, ab);
-  if (abLenSq == 0.0f) {
-    // 線分の長さが0の場合、始点を返す
-    return a;
+  Matrix4x4 result;
+  result.m[0][0] = c00 * invDet;
+  result.m[0][1] = c01 * invDet;
+  result.m[0][2] = c02 * invDet;
+  result.m[0][3] = 0.0f;
+  result.m[1][0] = c10 * invDet;
+  result.m[1][1] = c11 * invDet;
+  result.m[1][2] = c12 * invDet;
+  result.m[1][3] = 0.0f;
+  result.m[2][0] = c20 * invDet;
+  result.m[2][1] = c21 * invDet;
+  result.m[2][2] = c22 * invDet;
+  result.m[2][3] = 0.0f;
+
+  // t' = -t * R^-1
+  for (int j = 0; j < 3; ++j) {
+    result.m[3][j] = -(m.m[3][0] * result.m[0][j] + m.m[3][1] * result.m[1][j] +
+                       m.m[3][2] * result.m[2][j]);
   }
-
-  // 最近接点のパラメータtを計算（0 <= t <= 1にクランプ）
-  float t = Dot(ap, ab) / abLenSq;
-  if (t < 0.0f)
-    t = 0.0f;
-  if (t > 1.0f)
-    t = 1.0f;
-
-  // 最近接点を計算
-  Vector3 result = Add(a, Multiply(ab, t));
-  return result;
-
-}
-
-Vector3 Cross(const Vector3 &v1, const Vector3 &v2) {
-  Vector3 result;
-
-  result.x = v1.y * v2.z - v1.z * v2.y;
-  result.y = v1.z * v2.x - v1.x * v2.z;
-  result.z = v1.x * v2.y - v1.y * v2.x;
+  result.m[3][3] = 1.0f;
 
   return result;
 }
 
-//==================================
-// Matrix4x4 関連関数
-//==================================
-
-Matrix4x4 Add(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+Matrix4x4 InverseRigid(const Matrix4x4 &m) {
   Matrix4x4 result;
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      result.m[i][j] = m1.m[i][j] + m2.m[i][j];
-    }
-  }
-  return result;
-}
 
-Matrix4x4 Subtract(const Matrix4x4 &m1, const Matrix4x4 &m2) {
-  Matrix4x4 result;
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      result.m[i][j] = m1.m[i][j] - m2.m[i][j];
+  // 回転部分は直交行列なので転置が逆行列
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      result.m[i][j] = m.m[j][i];
     }
+    result.m[i][3] = 0.0f;
   }
-  return result;
-}
 
-Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2) {
-  Matrix4x4 result;
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      result.m[i][j] = 0;
-      for (int k = 0; k < 4; ++k) {
-        result.m[i][j] += m1.m[i][k] * m2.m[k][j];
-      }
-    }
+  // t' = -t * R^T
+  for (int j = 0; j < 3; ++j) {
+    result.m[3][j] = -(m.m[3][0] * m.m[j][0] + m.m[3][1] * m.m[j][1] +
+                       m.m[3][2] * m.m[j][2]);
   }
+  result.m[3][3] = 1.0f;
+
   return result;
 }
 
+// スカラー実装（SIMD 非対応環境と結果比較用）
+namespace MathScalar {
+
 Matrix4x4 Inverse(const Matrix4x4 &m) {
   //|A|用の変数
   float det = 0;
@@ -360,31 +272,7 @@ Matrix4x4 Inverse(const Matrix4x4 &m) {
   return result;
 }
 
-Matrix4x4 Transpose(const Matrix4x4 &m) {
-  Matrix4x4 result;
-
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      result.m[i][j] = m.m[j][i];
-    }
-  }
-
-  return result;
-}
-
-Matrix4x4 MakeIdentity4x4() {
-  Matrix4x4 result;
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      if (i == j) {
-        result.m[i][j] = 1.0f;
-      } else {
-        result.m[i][j] = 0.0f;
-      }
-    }
-  }
-  return result;
-}
+} // namespace MathScalar
 
 //==================================
 // 回転行列
@@ -403,29 +291,29 @@ Matrix4x4 MakeRotateMatrix(ShaftType shaft, float radian) {
   case X:
 
     result.m[0][0] = 1.0f;
-    result.m[1][1] = std::cosf(radian);
-    result.m[1][2] = std::sinf(radian);
-    result.m[2][1] = -std::sinf(radian);
-    result.m[2][2] = std::cosf(radian);
+    result.m[1][1] = std::cos(radian);
+    result.m[1][2] = std::sin(radian);
+    result.m[2][1] = -std::sin(radian);
+    result.m[2][2] = std::cos(radian);
     result.m[3][3] = 1.0f;
 
     break;
   case Y:
 
-    result.m[0][0] = std::cosf(radian);
-    result.m[0][2] = -std::sinf(radian);
+    result.m[0][0] = std::cos(radian);
+    result.m[0][2] = -std::sin(radian);
     result.m[1][1] = 1.0f;
-    result.m[2][0] = std::sinf(radian);
-    result.m[2][2] = std::cosf(radian);
+    result.m[2][0] = std::sin(radian);
+    result.m[2][2] = std::cos(radian);
     result.m[3][3] = 1.0f;
 
     break;
   case Z:
 
-    result.m[0][0] = std::cosf(radian);
-    result.m[0][1] = std::sinf(radian);
-    result.m[1][0] = -std::sinf(radian);
-    result.m[1][1] = std::cosf(radian);
+    result.m[0][0] = std::cos(radian);
+    result.m[0][1] = std::sin(radian);
+    result.m[1][0] = -std::sin(radian);
+    result.m[1][1] = std::cos(radian);
     result.m[2][2] = 1.0f;
     result.m[3][3] = 1.0f;
 
@@ -436,51 +324,100 @@ Matrix4x4 MakeRotateMatrix(ShaftType shaft, float radian) {
 }
 
 //==================================
-// 平行移動行列
+// Quaternion 関連関数
 //==================================
 
-Matrix4x4 MakeTranslateMatrix(const Vector3 &translate) {
+float Norm(const Quaternion &q) { return sqrtf(Dot(q, q)); }
 
-  Matrix4x4 result;
+Quaternion Normalize(const Quaternion &q) {
+  float norm = Norm(q);
+  if (norm == 0.0f) {
+    return IdentityQuaternion();
+  }
+  return {q.x / norm, q.y / norm, q.z / norm, q.w / norm};
+}
 
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      if (i == j) {
-        result.m[i][j] = 1.0f;
-      } else {
-        result.m[i][j] = 0.0f;
-      }
-    }
+Quaternion Inverse(const Quaternion &q) {
+  float normSq = Dot(q, q);
+  if (normSq == 0.0f) {
+    return IdentityQuaternion();
   }
+  Quaternion conj = Conjugate(q);
+  return {conj.x / normSq, conj.y / normSq, conj.z / normSq, conj.w / normSq};
+}
 
-  result.m[3][0] = translate.x;
-  result.m[3][1] = translate.y;
-  result.m[3][2] = translate.z;
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3 &axis, float angle) {
+  Vector3 n = Normalize(axis);
+  float s = std::sin(angle * 0.5f);
+  return {n.x * s, n.y * s, n.z * s, std::cos(angle * 0.5f)};
+}
 
+Quaternion MakeQuaternionFromEuler(const Vector3 &rotate) {
+  // X→Y→Z の順に適用するので q = qZ * qY * qX
+  float sx = std::sin(rotate.x * 0.5f), cx = std::cos(rotate.x * 0.5f);
+  float sy = std::sin(rotate.y * 0.5f), cy = std::cos(rotate.y * 0.5f);
+  float sz = std::sin(rotate.z * 0.5f), cz = std::cos(rotate.z * 0.5f);
+
+  Quaternion result;
+  result.x = cz * cy * sx - sz * sy * cx;
+  result.y = cz * sy * cx + sz * cy * sx;
+  result.z = sz * cy * cx - cz * sy * sx;
+  result.w = cz * cy * cx + sz * sy * sx;
   return result;
 }
 
-//==================================
-// 拡大縮小行列
-//==================================
+Vector3 QuaternionToEuler(const Quaternion &q) {
+  // R = Rx * Ry * Rz の成分から逆算する
+  // z は x を使って大きい成分から求め、y = ±90° 付近でも破綻しないようにする
+  Matrix4x4 r = MakeRotateMatrix(q);
+  Vector3 result;
+  result.x = std::atan2(r.m[1][2], r.m[2][2]);
+  float cy = sqrtf(r.m[0][0] * r.m[0][0] + r.m[0][1] * r.m[0][1]);
+  result.y = std::atan2(-r.m[0][2], cy);
+  float sx = std::sin(result.x), cx = std::cos(result.x);
+  result.z = std::atan2(sx * r.m[2][0] - cx * r.m[1][0],
+                        cx * r.m[1][1] - sx * r.m[2][1]);
+  return result;
+}
 
-Matrix4x4 MakeScaleMatrix(const Vector3 &scale) {
-  Matrix4x4 result;
+Vector3 RotateVector(const Vector3 &vector, const Quaternion &q) {
+  // v' = v + 2w(u×v) + 2u×(u×v)
+  Vector3 u = {q.x, q.y, q.z};
+  Vector3 t = Multiply(Cross(u, vector), 2.0f);
+  return Add(Add(vector, Multiply(t, q.w)), Cross(u, t));
+}
 
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      if (i == j) {
-        result.m[i][j] = (i == 0)   ? scale.x
-                         : (i == 1) ? scale.y
-                         : (i == 2) ? scale.z
-                                    : 1.0f;
-      } else {
-        result.m[i][j] = 0.0f;
-      }
-    }
+Matrix4x4 MakeRotateMatrix(const Quaternion &q) {
+  return MakeAffineMatrix({1.0f, 1.0f, 1.0f}, q, {0.0f, 0.0f, 0.0f});
+}
+
+Quaternion Slerp(const Quaternion &q0, const Quaternion &q1, float t) {
+  float dot = Dot(q0, q1);
+  Quaternion end = q1;
+  // 最短経路を通るよう反対側なら符号を反転
+  if (dot < 0.0f) {
+    end = {-q1.x, -q1.y, -q1.z, -q1.w};
+    dot = -dot;
   }
+  // ほぼ同じ向きなら Nlerp で十分（sin(θ)≈0 による誤差回避）
+  if (dot >= 0.9995f) {
+    return Nlerp(q0, end, t);
+  }
+  float theta = std::acos(dot);
+  float sinTheta = std::sin(theta);
+  float scale0 = std::sin((1.0f - t) * theta) / sinTheta;
+  float scale1 = std::sin(t * theta) / sinTheta;
+  return {scale0 * q0.x + scale1 * end.x, scale0 * q0.y + scale1 * end.y,
+          scale0 * q0.z + scale1 * end.z, scale0 * q0.w + scale1 * end.w};
+}
 
-  return result;
+Quaternion Nlerp(const Quaternion &q0, const Quaternion &q1, float t) {
+  float sign = (Dot(q0, q1) < 0.0f) ? -1.0f : 1.0f;
+  Quaternion result = {q0.x + (sign * q1.x - q0.x) * t,
+                       q0.y + (sign * q1.y - q0.y) * t,
+                       q0.z + (sign * q1.z - q0.z) * t,
+                       q0.w + (sign * q1.w - q0.w) * t};
+  return Normalize(result);
 }
 
 //==================================
@@ -489,79 +426,124 @@ Matrix4x4 MakeScaleMatrix(const Vector3 &scale) {
 Matrix4x4 MakeAffineMatrix(const Vector3 &scale, const Vector3 &rotate,
                            const Vector3 &translate) {
 
-  // スケーリング行列 S
-  Matrix4x4 resultScaleMatrix = MakeScaleMatrix(scale);
+  float sx = std::sin(rotate.x), cx = std::cos(rotate.x);
+  float sy = std::sin(rotate.y), cy = std::cos(rotate.y);
+  float sz = std::sin(rotate.z), cz = std::cos(rotate.z);
+
+  // S * (Rx * Ry * Rz) * T を展開した結果を直接書き込む
+  Matrix4x4 result;
+
+  result.m[0][0] = scale.x * (cy * cz);
+  result.m[0][1] = scale.x * (cy * sz);
+  result.m[0][2] = scale.x * (-sy);
+  result.m[0][3] = 0.0f;
 
-  // 回転行列 R
-  Matrix4x4 resultRotateXMatrix = MakeRotateMatrix(X, rotate.x);
-  Matrix4x4 resultRotateYMatrix = MakeRotateMatrix(Y, rotate.y);
-  Matrix4x4 resultRotateZMatrix = MakeRotateMatrix(Z, rotate.z);
-  Matrix4x4 resultRotateMatrix = Multiply(
-      resultRotateXMatrix, Multiply(resultRotateYMatrix, resultRotateZMatrix));
+  result.m[1][0] = scale.y * (sx * sy * cz - cx * sz);
+  result.m[1][1] = scale.y * (cx * cz + sx * sy * sz);
+  result.m[1][2] = scale.y * (sx * cy);
+  result.m[1][3] = 0.0f;
 
-  // 平行移動行列 T
-  Matrix4x4 resultTranslateMatrix = MakeTranslateMatrix(translate);
+  result.m[2][0] = scale.z * (sx * sz + cx * sy * cz);
+  result.m[2][1] = scale.z * (cx * sy * sz - sx * cz);
+  result.m[2][2] = scale.z * (cx * cy);
+  result.m[2][3] = 0.0f;
 
-  // アフィン変換行列 W = S * R * T
-  Matrix4x4 result = Multiply(
-      resultScaleMatrix, Multiply(resultRotateMatrix, resultTranslateMatrix));
+  result.m[3][0] = translate.x;
+  result.m[3][1] = translate.y;
+  result.m[3][2] = translate.z;
+  result.m[3][3] = 1.0f;
 
   return result;
 }
 
-//==================================
-// 透視投影行列
-//==================================
+Matrix4x4 MakeAffineMatrix(const Vector3 &scale, const Quaternion &rotate,
+                           const Vector3 &translate) {
 
-Matrix4x4 MakePerspectiveFovMatrix(float fov, float aspectRatio, float nearClip,
-                                   float farClip) {
-  Matrix4x4 result = {};
-  float cot = 1.0f / std::tanf(fov / 2.0f);
+  const Quaternion &q = rotate;
+  float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+  float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+  float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
 
-  result.m[0][0] = cot / aspectRatio;
-  result.m[1][1] = cot;
-  result.m[2][2] = farClip / (farClip - nearClip);
-  result.m[2][3] = 1.0f;
-  result.m[3][2] = -(farClip * nearClip) / (farClip - nearClip);
+  Matrix4x4 result;
+
+  result.m[0][0] = scale.x * (1.0f - 2.0f * (yy + zz));
+  result.m[0][1] = scale.x * (2.0f * (xy + wz));
+  result.m[0][2] = scale.x * (2.0f * (xz - wy));
+  result.m[0][3] = 0.0f;
+
+  result.m[1][0] = scale.y * (2.0f * (xy - wz));
+  result.m[1][1] = scale.y * (1.0f - 2.0f * (xx + zz));
+  result.m[1][2] = scale.y * (2.0f * (yz + wx));
+  result.m[1][3] = 0.0f;
+
+  result.m[2][0] = scale.z * (2.0f * (xz + wy));
+  result.m[2][1] = scale.z * (2.0f * (yz - wx));
+  result.m[2][2] = scale.z * (1.0f - 2.0f * (xx + yy));
+  result.m[2][3] = 0.0f;
+
+  result.m[3][0] = translate.x;
+  result.m[3][1] = translate.y;
+  result.m[3][2] = translate.z;
+  result.m[3][3] = 1.0f;
 
   return result;
 }
 
+Matrix4x4 MakeAffineMatrix(const Transform &transform) {
+  if (transform.useQuaternion) {
+    return MakeAffineMatrix(transform.scale, transform.quaternion,
+                            transform.translation);
+  }
+  return MakeAffineMatrix(transform.scale, transform.rotation,
+                          transform.translation);
+}
+
 //==================================
-// 正射影行列
+// ビュー行列
 //==================================
 
-Matrix4x4 MakeOrthographicMatrix(float left, float top, float right,
-                                 float bottom, float nearClip, float farClip) {
-
-  Matrix4x4 result = {};
+Matrix4x4 MakeLookAt(const Vector3 &eye, const Vector3 &target,
+                     const Vector3 &up) {
+  Vector3 zAxis = Normalize(Subtract(target, eye));
+  Vector3 xAxis = Normalize(Cross(up, zAxis));
+  Vector3 yAxis = Cross(zAxis, xAxis);
 
-  result.m[0][0] = 2.0f / (right - left);
-  result.m[1][1] = 2.0f / (top - bottom);
-  result.m[2][2] = 1.0f / (farClip - nearClip);
-  result.m[3][0] = (left + right) / (left - right);
-  result.m[3][1] = (top + bottom) / (bottom - top);
-  result.m[3][2] = nearClip / (nearClip - farClip);
+  // カメラのワールド行列 [x;y;z;eye] の剛体逆行列を直接書く
+  Matrix4x4 result;
+  result.m[0][0] = xAxis.x;
+  result.m[0][1] = yAxis.x;
+  result.m[0][2] = zAxis.x;
+  result.m[0][3] = 0.0f;
+  result.m[1][0] = xAxis.y;
+  result.m[1][1] = yAxis.y;
+  result.m[1][2] = zAxis.y;
+  result.m[1][3] = 0.0f;
+  result.m[2][0] = xAxis.z;
+  result.m[2][1] = yAxis.z;
+  result.m[2][2] = zAxis.z;
+  result.m[2][3] = 0.0f;
+  result.m[3][0] = -Dot(xAxis, eye);
+  result.m[3][1] = -Dot(yAxis, eye);
+  result.m[3][2] = -Dot(zAxis, eye);
   result.m[3][3] = 1.0f;
 
   return result;
 }
 
 //==================================
-// ビューポート変換行列
+// 透視投影行列
 //==================================
 
-Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height,
-                             float minDepth, float maxDepth) {
+Matrix4x4 MakePerspectiveFovMatrix(float fov, float aspectRatio, float nearClip,
+                                   float farClip) {
   Matrix4x4 result = {};
+  float cot = 1.0f / std::tan(fov / 2.0f);
 
-  result.m[0][0] = width / 2.0f;
-  result.m[1][1] = -height / 2.0f;
-  result.m[2][2] = maxDepth - minDepth;
-  result.m[3][0] = left + (width / 2.0f);
-  result.m[3][1] = top + (height / 2.0f);
-  result.m[3][2] = minDepth;
-  result.m[3][3] = 1.0f;
+  result.m[0][0] = cot / aspectRatio;
+  result.m[1][1] = cot;
+  result.m[2][2] = farClip / (farClip - nearClip);
+  result.m[2][3] = 1.0f;
+  result.m[3][2] = -(farClip * nearClip) / (farClip - nearClip);
 
   return result;
 }
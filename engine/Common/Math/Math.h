@@ -1,48 +1,161 @@
 #pragma once
+#include "MathSimd.h"
 #include "MathTypes.h"
 #include "struct.h"
+#include <type_traits>
+
+// 四則演算・行列生成など超越関数を使わないものはヘッダー内の constexpr inline。
+// 呼び出し側で展開され、定数引数ならコンパイル時に畳み込まれる。
+// sqrt / sin / cos を含むものと SIMD カーネル本体は Math.cpp / MathSimd.cpp。
 
 //==================================
 // Vector3 関連関数
 //==================================
 
 // 加算
-Vector3 Add(const Vector3 &v1, const Vector3 &v2);
+constexpr Vector3 Add(const Vector3 &v1, const Vector3 &v2) {
+  return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z};
+}
 // 減算
-Vector3 Subtract(const Vector3 &v1, const Vector3 &v2);
+constexpr Vector3 Subtract(const Vector3 &v1, const Vector3 &v2) {
+  return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z};
+}
 // スカラー倍
-Vector3 Multiply(const Vector3 &v1, float scalar);
+constexpr Vector3 Multiply(const Vector3 &v1, float scalar) {
+  return {v1.x * scalar, v1.y * scalar, v1.z * scalar};
+}
 // 内積
-float Dot(const Vector3 &v1, const Vector3 &v2);
+constexpr float Dot(const Vector3 &v1, const Vector3 &v2) {
+  return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+}
 // 長さ
 float Length(const Vector3 &v);
 // 正規化
 Vector3 Normalize(const Vector3 &v);
 // 座標変換
-Vector3 Vector3Transform(const Vector3 &vector, const Matrix4x4 &matrix);
+constexpr Vector3 Vector3Transform(const Vector3 &vector,
+                                   const Matrix4x4 &matrix) {
+  Vector3 result = {
+      vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] +
+          vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0],
+      vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] +
+          vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1],
+      vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] +
+          vector.z * matrix.m[2][2] + 1.0f * matrix.m[3][2]};
+
+  float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] +
+            vector.z * matrix.m[2][3] + 1.0f * matrix.m[3][3];
+  if (w == 0) {
+    w = 1.0f;
+  }
+
+  result.x /= w;
+  result.y /= w;
+  result.z /= w;
+  return result;
+}
+// 方向ベクトルの変換（w=0、平行移動を無視）
+constexpr Vector3 TransformNormal(const Vector3 &vector,
+                                  const Matrix4x4 &matrix) {
+  return {vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] +
+              vector.z * matrix.m[2][0],
+          vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] +
+              vector.z * matrix.m[2][1],
+          vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] +
+              vector.z * matrix.m[2][2]};
+}
 // 正射影ベクトル
-Vector3 project(const Vector3 &v1, const Vector3 &v2);
+constexpr Vector3 project(const Vector3 &v1, const Vector3 &v2) {
+  float lengthSq = Dot(v2, v2); // v2の長さの2乗
+  if (lengthSq == 0) {
+    return {0, 0, 0};
+  }
+  return Multiply(v2, Dot(v1, v2) / lengthSq);
+}
 // 最近接点
-Vector3 closestPoint(const Vector3 &point, const Segment& segment);
+constexpr Vector3 closestPoint(const Vector3 &point, const Segment &segment) {
+  // 線分の始点
+  const Vector3 &a = segment.origin;
+  // 線分の終点
+  Vector3 b = Add(segment.origin, segment.diff);
+
+  // abベクトル
+  Vector3 ab = Subtract(b, a);
+  // apベクトル
+  Vector3 ap = Subtract(point, a);
+
+  float abLenSq = Dot(ab, ab);
+  if (abLenSq == 0.0f) {
+    // 線分の長さが0の場合、始点を返す
+    return a;
+  }
+
+  // 最近接点のパラメータtを計算（0 <= t <= 1にクランプ）
+  float t = Dot(ap, ab) / abLenSq;
+  if (t < 0.0f)
+    t = 0.0f;
+  if (t > 1.0f)
+    t = 1.0f;
+
+  return Add(a, Multiply(ab, t));
+}
 // 直線の交点
-Vector3 Cross(const Vector3 &v1, const Vector3 &v2);
+constexpr Vector3 Cross(const Vector3 &v1, const Vector3 &v2) {
+  return {v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z,
+          v1.x * v2.y - v1.y * v2.x};
+}
 
 //==================================
 // Matrix4x4 関連関数
 //==================================
 
 // 行列の加法
-Matrix4x4 Add(const Matrix4x4 &m1, const Matrix4x4 &m2);
+constexpr Matrix4x4 Add(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  Matrix4x4 result = {};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      result.m[i][j] = m1.m[i][j] + m2.m[i][j];
+    }
+  }
+  return result;
+}
 // 行列の減法
-Matrix4x4 Subtract(const Matrix4x4 &m1, const Matrix4x4 &m2);
-// 行列の積
-Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2);
+constexpr Matrix4x4 Subtract(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  Matrix4x4 result = {};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      result.m[i][j] = m1.m[i][j] - m2.m[i][j];
+    }
+  }
+  return result;
+}
+// 行列の積（コンパイル時はスカラー版、実行時は SIMD カーネル）
+constexpr Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  if (std::is_constant_evaluated()) {
+    return MathScalar::Multiply(m1, m2);
+  }
+  return GetMatrixKernels().multiply(m1, m2);
+}
 // 逆行列
 Matrix4x4 Inverse(const Matrix4x4 &m);
+// アフィン行列（4列目が 0,0,0,1）の逆行列：3x3 部分の逆 + 平行移動の逆
+Matrix4x4 InverseAffine(const Matrix4x4 &m);
+// 回転+平行移動のみ（スケール 1）の逆行列：3x3 の転置 + 平行移動の逆
+Matrix4x4 InverseRigid(const Matrix4x4 &m);
 // 転置行列
-Matrix4x4 Transpose(const Matrix4x4 &m);
+constexpr Matrix4x4 Transpose(const Matrix4x4 &m) {
+  if (std::is_constant_evaluated()) {
+    return MathScalar::Transpose(m);
+  }
+  return GetMatrixKernels().transpose(m);
+}
 // 単位行列の生成
-Matrix4x4 MakeIdentity4x4();
+constexpr Matrix4x4 MakeIdentity4x4() {
+  return {{{1.0f, 0.0f, 0.0f, 0.0f},
+           {0.0f, 1.0f, 0.0f, 0.0f},
+           {0.0f, 0.0f, 1.0f, 0.0f},
+           {0.0f, 0.0f, 0.0f, 1.0f}}};
+}
 
 //==================================
 // 回転行列
@@ -54,19 +167,84 @@ Matrix4x4 MakeRotateMatrix(ShaftType shaft, float radian);
 // 平行移動行列
 //==================================
 
-Matrix4x4 MakeTranslateMatrix(const Vector3 &translate);
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector3 &translate) {
+  return {{{1.0f, 0.0f, 0.0f, 0.0f},
+           {0.0f, 1.0f, 0.0f, 0.0f},
+           {0.0f, 0.0f, 1.0f, 0.0f},
+           {translate.x, translate.y, translate.z, 1.0f}}};
+}
 
 //==================================
 // 拡大縮小行列
 //==================================
 
-Matrix4x4 MakeScaleMatrix(const Vector3 &scale);
+constexpr Matrix4x4 MakeScaleMatrix(const Vector3 &scale) {
+  return {{{scale.x, 0.0f, 0.0f, 0.0f},
+           {0.0f, scale.y, 0.0f, 0.0f},
+           {0.0f, 0.0f, scale.z, 0.0f},
+           {0.0f, 0.0f, 0.0f, 1.0f}}};
+}
+
+//==================================
+// Quaternion 関連関数
+//==================================
+
+// 単位クォータニオン
+constexpr Quaternion IdentityQuaternion() { return {0.0f, 0.0f, 0.0f, 1.0f}; }
+// 積（q2 で回転してから q1 で回転）
+constexpr Quaternion Multiply(const Quaternion &q1, const Quaternion &q2) {
+  return {q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+          q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+          q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w,
+          q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z};
+}
+// 共役
+constexpr Quaternion Conjugate(const Quaternion &q) {
+  return {-q.x, -q.y, -q.z, q.w};
+}
+// 内積
+constexpr float Dot(const Quaternion &q1, const Quaternion &q2) {
+  return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+// ノルム
+float Norm(const Quaternion &q);
+// 正規化
+Quaternion Normalize(const Quaternion &q);
+// 逆クォータニオン
+Quaternion Inverse(const Quaternion &q);
+// 任意軸回転
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3 &axis, float angle);
+// オイラー角（X→Y→Z の順に適用、MakeAffineMatrix と同じ）から変換
+Quaternion MakeQuaternionFromEuler(const Vector3 &rotate);
+// オイラー角（X→Y→Z）へ変換
+Vector3 QuaternionToEuler(const Quaternion &q);
+// ベクトルの回転
+Vector3 RotateVector(const Vector3 &vector, const Quaternion &q);
+// 回転行列
+Matrix4x4 MakeRotateMatrix(const Quaternion &q);
+// 球面線形補間（最短経路）
+Quaternion Slerp(const Quaternion &q0, const Quaternion &q1, float t);
+// 正規化線形補間（Slerp より軽い、角速度は一定でない）
+Quaternion Nlerp(const Quaternion &q0, const Quaternion &q1, float t);
 
 //==================================
 // Affine関数
 //==================================
+// W = S * R * T を行列積なしで直接組み立てる
 Matrix4x4 MakeAffineMatrix(const Vector3 &scale, const Vector3 &rotate,
                            const Vector3 &translate);
+Matrix4x4 MakeAffineMatrix(const Vector3 &scale, const Quaternion &rotate,
+                           const Vector3 &translate);
+// Transform（useQuaternion に応じてオイラー角/クォータニオンを選ぶ）
+Matrix4x4 MakeAffineMatrix(const Transform &transform);
+
+//==================================
+// ビュー行列
+//==================================
+
+// eye から target を見るビュー行列（左手系、up は概ねの上方向）
+Matrix4x4 MakeLookAt(const Vector3 &eye, const Vector3 &target,
+                     const Vector3 &up);
 
 //==================================
 // 透視投影行列
@@ -79,12 +257,91 @@ Matrix4x4 MakePerspectiveFovMatrix(float fov, float aspectRatio, float nearClip,
 // 正射影行列
 //==================================
 
-Matrix4x4 MakeOrthographicMatrix(float left, float top, float right,
-                                 float bottom, float nearClip, float farClip);
+constexpr Matrix4x4 MakeOrthographicMatrix(float left, float top, float right,
+                                           float bottom, float nearClip,
+                                           float farClip) {
+  Matrix4x4 result = {};
+
+  result.m[0][0] = 2.0f / (right - left);
+  result.m[1][1] = 2.0f / (top - bottom);
+  result.m[2][2] = 1.0f / (farClip - nearClip);
+  result.m[3][0] = (left + right) / (left - right);
+  result.m[3][1] = (top + bottom) / (bottom - top);
+  result.m[3][2] = nearClip / (nearClip - farClip);
+  result.m[3][3] = 1.0f;
+
+  return result;
+}
 
 //==================================
 // ビューポート変換行列
 //==================================
 
-Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height,
-                             float minDepth, float maxDepth);
+constexpr Matrix4x4 MakeViewportMatrix(float left, float top, float width,
+                                       float height, float minDepth,
+                                       float maxDepth) {
+  Matrix4x4 result = {};
+
+  result.m[0][0] = width / 2.0f;
+  result.m[1][1] = -height / 2.0f;
+  result.m[2][2] = maxDepth - minDepth;
+  result.m[3][0] = left + (width / 2.0f);
+  result.m[3][1] = top + (height / 2.0f);
+  result.m[3][2] = minDepth;
+  result.m[3][3] = 1.0f;
+
+  return result;
+}
+
+//==================================
+// 演算子
+//==================================
+// 中身は上の名前付き関数と同じ（既存コードはどちらで書いても結果は一致する）
+
+constexpr Vector3 operator+(const Vector3 &v1, const Vector3 &v2) {
+  return Add(v1, v2);
+}
+constexpr Vector3 operator-(const Vector3 &v1, const Vector3 &v2) {
+  return Subtract(v1, v2);
+}
+constexpr Vector3 operator-(const Vector3 &v) { return {-v.x, -v.y, -v.z}; }
+constexpr Vector3 operator*(const Vector3 &v, float scalar) {
+  return Multiply(v, scalar);
+}
+constexpr Vector3 operator*(float scalar, const Vector3 &v) {
+  return Multiply(v, scalar);
+}
+constexpr Vector3 operator/(const Vector3 &v, float scalar) {
+  return {v.x / scalar, v.y / scalar, v.z / scalar};
+}
+constexpr Vector3 &operator+=(Vector3 &v1, const Vector3 &v2) {
+  return v1 = Add(v1, v2);
+}
+constexpr Vector3 &operator-=(Vector3 &v1, const Vector3 &v2) {
+  return v1 = Subtract(v1, v2);
+}
+constexpr Vector3 &operator*=(Vector3 &v, float scalar) {
+  return v = Multiply(v, scalar);
+}
+
+constexpr Matrix4x4 operator+(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  return Add(m1, m2);
+}
+constexpr Matrix4x4 operator-(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  return Subtract(m1, m2);
+}
+// 行ベクトル規約なので a * b は「a を適用してから b」
+constexpr Matrix4x4 operator*(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  return Multiply(m1, m2);
+}
+constexpr Matrix4x4 &operator*=(Matrix4x4 &m1, const Matrix4x4 &m2) {
+  return m1 = Multiply(m1, m2);
+}
+// v * M（w=1 として変換）
+constexpr Vector3 operator*(const Vector3 &v, const Matrix4x4 &m) {
+  return Vector3Transform(v, m);
+}
+
+constexpr Quaternion operator*(const Quaternion &q1, const Quaternion &q2) {
+  return Multiply(q1, q2);
+}
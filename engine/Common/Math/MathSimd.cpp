@@ -0,0 +1,304 @@
+#include "MathSimd.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ||             \
+    defined(__i386__)
+#define CG2_MATH_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define CG2_MATH_X86 0
+#endif
+
+// GCC/Clang では AVX2 関数に target 属性が必要（MSVC は不要）
+#if CG2_MATH_X86 && !defined(_MSC_VER)
+#define CG2_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define CG2_TARGET_AVX2
+#endif
+
+//==================================
+// 判定
+//==================================
+
+SimdLevel DetectSimdLevel() {
+#if CG2_MATH_X86
+#if defined(_MSC_VER)
+  int info[4] = {};
+  __cpuid(info, 0);
+  const int maxLeaf = info[0];
+
+  __cpuid(info, 1);
+  const bool fma = (info[2] & (1 << 12)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+
+  bool avx2 = false;
+  if (maxLeaf >= 7) {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+  }
+
+  // OS が YMM レジスタを保存しているか（XCR0 の bit1,2）
+  bool osYmm = false;
+  if (osxsave) {
+    osYmm = (_xgetbv(0) & 0x6) == 0x6;
+  }
+
+  if (avx && avx2 && fma && osYmm) {
+    return SimdLevel::AVX2;
+  }
+#else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+  return SimdLevel::SSE2;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+const char *SimdLevelName(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::Scalar:
+    return "Scalar";
+  case SimdLevel::SSE2:
+    return "SSE2";
+  case SimdLevel::AVX2:
+    return "AVX2+FMA";
+  }
+  return "Unknown";
+}
+
+//==================================
+// ディスパッチ
+//==================================
+
+namespace {
+
+MatrixKernels MakeKernels(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::AVX2:
+    return {MathAVX2::Multiply, MathSSE2::Inverse, MathSSE2::Transpose};
+  case SimdLevel::SSE2:
+    return {MathSSE2::Multiply, MathSSE2::Inverse, MathSSE2::Transpose};
+  case SimdLevel::Scalar:
+  default:
+    return {MathScalar::Multiply, MathScalar::Inverse, MathScalar::Transpose};
+  }
+}
+
+struct KernelState {
+  SimdLevel level;
+  MatrixKernels kernels;
+};
+
+KernelState &State() {
+  static KernelState state = [] {
+    const SimdLevel level = DetectSimdLevel();
+    return KernelState{level, MakeKernels(level)};
+  }();
+  return state;
+}
+
+} // namespace
+
+const MatrixKernels &GetMatrixKernels() { return State().kernels; }
+
+SimdLevel GetSimdLevel() { return State().level; }
+
+void SetSimdLevel(SimdLevel level) {
+  const SimdLevel maxLevel = DetectSimdLevel();
+  if (static_cast<int>(level) > static_cast<int>(maxLevel)) {
+    level = maxLevel;
+  }
+  State() = KernelState{level, MakeKernels(level)};
+}
+
+//==================================
+// SSE2
+//==================================
+
+#if CG2_MATH_X86
+
+namespace {
+
+// シャッフル用マスク（x,y,z,w は取り出す要素番号）
+#define CG2_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+#define CG2_SWIZZLE(v, x, y, z, w)                                            \
+  _mm_shuffle_ps((v), (v), CG2_SHUFFLE_MASK(x, y, z, w))
+#define CG2_SHUFFLE(a, b, x, y, z, w)                                         \
+  _mm_shuffle_ps((a), (b), CG2_SHUFFLE_MASK(x, y, z, w))
+
+inline void LoadRows(const Matrix4x4 &m, __m128 rows[4]) {
+  rows[0] = _mm_loadu_ps(m.m[0]);
+  rows[1] = _mm_loadu_ps(m.m[1]);
+  rows[2] = _mm_loadu_ps(m.m[2]);
+  rows[3] = _mm_loadu_ps(m.m[3]);
+}
+
+inline void StoreRows(Matrix4x4 &m, const __m128 rows[4]) {
+  _mm_storeu_ps(m.m[0], rows[0]);
+  _mm_storeu_ps(m.m[1], rows[1]);
+  _mm_storeu_ps(m.m[2], rows[2]);
+  _mm_storeu_ps(m.m[3], rows[3]);
+}
+
+// 2x2 行列（x,y,z,w = m00,m01,m10,m11）の積 A*B
+inline __m128 Mat2Mul(__m128 a, __m128 b) {
+  return _mm_add_ps(
+      _mm_mul_ps(a, CG2_SWIZZLE(b, 0, 3, 0, 3)),
+      _mm_mul_ps(CG2_SWIZZLE(a, 1, 0, 3, 2), CG2_SWIZZLE(b, 2, 1, 2, 1)));
+}
+// 余因子行列との積 adj(A)*B
+inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+  return _mm_sub_ps(
+      _mm_mul_ps(CG2_SWIZZLE(a, 3, 3, 0, 0), b),
+      _mm_mul_ps(CG2_SWIZZLE(a, 1, 1, 2, 2), CG2_SWIZZLE(b, 2, 3, 0, 1)));
+}
+// 余因子行列との積 A*adj(B)
+inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+  return _mm_sub_ps(
+      _mm_mul_ps(a, CG2_SWIZZLE(b, 3, 0, 3, 0)),
+      _mm_mul_ps(CG2_SWIZZLE(a, 1, 0, 3, 2), CG2_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+} // namespace
+
+namespace MathSSE2 {
+
+Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  __m128 b[4];
+  LoadRows(m2, b);
+
+  Matrix4x4 result;
+  for (int i = 0; i < 4; ++i) {
+    // result[i] = m1[i][0]*b0 + m1[i][1]*b1 + m1[i][2]*b2 + m1[i][3]*b3
+    // （スカラー版と同じ順で加算するので結果は一致する）
+    __m128 r = _mm_mul_ps(_mm_set1_ps(m1.m[i][0]), b[0]);
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][1]), b[1]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][2]), b[2]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][3]), b[3]));
+    _mm_storeu_ps(result.m[i], r);
+  }
+  return result;
+}
+
+Matrix4x4 Inverse(const Matrix4x4 &m) {
+  // M = | A B |  を 2x2 ブロックに分けて余因子で解く
+  //     | C D |
+  __m128 r[4];
+  LoadRows(m, r);
+
+  const __m128 A = _mm_movelh_ps(r[0], r[1]);
+  const __m128 B = _mm_movehl_ps(r[1], r[0]);
+  const __m128 C = _mm_movelh_ps(r[2], r[3]);
+  const __m128 D = _mm_movehl_ps(r[3], r[2]);
+
+  // (|A|, |B|, |C|, |D|)
+  const __m128 detSub =
+      _mm_sub_ps(_mm_mul_ps(CG2_SHUFFLE(r[0], r[2], 0, 2, 0, 2),
+                            CG2_SHUFFLE(r[1], r[3], 1, 3, 1, 3)),
+                 _mm_mul_ps(CG2_SHUFFLE(r[0], r[2], 1, 3, 1, 3),
+                            CG2_SHUFFLE(r[1], r[3], 0, 2, 0, 2)));
+  const __m128 detA = CG2_SWIZZLE(detSub, 0, 0, 0, 0);
+  const __m128 detB = CG2_SWIZZLE(detSub, 1, 1, 1, 1);
+  const __m128 detC = CG2_SWIZZLE(detSub, 2, 2, 2, 2);
+  const __m128 detD = CG2_SWIZZLE(detSub, 3, 3, 3, 3);
+
+  const __m128 D_C = Mat2AdjMul(D, C);
+  const __m128 A_B = Mat2AdjMul(A, B);
+
+  __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, D_C));
+  __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, A_B));
+  __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, A_B));
+  __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, D_C));
+
+  // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+  __m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+  __m128 tr = _mm_mul_ps(A_B, CG2_SWIZZLE(D_C, 0, 2, 1, 3));
+  tr = _mm_add_ps(tr, CG2_SWIZZLE(tr, 2, 3, 0, 1));
+  tr = _mm_add_ps(tr, CG2_SWIZZLE(tr, 1, 0, 3, 2));
+  detM = _mm_sub_ps(detM, tr);
+
+  // (1/|M|, -1/|M|, -1/|M|, 1/|M|)
+  const __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+  X = _mm_mul_ps(X, rDetM);
+  Y = _mm_mul_ps(Y, rDetM);
+  Z = _mm_mul_ps(Z, rDetM);
+  W = _mm_mul_ps(W, rDetM);
+
+  // 余因子の並べ替えと行への格納をまとめて行う
+  __m128 out[4];
+  out[0] = CG2_SHUFFLE(X, Y, 3, 1, 3, 1);
+  out[1] = CG2_SHUFFLE(X, Y, 2, 0, 2, 0);
+  out[2] = CG2_SHUFFLE(Z, W, 3, 1, 3, 1);
+  out[3] = CG2_SHUFFLE(Z, W, 2, 0, 2, 0);
+
+  Matrix4x4 result;
+  StoreRows(result, out);
+  return result;
+}
+
+Matrix4x4 Transpose(const Matrix4x4 &m) {
+  __m128 r[4];
+  LoadRows(m, r);
+  _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+  Matrix4x4 result;
+  StoreRows(result, r);
+  return result;
+}
+
+} // namespace MathSSE2
+
+//==================================
+// AVX2 + FMA
+//==================================
+
+namespace MathAVX2 {
+
+CG2_TARGET_AVX2 Matrix4x4 Multiply(const Matrix4x4 &m1,
+                                   const Matrix4x4 &m2) {
+  // m2 の各行を上下 128bit に複製しておき、m1 の 2 行を同時に処理する
+  const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m2.m[0]));
+  const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m2.m[1]));
+  const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m2.m[2]));
+  const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m2.m[3]));
+
+  Matrix4x4 result;
+  for (int i = 0; i < 4; i += 2) {
+    // 下位 = 行 i, 上位 = 行 i+1
+    const __m256 a = _mm256_loadu_ps(m1.m[i]);
+    __m256 r = _mm256_mul_ps(_mm256_permute_ps(a, 0x00), b0);
+    r = _mm256_fmadd_ps(_mm256_permute_ps(a, 0x55), b1, r);
+    r = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xAA), b2, r);
+    r = _mm256_fmadd_ps(_mm256_permute_ps(a, 0xFF), b3, r);
+    _mm256_storeu_ps(result.m[i], r);
+  }
+  return result;
+}
+
+} // namespace MathAVX2
+
+#else // !CG2_MATH_X86
+
+// x86 以外ではスカラー版へフォールバック
+namespace MathSSE2 {
+Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  return MathScalar::Multiply(m1, m2);
+}
+Matrix4x4 Inverse(const Matrix4x4 &m) { return MathScalar::Inverse(m); }
+Matrix4x4 Transpose(const Matrix4x4 &m) { return MathScalar::Transpose(m); }
+} // namespace MathSSE2
+
+namespace MathAVX2 {
+Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  return MathScalar::Multiply(m1, m2);
+}
+} // namespace MathAVX2
+
+#endif
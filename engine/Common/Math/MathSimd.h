@@ -0,0 +1,74 @@
+#pragma once
+#include "MathTypes.h"
+
+//==================================
+// Matrix4x4 の SIMD カーネル
+//==================================
+// Math.cpp の Multiply / Inverse / Transpose はここで選ばれた実装を呼ぶ。
+// 初回呼び出し時に CPUID で判定し、AVX2+FMA > SSE2 > Scalar の順で採用する。
+
+enum class SimdLevel {
+  Scalar = 0, // 従来のスカラー実装
+  SSE2 = 1,   // x64 なら常に利用可能
+  AVX2 = 2,   // AVX2 + FMA（積のみ 256bit 化、丸めは FMA 分だけ異なる）
+};
+
+// 実行中の CPU で利用できる最上位レベル
+SimdLevel DetectSimdLevel();
+
+// 現在 Multiply / Inverse / Transpose が使っているレベル
+SimdLevel GetSimdLevel();
+
+// 使用レベルを強制変更（比較・デバッグ用）
+// CPU が対応していないレベルを指定した場合は DetectSimdLevel() に丸める
+void SetSimdLevel(SimdLevel level);
+
+const char *SimdLevelName(SimdLevel level);
+
+// Math.cpp から参照するディスパッチテーブル
+struct MatrixKernels {
+  Matrix4x4 (*multiply)(const Matrix4x4 &m1, const Matrix4x4 &m2);
+  Matrix4x4 (*inverse)(const Matrix4x4 &m);
+  Matrix4x4 (*transpose)(const Matrix4x4 &m);
+};
+const MatrixKernels &GetMatrixKernels();
+
+// 各実装を直接呼びたい場合（結果の突き合わせ用）
+// Multiply / Transpose のスカラー版は Math.h の constexpr 評価でも使う
+namespace MathScalar {
+constexpr Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2) {
+  Matrix4x4 result = {};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      result.m[i][j] = 0;
+      for (int k = 0; k < 4; ++k) {
+        result.m[i][j] += m1.m[i][k] * m2.m[k][j];
+      }
+    }
+  }
+  return result;
+}
+Matrix4x4 Inverse(const Matrix4x4 &m);
+constexpr Matrix4x4 Transpose(const Matrix4x4 &m) {
+  Matrix4x4 result = {};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      result.m[i][j] = m.m[j][i];
+    }
+  }
+  return result;
+}
+} // namespace MathScalar
+
+namespace MathSSE2 {
+// SSE2 は加算順序がスカラー版と同じなので積はビット一致する
+Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2);
+// 2x2 ブロック分解による逆行列（スカラー版とは許容誤差で一致）
+Matrix4x4 Inverse(const Matrix4x4 &m);
+Matrix4x4 Transpose(const Matrix4x4 &m);
+} // namespace MathSSE2
+
+namespace MathAVX2 {
+// 2 行ずつ 256bit で FMA（許容誤差で一致）
+Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2);
+} // namespace MathAVX2
@@ -10,6 +10,11 @@ struct Vector4 {
   float x, y, z, w;
 };
 
+// 回転用クォータニオン（w が実部）
+struct Quaternion {
+  float x, y, z, w;
+};
+
 struct Matrix3x3 {
   float m[3][3];
 };
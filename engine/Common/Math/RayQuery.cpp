@@ -0,0 +1,714 @@
+#include "RayQuery.h"
+#include "Math.h"
+#include "MathSimd.h"
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ||             \
+    defined(__i386__)
+#define CG2_RAY_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#else
+#define CG2_RAY_X86 0
+#endif
+
+// GCC/Clang では AVX2 関数に target 属性が必要（MSVC は不要）
+#if CG2_RAY_X86 && !defined(_MSC_VER)
+#define CG2_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CG2_TARGET_AVX2
+#endif
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+//==================================
+// スカラー版の本体（SIMD 版はこれと同じ演算順で書く）
+//==================================
+
+// _mm_min_ps / _mm_max_ps と同じ規則（NaN や等値のときは b を返す）
+inline float MinF(float a, float b) { return a < b ? a : b; }
+inline float MaxF(float a, float b) { return a > b ? a : b; }
+
+// 球との交差 t（a は Dot(diff, diff)）
+bool SphereT(const RayQuery &q, float a, float cx, float cy, float cz,
+             float r, float &outT) {
+  const float mx = q.origin.x - cx;
+  const float my = q.origin.y - cy;
+  const float mz = q.origin.z - cz;
+  const float b = mx * q.diff.x + my * q.diff.y + mz * q.diff.z;
+  const float c = mx * mx + my * my + mz * mz - r * r;
+  const float disc = b * b - a * c;
+  if (!(disc >= 0.0f)) {
+    return false;
+  }
+  const float s = std::sqrt(disc);
+  const float t0 = (-b - s) / a;
+  const float t1 = (-b + s) / a;
+  // 手前の交点が範囲外なら奥の交点（始点が内側のとき）
+  const float t = t0 >= q.tMin ? t0 : t1;
+  if (!(t >= q.tMin && t <= q.tMax)) {
+    return false;
+  }
+  outT = t;
+  return true;
+}
+
+// AABB との交差 t（inv は 1 / diff の各成分）
+bool AABBT(const RayQuery &q, const Vector3 &inv, float minX, float minY,
+           float minZ, float maxX, float maxY, float maxZ, float &outT) {
+  const float tx1 = (minX - q.origin.x) * inv.x;
+  const float tx2 = (maxX - q.origin.x) * inv.x;
+  const float ty1 = (minY - q.origin.y) * inv.y;
+  const float ty2 = (maxY - q.origin.y) * inv.y;
+  const float tz1 = (minZ - q.origin.z) * inv.z;
+  const float tz2 = (maxZ - q.origin.z) * inv.z;
+  const float tNear =
+      MaxF(MaxF(MinF(tx1, tx2), MinF(ty1, ty2)), MinF(tz1, tz2));
+  const float tFar =
+      MinF(MinF(MaxF(tx1, tx2), MaxF(ty1, ty2)), MaxF(tz1, tz2));
+  const float t = tNear >= q.tMin ? tNear : tFar;
+  if (!(tNear <= tFar && t >= q.tMin && t <= q.tMax)) {
+    return false;
+  }
+  outT = t;
+  return true;
+}
+
+// 三角形との交差 t（e1 = v1 - v0, e2 = v2 - v0）
+bool TriangleT(const RayQuery &q, float v0x, float v0y, float v0z, float e1x,
+               float e1y, float e1z, float e2x, float e2y, float e2z,
+               float &outT) {
+  const Vector3 &d = q.diff;
+  // p = diff x e2
+  const float px = d.y * e2z - d.z * e2y;
+  const float py = d.z * e2x - d.x * e2z;
+  const float pz = d.x * e2y - d.y * e2x;
+  const float det = e1x * px + e1y * py + e1z * pz;
+  if (det == 0.0f) {
+    return false; // 平行 or 面積 0
+  }
+  const float invDet = 1.0f / det;
+
+  const float sx = q.origin.x - v0x;
+  const float sy = q.origin.y - v0y;
+  const float sz = q.origin.z - v0z;
+  const float u = (sx * px + sy * py + sz * pz) * invDet;
+  if (!(u >= 0.0f && u <= 1.0f)) {
+    return false;
+  }
+
+  // qv = s x e1
+  const float qx = sy * e1z - sz * e1y;
+  const float qy = sz * e1x - sx * e1z;
+  const float qz = sx * e1y - sy * e1x;
+  const float v = (d.x * qx + d.y * qy + d.z * qz) * invDet;
+  if (!(v >= 0.0f && u + v <= 1.0f)) {
+    return false;
+  }
+
+  const float t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+  if (!(t >= q.tMin && t <= q.tMax)) {
+    return false;
+  }
+  outT = t;
+  return true;
+}
+
+Vector3 InverseDirection(const Vector3 &diff) {
+  return {1.0f / diff.x, 1.0f / diff.y, 1.0f / diff.z};
+}
+
+void FillHit(const RayQuery &q, float t, const Vector3 &normal,
+             RayHit *outHit) {
+  if (!outHit) {
+    return;
+  }
+  outHit->t = t;
+  outHit->distance = std::abs(t) * Length(q.diff);
+  outHit->point = Add(q.origin, Multiply(q.diff, t));
+  outHit->normal = normal;
+}
+
+// 両面扱いの法線をレイの来た側へ向ける
+Vector3 FaceToward(const Vector3 &normal, const Vector3 &diff) {
+  return Dot(normal, diff) > 0.0f ? Multiply(normal, -1.0f) : normal;
+}
+
+// 一括判定の途中経過
+struct Closest {
+  float t = kInfinity;
+  int index = -1;
+
+  void Update(float hitT, int hitIndex) {
+    if (hitT < t || (hitT == t && hitIndex < index)) {
+      t = hitT;
+      index = hitIndex;
+    }
+  }
+};
+
+#if CG2_RAY_X86
+
+//==================================
+// SSE2（4 個ずつ）
+//==================================
+
+inline __m128 Select4(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// レーンごとの最近値を保持し、最後に 1 つへまとめる
+struct Closest4 {
+  __m128 t = _mm_set1_ps(kInfinity);
+  __m128 index = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+  void Update(__m128 hit, __m128 hitT, __m128i hitIndex) {
+    const __m128 better = _mm_and_ps(hit, _mm_cmplt_ps(hitT, t));
+    t = Select4(better, hitT, t);
+    index = Select4(better, _mm_castsi128_ps(hitIndex), index);
+  }
+  void Reduce(Closest &out) const {
+    alignas(16) float ts[4];
+    alignas(16) int is[4];
+    _mm_store_ps(ts, t);
+    _mm_store_si128(reinterpret_cast<__m128i *>(is),
+                    _mm_castps_si128(index));
+    for (int k = 0; k < 4; ++k) {
+      if (is[k] >= 0) {
+        out.Update(ts[k], is[k]);
+      }
+    }
+  }
+};
+
+struct RaySSE {
+  __m128 ox, oy, oz, dx, dy, dz, tMin, tMax;
+  explicit RaySSE(const RayQuery &q)
+      : ox(_mm_set1_ps(q.origin.x)), oy(_mm_set1_ps(q.origin.y)),
+        oz(_mm_set1_ps(q.origin.z)), dx(_mm_set1_ps(q.diff.x)),
+        dy(_mm_set1_ps(q.diff.y)), dz(_mm_set1_ps(q.diff.z)),
+        tMin(_mm_set1_ps(q.tMin)), tMax(_mm_set1_ps(q.tMax)) {}
+};
+
+inline __m128 InRange4(const RaySSE &r, __m128 t) {
+  return _mm_and_ps(_mm_cmpge_ps(t, r.tMin), _mm_cmple_ps(t, r.tMax));
+}
+
+size_t SpheresSSE2(const RayQuery &q, float a, const SphereBoundsSoA &s,
+                   Closest &best) {
+  const RaySSE r(q);
+  const __m128 va = _mm_set1_ps(a);
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const size_t count = s.Size();
+  Closest4 best4;
+  __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 mx = _mm_sub_ps(r.ox, _mm_loadu_ps(&s.centerX[i]));
+    const __m128 my = _mm_sub_ps(r.oy, _mm_loadu_ps(&s.centerY[i]));
+    const __m128 mz = _mm_sub_ps(r.oz, _mm_loadu_ps(&s.centerZ[i]));
+    const __m128 rad = _mm_loadu_ps(&s.radius[i]);
+    __m128 b = _mm_add_ps(_mm_mul_ps(mx, r.dx), _mm_mul_ps(my, r.dy));
+    b = _mm_add_ps(b, _mm_mul_ps(mz, r.dz));
+    __m128 c = _mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my));
+    c = _mm_sub_ps(_mm_add_ps(c, _mm_mul_ps(mz, mz)), _mm_mul_ps(rad, rad));
+    const __m128 disc = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(va, c));
+    const __m128 real = _mm_cmpge_ps(disc, _mm_setzero_ps());
+    const __m128 root = _mm_sqrt_ps(_mm_and_ps(real, disc));
+    const __m128 negB = _mm_xor_ps(b, sign);
+    const __m128 t0 = _mm_div_ps(_mm_sub_ps(negB, root), va);
+    const __m128 t1 = _mm_div_ps(_mm_add_ps(negB, root), va);
+    const __m128 t = Select4(_mm_cmpge_ps(t0, r.tMin), t0, t1);
+    best4.Update(_mm_and_ps(real, InRange4(r, t)), t, index);
+    index = _mm_add_epi32(index, _mm_set1_epi32(4));
+  }
+  best4.Reduce(best);
+  return i;
+}
+
+size_t AABBsSSE2(const RayQuery &q, const Vector3 &inv,
+                 const AABBBoundsSoA &b, Closest &best) {
+  const RaySSE r(q);
+  const __m128 ix = _mm_set1_ps(inv.x);
+  const __m128 iy = _mm_set1_ps(inv.y);
+  const __m128 iz = _mm_set1_ps(inv.z);
+  const size_t count = b.Size();
+  Closest4 best4;
+  __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 tx1 =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.minX[i]), r.ox), ix);
+    const __m128 tx2 =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.maxX[i]), r.ox), ix);
+    const __m128 ty1 =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.minY[i]), r.oy), iy);
+    const __m128 ty2 =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.maxY[i]), r.oy), iy);
+    const __m128 tz1 =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.minZ[i]), r.oz), iz);
+    const __m128 tz2 =
+        _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.maxZ[i]), r.oz), iz);
+    const __m128 tNear = _mm_max_ps(
+        _mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)),
+        _mm_min_ps(tz1, tz2));
+    const __m128 tFar = _mm_min_ps(
+        _mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)),
+        _mm_max_ps(tz1, tz2));
+    const __m128 t = Select4(_mm_cmpge_ps(tNear, r.tMin), tNear, tFar);
+    best4.Update(_mm_and_ps(_mm_cmple_ps(tNear, tFar), InRange4(r, t)), t,
+                 index);
+    index = _mm_add_epi32(index, _mm_set1_epi32(4));
+  }
+  best4.Reduce(best);
+  return i;
+}
+
+size_t TrianglesSSE2(const RayQuery &q, const TriangleSoA &tri,
+                     Closest &best) {
+  const RaySSE r(q);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const size_t count = tri.Size();
+  Closest4 best4;
+  __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 e1x = _mm_loadu_ps(&tri.e1x[i]);
+    const __m128 e1y = _mm_loadu_ps(&tri.e1y[i]);
+    const __m128 e1z = _mm_loadu_ps(&tri.e1z[i]);
+    const __m128 e2x = _mm_loadu_ps(&tri.e2x[i]);
+    const __m128 e2y = _mm_loadu_ps(&tri.e2y[i]);
+    const __m128 e2z = _mm_loadu_ps(&tri.e2z[i]);
+
+    const __m128 px = _mm_sub_ps(_mm_mul_ps(r.dy, e2z), _mm_mul_ps(r.dz, e2y));
+    const __m128 py = _mm_sub_ps(_mm_mul_ps(r.dz, e2x), _mm_mul_ps(r.dx, e2z));
+    const __m128 pz = _mm_sub_ps(_mm_mul_ps(r.dx, e2y), _mm_mul_ps(r.dy, e2x));
+    __m128 det = _mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py));
+    det = _mm_add_ps(det, _mm_mul_ps(e1z, pz));
+    const __m128 invDet = _mm_div_ps(one, det);
+
+    const __m128 sx = _mm_sub_ps(r.ox, _mm_loadu_ps(&tri.v0x[i]));
+    const __m128 sy = _mm_sub_ps(r.oy, _mm_loadu_ps(&tri.v0y[i]));
+    const __m128 sz = _mm_sub_ps(r.oz, _mm_loadu_ps(&tri.v0z[i]));
+    __m128 u = _mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py));
+    u = _mm_mul_ps(_mm_add_ps(u, _mm_mul_ps(sz, pz)), invDet);
+
+    const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+    const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+    const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+    __m128 v = _mm_add_ps(_mm_mul_ps(r.dx, qx), _mm_mul_ps(r.dy, qy));
+    v = _mm_mul_ps(_mm_add_ps(v, _mm_mul_ps(r.dz, qz)), invDet);
+    __m128 t = _mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy));
+    t = _mm_mul_ps(_mm_add_ps(t, _mm_mul_ps(e2z, qz)), invDet);
+
+    __m128 hit = _mm_cmpneq_ps(det, zero);
+    hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+    hit = _mm_and_ps(hit, _mm_cmple_ps(u, one));
+    hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+    hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+    best4.Update(_mm_and_ps(hit, InRange4(r, t)), t, index);
+    index = _mm_add_epi32(index, _mm_set1_epi32(4));
+  }
+  best4.Reduce(best);
+  return i;
+}
+
+//==================================
+// AVX2（8 個ずつ、FMA は使わずスカラー版と丸めを一致させる）
+//==================================
+
+struct Closest8 {
+  __m256 t;
+  __m256 index;
+
+  CG2_TARGET_AVX2 Closest8()
+      : t(_mm256_set1_ps(kInfinity)),
+        index(_mm256_castsi256_ps(_mm256_set1_epi32(-1))) {}
+
+  CG2_TARGET_AVX2 void Update(__m256 hit, __m256 hitT, __m256i hitIndex) {
+    const __m256 better =
+        _mm256_and_ps(hit, _mm256_cmp_ps(hitT, t, _CMP_LT_OQ));
+    t = _mm256_blendv_ps(t, hitT, better);
+    index = _mm256_blendv_ps(index, _mm256_castsi256_ps(hitIndex), better);
+  }
+  CG2_TARGET_AVX2 void Reduce(Closest &out) const {
+    alignas(32) float ts[8];
+    alignas(32) int is[8];
+    _mm256_store_ps(ts, t);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(is),
+                       _mm256_castps_si256(index));
+    for (int k = 0; k < 8; ++k) {
+      if (is[k] >= 0) {
+        out.Update(ts[k], is[k]);
+      }
+    }
+  }
+};
+
+struct RayAVX {
+  __m256 ox, oy, oz, dx, dy, dz, tMin, tMax;
+  CG2_TARGET_AVX2 explicit RayAVX(const RayQuery &q)
+      : ox(_mm256_set1_ps(q.origin.x)), oy(_mm256_set1_ps(q.origin.y)),
+        oz(_mm256_set1_ps(q.origin.z)), dx(_mm256_set1_ps(q.diff.x)),
+        dy(_mm256_set1_ps(q.diff.y)), dz(_mm256_set1_ps(q.diff.z)),
+        tMin(_mm256_set1_ps(q.tMin)), tMax(_mm256_set1_ps(q.tMax)) {}
+};
+
+CG2_TARGET_AVX2 inline __m256 InRange8(const RayAVX &r, __m256 t) {
+  return _mm256_and_ps(_mm256_cmp_ps(t, r.tMin, _CMP_GE_OQ),
+                       _mm256_cmp_ps(t, r.tMax, _CMP_LE_OQ));
+}
+
+CG2_TARGET_AVX2 size_t SpheresAVX2(const RayQuery &q, float a,
+                                   const SphereBoundsSoA &s, Closest &best) {
+  const RayAVX r(q);
+  const __m256 va = _mm256_set1_ps(a);
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const size_t count = s.Size();
+  Closest8 best8;
+  __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 mx = _mm256_sub_ps(r.ox, _mm256_loadu_ps(&s.centerX[i]));
+    const __m256 my = _mm256_sub_ps(r.oy, _mm256_loadu_ps(&s.centerY[i]));
+    const __m256 mz = _mm256_sub_ps(r.oz, _mm256_loadu_ps(&s.centerZ[i]));
+    const __m256 rad = _mm256_loadu_ps(&s.radius[i]);
+    __m256 b = _mm256_add_ps(_mm256_mul_ps(mx, r.dx), _mm256_mul_ps(my, r.dy));
+    b = _mm256_add_ps(b, _mm256_mul_ps(mz, r.dz));
+    __m256 c = _mm256_add_ps(_mm256_mul_ps(mx, mx), _mm256_mul_ps(my, my));
+    c = _mm256_sub_ps(_mm256_add_ps(c, _mm256_mul_ps(mz, mz)),
+                      _mm256_mul_ps(rad, rad));
+    const __m256 disc =
+        _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(va, c));
+    const __m256 real = _mm256_cmp_ps(disc, _mm256_setzero_ps(), _CMP_GE_OQ);
+    const __m256 root = _mm256_sqrt_ps(_mm256_and_ps(real, disc));
+    const __m256 negB = _mm256_xor_ps(b, sign);
+    const __m256 t0 = _mm256_div_ps(_mm256_sub_ps(negB, root), va);
+    const __m256 t1 = _mm256_div_ps(_mm256_add_ps(negB, root), va);
+    const __m256 t =
+        _mm256_blendv_ps(t1, t0, _mm256_cmp_ps(t0, r.tMin, _CMP_GE_OQ));
+    best8.Update(_mm256_and_ps(real, InRange8(r, t)), t, index);
+    index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+  }
+  best8.Reduce(best);
+  return i;
+}
+
+CG2_TARGET_AVX2 size_t AABBsAVX2(const RayQuery &q, const Vector3 &inv,
+                                 const AABBBoundsSoA &b, Closest &best) {
+  const RayAVX r(q);
+  const __m256 ix = _mm256_set1_ps(inv.x);
+  const __m256 iy = _mm256_set1_ps(inv.y);
+  const __m256 iz = _mm256_set1_ps(inv.z);
+  const size_t count = b.Size();
+  Closest8 best8;
+  __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 tx1 =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&b.minX[i]), r.ox), ix);
+    const __m256 tx2 =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&b.maxX[i]), r.ox), ix);
+    const __m256 ty1 =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&b.minY[i]), r.oy), iy);
+    const __m256 ty2 =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&b.maxY[i]), r.oy), iy);
+    const __m256 tz1 =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&b.minZ[i]), r.oz), iz);
+    const __m256 tz2 =
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&b.maxZ[i]), r.oz), iz);
+    const __m256 tNear = _mm256_max_ps(
+        _mm256_max_ps(_mm256_min_ps(tx1, tx2), _mm256_min_ps(ty1, ty2)),
+        _mm256_min_ps(tz1, tz2));
+    const __m256 tFar = _mm256_min_ps(
+        _mm256_min_ps(_mm256_max_ps(tx1, tx2), _mm256_max_ps(ty1, ty2)),
+        _mm256_max_ps(tz1, tz2));
+    const __m256 t = _mm256_blendv_ps(
+        tFar, tNear, _mm256_cmp_ps(tNear, r.tMin, _CMP_GE_OQ));
+    best8.Update(_mm256_and_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ),
+                               InRange8(r, t)),
+                 t, index);
+    index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+  }
+  best8.Reduce(best);
+  return i;
+}
+
+CG2_TARGET_AVX2 size_t TrianglesAVX2(const RayQuery &q,
+                                     const TriangleSoA &tri, Closest &best) {
+  const RayAVX r(q);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const size_t count = tri.Size();
+  Closest8 best8;
+  __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 e1x = _mm256_loadu_ps(&tri.e1x[i]);
+    const __m256 e1y = _mm256_loadu_ps(&tri.e1y[i]);
+    const __m256 e1z = _mm256_loadu_ps(&tri.e1z[i]);
+    const __m256 e2x = _mm256_loadu_ps(&tri.e2x[i]);
+    const __m256 e2y = _mm256_loadu_ps(&tri.e2y[i]);
+    const __m256 e2z = _mm256_loadu_ps(&tri.e2z[i]);
+
+    const __m256 px =
+        _mm256_sub_ps(_mm256_mul_ps(r.dy, e2z), _mm256_mul_ps(r.dz, e2y));
+    const __m256 py =
+        _mm256_sub_ps(_mm256_mul_ps(r.dz, e2x), _mm256_mul_ps(r.dx, e2z));
+    const __m256 pz =
+        _mm256_sub_ps(_mm256_mul_ps(r.dx, e2y), _mm256_mul_ps(r.dy, e2x));
+    __m256 det = _mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py));
+    det = _mm256_add_ps(det, _mm256_mul_ps(e1z, pz));
+    const __m256 invDet = _mm256_div_ps(one, det);
+
+    const __m256 sx = _mm256_sub_ps(r.ox, _mm256_loadu_ps(&tri.v0x[i]));
+    const __m256 sy = _mm256_sub_ps(r.oy, _mm256_loadu_ps(&tri.v0y[i]));
+    const __m256 sz = _mm256_sub_ps(r.oz, _mm256_loadu_ps(&tri.v0z[i]));
+    __m256 u = _mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py));
+    u = _mm256_mul_ps(_mm256_add_ps(u, _mm256_mul_ps(sz, pz)), invDet);
+
+    const __m256 qx =
+        _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+    const __m256 qy =
+        _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+    const __m256 qz =
+        _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+    __m256 v = _mm256_add_ps(_mm256_mul_ps(r.dx, qx), _mm256_mul_ps(r.dy, qy));
+    v = _mm256_mul_ps(_mm256_add_ps(v, _mm256_mul_ps(r.dz, qz)), invDet);
+    __m256 t = _mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy));
+    t = _mm256_mul_ps(_mm256_add_ps(t, _mm256_mul_ps(e2z, qz)), invDet);
+
+    __m256 hit = _mm256_cmp_ps(det, zero, _CMP_NEQ_UQ);
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, one, _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit,
+                        _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+    best8.Update(_mm256_and_ps(hit, InRange8(r, t)), t, index);
+    index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+  }
+  best8.Reduce(best);
+  return i;
+}
+
+#endif // CG2_RAY_X86
+
+bool UseAVX2() {
+#if CG2_RAY_X86
+  return GetSimdLevel() == SimdLevel::AVX2;
+#else
+  return false;
+#endif
+}
+
+} // namespace
+
+//==================================
+// RayQuery
+//==================================
+
+RayQuery MakeRayQuery(const Ray &ray) {
+  return {ray.origin, ray.diff, 0.0f, kInfinity};
+}
+
+RayQuery MakeRayQuery(const Segment &segment) {
+  return {segment.origin, segment.diff, 0.0f, 1.0f};
+}
+
+RayQuery MakeRayQuery(const Line &line) {
+  return {line.origin, line.diff, -kInfinity, kInfinity};
+}
+
+//==================================
+// 単体判定
+//==================================
+
+bool Raycast(const RayQuery &ray, const SphereData &sphere, RayHit *outHit) {
+  float t = 0.0f;
+  if (!SphereT(ray, Dot(ray.diff, ray.diff), sphere.center.x, sphere.center.y,
+               sphere.center.z, sphere.radius, t)) {
+    return false;
+  }
+  if (outHit) {
+    const Vector3 point = Add(ray.origin, Multiply(ray.diff, t));
+    FillHit(ray, t, Normalize(Subtract(point, sphere.center)), outHit);
+  }
+  return true;
+}
+
+bool Raycast(const RayQuery &ray, const AABB &aabb, RayHit *outHit) {
+  const Vector3 inv = InverseDirection(ray.diff);
+  float t = 0.0f;
+  if (!AABBT(ray, inv, aabb.min.x, aabb.min.y, aabb.min.z, aabb.max.x,
+             aabb.max.y, aabb.max.z, t)) {
+    return false;
+  }
+  if (outHit) {
+    // 交点に最も近い面の外向き法線
+    const Vector3 point = Add(ray.origin, Multiply(ray.diff, t));
+    const float faceDist[6] = {
+        std::abs(point.x - aabb.min.x), std::abs(point.x - aabb.max.x),
+        std::abs(point.y - aabb.min.y), std::abs(point.y - aabb.max.y),
+        std::abs(point.z - aabb.min.z), std::abs(point.z - aabb.max.z)};
+    const Vector3 faceNormal[6] = {{-1, 0, 0}, {1, 0, 0},  {0, -1, 0},
+                                   {0, 1, 0},  {0, 0, -1}, {0, 0, 1}};
+    int face = 0;
+    for (int f = 1; f < 6; ++f) {
+      if (faceDist[f] < faceDist[face]) {
+        face = f;
+      }
+    }
+    FillHit(ray, t, faceNormal[face], outHit);
+  }
+  return true;
+}
+
+bool Raycast(const RayQuery &ray, const Plane &plane, RayHit *outHit) {
+  const float denom = Dot(plane.normal, ray.diff);
+  if (denom == 0.0f) {
+    return false; // 平行
+  }
+  const float t = (plane.distance - Dot(plane.normal, ray.origin)) / denom;
+  if (!(t >= ray.tMin && t <= ray.tMax)) {
+    return false;
+  }
+  FillHit(ray, t, FaceToward(plane.normal, ray.diff), outHit);
+  return true;
+}
+
+bool Raycast(const RayQuery &ray, const Vector3 &v0, const Vector3 &v1,
+             const Vector3 &v2, RayHit *outHit) {
+  const Vector3 e1 = Subtract(v1, v0);
+  const Vector3 e2 = Subtract(v2, v0);
+  float t = 0.0f;
+  if (!TriangleT(ray, v0.x, v0.y, v0.z, e1.x, e1.y, e1.z, e2.x, e2.y, e2.z,
+                 t)) {
+    return false;
+  }
+  FillHit(ray, t, FaceToward(Normalize(Cross(e1, e2)), ray.diff), outHit);
+  return true;
+}
+
+//==================================
+// TriangleSoA
+//==================================
+
+void TriangleSoA::Resize(size_t count) {
+  v0x.resize(count);
+  v0y.resize(count);
+  v0z.resize(count);
+  e1x.resize(count);
+  e1y.resize(count);
+  e1z.resize(count);
+  e2x.resize(count);
+  e2y.resize(count);
+  e2z.resize(count);
+}
+
+void TriangleSoA::Set(size_t index, const Vector3 &v0, const Vector3 &v1,
+                      const Vector3 &v2) {
+  v0x[index] = v0.x;
+  v0y[index] = v0.y;
+  v0z[index] = v0.z;
+  e1x[index] = v1.x - v0.x;
+  e1y[index] = v1.y - v0.y;
+  e1z[index] = v1.z - v0.z;
+  e2x[index] = v2.x - v0.x;
+  e2y[index] = v2.y - v0.y;
+  e2z[index] = v2.z - v0.z;
+}
+
+void TriangleSoA::Push(const Vector3 &v0, const Vector3 &v1,
+                       const Vector3 &v2) {
+  Resize(Size() + 1);
+  Set(Size() - 1, v0, v1, v2);
+}
+
+//==================================
+// 一括判定
+//==================================
+// SIMD で最も近い番号を決め、法線などは勝者だけスカラー版で求める
+
+int RaycastClosest(const RayQuery &ray, const SphereBoundsSoA &spheres,
+                   RayHit *outHit) {
+  const float a = Dot(ray.diff, ray.diff);
+  Closest best;
+  size_t i = 0;
+#if CG2_RAY_X86
+  i = UseAVX2() ? SpheresAVX2(ray, a, spheres, best)
+                : SpheresSSE2(ray, a, spheres, best);
+#endif
+  for (; i < spheres.Size(); ++i) {
+    float t = 0.0f;
+    if (SphereT(ray, a, spheres.centerX[i], spheres.centerY[i],
+                spheres.centerZ[i], spheres.radius[i], t)) {
+      best.Update(t, int(i));
+    }
+  }
+  if (best.index >= 0 && outHit) {
+    SphereData sphere;
+    sphere.center = {spheres.centerX[best.index], spheres.centerY[best.index],
+                     spheres.centerZ[best.index]};
+    sphere.radius = spheres.radius[best.index];
+    Raycast(ray, sphere, outHit);
+  }
+  return best.index;
+}
+
+int RaycastClosest(const RayQuery &ray, const AABBBoundsSoA &aabbs,
+                   RayHit *outHit) {
+  const Vector3 inv = InverseDirection(ray.diff);
+  Closest best;
+  size_t i = 0;
+#if CG2_RAY_X86
+  i = UseAVX2() ? AABBsAVX2(ray, inv, aabbs, best)
+                : AABBsSSE2(ray, inv, aabbs, best);
+#endif
+  for (; i < aabbs.Size(); ++i) {
+    float t = 0.0f;
+    if (AABBT(ray, inv, aabbs.minX[i], aabbs.minY[i], aabbs.minZ[i],
+              aabbs.maxX[i], aabbs.maxY[i], aabbs.maxZ[i], t)) {
+      best.Update(t, int(i));
+    }
+  }
+  if (best.index >= 0 && outHit) {
+    AABB aabb;
+    aabb.min = {aabbs.minX[best.index], aabbs.minY[best.index],
+                aabbs.minZ[best.index]};
+    aabb.max = {aabbs.maxX[best.index], aabbs.maxY[best.index],
+                aabbs.maxZ[best.index]};
+    Raycast(ray, aabb, outHit);
+  }
+  return best.index;
+}
+
+int RaycastClosest(const RayQuery &ray, const TriangleSoA &triangles,
+                   RayHit *outHit) {
+  Closest best;
+  size_t i = 0;
+#if CG2_RAY_X86
+  i = UseAVX2() ? TrianglesAVX2(ray, triangles, best)
+                : TrianglesSSE2(ray, triangles, best);
+#endif
+  for (; i < triangles.Size(); ++i) {
+    float t = 0.0f;
+    if (TriangleT(ray, triangles.v0x[i], triangles.v0y[i], triangles.v0z[i],
+                  triangles.e1x[i], triangles.e1y[i], triangles.e1z[i],
+                  triangles.e2x[i], triangles.e2y[i], triangles.e2z[i], t)) {
+      best.Update(t, int(i));
+    }
+  }
+  if (best.index >= 0 && outHit) {
+    // t は SIMD 版とスカラー版で一致するのでそのまま使い、法線だけ求める
+    const size_t k = size_t(best.index);
+    const Vector3 e1 = {triangles.e1x[k], triangles.e1y[k], triangles.e1z[k]};
+    const Vector3 e2 = {triangles.e2x[k], triangles.e2y[k], triangles.e2z[k]};
+    FillHit(ray, best.t, FaceToward(Normalize(Cross(e1, e2)), ray.diff),
+            outHit);
+  }
+  return best.index;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "Frustum.h"
+#include "MathTypes.h"
+#include "struct.h"
+#include <cstddef>
+#include <vector>
+
+//==================================
+// レイ判定（ピッキング・レイキャスト用）
+//==================================
+// Ray / Segment / Line はどれも origin + diff * t で表せるので、
+// t の範囲を付けた RayQuery にそろえてから判定する。
+// 一括版は 1 本のレイと多数の形状を SSE2 で 4 個、AVX2 環境では 8 個ずつ
+// 判定し、最も近い交差を返す（演算順はスカラー版と同じなので結果も一致する）。
+
+// t の範囲付きレイ
+struct RayQuery {
+  Vector3 origin;
+  Vector3 diff;
+  float tMin;
+  float tMax;
+};
+
+// Ray: t∈[0,∞) / Segment: t∈[0,1] / Line: t∈(-∞,∞)
+RayQuery MakeRayQuery(const Ray &ray);
+RayQuery MakeRayQuery(const Segment &segment);
+RayQuery MakeRayQuery(const Line &line);
+
+// 交差結果
+struct RayHit {
+  float t = 0.0f;        // origin + diff * t が交点
+  float distance = 0.0f; // origin からの距離（t * |diff|）
+  Vector3 point = {0.0f, 0.0f, 0.0f};
+  // 球・AABB は外向き、平面・三角形は両面扱いでレイの来た側を向く
+  Vector3 normal = {0.0f, 1.0f, 0.0f};
+};
+
+//==================================
+// 単体判定（outHit は nullptr 可）
+//==================================
+// 始点が球・AABB の内側にある場合は出ていく側の交点を返す
+
+bool Raycast(const RayQuery &ray, const SphereData &sphere,
+             RayHit *outHit = nullptr);
+// スラブ法
+bool Raycast(const RayQuery &ray, const AABB &aabb, RayHit *outHit = nullptr);
+bool Raycast(const RayQuery &ray, const Plane &plane,
+             RayHit *outHit = nullptr);
+// Möller–Trumbore
+bool Raycast(const RayQuery &ray, const Vector3 &v0, const Vector3 &v1,
+             const Vector3 &v2, RayHit *outHit = nullptr);
+
+//==================================
+// 一括判定（最も近い交差の番号を返す、なければ -1）
+//==================================
+
+// 三角形列（v0 と 2 辺を成分ごとに連続配置）
+struct TriangleSoA {
+  std::vector<float> v0x, v0y, v0z;
+  std::vector<float> e1x, e1y, e1z; // v1 - v0
+  std::vector<float> e2x, e2y, e2z; // v2 - v0
+
+  size_t Size() const { return v0x.size(); }
+  void Resize(size_t count);
+  void Clear() { Resize(0); }
+
+  void Set(size_t index, const Vector3 &v0, const Vector3 &v1,
+           const Vector3 &v2);
+  void Push(const Vector3 &v0, const Vector3 &v1, const Vector3 &v2);
+};
+
+// 同じ距離で当たった場合は番号の小さい方を返す
+int RaycastClosest(const RayQuery &ray, const SphereBoundsSoA &spheres,
+                   RayHit *outHit = nullptr);
+int RaycastClosest(const RayQuery &ray, const AABBBoundsSoA &aabbs,
+                   RayHit *outHit = nullptr);
+int RaycastClosest(const RayQuery &ray, const TriangleSoA &triangles,
+                   RayHit *outHit = nullptr);
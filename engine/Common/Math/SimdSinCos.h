@@ -0,0 +1,81 @@
+#pragma once
+
+//==================================
+// SSE2 の 4 要素同時 sin/cos（TransformBatch / SpriteBatch で共有）
+//==================================
+// x86 / x64 なら CG2_SIMD_SSE2 が 1 になり、SimdMath::SinCos4 が使える。
+// それ以外では 0 のままなので、呼び出し側はスカラー経路を用意する。
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ||             \
+    defined(__i386__)
+#define CG2_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define CG2_SIMD_SSE2 0
+#endif
+
+#if CG2_SIMD_SSE2
+namespace SimdMath {
+
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+  // mask ? a : b
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// 4 要素同時の sin/cos（[-pi,pi] に畳んでから 11/10 次の多項式近似）
+// |x| が大きいと畳んだ後の精度は落ちるが、値は常に [-1,1] に収まる
+// （NaN / ±inf は NaN になる）
+inline void SinCos4(__m128 x, __m128 &outSin, __m128 &outCos) {
+  const __m128 kInv2Pi = _mm_set1_ps(0.159154943f);
+  // 2pi を 3 つに分けた値（上 2 つは下位ビットが 0 なので q との積が正確）
+  const __m128 k2PiHi = _mm_set1_ps(6.28125f);
+  const __m128 k2PiMid = _mm_set1_ps(1.93500518798828125e-3f);
+  const __m128 k2PiLo = _mm_set1_ps(3.019915981956752864e-7f);
+  const __m128 kPi = _mm_set1_ps(3.14159274f);
+  const __m128 kHalfPi = _mm_set1_ps(1.57079637f);
+  const __m128 kSignBit = _mm_set1_ps(-0.0f);
+  const __m128 kExact = _mm_set1_ps(8388608.0f); // 2^23：これ以上は整数のみ
+
+  // x -= 2pi * round(x / 2pi)
+  // _mm_cvtps_epi32 は 2^31 以上で溢れるので、2^23 以上（もう整数）は
+  // 丸めずにそのまま使う
+  const __m128 scaled = _mm_mul_ps(x, kInv2Pi);
+  const __m128 small = _mm_cmplt_ps(_mm_andnot_ps(kSignBit, scaled), kExact);
+  const __m128 q =
+      Select(small, _mm_cvtepi32_ps(_mm_cvtps_epi32(scaled)), scaled);
+  x = _mm_sub_ps(x, _mm_mul_ps(q, k2PiHi));
+  x = _mm_sub_ps(x, _mm_mul_ps(q, k2PiMid));
+  x = _mm_sub_ps(x, _mm_mul_ps(q, k2PiLo));
+  // 大きな q では積の丸めで [-pi,pi] をはみ出すので詰める
+  // （min / max は第 2 引数が NaN ならそれを返す）
+  x = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), kPi), _mm_min_ps(kPi, x));
+
+  // |x| > pi/2 なら x = ±pi - x（sin は不変、cos は符号反転）
+  const __m128 sign = _mm_and_ps(x, kSignBit);
+  const __m128 absX = _mm_andnot_ps(kSignBit, x);
+  const __m128 reflect = _mm_cmpgt_ps(absX, kHalfPi);
+  const __m128 reflected = _mm_sub_ps(_mm_or_ps(kPi, sign), x);
+  x = Select(reflect, reflected, x);
+  const __m128 cosSign = _mm_and_ps(reflect, kSignBit);
+
+  const __m128 x2 = _mm_mul_ps(x, x);
+
+  __m128 s = _mm_set1_ps(-2.3889859e-08f);
+  s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(2.7525562e-06f));
+  s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(-0.00019840874f));
+  s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(0.0083333310f));
+  s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(-0.16666667f));
+  s = _mm_add_ps(_mm_mul_ps(s, x2), _mm_set1_ps(1.0f));
+  outSin = _mm_mul_ps(s, x);
+
+  __m128 c = _mm_set1_ps(-2.6051615e-07f);
+  c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(2.4760495e-05f));
+  c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(-0.0013888378f));
+  c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(0.041666638f));
+  c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(-0.5f));
+  c = _mm_add_ps(_mm_mul_ps(c, x2), _mm_set1_ps(1.0f));
+  outCos = _mm_xor_ps(c, cosSign);
+}
+
+} // namespace SimdMath
+#endif // CG2_SIMD_SSE2
@@ -0,0 +1,348 @@
+#include "TransformBatch.h"
+#include "Math.h"
+#include "SimdSinCos.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+//==================================
+// TransformBatchSoA
+//==================================
+
+void TransformBatchSoA::Resize(size_t count) {
+  scaleX.resize(count);
+  scaleY.resize(count);
+  scaleZ.resize(count);
+  rotateX.resize(count);
+  rotateY.resize(count);
+  rotateZ.resize(count);
+  rotateW.resize(count);
+  translateX.resize(count);
+  translateY.resize(count);
+  translateZ.resize(count);
+  useQuaternion.resize(count);
+}
+
+void TransformBatchSoA::Set(size_t index, const Transform &t) {
+  scaleX[index] = t.scale.x;
+  scaleY[index] = t.scale.y;
+  scaleZ[index] = t.scale.z;
+  if (t.useQuaternion) {
+    rotateX[index] = t.quaternion.x;
+    rotateY[index] = t.quaternion.y;
+    rotateZ[index] = t.quaternion.z;
+    rotateW[index] = t.quaternion.w;
+    useQuaternion[index] = ~0u;
+  } else {
+    rotateX[index] = t.rotation.x;
+    rotateY[index] = t.rotation.y;
+    rotateZ[index] = t.rotation.z;
+    rotateW[index] = 0.0f;
+    useQuaternion[index] = 0u;
+  }
+  translateX[index] = t.translation.x;
+  translateY[index] = t.translation.y;
+  translateZ[index] = t.translation.z;
+}
+
+Transform TransformBatchSoA::Get(size_t index) const {
+  Transform t;
+  t.scale = {scaleX[index], scaleY[index], scaleZ[index]};
+  t.useQuaternion = useQuaternion[index] != 0;
+  if (t.useQuaternion) {
+    t.rotation = {0.0f, 0.0f, 0.0f};
+    t.quaternion = {rotateX[index], rotateY[index], rotateZ[index],
+                    rotateW[index]};
+  } else {
+    t.rotation = {rotateX[index], rotateY[index], rotateZ[index]};
+  }
+  t.translation = {translateX[index], translateY[index], translateZ[index]};
+  return t;
+}
+
+void TransformBatchSoA::Push(const Transform &t) {
+  Resize(Size() + 1);
+  Set(Size() - 1, t);
+}
+
+namespace {
+
+#if CG2_SIMD_SSE2
+
+//==================================
+// SSE2 版（4 個ずつ）
+//==================================
+
+// 4 レーン分の入力（SoA の途中を指すか、端数を詰めた一時領域を指す）
+struct Lanes4 {
+  const float *scale[3];
+  const float *rotate[4];
+  const float *translate[3];
+  const uint32_t *useQuaternion;
+};
+
+Lanes4 LanesAt(const TransformBatchSoA &soa, size_t i) {
+  return {{&soa.scaleX[i], &soa.scaleY[i], &soa.scaleZ[i]},
+          {&soa.rotateX[i], &soa.rotateY[i], &soa.rotateZ[i], &soa.rotateW[i]},
+          {&soa.translateX[i], &soa.translateY[i], &soa.translateZ[i]},
+          &soa.useQuaternion[i]};
+}
+
+// 端数（1～3 個）を 4 レーンに詰める。空きは最後の要素の複製
+struct PaddedLanes4 {
+  float scale[3][4];
+  float rotate[4][4];
+  float translate[3][4];
+  uint32_t useQuaternion[4];
+
+  PaddedLanes4(const TransformBatchSoA &soa, size_t begin, size_t count) {
+    for (size_t lane = 0; lane < 4; ++lane) {
+      const size_t i = begin + (std::min)(lane, count - 1);
+      scale[0][lane] = soa.scaleX[i];
+      scale[1][lane] = soa.scaleY[i];
+      scale[2][lane] = soa.scaleZ[i];
+      rotate[0][lane] = soa.rotateX[i];
+      rotate[1][lane] = soa.rotateY[i];
+      rotate[2][lane] = soa.rotateZ[i];
+      rotate[3][lane] = soa.rotateW[i];
+      translate[0][lane] = soa.translateX[i];
+      translate[1][lane] = soa.translateY[i];
+      translate[2][lane] = soa.translateZ[i];
+      useQuaternion[lane] = soa.useQuaternion[i];
+    }
+  }
+
+  Lanes4 Lanes() const {
+    return {{scale[0], scale[1], scale[2]},
+            {rotate[0], rotate[1], rotate[2], rotate[3]},
+            {translate[0], translate[1], translate[2]},
+            useQuaternion};
+  }
+};
+
+// 行 r の 4 列（レーン = オブジェクト）を転置して 4 オブジェクトへ書き出す
+inline void StoreRow4(TransformationMatrix *out, Matrix4x4 TransformationMatrix::*member,
+                      int row, __m128 c0, __m128 c1, __m128 c2, __m128 c3) {
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  _mm_storeu_ps((out[0].*member).m[row], c0);
+  _mm_storeu_ps((out[1].*member).m[row], c1);
+  _mm_storeu_ps((out[2].*member).m[row], c2);
+  _mm_storeu_ps((out[3].*member).m[row], c3);
+}
+
+// オイラー角（X*Y*Z 順）の回転部分
+void EulerRotation4(const Lanes4 &in, __m128 r[3][3]) {
+  __m128 sx, cx, sy, cy, sz, cz;
+  SimdMath::SinCos4(_mm_loadu_ps(in.rotate[0]), sx, cx);
+  SimdMath::SinCos4(_mm_loadu_ps(in.rotate[1]), sy, cy);
+  SimdMath::SinCos4(_mm_loadu_ps(in.rotate[2]), sz, cz);
+
+  const __m128 sxsy = _mm_mul_ps(sx, sy);
+  const __m128 cxsy = _mm_mul_ps(cx, sy);
+
+  r[0][0] = _mm_mul_ps(cy, cz);
+  r[0][1] = _mm_mul_ps(cy, sz);
+  r[0][2] = _mm_sub_ps(_mm_setzero_ps(), sy);
+  r[1][0] = _mm_sub_ps(_mm_mul_ps(sxsy, cz), _mm_mul_ps(cx, sz));
+  r[1][1] = _mm_add_ps(_mm_mul_ps(cx, cz), _mm_mul_ps(sxsy, sz));
+  r[1][2] = _mm_mul_ps(sx, cy);
+  r[2][0] = _mm_add_ps(_mm_mul_ps(sx, sz), _mm_mul_ps(cxsy, cz));
+  r[2][1] = _mm_sub_ps(_mm_mul_ps(cxsy, sz), _mm_mul_ps(sx, cz));
+  r[2][2] = _mm_mul_ps(cx, cy);
+}
+
+// クォータニオンの回転部分（MakeAffineMatrix(scale, Quaternion, ...) と同じ式）
+void QuaternionRotation4(const Lanes4 &in, __m128 r[3][3]) {
+  const __m128 x = _mm_loadu_ps(in.rotate[0]);
+  const __m128 y = _mm_loadu_ps(in.rotate[1]);
+  const __m128 z = _mm_loadu_ps(in.rotate[2]);
+  const __m128 w = _mm_loadu_ps(in.rotate[3]);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 two = _mm_set1_ps(2.0f);
+
+  const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y),
+               zz = _mm_mul_ps(z, z);
+  const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z),
+               yz = _mm_mul_ps(y, z);
+  const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y),
+               wz = _mm_mul_ps(w, z);
+
+  r[0][0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+  r[0][1] = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+  r[0][2] = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+  r[1][0] = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+  r[1][1] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+  r[1][2] = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+  r[2][0] = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+  r[2][1] = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+  r[2][2] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+}
+
+void ComputeBlock4(const Lanes4 &in, const __m128 vp[4][4],
+                   TransformationMatrix *out) {
+  // 4 個とも同じ種類なら片方だけ計算する（混在時は両方作ってレーンで選ぶ）
+  const __m128 quatMask = _mm_loadu_ps(reinterpret_cast<const float *>(in.useQuaternion));
+  const int quatLanes = _mm_movemask_ps(quatMask);
+  __m128 rot[3][3];
+  if (quatLanes == 0) {
+    EulerRotation4(in, rot);
+  } else if (quatLanes == 0xF) {
+    QuaternionRotation4(in, rot);
+  } else {
+    __m128 euler[3][3];
+    EulerRotation4(in, euler);
+    QuaternionRotation4(in, rot);
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 3; ++c) {
+        rot[r][c] = SimdMath::Select(quatMask, rot[r][c], euler[r][c]);
+      }
+    }
+  }
+
+  __m128 w[4][3];
+  for (int r = 0; r < 3; ++r) {
+    const __m128 scale = _mm_loadu_ps(in.scale[r]);
+    for (int c = 0; c < 3; ++c) {
+      w[r][c] = _mm_mul_ps(rot[r][c], scale);
+    }
+  }
+  w[3][0] = _mm_loadu_ps(in.translate[0]);
+  w[3][1] = _mm_loadu_ps(in.translate[1]);
+  w[3][2] = _mm_loadu_ps(in.translate[2]);
+
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+
+  for (int r = 0; r < 4; ++r) {
+    StoreRow4(out, &TransformationMatrix::World, r, w[r][0], w[r][1], w[r][2],
+              (r == 3) ? one : zero);
+
+    __m128 c[4];
+    for (int col = 0; col < 4; ++col) {
+      __m128 v = _mm_mul_ps(w[r][0], vp[0][col]);
+      v = _mm_add_ps(v, _mm_mul_ps(w[r][1], vp[1][col]));
+      v = _mm_add_ps(v, _mm_mul_ps(w[r][2], vp[2][col]));
+      if (r == 3) {
+        v = _mm_add_ps(v, vp[3][col]);
+      }
+      c[col] = v;
+    }
+    StoreRow4(out, &TransformationMatrix::WVP, r, c[0], c[1], c[2], c[3]);
+  }
+}
+
+void ComputeRange(const TransformBatchSoA &soa, size_t begin, size_t end,
+                  const Matrix4x4 &viewProj, TransformationMatrix *out) {
+  __m128 vp[4][4];
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      vp[r][c] = _mm_set1_ps(viewProj.m[r][c]);
+    }
+  }
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    ComputeBlock4(LanesAt(soa, i), vp, out + i);
+  }
+  if (i < end) {
+    // 端数も同じカーネルで計算し、必要な分だけ写す
+    const size_t rest = end - i;
+    const PaddedLanes4 padded(soa, i, rest);
+    TransformationMatrix tail[4];
+    ComputeBlock4(padded.Lanes(), vp, tail);
+    std::copy(tail, tail + rest, out + i);
+  }
+}
+
+#else // !CG2_SIMD_SSE2
+
+//==================================
+// スカラー版（非 x86 用）
+//==================================
+
+void ComputeOneScalar(const TransformBatchSoA &soa, size_t i,
+                      const Matrix4x4 &vp, TransformationMatrix &out) {
+  const Vector3 scale = {soa.scaleX[i], soa.scaleY[i], soa.scaleZ[i]};
+  const Vector3 translate = {soa.translateX[i], soa.translateY[i],
+                             soa.translateZ[i]};
+  const Matrix4x4 w =
+      soa.useQuaternion[i]
+          ? MakeAffineMatrix(scale,
+                             Quaternion{soa.rotateX[i], soa.rotateY[i],
+                                        soa.rotateZ[i], soa.rotateW[i]},
+                             translate)
+          : MakeAffineMatrix(
+                scale, Vector3{soa.rotateX[i], soa.rotateY[i], soa.rotateZ[i]},
+                translate);
+
+  // W の 4 列目は (0,0,0,1) 固定なので 3 列分 + 平行移動行だけ足す
+  out.World = w;
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      float v = w.m[r][0] * vp.m[0][c] + w.m[r][1] * vp.m[1][c] +
+                w.m[r][2] * vp.m[2][c];
+      if (r == 3) {
+        v += vp.m[3][c];
+      }
+      out.WVP.m[r][c] = v;
+    }
+  }
+}
+
+void ComputeRange(const TransformBatchSoA &soa, size_t begin, size_t end,
+                  const Matrix4x4 &viewProj, TransformationMatrix *out) {
+  for (size_t i = begin; i < end; ++i) {
+    ComputeOneScalar(soa, i, viewProj, out[i]);
+  }
+}
+
+#endif // CG2_SIMD_SSE2
+
+} // namespace
+
+void ComputeTransformationMatrices(const TransformBatchSoA &transforms,
+                                   const Matrix4x4 &viewProj,
+                                   TransformationMatrix *out,
+                                   uint32_t workerCount) {
+  const size_t count = transforms.Size();
+  if (count == 0) {
+    return;
+  }
+
+  // 1 スレッドあたり最低この数は処理させる（少数ならスレッド起動の方が重い）
+  constexpr size_t kMinPerWorker = 1024;
+  size_t workers = (std::max)(workerCount, 1u);
+  workers = (std::min)(workers, (count + kMinPerWorker - 1) / kMinPerWorker);
+  if (workers <= 1) {
+    ComputeRange(transforms, 0, count, viewProj, out);
+    return;
+  }
+
+  // 4 の倍数で区切ってスレッドへ配る（最後の区間は呼び出し元で処理）
+  const size_t chunk = ((count / workers) + 3) & ~size_t(3);
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  size_t begin = 0;
+  for (size_t w = 0; w + 1 < workers && begin < count; ++w) {
+    const size_t end = (std::min)(begin + chunk, count);
+    threads.emplace_back([&transforms, &viewProj, out, begin, end] {
+      ComputeRange(transforms, begin, end, viewProj, out);
+    });
+    begin = end;
+  }
+  ComputeRange(transforms, begin, count, viewProj, out);
+  for (auto &t : threads) {
+    t.join();
+  }
+}
+
+void ComputeTransformationMatrices(const Transform *transforms, size_t count,
+                                   const Matrix4x4 &viewProj,
+                                   TransformationMatrix *out,
+                                   uint32_t workerCount) {
+  thread_local TransformBatchSoA scratch;
+  scratch.Resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    scratch.Set(i, transforms[i]);
+  }
+  ComputeTransformationMatrices(scratch, viewProj, out, workerCount);
+}
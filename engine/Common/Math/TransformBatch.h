@@ -0,0 +1,47 @@
+#pragma once
+#include "MathTypes.h"
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// Transform の一括行列計算
+//==================================
+// N 個の Transform と 1 つの view*proj から N 個の TransformationMatrix を作る。
+// 内部は SoA で 4 個ずつ SSE2 処理し、回転は MakeAffineMatrix と同じ
+// X*Y*Z 順のオイラー角を閉じた式で展開している（sin/cos も SIMD 近似）。
+// クォータニオンの要素はオイラー角を経由せず、そのまま行列にする。
+// 4 に満たない端数も一時領域に詰めて同じカーネルを通す（位置で結果が
+// 変わらない）。
+
+// 成分ごとに連続配置した Transform 列
+// useQuaternion[i] が ~0u なら rotateX/Y/Z/W はクォータニオン、
+// 0 なら rotateX/Y/Z がオイラー角（rotateW は使わない）
+struct TransformBatchSoA {
+  std::vector<float> scaleX, scaleY, scaleZ;
+  std::vector<float> rotateX, rotateY, rotateZ, rotateW;
+  std::vector<float> translateX, translateY, translateZ;
+  std::vector<uint32_t> useQuaternion; // SIMD でそのままマスクに使う
+
+  size_t Size() const { return scaleX.size(); }
+  void Resize(size_t count);
+  void Clear() { Resize(0); }
+
+  void Set(size_t index, const Transform &t);
+  Transform Get(size_t index) const;
+  void Push(const Transform &t);
+};
+
+// SoA 版（ホットループ用）
+// workerCount > 1 なら 4 の倍数単位で分割してスレッド実行する
+void ComputeTransformationMatrices(const TransformBatchSoA &transforms,
+                                   const Matrix4x4 &viewProj,
+                                   TransformationMatrix *out,
+                                   uint32_t workerCount = 1);
+
+// AoS 版（内部でスレッドローカルの SoA に詰め替えてから計算）
+void ComputeTransformationMatrices(const Transform *transforms, size_t count,
+                                   const Matrix4x4 &viewProj,
+                                   TransformationMatrix *out,
+                                   uint32_t workerCount = 1);
@@ -0,0 +1,403 @@
+#include "TriangleBvh.h"
+#include "Math.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <thread>
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+// SAH のビン数
+constexpr int kBinCount = 16;
+// これ以下の三角形数なら分割しない
+constexpr uint32_t kMinLeafSize = 2;
+// SAH が葉を選んでもこれを超えるなら分割する
+constexpr uint32_t kMaxLeafSize = 8;
+// ノード 1 段をたどるコスト（三角形 1 枚の判定を 1 とした相対値）
+constexpr float kTraversalCost = 1.0f;
+// これ以上深くはしない（走査スタックの上限に合わせる）
+constexpr uint32_t kMaxDepth = 60;
+// 部分木をスレッドに分ける最小三角形数
+constexpr uint32_t kParallelMinTriangles = 4096;
+
+struct Box {
+  Vector3 min = {kInfinity, kInfinity, kInfinity};
+  Vector3 max = {-kInfinity, -kInfinity, -kInfinity};
+
+  void Grow(const Vector3 &p) {
+    min = {(std::min)(min.x, p.x), (std::min)(min.y, p.y),
+           (std::min)(min.z, p.z)};
+    max = {(std::max)(max.x, p.x), (std::max)(max.y, p.y),
+           (std::max)(max.z, p.z)};
+  }
+  void Grow(const Box &b) {
+    Grow(b.min);
+    Grow(b.max);
+  }
+  float HalfArea() const {
+    if (min.x > max.x) {
+      return 0.0f;
+    }
+    const Vector3 e = Subtract(max, min);
+    return e.x * e.y + e.y * e.z + e.z * e.x;
+  }
+};
+
+float Axis(const Vector3 &v, int axis) {
+  return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+// ノード AABB とのスラブ判定（当たれば範囲内の入射 t、外れなら ∞）
+float NodeEntry(const RayQuery &ray, const Vector3 &inv, const Vector3 &min,
+                const Vector3 &max) {
+  const float tx1 = (min.x - ray.origin.x) * inv.x;
+  const float tx2 = (max.x - ray.origin.x) * inv.x;
+  const float ty1 = (min.y - ray.origin.y) * inv.y;
+  const float ty2 = (max.y - ray.origin.y) * inv.y;
+  const float tz1 = (min.z - ray.origin.z) * inv.z;
+  const float tz2 = (max.z - ray.origin.z) * inv.z;
+  const float tNear = (std::max)((std::max)((std::min)(tx1, tx2),
+                                            (std::min)(ty1, ty2)),
+                                 (std::min)(tz1, tz2));
+  const float tFar = (std::min)((std::min)((std::max)(tx1, tx2),
+                                           (std::max)(ty1, ty2)),
+                                (std::max)(tz1, tz2));
+  if (tNear <= tFar && tFar >= ray.tMin && tNear <= ray.tMax) {
+    return (std::max)(tNear, ray.tMin);
+  }
+  return kInfinity;
+}
+
+} // namespace
+
+//==================================
+// 構築
+//==================================
+
+// 構築中だけ使う三角形ごとの情報
+struct TriangleBvh::BuildInput {
+  std::vector<Box> bounds;
+  std::vector<Vector3> centroids;
+  std::vector<uint32_t> ids; // 部分木ごとに担当範囲だけを並べ替える
+};
+
+void TriangleBvh::Build(const Vector3 *vertices, const uint32_t *indices,
+                        size_t triangleCount, uint32_t workerCount) {
+  Clear();
+  if (triangleCount == 0) {
+    return;
+  }
+  assert(triangleCount <= (std::numeric_limits<uint32_t>::max)());
+
+  auto vertexOf = [&](size_t tri, int corner) -> const Vector3 & {
+    const size_t i = tri * 3 + corner;
+    return vertices[indices ? indices[i] : i];
+  };
+
+  BuildInput in;
+  in.bounds.resize(triangleCount);
+  in.centroids.resize(triangleCount);
+  in.ids.resize(triangleCount);
+  for (size_t t = 0; t < triangleCount; ++t) {
+    Box b;
+    b.Grow(vertexOf(t, 0));
+    b.Grow(vertexOf(t, 1));
+    b.Grow(vertexOf(t, 2));
+    in.bounds[t] = b;
+    in.centroids[t] = Multiply(Add(b.min, b.max), 0.5f);
+    in.ids[t] = uint32_t(t);
+  }
+
+  // workerCount 本まで枝分かれするように並列化する深さを決める
+  uint32_t parallelDepth = 0;
+  while ((1u << parallelDepth) < workerCount) {
+    ++parallelDepth;
+  }
+
+  nodes_.reserve(triangleCount * 2 / kMinLeafSize);
+  nodes_.resize(1);
+  BuildNode(in, nodes_, 0, 0, uint32_t(triangleCount), 0, parallelDepth);
+  nodes_.shrink_to_fit();
+
+  // 葉の順に三角形をコピー
+  triangleIds_ = std::move(in.ids);
+  vertices_.resize(triangleCount * 3);
+  for (size_t k = 0; k < triangleCount; ++k) {
+    for (int c = 0; c < 3; ++c) {
+      vertices_[k * 3 + c] = vertexOf(triangleIds_[k], c);
+    }
+  }
+}
+
+void TriangleBvh::BuildNode(BuildInput &in, std::vector<Node> &nodes,
+                            uint32_t nodeIndex, uint32_t first,
+                            uint32_t count, uint32_t depth,
+                            uint32_t parallelDepth) {
+  struct Task {
+    uint32_t nodeIndex, first, count, depth;
+  };
+
+  // 右の子はこの関数内でループ処理し、左の子だけ再帰（またはスレッド）にする
+  Task task = {nodeIndex, first, count, depth};
+  std::vector<std::thread> threads;
+  std::vector<std::vector<Node>> subtrees;
+  std::vector<uint32_t> subtreeSlots;
+  subtrees.reserve(parallelDepth);
+
+  for (;;) {
+    Box nodeBounds, centroidBounds;
+    for (uint32_t i = task.first; i < task.first + task.count; ++i) {
+      nodeBounds.Grow(in.bounds[in.ids[i]]);
+      centroidBounds.Grow(in.centroids[in.ids[i]]);
+    }
+
+    Node &node = nodes[task.nodeIndex];
+    node.min = nodeBounds.min;
+    node.max = nodeBounds.max;
+
+    // ---- SAH でもっとも安い分割を探す ----
+    int bestAxis = -1;
+    int bestSplit = 0;
+    float bestCost = kInfinity;
+    if (task.count > kMinLeafSize && task.depth < kMaxDepth) {
+      for (int axis = 0; axis < 3; ++axis) {
+        const float lo = Axis(centroidBounds.min, axis);
+        const float extent = Axis(centroidBounds.max, axis) - lo;
+        if (!(extent > 0.0f)) {
+          continue;
+        }
+        const float scale = float(kBinCount) / extent;
+
+        Box binBounds[kBinCount];
+        uint32_t binCount[kBinCount] = {};
+        for (uint32_t i = task.first; i < task.first + task.count; ++i) {
+          const uint32_t id = in.ids[i];
+          const int b = (std::min)(
+              kBinCount - 1, int((Axis(in.centroids[id], axis) - lo) * scale));
+          binBounds[b].Grow(in.bounds[id]);
+          ++binCount[b];
+        }
+
+        // 右側からの累積面積を先に求め、左から掃引する
+        float rightArea[kBinCount];
+        uint32_t rightCount[kBinCount];
+        Box acc;
+        uint32_t accCount = 0;
+        for (int b = kBinCount - 1; b > 0; --b) {
+          acc.Grow(binBounds[b]);
+          accCount += binCount[b];
+          rightArea[b] = acc.HalfArea();
+          rightCount[b] = accCount;
+        }
+        acc = Box();
+        accCount = 0;
+        for (int b = 0; b < kBinCount - 1; ++b) {
+          acc.Grow(binBounds[b]);
+          accCount += binCount[b];
+          if (accCount == 0 || rightCount[b + 1] == 0) {
+            continue;
+          }
+          const float cost = float(accCount) * acc.HalfArea() +
+                             float(rightCount[b + 1]) * rightArea[b + 1];
+          if (cost < bestCost) {
+            bestCost = cost;
+            bestAxis = axis;
+            bestSplit = b;
+          }
+        }
+      }
+    }
+
+    const float parentArea = nodeBounds.HalfArea();
+    const float leafCost = float(task.count) * parentArea;
+    const float splitCost = kTraversalCost * parentArea + bestCost;
+    const bool makeLeaf =
+        bestAxis < 0 || (splitCost >= leafCost && task.count <= kMaxLeafSize);
+    if (makeLeaf) {
+      node.leftFirst = task.first;
+      node.count = task.count;
+      break;
+    }
+
+    // ---- 分割 ----
+    const float lo = Axis(centroidBounds.min, bestAxis);
+    const float scale =
+        float(kBinCount) / (Axis(centroidBounds.max, bestAxis) - lo);
+    uint32_t *begin = in.ids.data() + task.first;
+    uint32_t *mid = std::partition(begin, begin + task.count, [&](uint32_t id) {
+      const int b = (std::min)(
+          kBinCount - 1, int((Axis(in.centroids[id], bestAxis) - lo) * scale));
+      return b <= bestSplit;
+    });
+    const uint32_t leftCount = uint32_t(mid - begin);
+
+    const uint32_t leftIndex = uint32_t(nodes.size());
+    nodes.resize(nodes.size() + 2);
+    nodes[task.nodeIndex].leftFirst = leftIndex;
+    nodes[task.nodeIndex].count = 0;
+
+    const Task left = {leftIndex, task.first, leftCount, task.depth + 1};
+    const Task right = {leftIndex + 1, task.first + leftCount,
+                        task.count - leftCount, task.depth + 1};
+
+    if (subtrees.size() < parallelDepth &&
+        task.count >= kParallelMinTriangles) {
+      // 左の部分木は別スレッドで独立した配列に作り、後で連結する
+      subtrees.emplace_back();
+      subtreeSlots.push_back(leftIndex);
+      std::vector<Node> *out = &subtrees.back();
+      const uint32_t remaining = parallelDepth - uint32_t(subtrees.size());
+      threads.emplace_back([&in, out, left, remaining] {
+        out->resize(1);
+        BuildNode(in, *out, 0, left.first, left.count, left.depth, remaining);
+      });
+    } else {
+      BuildNode(in, nodes, left.nodeIndex, left.first, left.count, left.depth,
+                0);
+    }
+    task = right;
+  }
+
+  for (size_t s = 0; s < threads.size(); ++s) {
+    threads[s].join();
+
+    // 部分木の 0 番を予約済みの枠へ、残りを末尾へ移し、子の番号を付け替える
+    const std::vector<Node> &sub = subtrees[s];
+    const uint32_t base = uint32_t(nodes.size());
+    auto relocate = [base](Node n) {
+      if (n.count == 0) {
+        n.leftFirst = base + n.leftFirst - 1;
+      }
+      return n;
+    };
+    nodes[subtreeSlots[s]] = relocate(sub[0]);
+    for (size_t k = 1; k < sub.size(); ++k) {
+      nodes.push_back(relocate(sub[k]));
+    }
+  }
+}
+
+void TriangleBvh::Clear() {
+  nodes_.clear();
+  vertices_.clear();
+  triangleIds_.clear();
+}
+
+AABB TriangleBvh::Bounds() const {
+  AABB aabb;
+  if (nodes_.empty()) {
+    aabb.min = {0.0f, 0.0f, 0.0f};
+    aabb.max = {0.0f, 0.0f, 0.0f};
+  } else {
+    aabb.min = nodes_[0].min;
+    aabb.max = nodes_[0].max;
+  }
+  return aabb;
+}
+
+//==================================
+// 判定
+//==================================
+
+bool TriangleBvh::RaycastClosest(const RayQuery &ray, RayHit *outHit,
+                                 uint32_t *outTriangle) const {
+  if (nodes_.empty()) {
+    return false;
+  }
+  const Vector3 inv = {1.0f / ray.diff.x, 1.0f / ray.diff.y,
+                       1.0f / ray.diff.z};
+  if (NodeEntry(ray, inv, nodes_[0].min, nodes_[0].max) == kInfinity) {
+    return false;
+  }
+
+  // 当たるたびに tMax を縮め、それより奥のノードは入らない
+  RayQuery query = ray;
+  RayHit hit;
+  int64_t bestTriangle = -1;
+
+  struct Entry {
+    uint32_t node;
+    float t; // ノードへの入射 t
+  };
+  Entry stack[kMaxDepth + 4];
+  uint32_t sp = 0;
+  stack[sp++] = {0, ray.tMin};
+  while (sp > 0) {
+    const Entry entry = stack[--sp];
+    if (entry.t > query.tMax) {
+      continue; // 積んだ後で更に近い交差が見つかった
+    }
+    const Node &node = nodes_[entry.node];
+    if (node.count > 0) {
+      for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+        const Vector3 *v = &vertices_[size_t(i) * 3];
+        if (Raycast(query, v[0], v[1], v[2], &hit)) {
+          query.tMax = hit.t;
+          bestTriangle = i;
+        }
+      }
+      continue;
+    }
+
+    // 近い子を後に積んで先に処理する
+    uint32_t nearChild = node.leftFirst;
+    uint32_t farChild = node.leftFirst + 1;
+    float tNear = NodeEntry(query, inv, nodes_[nearChild].min,
+                            nodes_[nearChild].max);
+    float tFar =
+        NodeEntry(query, inv, nodes_[farChild].min, nodes_[farChild].max);
+    if (tFar < tNear) {
+      std::swap(nearChild, farChild);
+      std::swap(tNear, tFar);
+    }
+    if (tFar != kInfinity) {
+      stack[sp++] = {farChild, tFar};
+    }
+    if (tNear != kInfinity) {
+      stack[sp++] = {nearChild, tNear};
+    }
+  }
+
+  if (bestTriangle < 0) {
+    return false;
+  }
+  if (outHit) {
+    *outHit = hit;
+  }
+  if (outTriangle) {
+    *outTriangle = triangleIds_[size_t(bestTriangle)];
+  }
+  return true;
+}
+
+bool TriangleBvh::RaycastAny(const RayQuery &ray) const {
+  if (nodes_.empty()) {
+    return false;
+  }
+  const Vector3 inv = {1.0f / ray.diff.x, 1.0f / ray.diff.y,
+                       1.0f / ray.diff.z};
+
+  uint32_t stack[kMaxDepth + 4];
+  uint32_t sp = 0;
+  stack[sp++] = 0;
+  while (sp > 0) {
+    const Node &node = nodes_[stack[--sp]];
+    if (NodeEntry(ray, inv, node.min, node.max) == kInfinity) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (uint32_t i = node.leftFirst; i < node.leftFirst + node.count; ++i) {
+        const Vector3 *v = &vertices_[size_t(i) * 3];
+        if (Raycast(ray, v[0], v[1], v[2])) {
+          return true;
+        }
+      }
+      continue;
+    }
+    stack[sp++] = node.leftFirst + 1;
+    stack[sp++] = node.leftFirst;
+  }
+  return false;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "MathTypes.h"
+#include "RayQuery.h"
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 三角形 BVH（ピッキング・レイキャスト用）
+//==================================
+// ビン分割の SAH でトップダウンに構築する。葉の三角形は葉の順に並べ替えて
+// コピーして持つので、元の頂点配列は構築後に捨ててよい。
+// 判定はオブジェクト空間のまま行う（座標変換は呼び出し側、Model3D::Raycast 参照）。
+
+class TriangleBvh {
+public:
+  // indices == nullptr なら vertices を 3 個ずつの三角形リストとして扱う
+  // workerCount > 1 なら上位の分割で左右の部分木をスレッドに分けて構築する
+  void Build(const Vector3 *vertices, const uint32_t *indices,
+             size_t triangleCount, uint32_t workerCount = 1);
+  void Clear();
+
+  // 最も近い交差（outTriangle は元の三角形番号）
+  bool RaycastClosest(const RayQuery &ray, RayHit *outHit = nullptr,
+                      uint32_t *outTriangle = nullptr) const;
+  // どれか 1 つでも当たれば true（遮蔽判定用、最も近いとは限らない）
+  bool RaycastAny(const RayQuery &ray) const;
+
+  bool Empty() const { return nodes_.empty(); }
+  size_t TriangleCount() const { return triangleIds_.size(); }
+  size_t NodeCount() const { return nodes_.size(); }
+  // 全体の AABB（空なら原点の点）
+  AABB Bounds() const;
+
+private:
+  // 32 byte。count > 0 なら葉（first から count 個）、0 なら内部ノード
+  // （子は leftFirst と leftFirst + 1）
+  struct Node {
+    Vector3 min;
+    uint32_t leftFirst;
+    Vector3 max;
+    uint32_t count;
+  };
+
+  struct BuildInput;
+  static void BuildNode(BuildInput &in, std::vector<Node> &nodes,
+                        uint32_t nodeIndex, uint32_t first, uint32_t count,
+                        uint32_t depth, uint32_t parallelDepth);
+
+  std::vector<Node> nodes_;
+  // 葉の順に並べた三角形（v0, v1, v2）と元の番号
+  std::vector<Vector3> vertices_;
+  std::vector<uint32_t> triangleIds_;
+};
@@ -52,6 +52,52 @@ ID3D12Resource *CreateTextureResource(ID3D12Device *device,
   return resource;
 }
 
+ID3D12Resource *CreateDefaultBufferResource(ID3D12Device *device,
+                                            size_t sizeInBytes) {
+  D3D12_HEAP_PROPERTIES heapProperties{};
+  heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+  D3D12_RESOURCE_DESC bufferDesc{};
+  bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+  bufferDesc.Width = sizeInBytes;
+  bufferDesc.Height = 1;
+  bufferDesc.DepthOrArraySize = 1;
+  bufferDesc.MipLevels = 1;
+  bufferDesc.SampleDesc.Count = 1;
+  bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+  // コピーキューでも描画キューでも暗黙の遷移で使えるよう COMMON で作る
+  ID3D12Resource *buffer = nullptr;
+  HRESULT hr = device->CreateCommittedResource(
+      &heapProperties, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+      D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&buffer));
+  assert(SUCCEEDED(hr));
+  return buffer;
+}
+
+ID3D12Resource *
+CreateDefaultTextureResource(ID3D12Device *device,
+                             const DirectX::TexMetadata &metadata) {
+  D3D12_RESOURCE_DESC resourceDesc{};
+  resourceDesc.Width = UINT(metadata.width);
+  resourceDesc.Height = UINT(metadata.height);
+  resourceDesc.MipLevels = UINT16(metadata.mipLevels);
+  resourceDesc.DepthOrArraySize = UINT16(metadata.arraySize);
+  resourceDesc.Format = metadata.format;
+  resourceDesc.SampleDesc.Count = 1;
+  resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION(metadata.dimension);
+
+  D3D12_HEAP_PROPERTIES heapProperties{};
+  heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+  ID3D12Resource *resource = nullptr;
+  HRESULT hr = device->CreateCommittedResource(
+      &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc,
+      D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&resource));
+  assert(SUCCEEDED(hr));
+  return resource;
+}
+
 IDxcBlob *CompileShader(
     // CompilerするShaderファイルへのパス
     const std::wstring &filePath,
@@ -8,6 +8,13 @@
 // バッファリソース作成
 ID3D12Resource *CreateBufferResource(ID3D12Device *device, size_t sizeInBytes);
 
+// DEFAULT ヒープに COMMON で作る（中身は UploadManager で写す）
+ID3D12Resource *CreateDefaultBufferResource(ID3D12Device *device,
+                                            size_t sizeInBytes);
+ID3D12Resource *
+CreateDefaultTextureResource(ID3D12Device *device,
+                             const DirectX::TexMetadata &metadata);
+
 IDxcBlob *CompileShader(
     // CompilerするShaderファイルへのパス
     const std::wstring &filePath,
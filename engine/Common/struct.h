@@ -2,7 +2,6 @@
 #include <cstdint>
 #include <vector>
 #include <string>
-#include <windows.h>
 #include "Math/MathTypes.h"
 
 // printf関数の表示位置
@@ -11,8 +10,11 @@ static const int kColumnWidth = 60;
 
 struct Transform {
   Vector3 scale;
-  Vector3 rotation;
+  Vector3 rotation; // オイラー角（X→Y→Z の順に適用）
   Vector3 translation;
+  // useQuaternion=true のときは rotation の代わりに quaternion を使う
+  Quaternion quaternion = {0.0f, 0.0f, 0.0f, 1.0f};
+  bool useQuaternion = false;
 };
 
 // 球
@@ -90,10 +92,21 @@ struct DirectionalLight {
 };
 
 struct MaterialData {
+  std::string name;            // newmtl の名前
   std::string textureFilePath; // テクスチャファイルのパス
 };
 
+// 部分メッシュ（インデックスの範囲と使うマテリアル）
+struct MeshSubset {
+  uint32_t indexStart = 0;
+  uint32_t indexCount = 0;
+  int32_t materialIndex = -1; // ModelData::materials の番号（-1 は指定なし）
+};
+
 struct ModelData {
   std::vector<VertexData> vertices; // 頂点データの配列
-  MaterialData material;            // マテリアルデータ
+  MaterialData material;            // マテリアルデータ（最後の map_Kd）
+  std::vector<MaterialData> materials; // mtllib で定義された全マテリアル
+  // o / g / usemtl で区切った範囲（vertices の番号、ファイル順）
+  std::vector<MeshSubset> subsets;
 };
@@ -35,6 +35,10 @@ public:
   ID3D12GraphicsCommandList *List() const { return list_; }
   uint32_t FrameCount() const { return frameCount_; }
 
+  // フェンス値（UploadRing などフレーム単位で使い回すものの回収に使う）
+  uint64_t CompletedFenceValue() const { return fence_->GetCompletedValue(); }
+  uint64_t LastSignaledFenceValue() const { return globalFenceValue_; }
+
 private:
   ID3D12Device *device_ = nullptr;
   D3D12_COMMAND_LIST_TYPE type_ = D3D12_COMMAND_LIST_TYPE_DIRECT;
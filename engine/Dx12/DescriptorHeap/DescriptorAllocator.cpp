@@ -0,0 +1,148 @@
+#include "DescriptorAllocator.h"
+#include <algorithm>
+#include <cassert>
+
+void DescriptorAllocator::Init(uint32_t persistentCapacity,
+                               uint32_t transientCapacity) {
+  persistentCapacity_ = persistentCapacity;
+  used_ = 0;
+  freeRanges_.clear();
+  if (persistentCapacity_ > 0) {
+    freeRanges_.push_back({0, persistentCapacity_});
+  }
+  generation_.assign(persistentCapacity_, 1);
+  blockCount_.assign(persistentCapacity_, 0);
+  framePending_.clear();
+  pending_.clear();
+  pendingCount_ = 0;
+  transient_.Init(transientCapacity);
+
+  stats_ = {};
+  stats_.persistentCapacity = persistentCapacity_;
+  stats_.transientCapacity = transientCapacity;
+  UpdateFreeStats_();
+}
+
+DescriptorHandle DescriptorAllocator::Allocate(uint32_t count) {
+  assert(count > 0);
+  // 先頭一致（小さい番号から詰める）
+  for (size_t i = 0; i < freeRanges_.size(); ++i) {
+    Range &range = freeRanges_[i];
+    if (range.count < count)
+      continue;
+
+    const uint32_t start = range.start;
+    range.start += count;
+    range.count -= count;
+    if (range.count == 0) {
+      freeRanges_.erase(freeRanges_.begin() + i);
+    }
+
+    blockCount_[start] = count;
+    used_ += count;
+    stats_.persistentUsed = used_;
+    stats_.persistentPeak = (std::max)(stats_.persistentPeak, used_);
+    UpdateFreeStats_();
+    return {start, generation_[start]};
+  }
+
+  ++stats_.failedAllocations;
+  return {};
+}
+
+bool DescriptorAllocator::IsValid(DescriptorHandle handle) const {
+  return handle.index < persistentCapacity_ &&
+         blockCount_[handle.index] != 0 &&
+         generation_[handle.index] == handle.generation;
+}
+
+uint32_t DescriptorAllocator::CountOf(DescriptorHandle handle) const {
+  return IsValid(handle) ? blockCount_[handle.index] : 0;
+}
+
+void DescriptorAllocator::Free(DescriptorHandle handle) {
+  if (!handle)
+    return;
+  if (!IsValid(handle)) {
+    // 二重解放・古いハンドル（番号はもう別の持ち主のものかもしれない）
+    ++stats_.staleFrees;
+    return;
+  }
+
+  const uint32_t count = blockCount_[handle.index];
+  blockCount_[handle.index] = 0;
+  // ここで世代を進めるので、残っているコピーはすぐ無効になる
+  ++generation_[handle.index];
+  framePending_.push_back({handle.index, count});
+  pendingCount_ += count;
+  stats_.pendingFree = pendingCount_;
+}
+
+uint32_t DescriptorAllocator::AllocateTransient(uint32_t count) {
+  const uint64_t offset = transient_.Allocate(count, 1);
+  if (offset == RingAllocator::kInvalidOffset)
+    return kInvalidIndex;
+  return persistentCapacity_ + static_cast<uint32_t>(offset);
+}
+
+void DescriptorAllocator::BeginFrame(uint64_t completedFenceValue) {
+  while (!pending_.empty() &&
+         pending_.front().fenceValue <= completedFenceValue) {
+    for (const Range &range : pending_.front().ranges) {
+      Release_(range);
+    }
+    pending_.pop_front();
+  }
+  transient_.BeginFrame(completedFenceValue);
+
+  stats_.persistentUsed = used_;
+  stats_.pendingFree = pendingCount_;
+  UpdateFreeStats_();
+}
+
+void DescriptorAllocator::EndFrame(uint64_t fenceValue) {
+  if (!framePending_.empty()) {
+    assert(pending_.empty() || pending_.back().fenceValue <= fenceValue);
+    pending_.push_back({fenceValue, std::move(framePending_)});
+    framePending_.clear();
+  }
+  transient_.EndFrame(fenceValue);
+
+  const RingAllocator::Stats &ring = transient_.GetStats();
+  stats_.transientFrameUsed = static_cast<uint32_t>(ring.frameBytes);
+  stats_.transientFrameOverflows = ring.frameOverflows;
+}
+
+void DescriptorAllocator::Release_(const Range &range) {
+  used_ -= range.count;
+  pendingCount_ -= range.count;
+
+  auto it = std::lower_bound(
+      freeRanges_.begin(), freeRanges_.end(), range.start,
+      [](const Range &r, uint32_t start) { return r.start < start; });
+  it = freeRanges_.insert(it, range);
+
+  // 後ろとつなげる
+  auto next = it + 1;
+  if (next != freeRanges_.end() && it->start + it->count == next->start) {
+    it->count += next->count;
+    freeRanges_.erase(next);
+  }
+  // 前とつなげる
+  if (it != freeRanges_.begin()) {
+    auto prev = it - 1;
+    if (prev->start + prev->count == it->start) {
+      prev->count += it->count;
+      freeRanges_.erase(it);
+    }
+  }
+}
+
+void DescriptorAllocator::UpdateFreeStats_() {
+  stats_.freeRanges = static_cast<uint32_t>(freeRanges_.size());
+  uint32_t largest = 0;
+  for (const Range &range : freeRanges_) {
+    largest = (std::max)(largest, range.count);
+  }
+  stats_.largestFreeRange = largest;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "UploadRing/RingAllocator.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// 常駐領域から切り出したディスクリプタ（index は常駐領域の先頭からの番号）
+// generation は解放のたびに進むので、解放済みのハンドルは IsValid で弾ける
+struct DescriptorHandle {
+  static constexpr uint32_t kInvalidIndex = ~0u;
+  uint32_t index = kInvalidIndex;
+  uint32_t generation = 0;
+
+  explicit operator bool() const { return index != kInvalidIndex; }
+};
+
+//==================================
+// ディスクリプタの割り当て（D3D 非依存、番号の管理だけ）
+//==================================
+// [0, persistent) は常駐領域：空き範囲のリスト（番号順、隣とはくっつける）
+// から先頭一致で切り出す。Free した範囲はすぐには戻さず、そのフレームを
+// EndFrame で閉じたときのフェンス値が BeginFrame の完了値に達してから戻す
+// （GPU が読み終えるまで同じ番号を使い回さない）。
+// [persistent, persistent + transient) はフレームごとの一時領域：
+// RingAllocator で個数単位に切り出し、フェンスで回収する（動的テーブル用）。
+// フェンス値はただの数値として扱うので、GPU なしで確かめられる。
+class DescriptorAllocator {
+public:
+  static constexpr uint32_t kInvalidIndex = DescriptorHandle::kInvalidIndex;
+
+  struct Stats {
+    uint32_t persistentCapacity = 0;
+    uint32_t persistentUsed = 0; // 解放待ちを含む
+    uint32_t persistentPeak = 0;
+    uint32_t pendingFree = 0;      // GPU の完了待ちの個数
+    uint32_t freeRanges = 0;       // 空き範囲の数（断片化の目安）
+    uint32_t largestFreeRange = 0;
+    uint32_t failedAllocations = 0; // 常駐領域に入らなかった回数
+    uint32_t staleFrees = 0;        // 解放済みハンドルを Free した回数
+
+    uint32_t transientCapacity = 0;
+    uint32_t transientFrameUsed = 0;      // 直近に閉じたフレームの個数
+    uint32_t transientFrameOverflows = 0; // 直近に閉じたフレーム
+  };
+
+  void Init(uint32_t persistentCapacity, uint32_t transientCapacity = 0);
+
+  // 常駐領域から count 個を連続で切り出す（入らなければ無効なハンドル）
+  DescriptorHandle Allocate(uint32_t count = 1);
+  // 解放を予約する（番号が戻るのはこのフレームの GPU 完了後）
+  void Free(DescriptorHandle handle);
+  // まだ生きているハンドルか（解放済み・世代違いは false）
+  bool IsValid(DescriptorHandle handle) const;
+  // Allocate したときの個数（無効なら 0）
+  uint32_t CountOf(DescriptorHandle handle) const;
+
+  // 一時領域から count 個を連続で切り出し、ヒープ全体での番号を返す
+  // （そのフレームの間だけ有効。入らなければ kInvalidIndex）
+  uint32_t AllocateTransient(uint32_t count);
+
+  // 完了したフェンス値までのフレームの解放・一時領域を回収する
+  void BeginFrame(uint64_t completedFenceValue);
+  // 今フレームの解放と一時領域を fenceValue の分として閉じる
+  void EndFrame(uint64_t fenceValue);
+
+  const Stats &GetStats() const { return stats_; }
+
+private:
+  struct Range {
+    uint32_t start;
+    uint32_t count;
+  };
+  struct PendingFrame {
+    uint64_t fenceValue;
+    std::vector<Range> ranges;
+  };
+
+  // 空きリストへ戻す（前後の空きとつなげる）
+  void Release_(const Range &range);
+  void UpdateFreeStats_();
+
+  uint32_t persistentCapacity_ = 0;
+  uint32_t used_ = 0;
+
+  std::vector<Range> freeRanges_; // start の昇順
+  // 範囲の先頭の番号ごと（途中の番号は使わない）
+  std::vector<uint32_t> generation_;
+  std::vector<uint32_t> blockCount_; // 0 なら生きていない
+
+  std::vector<Range> framePending_; // 今フレームに Free された分
+  std::deque<PendingFrame> pending_;
+  uint32_t pendingCount_ = 0;
+
+  RingAllocator transient_;
+
+  Stats stats_{};
+};
@@ -1,15 +1,18 @@
 #include "DescriptorHeap.h"
 
 void DescriptorHeap::Init(ID3D12Device *device, D3D12_DESCRIPTOR_HEAP_TYPE type,
-                          UINT capacity, bool shaderVisible) {
+                          UINT capacity, bool shaderVisible,
+                          UINT transientCapacity) {
   assert(device && capacity > 0);
   device_ = device;
   type_ = type;
   capacity_ = capacity;
+  transientCapacity_ = transientCapacity;
+  alloc_.Init(capacity_, transientCapacity_);
 
   D3D12_DESCRIPTOR_HEAP_DESC desc{};
   desc.Type = type_;
-  desc.NumDescriptors = capacity_;
+  desc.NumDescriptors = capacity_ + transientCapacity_;
   desc.Flags = shaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE
                              : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 
@@ -29,28 +32,69 @@ void DescriptorHeap::Term() {
     heap_ = nullptr;
   }
   device_ = nullptr;
-  offset_ = 0;
+  alloc_.Init(0);
+}
+
+void DescriptorHeap::BeginFrame(uint64_t completedFenceValue) {
+  alloc_.BeginFrame(completedFenceValue);
+}
+
+void DescriptorHeap::EndFrame(uint64_t fenceValue) {
+  alloc_.EndFrame(fenceValue);
+}
+
+DescriptorHandle DescriptorHeap::Allocate(UINT count) {
+  const DescriptorHandle handle = alloc_.Allocate(count);
+  assert(handle && "Descriptor heap exhausted");
+  return handle;
+}
+
+void DescriptorHeap::Free(DescriptorHandle handle) {
+  // Term 済み（シーンより先にヒープを片付けた場合など）は何もしない
+  if (!heap_)
+    return;
+  alloc_.Free(handle);
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeap::CPU(DescriptorHandle handle,
+                                                UINT i) const {
+  assert(alloc_.IsValid(handle) && i < alloc_.CountOf(handle));
+  return CPUAt(handle.index + i);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorHeap::GPU(DescriptorHandle handle,
+                                                UINT i) const {
+  assert(alloc_.IsValid(handle) && i < alloc_.CountOf(handle));
+  return GPUAt(handle.index + i);
 }
 
 // 1つ（または複数）ぶん確保して、先頭のCPUハンドルを返す
 // 返り値 + i*Increment() で連番分を使えます
 D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeap::AllocateCPU(UINT count) {
-  assert(offset_ + count <= capacity_ && "Descriptor heap exhausted");
-  D3D12_CPU_DESCRIPTOR_HANDLE h = cpuStart_;
-  h.ptr += static_cast<SIZE_T>(offset_) * static_cast<SIZE_T>(inc_);
-  offset_ += count;
-  return h;
+  return CPUAt(Allocate(count).index);
+}
+
+DescriptorSpan DescriptorHeap::AllocateTransient(UINT count) {
+  const uint32_t index = alloc_.AllocateTransient(count);
+  if (index == DescriptorAllocator::kInvalidIndex)
+    return {};
+  DescriptorSpan span;
+  span.cpu = CPUAt(index);
+  if (shaderVisible_)
+    span.gpu = GPUAt(index);
+  span.count = count;
+  return span;
 }
 
 // 任意のインデックスのCPU/GPUハンドル（読み直し用）
 D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeap::CPUAt(UINT index) const {
-  assert(index < capacity_);
+  assert(index < capacity_ + transientCapacity_);
   D3D12_CPU_DESCRIPTOR_HANDLE h = cpuStart_;
   h.ptr += static_cast<SIZE_T>(index) * static_cast<SIZE_T>(inc_);
   return h;
 }
 D3D12_GPU_DESCRIPTOR_HANDLE DescriptorHeap::GPUAt(UINT index) const {
-  assert(shaderVisible_ && index < capacity_);
+  assert(shaderVisible_ && index < capacity_ + transientCapacity_);
   D3D12_GPU_DESCRIPTOR_HANDLE h = gpuStart_;
   h.ptr += static_cast<UINT64>(index) * static_cast<UINT64>(inc_);
   return h;
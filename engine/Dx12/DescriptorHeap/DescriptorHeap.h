@@ -1,19 +1,50 @@
 #pragma once
+#include "DescriptorHeap/DescriptorAllocator.h"
 #include <cassert>
 #include <cstdint>
 #include <d3d12.h>
 
+// 一時領域から切り出した連続ディスクリプタ（そのフレームの間だけ有効）
+struct DescriptorSpan {
+  D3D12_CPU_DESCRIPTOR_HANDLE cpu{};
+  D3D12_GPU_DESCRIPTOR_HANDLE gpu{}; // シェーダー可視のときだけ
+  UINT count = 0;
+
+  explicit operator bool() const { return count != 0; }
+};
+
+// ヒープは [常駐 capacity 個][一時 transientCapacity 個] に分けて使う
+// （割り当ての中身は DescriptorAllocator を参照）
 class DescriptorHeap {
 public:
   void Init(ID3D12Device *device, D3D12_DESCRIPTOR_HEAP_TYPE type,
-            UINT capacity, bool shaderVisible = false);
+            UINT capacity, bool shaderVisible = false,
+            UINT transientCapacity = 0);
 
   void Term();
 
+  // フレームの始めと終わり（Free した番号と一時領域をフェンスで回収する）
+  void BeginFrame(uint64_t completedFenceValue);
+  void EndFrame(uint64_t fenceValue);
+
+  // 常駐領域から count 個を連続で確保（足りなければ assert）
+  DescriptorHandle Allocate(UINT count = 1);
+  // GPU が使い終えてから番号を戻す。Term 後や無効なハンドルは何もしない
+  void Free(DescriptorHandle handle);
+  bool IsValid(DescriptorHandle handle) const {
+    return alloc_.IsValid(handle);
+  }
+  // ハンドルの i 番目の CPU/GPU ハンドル（生きていなければ assert）
+  D3D12_CPU_DESCRIPTOR_HANDLE CPU(DescriptorHandle handle, UINT i = 0) const;
+  D3D12_GPU_DESCRIPTOR_HANDLE GPU(DescriptorHandle handle, UINT i = 0) const;
+
   // 1つ（または複数）ぶん確保して、先頭のCPUハンドルを返す
-  // 返り値 + i*Increment() で連番分を使えます
+  // 返り値 + i*Increment() で連番分を使えます（解放しない用途：RTV/DSV など）
   D3D12_CPU_DESCRIPTOR_HANDLE AllocateCPU(UINT count = 1);
 
+  // 一時領域から count 個（動的なテーブル用。足りなければ count = 0）
+  DescriptorSpan AllocateTransient(UINT count);
+
   // 任意のインデックスのCPU/GPUハンドル（読み直し用）
   D3D12_CPU_DESCRIPTOR_HANDLE CPUAt(UINT index) const;
   D3D12_GPU_DESCRIPTOR_HANDLE GPUAt(UINT index) const;
@@ -22,16 +53,19 @@ public:
   UINT Increment() const { return inc_; }
   ID3D12DescriptorHeap *Heap() const { return heap_; }
   bool ShaderVisible() const { return shaderVisible_; }
-  UINT Capacity() const { return capacity_; }
-  UINT Used() const { return offset_; }
-  void Reset() { offset_ = 0; } // （※後述の“フレームリング”戦略と併用推奨）
+  UINT Capacity() const { return capacity_; } // 常駐領域の個数
+  UINT Used() const { return alloc_.GetStats().persistentUsed; }
+  const DescriptorAllocator::Stats &GetStats() const {
+    return alloc_.GetStats();
+  }
 
 private:
   ID3D12Device *device_ = nullptr;
   D3D12_DESCRIPTOR_HEAP_TYPE type_{};
   ID3D12DescriptorHeap *heap_ = nullptr;
-  UINT capacity_ = 0, inc_ = 0, offset_ = 0;
+  UINT capacity_ = 0, transientCapacity_ = 0, inc_ = 0;
   bool shaderVisible_ = false;
   D3D12_CPU_DESCRIPTOR_HANDLE cpuStart_{};
   D3D12_GPU_DESCRIPTOR_HANDLE gpuStart_{};
+  DescriptorAllocator alloc_;
 };
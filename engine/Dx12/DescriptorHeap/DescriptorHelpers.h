@@ -32,10 +32,10 @@ CreateDSV2D(ID3D12Device *device, DescriptorHeap &dsvHeap, ID3D12Resource *res,
 }
 
 // SRV（2D）: mipLevels は DirectXTex の metadata.mipLevels を渡すと便利
-inline D3D12_CPU_DESCRIPTOR_HANDLE
-CreateSRV2D(ID3D12Device *device, DescriptorHeap &srvHeap, ID3D12Resource *res,
-            DXGI_FORMAT fmt, UINT mipLevels, UINT mostDetailedMip = 0) {
-  auto h = srvHeap.AllocateCPU();
+// 書き込み先を自分で確保した場合（DescriptorHeap::Allocate など）はこちら
+inline void CreateSRV2DAt(ID3D12Device *device, D3D12_CPU_DESCRIPTOR_HANDLE h,
+                          ID3D12Resource *res, DXGI_FORMAT fmt, UINT mipLevels,
+                          UINT mostDetailedMip = 0) {
   D3D12_SHADER_RESOURCE_VIEW_DESC desc{};
   desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
   desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
@@ -44,6 +44,13 @@ CreateSRV2D(ID3D12Device *device, DescriptorHeap &srvHeap, ID3D12Resource *res,
   desc.Texture2D.MipLevels = mipLevels;
   desc.Texture2D.ResourceMinLODClamp = 0.0f;
   device->CreateShaderResourceView(res, &desc, h);
+}
+
+inline D3D12_CPU_DESCRIPTOR_HANDLE
+CreateSRV2D(ID3D12Device *device, DescriptorHeap &srvHeap, ID3D12Resource *res,
+            DXGI_FORMAT fmt, UINT mipLevels, UINT mostDetailedMip = 0) {
+  auto h = srvHeap.AllocateCPU();
+  CreateSRV2DAt(device, h, res, fmt, mipLevels, mostDetailedMip);
   return h;
 }
 
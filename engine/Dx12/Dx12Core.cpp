@@ -14,11 +14,16 @@ void Dx12Core::Init(HWND hwnd, const Desc &d) {
   // Command
   cmd_.Init(dev, D3D12_COMMAND_LIST_TYPE_DIRECT, d.frameCount);
 
+  // フレームごとの CB 用リング
+  upload_.Init(dev, d.uploadRingSize);
+  // テクスチャ等の転送用（コピーキュー）
+  uploader_.Init(dev, cmd_.Queue(), d.copyStagingSize);
+
   // Heaps
   rtv_.Init(dev, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, d.frameCount, false);
   dsv_.Init(dev, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 1, false);
   srv_.Init(dev, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, d.srvHeapCapacity,
-            true);
+            true, d.srvTransientCapacity);
 
   // SwapChain
   swap_.SetRtvHeap(rtv_.Heap(), rtv_.Increment());
@@ -50,6 +55,10 @@ void Dx12Core::Init(HWND hwnd, const Desc &d) {
 void Dx12Core::BeginFrame() {
   backIndex_ = swap_.CurrentBackBufferIndex();
   cmd_.BeginFrame(backIndex_);
+  // GPU が読み終えたフレームの CB 領域を回収
+  upload_.BeginFrame(cmd_.CompletedFenceValue());
+  // 同じく、解放済みの SRV の番号と一時領域を回収
+  srv_.BeginFrame(cmd_.CompletedFenceValue());
 
   // Present → RenderTarget
   cmd_.Transition(swap_.BackBuffer(backIndex_), D3D12_RESOURCE_STATE_PRESENT,
@@ -86,7 +95,11 @@ void Dx12Core::EndFrame() {
                   D3D12_RESOURCE_STATE_RENDER_TARGET,
                   D3D12_RESOURCE_STATE_PRESENT);
 
+  // このフレームまでに積んだ転送を流す（描画キューは GPU 側で完了を待つ）
+  uploader_.Submit();
   cmd_.EndFrame();
+  upload_.EndFrame(cmd_.LastSignaledFenceValue());
+  srv_.EndFrame(cmd_.LastSignaledFenceValue());
   // vsync=1, tearingなら 0 でもOK（好みで）
   swap_.Present(1, 0);
   cmd_.WaitForFrame(backIndex_);
@@ -96,6 +109,8 @@ void Dx12Core::WaitForGPU() { cmd_.FlushGPU(); }
 
 void Dx12Core::Term() {
   cmd_.FlushGPU();
+  uploader_.Term();
+  upload_.Term();
   depth_.Term();
   swap_.Term();
   srv_.Term();
@@ -5,6 +5,8 @@
 #include "Device/Device.h"
 #include "GraphicsPipeline/GraphicsPipeline.h"
 #include "SwapChain/SwapChain.h"
+#include "UploadManager/UploadManager.h"
+#include "UploadRing/UploadRing.h"
 #include <d3d12.h>
 #include <dxgi1_6.h>
 
@@ -18,8 +20,11 @@ public:
     UINT frameCount = 2;
     bool debug = true;
     bool gpuValidation = false;
-    UINT srvHeapCapacity = 256;
+    UINT srvHeapCapacity = 4096;    // 常駐（テクスチャなど。解放で再利用）
+    UINT srvTransientCapacity = 1024; // フレームごとの動的テーブル用
     bool allowTearingIfSupported = true;
+    UINT64 uploadRingSize = 8ull * 1024 * 1024; // フレームごとの CB 用
+    UINT64 copyStagingSize = 32ull * 1024 * 1024; // テクスチャ等の転送用
   };
 
   void Init(HWND hwnd, const Desc &d);
@@ -37,9 +42,14 @@ public:
   ID3D12CommandQueue *Queue() const { return cmd_.Queue(); }
 
   // ヒープとRT/DS
+  // SRV ヒープ：常駐は Allocate/Free、動的テーブルは AllocateTransient
   DescriptorHeap &SRV() { return srv_; }
   DescriptorHeap &RTV() { return rtv_; }
   DescriptorHeap &DSV() { return dsv_; }
+  // フレームごとの CB 用リング（切り出した領域はそのフレームの間だけ有効）
+  UploadRing &Upload() { return upload_; }
+  // DEFAULT ヒープへの転送（コピーキュー。EndFrame で描画より先に流す）
+  UploadManager &Uploader() { return uploader_; }
   D3D12_CPU_DESCRIPTOR_HANDLE CurrentRTV() const {
     return swap_.RtvAt(backIndex_);
   }
@@ -77,6 +87,8 @@ private:
   SwapChain swap_;
   DescriptorHeap rtv_, dsv_, srv_;
   DepthStencil depth_;
+  UploadRing upload_;
+  UploadManager uploader_;
   UINT backIndex_ = 0;
   bool allowTearing_ = false;
   D3D12_VIEWPORT viewport_{};
@@ -44,7 +44,7 @@ void GraphicsPipeline::Build(const D3D12_INPUT_ELEMENT_DESC *inputElems,
 
 void GraphicsPipeline::buildRootSignature_() {
   // ルートパラメータ
-  D3D12_ROOT_PARAMETER params[4] = {};
+  D3D12_ROOT_PARAMETER params[5] = {};
   // 0: CBV b0 (PS)
   params[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
   params[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
@@ -68,6 +68,12 @@ void GraphicsPipeline::buildRootSignature_() {
   params[3].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
   params[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
   params[3].Descriptor.ShaderRegister = 1;
+  // 4: SRV t0, space1 (VS) インスタンス描画の StructuredBuffer
+  //    （INSTANCED の VS だけが読む。ほかの描画では積まなくてよい）
+  params[4].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+  params[4].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+  params[4].Descriptor.ShaderRegister = 0;
+  params[4].Descriptor.RegisterSpace = 1;
 
   // 静的サンプラ s0
   D3D12_STATIC_SAMPLER_DESC samp{};
@@ -23,22 +23,8 @@ void PipelineManager::Term() {
 GraphicsPipeline *PipelineManager::CreateFromFiles(const std::string &key,
                                                    const PipelineDesc &desc) {
   // シェーダをコンパイル
-  ShaderDesc vs{};
-  vs.path = desc.vsPath.c_str();
-  vs.target = desc.vsTarget.c_str();
-  vs.entry = desc.vsEntry.c_str();
-  vs.optimize = desc.optimize;
-  vs.debugInfo = desc.debugInfo;
-
-  ShaderDesc ps{};
-  ps.path = desc.psPath.c_str();
-  ps.target = desc.psTarget.c_str();
-  ps.entry = desc.psEntry.c_str();
-  ps.optimize = desc.optimize;
-  ps.debugInfo = desc.debugInfo;
-
-  CompiledShader VS = compiler_.Compile(vs);
-  CompiledShader PS = compiler_.Compile(ps);
+  CompiledShader VS, PS;
+  compileShaders_(desc, VS, PS);
   assert(VS.HasBlob() && PS.HasBlob());
 
   return createFromBlobs_(key, desc, VS.Blob(), PS.Blob());
@@ -47,11 +33,16 @@ GraphicsPipeline *PipelineManager::CreateFromFiles(const std::string &key,
 GraphicsPipeline *PipelineManager::CreateFromFiles(const std::string &key,
                                                    const std::wstring &vsPath,
                                                    const std::wstring &psPath,
-                                                   InputLayoutType layoutType) {
+                                                   InputLayoutType layoutType,
+                                                   bool instanced) {
   PipelineDesc pdesc{};
   pdesc.vsPath = vsPath;
   pdesc.psPath = psPath;
   pdesc.inputLayout = GetInputLayout(layoutType);
+  pdesc.defines = GetLayoutDefines(layoutType);
+  if (instanced) {
+    pdesc.defines.push_back({L"INSTANCED", L"1"});
+  }
 #ifdef _DEBUG
   pdesc.optimize = false;
   pdesc.debugInfo = true;
@@ -68,20 +59,8 @@ bool PipelineManager::Rebuild(const std::string &key) {
     return false;
   const PipelineDesc &desc = it->second.desc;
 
-  ShaderDesc vs{}, ps{};
-  vs.path = desc.vsPath.c_str();
-  vs.target = desc.vsTarget.c_str();
-  vs.entry = desc.vsEntry.c_str();
-  vs.optimize = desc.optimize;
-  vs.debugInfo = desc.debugInfo;
-  ps.path = desc.psPath.c_str();
-  ps.target = desc.psTarget.c_str();
-  ps.entry = desc.psEntry.c_str();
-  ps.optimize = desc.optimize;
-  ps.debugInfo = desc.debugInfo;
-
-  CompiledShader VS = compiler_.Compile(vs);
-  CompiledShader PS = compiler_.Compile(ps);
+  CompiledShader VS, PS;
+  compileShaders_(desc, VS, PS);
   if (!VS.HasBlob() || !PS.HasBlob())
     return false;
 
@@ -95,6 +74,36 @@ bool PipelineManager::Rebuild(const std::string &key) {
   return true;
 }
 
+void PipelineManager::compileShaders_(const PipelineDesc &desc,
+                                      CompiledShader &vs,
+                                      CompiledShader &ps) const {
+  // DxcDefine は desc の文字列を指すだけ（Compile の間だけ使う）
+  std::vector<DxcDefine> defines;
+  defines.reserve(desc.defines.size());
+  for (const auto &d : desc.defines) {
+    defines.push_back({d.first.c_str(), d.second.c_str()});
+  }
+
+  ShaderDesc vsDesc{};
+  vsDesc.path = desc.vsPath.c_str();
+  vsDesc.target = desc.vsTarget.c_str();
+  vsDesc.entry = desc.vsEntry.c_str();
+  vsDesc.defines = defines;
+  vsDesc.optimize = desc.optimize;
+  vsDesc.debugInfo = desc.debugInfo;
+
+  ShaderDesc psDesc{};
+  psDesc.path = desc.psPath.c_str();
+  psDesc.target = desc.psTarget.c_str();
+  psDesc.entry = desc.psEntry.c_str();
+  psDesc.defines = defines;
+  psDesc.optimize = desc.optimize;
+  psDesc.debugInfo = desc.debugInfo;
+
+  vs = compiler_.Compile(vsDesc);
+  ps = compiler_.Compile(psDesc);
+}
+
 GraphicsPipeline *PipelineManager::createFromBlobs_(const std::string &key,
                                                     const PipelineDesc &desc,
                                                     IDxcBlob *vs,
@@ -125,6 +134,60 @@ PipelineManager::GetInputLayout(InputLayoutType type) {
          D3D12_APPEND_ALIGNED_ELEMENT,
          D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
     };
+  case InputLayoutType::Object3DCompact:
+    // float3 位置 / half2 UV / 八面体 snorm16 法線
+    return {
+        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    };
+  case InputLayoutType::Object3DQuantized:
+    // unorm16 位置（scale/offset は WVP 側） / half2 UV / 八面体 snorm16 法線
+    return {
+        {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    };
+  case InputLayoutType::Sprite:
+    // 画面座標 float2 / UV float2 / RGBA8 の色（SpriteBatch）
+    return {
+        {"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0,
+         D3D12_APPEND_ALIGNED_ELEMENT,
+         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    };
   }
   return {}; // 不明なタイプ
 }
+
+std::vector<std::pair<std::wstring, std::wstring>>
+PipelineManager::GetLayoutDefines(InputLayoutType type) {
+  switch (type) {
+  case InputLayoutType::Object3D:
+    return {};
+  case InputLayoutType::Object3DCompact:
+    return {{L"VERTEX_COMPACT", L"1"}};
+  case InputLayoutType::Object3DQuantized:
+    return {{L"VERTEX_QUANTIZED", L"1"}};
+  case InputLayoutType::Sprite:
+    return {{L"VERTEX_SPRITE", L"1"}};
+  }
+  return {};
+}
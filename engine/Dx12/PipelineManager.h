@@ -1,17 +1,36 @@
 #pragma once
 #include "GraphicsPipeline/GraphicsPipeline.h"
 #include "ShaderCompiler/ShaderCompiler.h"
+#include "VertexFormat/VertexFormat.h"
 #include <d3d12.h>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 enum class InputLayoutType {
-  Object3D,
+  Object3D,          // VertexData（36 byte）
+  Object3DCompact,   // VertexCompact（20 byte、VS に VERTEX_COMPACT）
+  Object3DQuantized, // VertexQuantized（16 byte、VS に VERTEX_QUANTIZED）
+  Sprite,            // SpriteVertex（20 byte、VS に VERTEX_SPRITE）
   // 他のレイアウトタイプをここに追加
 };
 
+// 頂点形式に合う Object3d の PSO のキー（App で登録している名前）
+// instanced なら InstancedRenderer 用（VS に INSTANCED）
+inline const char *Object3DPipelineKey(VertexFormat format,
+                                       bool instanced = false) {
+  switch (format) {
+  case VertexFormat::Compact:
+    return instanced ? "object3d_instanced_compact" : "object3d_compact";
+  case VertexFormat::Quantized:
+    return instanced ? "object3d_instanced_quantized" : "object3d_quantized";
+  default:
+    return instanced ? "object3d_instanced" : "object3d";
+  }
+}
+
 struct PipelineDesc {
   // シェーダ
   std::wstring vsPath = L"";
@@ -22,6 +41,8 @@ struct PipelineDesc {
   std::wstring psTarget = L"ps_6_0";
   bool optimize = true;
   bool debugInfo = false;
+  // マクロ定義（VS/PS 共通、例: {L"VERTEX_COMPACT", L"1"}）
+  std::vector<std::pair<std::wstring, std::wstring>> defines;
 
   // 入力レイアウト（実体を保持してポインタ寿命問題を回避）
   std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout;
@@ -42,9 +63,12 @@ public:
                                     const PipelineDesc &desc);
 
   // HLSLファイルから作成
+  // instanced なら VS に INSTANCED を定義（行列と色を StructuredBuffer から
+  // SV_InstanceID で読む、InstancedRenderer 用）
   GraphicsPipeline *CreateFromFiles(const std::string &key, const std::wstring &vsPath,
                   const std::wstring &psPath,
-                  InputLayoutType layoutType = InputLayoutType::Object3D);
+                  InputLayoutType layoutType = InputLayoutType::Object3D,
+                  bool instanced = false);
 
   bool Rebuild(const std::string &key);
 
@@ -64,6 +88,12 @@ private:
 
   // 入力レイアウトの定義を取得
   static std::vector<D3D12_INPUT_ELEMENT_DESC> GetInputLayout(InputLayoutType type);
+  // 入力レイアウトに合わせた VS 用マクロ
+  static std::vector<std::pair<std::wstring, std::wstring>>
+  GetLayoutDefines(InputLayoutType type);
+  // desc の設定でシェーダをコンパイル
+  void compileShaders_(const PipelineDesc &desc, CompiledShader &vs,
+                       CompiledShader &ps) const;
 
   struct Entry {
     PipelineDesc desc;
@@ -0,0 +1,268 @@
+#include "UploadManager.h"
+#include "function/function.h"
+#include <cassert>
+#include <cstring>
+
+void UploadManager::Init(ID3D12Device *device,
+                         ID3D12CommandQueue *graphicsQueue,
+                         uint64_t stagingCapacity) {
+  Term();
+  assert(device && graphicsQueue && stagingCapacity > 0);
+  device_ = device;
+  graphicsQueue_ = graphicsQueue;
+
+  // コピー専用のキュー
+  D3D12_COMMAND_QUEUE_DESC qdesc{};
+  qdesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+  HRESULT hr = device_->CreateCommandQueue(&qdesc, IID_PPV_ARGS(&queue_));
+  assert(SUCCEEDED(hr));
+
+  hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY,
+                                       IID_PPV_ARGS(&allocator_));
+  assert(SUCCEEDED(hr));
+  hr = device_->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, allocator_,
+                                  nullptr, IID_PPV_ARGS(&list_));
+  assert(SUCCEEDED(hr));
+  hr = list_->Close(); // 最初は閉じておく
+  assert(SUCCEEDED(hr));
+  freeAllocators_.push_back(allocator_);
+  allocator_ = nullptr;
+
+  hr = device_->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
+  assert(SUCCEEDED(hr));
+  fenceEvent_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+  assert(fenceEvent_ != nullptr);
+  lastFenceValue_ = 0;
+  nextFenceValue_ = 1;
+
+  // テクスチャの配置境界（512）に揃える
+  stagingCapacity =
+      (stagingCapacity + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1) &
+      ~uint64_t(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
+  staging_ = CreateBufferResource(device_, size_t(stagingCapacity));
+  hr = staging_->Map(0, nullptr, reinterpret_cast<void **>(&stagingCpu_));
+  assert(SUCCEEDED(hr));
+  stagingRing_.Init(stagingCapacity);
+
+  stats_ = {};
+  stats_.stagingCapacity = stagingCapacity;
+}
+
+void UploadManager::Term() {
+  if (!queue_)
+    return;
+  // 積み残しを流し、全部終わってから片付ける
+  Wait(Submit());
+  Reclaim_();
+
+  for (ID3D12CommandAllocator *allocator : freeAllocators_) {
+    allocator->Release();
+  }
+  freeAllocators_.clear();
+  if (staging_) {
+    staging_->Unmap(0, nullptr);
+    staging_->Release();
+    staging_ = nullptr;
+  }
+  stagingCpu_ = nullptr;
+  if (list_) {
+    list_->Release();
+    list_ = nullptr;
+  }
+  if (fence_) {
+    fence_->Release();
+    fence_ = nullptr;
+  }
+  if (fenceEvent_) {
+    CloseHandle(fenceEvent_);
+    fenceEvent_ = nullptr;
+  }
+  queue_->Release();
+  queue_ = nullptr;
+  graphicsQueue_ = nullptr;
+  device_ = nullptr;
+}
+
+void UploadManager::Open_() {
+  if (recording_)
+    return;
+  Reclaim_();
+  if (freeAllocators_.empty()) {
+    ID3D12CommandAllocator *allocator = nullptr;
+    HRESULT hr = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY,
+                                                 IID_PPV_ARGS(&allocator));
+    assert(SUCCEEDED(hr));
+    freeAllocators_.push_back(allocator);
+  }
+  allocator_ = freeAllocators_.back();
+  freeAllocators_.pop_back();
+
+  HRESULT hr = allocator_->Reset();
+  assert(SUCCEEDED(hr));
+  hr = list_->Reset(allocator_, nullptr);
+  assert(SUCCEEDED(hr));
+  recording_ = true;
+}
+
+UploadManager::Staging UploadManager::AllocateStaging_(uint64_t size,
+                                                       uint64_t alignment) {
+  stagingRing_.BeginFrame(fence_->GetCompletedValue());
+  uint64_t offset = stagingRing_.Allocate(size, alignment);
+  if (offset == RingAllocator::kInvalidOffset &&
+      size <= stats_.stagingCapacity) {
+    // 一杯：今のまとまりを流し、使用中の分が空くまで待ってからもう一度
+    ++stats_.stagingStalls;
+    Wait(Submit());
+    stagingRing_.BeginFrame(fence_->GetCompletedValue());
+    offset = stagingRing_.Allocate(size, alignment);
+  }
+  if (offset != RingAllocator::kInvalidOffset) {
+    stats_.stagingUsed = stagingRing_.GetStats().usedBytes;
+    return {staging_, stagingCpu_ + offset, offset};
+  }
+
+  // リングより大きい：このまとまり専用に作り、完了したら解放する
+  ID3D12Resource *buffer = CreateBufferResource(device_, size_t(size));
+  uint8_t *cpu = nullptr;
+  HRESULT hr = buffer->Map(0, nullptr, reinterpret_cast<void **>(&cpu));
+  assert(SUCCEEDED(hr));
+  batchDedicated_.push_back(buffer);
+  ++stats_.dedicatedBuffers;
+  return {buffer, cpu, 0};
+}
+
+void UploadManager::UploadTexture(ID3D12Resource *dst,
+                                  const D3D12_SUBRESOURCE_DATA *data,
+                                  UINT count, UINT firstSubresource) {
+  assert(queue_ && dst && data && count > 0);
+
+  // 各サブリソースのステージング上の並び（行は 256 境界に揃う）
+  const D3D12_RESOURCE_DESC desc = dst->GetDesc();
+  std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(count);
+  std::vector<UINT> rowCounts(count);
+  std::vector<UINT64> rowSizes(count);
+  UINT64 totalBytes = 0;
+  device_->GetCopyableFootprints(&desc, firstSubresource, count, 0,
+                                 layouts.data(), rowCounts.data(),
+                                 rowSizes.data(), &totalBytes);
+
+  const Staging staging =
+      AllocateStaging_(totalBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+  Open_();
+
+  for (UINT i = 0; i < count; ++i) {
+    const D3D12_SUBRESOURCE_FOOTPRINT &footprint = layouts[i].Footprint;
+    uint8_t *dstBase = staging.cpu + layouts[i].Offset;
+    const uint8_t *srcBase = static_cast<const uint8_t *>(data[i].pData);
+    for (UINT z = 0; z < footprint.Depth; ++z) {
+      for (UINT row = 0; row < rowCounts[i]; ++row) {
+        std::memcpy(dstBase + uint64_t(z) * footprint.RowPitch * rowCounts[i] +
+                        uint64_t(row) * footprint.RowPitch,
+                    srcBase + uint64_t(z) * data[i].SlicePitch +
+                        uint64_t(row) * data[i].RowPitch,
+                    size_t(rowSizes[i]));
+      }
+    }
+
+    D3D12_TEXTURE_COPY_LOCATION src{};
+    src.pResource = staging.buffer;
+    src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    src.PlacedFootprint = layouts[i];
+    src.PlacedFootprint.Offset += staging.offset;
+
+    D3D12_TEXTURE_COPY_LOCATION dstLocation{};
+    dstLocation.pResource = dst;
+    dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    dstLocation.SubresourceIndex = firstSubresource + i;
+
+    list_->CopyTextureRegion(&dstLocation, 0, 0, 0, &src, nullptr);
+  }
+
+  ++batchUploads_;
+  batchBytes_ += totalBytes;
+}
+
+void UploadManager::UploadBuffer(ID3D12Resource *dst, const void *data,
+                                 uint64_t size, uint64_t dstOffset) {
+  assert(queue_ && dst && data && size > 0);
+  const Staging staging = AllocateStaging_(size, 16);
+  Open_();
+
+  std::memcpy(staging.cpu, data, size_t(size));
+  list_->CopyBufferRegion(dst, dstOffset, staging.buffer, staging.offset,
+                          size);
+
+  ++batchUploads_;
+  batchBytes_ += size;
+}
+
+UploadToken UploadManager::Submit() {
+  if (!recording_)
+    return {lastFenceValue_};
+
+  HRESULT hr = list_->Close();
+  assert(SUCCEEDED(hr));
+  ID3D12CommandList *lists[] = {list_};
+  queue_->ExecuteCommandLists(1, lists);
+
+  const uint64_t fenceValue = nextFenceValue_++;
+  hr = queue_->Signal(fence_, fenceValue);
+  assert(SUCCEEDED(hr));
+  // 描画キューはこの後に積む分からコピーの完了を待つ（CPU は止めない）
+  hr = graphicsQueue_->Wait(fence_, fenceValue);
+  assert(SUCCEEDED(hr));
+  lastFenceValue_ = fenceValue;
+  recording_ = false;
+
+  // アロケータと個別バッファは完了してから回収
+  retired_.push_back({fenceValue, allocator_, nullptr});
+  allocator_ = nullptr;
+  for (ID3D12Resource *buffer : batchDedicated_) {
+    retired_.push_back({fenceValue, nullptr, buffer});
+  }
+  batchDedicated_.clear();
+  stagingRing_.EndFrame(fenceValue);
+
+  ++stats_.batches;
+  stats_.lastBatchUploads = batchUploads_;
+  stats_.lastBatchBytes = batchBytes_;
+  batchUploads_ = 0;
+  batchBytes_ = 0;
+  return {fenceValue};
+}
+
+bool UploadManager::IsComplete(UploadToken token) const {
+  return !token || (fence_ && fence_->GetCompletedValue() >= token.fenceValue);
+}
+
+void UploadManager::Wait(UploadToken token) {
+  if (!token || !fence_)
+    return;
+  // 流していないまとまりを待つなら先に流す
+  if (token.fenceValue > lastFenceValue_) {
+    if (!recording_)
+      return; // 何も積まれなかったまとまり（Signal されない）
+    Submit();
+  }
+  if (fence_->GetCompletedValue() < token.fenceValue) {
+    HRESULT hr = fence_->SetEventOnCompletion(token.fenceValue, fenceEvent_);
+    assert(SUCCEEDED(hr));
+    WaitForSingleObject(fenceEvent_, INFINITE);
+  }
+}
+
+void UploadManager::Reclaim_() {
+  const uint64_t completed = fence_->GetCompletedValue();
+  while (!retired_.empty() && retired_.front().fenceValue <= completed) {
+    const Retired &retired = retired_.front();
+    if (retired.allocator)
+      freeAllocators_.push_back(retired.allocator);
+    if (retired.dedicated) {
+      retired.dedicated->Unmap(0, nullptr);
+      retired.dedicated->Release();
+    }
+    retired_.pop_front();
+  }
+  stagingRing_.BeginFrame(completed);
+  stats_.stagingUsed = stagingRing_.GetStats().usedBytes;
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include "UploadRing/RingAllocator.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <deque>
+#include <vector>
+
+// Submit で発行したまとまりの完了待ち用（0 は「待つものなし」）
+struct UploadToken {
+  uint64_t fenceValue = 0;
+
+  explicit operator bool() const { return fenceValue != 0; }
+};
+
+//==================================
+// コピーキューでのアップロード
+//==================================
+// DEFAULT ヒープのテクスチャ / バッファへ、アップロードヒープに置いた
+// ステージング（RingAllocator で切り出す）から専用のコピーキューで写す。
+// Upload* は現在のまとまりに積むだけで、Submit でまとめて 1 回
+// ExecuteCommandLists → Signal する（何枚積んでもフェンスは 1 つ）。
+// Submit は描画キューにも GPU 側で完了を待たせるので、その後に実行する描画
+// からはそのまま使える（Dx12Core::EndFrame が描画の Execute の前に呼ぶ）。
+// CPU 側で確かめたいときはトークンを IsComplete / Wait。
+// 書き込み先は COMMON で作っておく（コピーキューでは暗黙に COPY_DEST に
+// 上がり、終わると COMMON に戻る。描画キューで読むときも暗黙に上がる）。
+class UploadManager {
+public:
+  struct Stats {
+    uint32_t batches = 0;           // これまでの Submit 数
+    uint32_t lastBatchUploads = 0;  // 直近の Submit に入っていた Upload* の数
+    uint64_t lastBatchBytes = 0;    // 同、ステージングに書いた量
+    uint32_t dedicatedBuffers = 0;  // リングに入らず個別に作った数（累計）
+    uint32_t stagingStalls = 0;     // リングが空くのを CPU で待った回数
+    uint64_t stagingCapacity = 0;
+    uint64_t stagingUsed = 0;       // 回収されていない分
+  };
+
+  UploadManager() = default;
+  ~UploadManager() { Term(); }
+  UploadManager(const UploadManager &) = delete;
+  UploadManager &operator=(const UploadManager &) = delete;
+
+  // graphicsQueue: Submit のたびに完了を GPU 側で待たせる描画キュー
+  void Init(ID3D12Device *device, ID3D12CommandQueue *graphicsQueue,
+            uint64_t stagingCapacity = 32ull * 1024 * 1024);
+  // 積んだ分を流して完了まで待ってから片付ける
+  void Term();
+
+  // テクスチャのサブリソース [first, first + count) を写す
+  // （data の中身はステージングへ写すので、呼び出し後は捨ててよい）
+  void UploadTexture(ID3D12Resource *dst, const D3D12_SUBRESOURCE_DATA *data,
+                     UINT count, UINT firstSubresource = 0);
+  // バッファの dstOffset から size バイトを写す（頂点 / インデックスなど）
+  void UploadBuffer(ID3D12Resource *dst, const void *data, uint64_t size,
+                    uint64_t dstOffset = 0);
+
+  // 積んだ分を流す。何も積んでいなければ直前のトークンを返す
+  UploadToken Submit();
+  // 今のまとまりが流れたときに返るトークン（Upload* の直後に配る用）
+  UploadToken PendingToken() const { return {nextFenceValue_}; }
+  bool HasPending() const { return recording_; }
+
+  bool IsComplete(UploadToken token) const;
+  void Wait(UploadToken token);
+
+  bool IsReady() const { return queue_ != nullptr; }
+  const Stats &GetStats() const { return stats_; }
+
+private:
+  struct Staging {
+    ID3D12Resource *buffer; // ステージングの本体（リング or 個別）
+    uint8_t *cpu;
+    uint64_t offset;
+  };
+  struct Retired {
+    uint64_t fenceValue;
+    ID3D12CommandAllocator *allocator; // 使い回す
+    ID3D12Resource *dedicated;         // 解放する（なければ nullptr）
+  };
+
+  // コマンドリストを開く（済みなら何もしない）
+  void Open_();
+  // size バイトのステージングを取る（リングが一杯なら流して待つ）
+  Staging AllocateStaging_(uint64_t size, uint64_t alignment);
+  // 完了したまとまりのアロケータと個別バッファを回収する
+  void Reclaim_();
+
+  ID3D12Device *device_ = nullptr;
+  ID3D12CommandQueue *graphicsQueue_ = nullptr; // 非所有
+  ID3D12CommandQueue *queue_ = nullptr;         // COPY
+  ID3D12GraphicsCommandList *list_ = nullptr;
+  ID3D12CommandAllocator *allocator_ = nullptr; // 記録中のもの
+  std::vector<ID3D12CommandAllocator *> freeAllocators_;
+  std::deque<Retired> retired_;
+  std::vector<ID3D12Resource *> batchDedicated_; // 今のまとまりの個別バッファ
+
+  ID3D12Fence *fence_ = nullptr;
+  HANDLE fenceEvent_ = nullptr;
+  uint64_t lastFenceValue_ = 0;
+  uint64_t nextFenceValue_ = 1;
+  bool recording_ = false;
+
+  ID3D12Resource *staging_ = nullptr; // マップしたまま
+  uint8_t *stagingCpu_ = nullptr;
+  RingAllocator stagingRing_;
+
+  uint32_t batchUploads_ = 0;
+  uint64_t batchBytes_ = 0;
+  Stats stats_{};
+};
@@ -0,0 +1,92 @@
+#include "RingAllocator.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+void RingAllocator::Init(uint64_t capacity) {
+  capacity_ = capacity;
+  head_ = tail_ = used_ = 0;
+  frameBytes_ = 0;
+  frameAllocations_ = frameOverflows_ = 0;
+  frames_.clear();
+  stats_ = {};
+  stats_.capacity = capacity_;
+}
+
+void RingAllocator::BeginFrame(uint64_t completedFenceValue) {
+  while (!frames_.empty() && frames_.front().fenceValue <= completedFenceValue) {
+    tail_ = frames_.front().end;
+    used_ -= frames_.front().bytes;
+    frames_.pop_front();
+  }
+  stats_.usedBytes = used_;
+  stats_.framesInFlight = static_cast<uint32_t>(frames_.size());
+}
+
+uint64_t RingAllocator::Allocate(uint64_t size, uint64_t alignment) {
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+  size = (std::max)(size, uint64_t(1));
+
+  // 何も残っていなければ先頭から使い直す
+  if (used_ == 0) {
+    head_ = tail_ = 0;
+  }
+
+  const uint64_t offset = AlignUp(head_, alignment);
+  // 空きが [head_, capacity_) と [0, tail_) に分かれているか
+  const bool split = head_ > tail_ || used_ == 0;
+  if (split) {
+    if (offset + size <= capacity_) {
+      return Commit_(offset, size);
+    }
+    // 末尾に入らなければ先頭へ回る（末尾の余りは今フレームの分として捨てる）
+    if (size <= tail_) {
+      const uint64_t padding = capacity_ - head_;
+      used_ += padding;
+      frameBytes_ += padding;
+      head_ = 0;
+      return Commit_(0, size);
+    }
+  } else if (offset + size <= tail_) {
+    // 回り込み済み：空きは [head_, tail_) だけ
+    return Commit_(offset, size);
+  }
+
+  ++frameOverflows_;
+  ++stats_.totalOverflows;
+  return kInvalidOffset;
+}
+
+uint64_t RingAllocator::Commit_(uint64_t offset, uint64_t size) {
+  const uint64_t advance = offset + size - head_;
+  used_ += advance;
+  frameBytes_ += advance;
+  head_ = offset + size;
+  ++frameAllocations_;
+
+  stats_.usedBytes = used_;
+  stats_.peakUsedBytes = (std::max)(stats_.peakUsedBytes, used_);
+  return offset;
+}
+
+void RingAllocator::EndFrame(uint64_t fenceValue) {
+  // 何も切り出さなかったフレームは回収するものがない
+  if (frameBytes_ > 0) {
+    assert(frames_.empty() || frames_.back().fenceValue < fenceValue);
+    frames_.push_back({fenceValue, head_, frameBytes_});
+  }
+
+  stats_.frameBytes = frameBytes_;
+  stats_.frameAllocations = frameAllocations_;
+  stats_.frameOverflows = frameOverflows_;
+  stats_.framesInFlight = static_cast<uint32_t>(frames_.size());
+  frameBytes_ = 0;
+  frameAllocations_ = frameOverflows_ = 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+//==================================
+// リングアロケータ（D3D 非依存、オフセットの管理だけ）
+//==================================
+// 1 本のバッファを先頭から順に切り出し、末尾に入らなければ先頭へ回る。
+// EndFrame でそのフレームに切り出した範囲へフェンス値を付け、
+// BeginFrame に渡された完了値以下のフレームの範囲を回収する。
+// フェンス値はただの数値として扱うので、GPU なしで偽のフェンス値を
+// 渡して確かめられる（実際の値は CommandContext から取る）。
+class RingAllocator {
+public:
+  static constexpr uint64_t kInvalidOffset = ~0ull;
+
+  struct Stats {
+    uint64_t capacity = 0;
+    uint64_t usedBytes = 0;     // 回収されていない分（今フレームを含む）
+    uint64_t peakUsedBytes = 0; // usedBytes の最大
+    uint64_t frameBytes = 0;    // 直近に閉じたフレームで使った分（余りを含む）
+    uint32_t frameAllocations = 0; // 直近に閉じたフレームの切り出し回数
+    uint32_t frameOverflows = 0;   // 直近に閉じたフレームで入らなかった回数
+    uint64_t totalOverflows = 0;
+    uint32_t framesInFlight = 0;   // 回収待ちのフレーム数
+  };
+
+  void Init(uint64_t capacity);
+
+  // 完了したフェンス値までのフレームを回収する
+  void BeginFrame(uint64_t completedFenceValue);
+
+  // size バイトを alignment（2 のべき）境界で切り出す。
+  // 空きがなければ kInvalidOffset を返し、溢れとして数える
+  uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+  // 今フレームの切り出しを、GPU が読み終えたら fenceValue になる分として閉じる
+  void EndFrame(uint64_t fenceValue);
+
+  const Stats &GetStats() const { return stats_; }
+
+private:
+  struct Frame {
+    uint64_t fenceValue;
+    uint64_t end;   // このフレームの最後の切り出しの終わり
+    uint64_t bytes; // このフレームで進めた量（回り込みの余りを含む）
+  };
+
+  // head_ から offset + size まで進める
+  uint64_t Commit_(uint64_t offset, uint64_t size);
+
+  uint64_t capacity_ = 0;
+  uint64_t head_ = 0; // 次に切り出す位置
+  uint64_t tail_ = 0; // 回収待ちの一番古い位置
+  uint64_t used_ = 0; // [tail_, head_) の量（満杯と空を区別する）
+
+  uint64_t frameBytes_ = 0;
+  uint32_t frameAllocations_ = 0;
+  uint32_t frameOverflows_ = 0;
+  std::deque<Frame> frames_;
+
+  Stats stats_{};
+};
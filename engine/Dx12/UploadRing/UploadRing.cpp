@@ -0,0 +1,62 @@
+#include "UploadRing.h"
+#include "function/function.h"
+#include <cassert>
+#include <string>
+
+void UploadRing::Init(ID3D12Device *device, uint64_t capacity) {
+  Term();
+  assert(device && capacity > 0);
+  // 切り出しは 256 バイト境界なので容量もそれに揃える
+  capacity = (capacity + D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1) &
+             ~uint64_t(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1);
+
+  resource_ = CreateBufferResource(device, size_t(capacity));
+  HRESULT hr =
+      resource_->Map(0, nullptr, reinterpret_cast<void **>(&mapped_));
+  assert(SUCCEEDED(hr));
+  gpuBase_ = resource_->GetGPUVirtualAddress();
+  ring_.Init(capacity);
+  overflowReported_ = false;
+}
+
+void UploadRing::Term() {
+  // GPU が使い終わっていること（Dx12Core::Term は FlushGPU の後に呼ぶ）
+  if (resource_) {
+    resource_->Unmap(0, nullptr);
+    resource_->Release();
+    resource_ = nullptr;
+  }
+  mapped_ = nullptr;
+  gpuBase_ = 0;
+}
+
+void UploadRing::BeginFrame(uint64_t completedFenceValue) {
+  ring_.BeginFrame(completedFenceValue);
+}
+
+void UploadRing::EndFrame(uint64_t fenceValue) {
+  ring_.EndFrame(fenceValue);
+
+  const RingAllocator::Stats &stats = ring_.GetStats();
+  if (stats.frameOverflows > 0 && !overflowReported_) {
+    const std::string message =
+        "UploadRing: overflow (" + std::to_string(stats.frameOverflows) +
+        " allocations in a frame, capacity " + std::to_string(stats.capacity) +
+        " bytes)\n";
+    OutputDebugStringA(message.c_str());
+    overflowReported_ = true;
+  }
+}
+
+UploadAllocation UploadRing::Allocate(uint64_t size, uint64_t alignment) {
+  UploadAllocation alloc;
+  if (!resource_)
+    return alloc;
+  const uint64_t offset = ring_.Allocate(size, alignment);
+  if (offset == RingAllocator::kInvalidOffset)
+    return alloc;
+  alloc.cpu = mapped_ + offset;
+  alloc.gpu = gpuBase_ + offset;
+  alloc.size = size;
+  return alloc;
+}
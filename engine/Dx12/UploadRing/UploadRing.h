@@ -0,0 +1,61 @@
+#pragma once
+#include "UploadRing/RingAllocator.h"
+#include <cstdint>
+#include <cstring>
+#include <d3d12.h>
+
+// UploadRing::Allocate の結果（溢れたときは cpu == nullptr, gpu == 0）
+struct UploadAllocation {
+  void *cpu = nullptr;
+  D3D12_GPU_VIRTUAL_ADDRESS gpu = 0;
+  uint64_t size = 0;
+
+  explicit operator bool() const { return cpu != nullptr; }
+};
+
+//==================================
+// フレームごとのアップロード用リング
+//==================================
+// マップしたままのアップロードヒープを 1 本だけ作り、定数バッファなどを
+// 256 バイト境界で切り出す（オブジェクトごとに CreateBufferResource しない）。
+// 切り出した領域はそのフレームの間だけ有効で、CommandContext のフェンス値で
+// GPU が読み終えたと分かってから使い回す（Dx12Core が BeginFrame / EndFrame
+// を呼ぶ）。入らなかったときは空の UploadAllocation を返して溢れを数える。
+class UploadRing {
+public:
+  UploadRing() = default;
+  ~UploadRing() { Term(); }
+  UploadRing(const UploadRing &) = delete;
+  UploadRing &operator=(const UploadRing &) = delete;
+
+  void Init(ID3D12Device *device, uint64_t capacity);
+  void Term();
+
+  // completedFenceValue: 完了済みのフェンス値（それまでのフレームを回収）
+  void BeginFrame(uint64_t completedFenceValue);
+  // fenceValue: 今フレームの ExecuteCommandLists の後に Signal した値
+  void EndFrame(uint64_t fenceValue);
+
+  UploadAllocation Allocate(
+      uint64_t size,
+      uint64_t alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+  // data を CB として書き込み、GPU アドレスを返す（溢れたら 0）
+  template <class T> D3D12_GPU_VIRTUAL_ADDRESS PushConstants(const T &data) {
+    const UploadAllocation alloc = Allocate(sizeof(T));
+    if (!alloc)
+      return 0;
+    std::memcpy(alloc.cpu, &data, sizeof(T));
+    return alloc.gpu;
+  }
+
+  bool IsReady() const { return resource_ != nullptr; }
+  const RingAllocator::Stats &GetStats() const { return ring_.GetStats(); }
+
+private:
+  ID3D12Resource *resource_ = nullptr;
+  uint8_t *mapped_ = nullptr;
+  D3D12_GPU_VIRTUAL_ADDRESS gpuBase_ = 0;
+  RingAllocator ring_;
+  bool overflowReported_ = false; // 溢れを出力に出したか（1 回だけ）
+};
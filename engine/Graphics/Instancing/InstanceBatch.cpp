@@ -0,0 +1,77 @@
+#include "InstanceBatch.h"
+#include "Math/Math.h"
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+namespace {
+
+// バケットの並び順（頂点形式を先に。ポインタは値として比べる）
+auto SortTuple(const InstanceBucketKey &key) {
+  return std::make_tuple(key.vertexFormat,
+                         reinterpret_cast<uintptr_t>(key.geometry), key.lod,
+                         key.material);
+}
+
+} // namespace
+
+void InstanceBatch::Clear() {
+  submissions_.clear();
+  transforms_.Clear();
+  instances_.clear();
+  buckets_.clear();
+}
+
+uint32_t InstanceBatch::Add(const InstanceBucketKey &key,
+                            const Transform &transform, const Vector4 &color,
+                            const Matrix4x4 *preTransform) {
+  const uint32_t index = static_cast<uint32_t>(submissions_.size());
+  submissions_.push_back({key, color, preTransform});
+  transforms_.Push(transform);
+  return index;
+}
+
+void InstanceBatch::Build(const Matrix4x4 &viewProj, uint32_t workerCount) {
+  const size_t count = submissions_.size();
+  instances_.resize(count);
+  buckets_.clear();
+  if (count == 0) {
+    return;
+  }
+
+  // 同じキーを隣り合わせる（同じキーの中は追加順のまま）
+  order_.resize(count);
+  std::iota(order_.begin(), order_.end(), 0u);
+  std::stable_sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) {
+    return SortTuple(submissions_[a].key) < SortTuple(submissions_[b].key);
+  });
+
+  // 並べ替えた順に Transform を詰めて一括で行列にする
+  sorted_.Resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    sorted_.Set(i, transforms_.Get(order_[i]));
+  }
+  matrices_.resize(count);
+  ComputeTransformationMatrices(sorted_, viewProj, matrices_.data(),
+                                workerCount);
+
+  for (size_t i = 0; i < count; ++i) {
+    const Submission &submission = submissions_[order_[i]];
+    InstanceData &instance = instances_[i];
+    instance.World = matrices_[i].World;
+    instance.WVP = matrices_[i].WVP;
+    if (submission.preTransform) {
+      instance.WVP = Multiply(*submission.preTransform, instance.WVP);
+    }
+    instance.color = submission.color;
+
+    if (buckets_.empty() || !(buckets_.back().key == submission.key)) {
+      InstanceBucket bucket;
+      bucket.key = submission.key;
+      bucket.firstInstance = static_cast<uint32_t>(i);
+      bucket.firstSubmission = order_[i];
+      buckets_.push_back(bucket);
+    }
+    ++buckets_.back().instanceCount;
+  }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "Math/MathTypes.h"
+#include "Math/TransformBatch.h"
+#include "VertexFormat/VertexFormat.h"
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// インスタンス描画の詰め込み（D3D 非依存）
+//==================================
+// 1 フレーム分の (メッシュ, マテリアル, Transform, 色) を集め、同じメッシュ・
+// マテリアルどうしを隣り合うよう並べ替えてから、VS の StructuredBuffer へ
+// そのまま写せる InstanceData の配列を作る。
+// 1 つのバケット（同じキー）が 1 回の DrawIndexedInstanced になる。
+
+// StructuredBuffer<InstanceData> の 1 要素（Object3d.VS.hlsl の INSTANCED と対応）
+struct InstanceData {
+  Matrix4x4 WVP;
+  Matrix4x4 World;
+  Vector4 color;
+};
+static_assert(sizeof(InstanceData) == 144, "Object3d.VS.hlsl と合わせる");
+
+// まとめて描けるかの判定に使うキー（全部同じなら同じバケット）
+struct InstanceBucketKey {
+  // VB の頂点形式（入力レイアウトが違うので PSO が変わる）
+  VertexFormat vertexFormat = VertexFormat::Standard;
+  const void *geometry = nullptr; // VB / IB の持ち主（ModelMesh や Sphere）
+  uint32_t lod = 0;               // 描く IB の範囲
+  uint64_t material = 0;          // SRV など（呼び出し側で決める値）
+
+  bool operator==(const InstanceBucketKey &) const = default;
+};
+
+// 同じキーのインスタンスの並び（instances[firstInstance] から instanceCount 個）
+struct InstanceBucket {
+  InstanceBucketKey key{};
+  uint32_t firstInstance = 0;
+  uint32_t instanceCount = 0;
+  // バケットの最初に Add された番号（描画に必要な情報を呼び出し側で引く用）
+  uint32_t firstSubmission = 0;
+};
+
+class InstanceBatch {
+public:
+  // 前フレームの分を捨てる（容量は残す）
+  void Clear();
+
+  // 1 インスタンス追加して、追加順の番号を返す。
+  // preTransform は World の前に掛ける行列（Quantized の復元行列など、
+  // 同じ geometry では同じもの）。Build まで生きている必要がある
+  uint32_t Add(const InstanceBucketKey &key, const Transform &transform,
+               const Vector4 &color, const Matrix4x4 *preTransform = nullptr);
+
+  // キーで並べ替え（頂点形式が先なので PSO の切り替えは形式の数まで。
+  // 同じキーの中は追加順）、行列を計算して詰める。
+  // 行列は TransformBatch の SIMD 経路（workerCount > 1 ならスレッド分割）
+  void Build(const Matrix4x4 &viewProj, uint32_t workerCount = 1);
+
+  size_t Size() const { return submissions_.size(); }
+  const std::vector<InstanceData> &Instances() const { return instances_; }
+  const std::vector<InstanceBucket> &Buckets() const { return buckets_; }
+
+private:
+  struct Submission {
+    InstanceBucketKey key;
+    Vector4 color;
+    const Matrix4x4 *preTransform;
+  };
+
+  std::vector<Submission> submissions_;
+  TransformBatchSoA transforms_; // 追加順
+
+  // Build の結果
+  std::vector<uint32_t> order_; // 並べ替え後 → 追加順の番号
+  TransformBatchSoA sorted_;
+  std::vector<TransformationMatrix> matrices_;
+  std::vector<InstanceData> instances_;
+  std::vector<InstanceBucket> buckets_;
+};
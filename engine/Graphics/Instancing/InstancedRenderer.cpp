@@ -0,0 +1,208 @@
+#include "InstancedRenderer.h"
+#include "Math/Math.h"
+#include "Model3D/Model3D.h"
+#include "PipelineManager.h"
+#include "Sphere/Sphere.h"
+#include "function/function.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+InstancedRenderer::~InstancedRenderer() {
+  if (instanceBuffer_)
+    instanceBuffer_->Release();
+  if (cbMat_.resource)
+    cbMat_.resource->Release();
+  if (cbLight_.resource)
+    cbLight_.resource->Release();
+}
+
+void InstancedRenderer::Initialize(ID3D12Device *device, uint32_t maxInstances,
+                                   uint32_t frameCount) {
+  assert(maxInstances > 0 && frameCount > 0);
+  device_ = device;
+  maxInstances_ = maxInstances;
+  frameCount_ = frameCount;
+  frame_ = 0;
+
+  // インスタンスバッファ（マップしたまま使う）
+  instanceBuffer_ = CreateBufferResource(
+      device_, sizeof(InstanceData) * size_t(maxInstances_) * frameCount_);
+  instanceBuffer_->Map(0, nullptr,
+                       reinterpret_cast<void **>(&instanceMapped_));
+
+  // CB: Material
+  cbMat_.resource = CreateBufferResource(device_, sizeof(Material));
+  cbMat_.resource->Map(0, nullptr, reinterpret_cast<void **>(&cbMat_.mapped));
+  cbMat_.mapped->color = {1, 1, 1, 1};
+  cbMat_.mapped->uvTransform = MakeIdentity4x4();
+  cbMat_.mapped->lightingMode = 2; // HalfLambert 既定
+
+  // CB: Light
+  cbLight_.resource = CreateBufferResource(device_, sizeof(DirectionalLight));
+  cbLight_.resource->Map(0, nullptr,
+                         reinterpret_cast<void **>(&cbLight_.mapped));
+  cbLight_.mapped->color = {1, 1, 1, 1};
+  cbLight_.mapped->direction = {0.0f, -1.0f, 0.0f};
+  cbLight_.mapped->intensity = 1.0f;
+}
+
+void InstancedRenderer::Begin() {
+  batch_.Clear();
+  sources_.clear();
+  uploadedCount_ = 0;
+  frame_ = (frame_ + 1) % frameCount_;
+}
+
+void InstancedRenderer::Add(const Model3D &model, const Vector4 &color) {
+  AddModel_(model, model.GetTransform(), color);
+}
+
+void InstancedRenderer::Add(const Model3D &model, const Transform &transform,
+                            const Vector4 &color) {
+  AddModel_(model, transform, color);
+}
+
+void InstancedRenderer::Add(const Sphere &sphere, const Vector4 &color) {
+  AddSphere_(sphere, sphere.GetTransform(), color);
+}
+
+void InstancedRenderer::Add(const Sphere &sphere, const Transform &transform,
+                            const Vector4 &color) {
+  AddSphere_(sphere, transform, color);
+}
+
+void InstancedRenderer::AddModel_(const Model3D &model,
+                                  const Transform &transform,
+                                  const Vector4 &color) {
+  const ModelMesh *mesh = model.GetMesh();
+  if (!mesh || mesh->GetVertexCount() == 0)
+    return;
+
+  // 部分メッシュの SRV の並びが同じならまとめられる
+  uint64_t material = 1469598103934665603ull; // FNV-1a
+  for (size_t i = 0; i < model.GetSubmeshCount(); ++i) {
+    material = (material ^ model.GetSubmeshSrv(i).ptr) * 1099511628211ull;
+  }
+
+  InstanceBucketKey key;
+  key.vertexFormat = mesh->GetVertexFormat();
+  key.geometry = mesh;
+  key.lod = model.GetCurrentLod();
+  key.material = material;
+  const Matrix4x4 *dequantize = key.vertexFormat == VertexFormat::Quantized
+                                    ? &mesh->GetDequantizeMatrix()
+                                    : nullptr;
+  batch_.Add(key, transform, color, dequantize);
+
+  Source source;
+  source.vbv = mesh->GetVertexBufferView();
+  source.ibv = mesh->GetIndexBufferView();
+  source.subsets = mesh->GetSubsets(key.lod);
+  source.subsetCount = mesh->GetSubsetCount();
+  source.model = &model;
+  sources_.push_back(source);
+}
+
+void InstancedRenderer::AddSphere_(const Sphere &sphere,
+                                   const Transform &transform,
+                                   const Vector4 &color) {
+  if (sphere.GetIndexCount() == 0)
+    return;
+
+  InstanceBucketKey key;
+  key.geometry = &sphere;
+  key.material = sphere.GetTexture().ptr;
+  batch_.Add(key, transform, color);
+
+  Source source;
+  source.vbv = sphere.GetVertexBufferView();
+  source.ibv = sphere.GetIndexBufferView();
+  source.whole = {0, sphere.GetIndexCount(), -1};
+  source.srv = sphere.GetTexture();
+  sources_.push_back(source);
+}
+
+void InstancedRenderer::End(const Matrix4x4 &view, const Matrix4x4 &proj) {
+  batch_.Build(Multiply(view, proj));
+
+  const std::vector<InstanceData> &instances = batch_.Instances();
+  // 上限を超えた分は描かない（Initialize の maxInstances を増やす）
+  assert(instances.size() <= maxInstances_);
+  uploadedCount_ =
+      static_cast<uint32_t>((std::min)(instances.size(), size_t(maxInstances_)));
+  std::memcpy(instanceMapped_ + size_t(frame_) * maxInstances_,
+              instances.data(), sizeof(InstanceData) * uploadedCount_);
+
+  stats_.instances = uploadedCount_;
+  stats_.buckets = static_cast<uint32_t>(batch_.Buckets().size());
+}
+
+void InstancedRenderer::Draw(ID3D12GraphicsCommandList *cmdList,
+                             PipelineManager &pipelines) {
+  stats_.drawCalls = 0;
+  stats_.pipelineChanges = 0;
+  if (uploadedCount_ == 0)
+    return;
+
+  cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+  // SV_InstanceID は StartInstanceLocation を含まないので、
+  // バケットの先頭をルート SRV のアドレスでずらす
+  const D3D12_GPU_VIRTUAL_ADDRESS frameBase =
+      instanceBuffer_->GetGPUVirtualAddress() +
+      sizeof(InstanceData) * size_t(frame_) * maxInstances_;
+
+  UINT64 boundSrv = 0;
+  const GraphicsPipeline *boundPipeline = nullptr;
+  ID3D12RootSignature *boundRoot = nullptr;
+  for (const InstanceBucket &bucket : batch_.Buckets()) {
+    if (bucket.firstInstance >= uploadedCount_)
+      break;
+    const uint32_t instanceCount =
+        (std::min)(bucket.instanceCount, uploadedCount_ - bucket.firstInstance);
+    const Source &source = sources_[bucket.firstSubmission];
+
+    // バケットは頂点形式順に並んでいるので、切り替えは形式の数まで
+    GraphicsPipeline *pipeline =
+        pipelines.Get(Object3DPipelineKey(bucket.key.vertexFormat, true));
+    assert(pipeline && "App で Object3DPipelineKey の PSO を登録する");
+    if (!pipeline)
+      continue;
+    if (pipeline != boundPipeline) {
+      // ルートシグネチャが変わるとルート引数は全部無効になるので入れ直す
+      if (pipeline->Root() != boundRoot) {
+        cmdList->SetGraphicsRootSignature(pipeline->Root());
+        cmdList->SetGraphicsRootConstantBufferView(
+            0, cbMat_.resource->GetGPUVirtualAddress());
+        cmdList->SetGraphicsRootConstantBufferView(
+            3, cbLight_.resource->GetGPUVirtualAddress());
+        boundRoot = pipeline->Root();
+        boundSrv = 0;
+      }
+      cmdList->SetPipelineState(pipeline->PSO());
+      boundPipeline = pipeline;
+      ++stats_.pipelineChanges;
+    }
+
+    cmdList->SetGraphicsRootShaderResourceView(
+        4, frameBase + sizeof(InstanceData) * bucket.firstInstance);
+    cmdList->IASetVertexBuffers(0, 1, &source.vbv);
+    cmdList->IASetIndexBuffer(&source.ibv);
+
+    const MeshSubset *subsets = source.subsets ? source.subsets : &source.whole;
+    for (uint32_t i = 0; i < source.subsetCount; ++i) {
+      if (subsets[i].indexCount == 0)
+        continue;
+      const D3D12_GPU_DESCRIPTOR_HANDLE srv =
+          source.model ? source.model->GetSubmeshSrv(i) : source.srv;
+      if (boundSrv == 0 || srv.ptr != boundSrv) {
+        cmdList->SetGraphicsRootDescriptorTable(2, srv);
+        boundSrv = srv.ptr;
+      }
+      cmdList->DrawIndexedInstanced(subsets[i].indexCount, instanceCount,
+                                    subsets[i].indexStart, 0, 0);
+      ++stats_.drawCalls;
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "Instancing/InstanceBatch.h"
+#include "struct.h"
+#include <d3d12.h>
+#include <vector>
+
+class Model3D;
+class PipelineManager;
+class Sphere;
+
+//==================================
+// インスタンス描画
+//==================================
+// Begin → Add（モデル / 球ごと）→ End で InstanceBatch に集めて
+// StructuredBuffer（アップロードヒープ、フレーム数分を順番に使う）へ書き、
+// Draw でバケット（メッシュ × マテリアル × LOD）ごとに 1 回だけ
+// DrawIndexedInstanced する（部分メッシュがあればその数だけ）。
+// 描画には INSTANCED 付きの Object3d.VS を使い、PSO はバケットの頂点形式に
+// 合わせて切り替える（Object3DPipelineKey(format, true) の名前）。
+// RootParam: 0:Material, 2:SRV, 3:Light, 4:インスタンス（t0, space1）
+class InstancedRenderer {
+public:
+  InstancedRenderer() = default;
+  ~InstancedRenderer();
+  InstancedRenderer(const InstancedRenderer &) = delete;
+  InstancedRenderer &operator=(const InstancedRenderer &) = delete;
+
+  // maxInstances は 1 フレームの上限、frameCount は GPU が同時に読みうる
+  // フレーム数（それだけの領域を順番に使う）
+  void Initialize(ID3D12Device *device, uint32_t maxInstances = 4096,
+                  uint32_t frameCount = 3);
+
+  // 全インスタンス共通のマテリアル（色はインスタンスごとの色と掛ける）/ ライト
+  Material *Mat() { return cbMat_.mapped; }
+  DirectionalLight *Light() { return cbLight_.mapped; }
+
+  // フレームの始め（前フレームの分を捨てて次の領域へ）
+  void Begin();
+
+  // モデルの Transform / 今の LOD / SRV で追加
+  void Add(const Model3D &model, const Vector4 &color = {1, 1, 1, 1});
+  // メッシュとテクスチャだけ使い、置き場所は transform
+  void Add(const Model3D &model, const Transform &transform,
+           const Vector4 &color = {1, 1, 1, 1});
+  void Add(const Sphere &sphere, const Vector4 &color = {1, 1, 1, 1});
+  void Add(const Sphere &sphere, const Transform &transform,
+           const Vector4 &color = {1, 1, 1, 1});
+
+  // 並べ替えて行列を計算し、インスタンスバッファへ書く
+  void End(const Matrix4x4 &view, const Matrix4x4 &proj);
+
+  // バケットごとに描く（PSO / ルートシグネチャは頂点形式が変わるたびに
+  // pipelines から引いて設定する）
+  void Draw(ID3D12GraphicsCommandList *cmdList, PipelineManager &pipelines);
+
+  struct Stats {
+    uint32_t instances = 0;
+    uint32_t buckets = 0;
+    uint32_t drawCalls = 0; // 直近の Draw
+    uint32_t pipelineChanges = 0; // 直近の Draw で PSO を設定した回数
+  };
+  const Stats &GetStats() const { return stats_; }
+  const InstanceBatch &GetBatch() const { return batch_; }
+
+private:
+  // バケットを描くのに必要なもの（Add ごとに控え、バケットの先頭のものを使う）
+  struct Source {
+    D3D12_VERTEX_BUFFER_VIEW vbv{};
+    D3D12_INDEX_BUFFER_VIEW ibv{};
+    const MeshSubset *subsets = nullptr; // nullptr なら whole
+    uint32_t subsetCount = 1;
+    MeshSubset whole{};
+    const Model3D *model = nullptr; // 部分メッシュの SRV を引く（球は nullptr）
+    D3D12_GPU_DESCRIPTOR_HANDLE srv{};
+  };
+
+  void AddModel_(const Model3D &model, const Transform &transform,
+                 const Vector4 &color);
+  void AddSphere_(const Sphere &sphere, const Transform &transform,
+                  const Vector4 &color);
+
+  ID3D12Device *device_ = nullptr;
+  InstanceBatch batch_;
+  std::vector<Source> sources_; // Add 順
+
+  // インスタンスバッファ（maxInstances_ 個 × frameCount_）
+  ID3D12Resource *instanceBuffer_ = nullptr;
+  InstanceData *instanceMapped_ = nullptr;
+  uint32_t maxInstances_ = 0;
+  uint32_t frameCount_ = 0;
+  uint32_t frame_ = 0;
+  uint32_t uploadedCount_ = 0; // 今フレームに書いた数（上限で切る）
+
+  struct CB_Material {
+    ID3D12Resource *resource = nullptr;
+    Material *mapped = nullptr;
+  };
+  struct CB_Light {
+    ID3D12Resource *resource = nullptr;
+    DirectionalLight *mapped = nullptr;
+  };
+  CB_Material cbMat_{};
+  CB_Light cbLight_{};
+
+  Stats stats_{};
+};
@@ -0,0 +1,425 @@
+#include "MeshCache.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// ファイル先頭（リトルエンディアン前提、各配列は 16 byte 境界）
+struct MeshCacheHeader {
+  char magic[8]; // "CG2MESH\0"
+  uint32_t version;
+  uint32_t headerSize;
+
+  // 元ファイル
+  int64_t sourceTimestamp;
+  uint64_t sourceSize;
+  uint64_t sourceHash;
+
+  uint32_t vertexCount;
+  uint32_t vertexStride;
+  uint32_t vertexFormat; // VertexFormat
+  float quantizationScale[3];
+  float quantizationOffset[3];
+  uint32_t reserved;
+  uint32_t indexCount;
+  uint32_t indexSize;
+  uint32_t subsetCount;
+  uint32_t materialCount;
+  uint64_t materialBytes; // 文字列（長さ uint32 + 本体）の合計
+  uint32_t lodCount;
+  uint32_t lodSettingCount; // MeshLodSettings
+  float lodTriangleRatio;
+  float lodMaxError;
+
+  float boundsMin[3];
+  float boundsMax[3];
+  float sphereCenter[3];
+  float sphereRadius;
+  float acmr[2]; // 最適化の前 / 後
+  float atvr[2];
+
+  uint64_t vertexOffset;
+  uint64_t indexOffset;
+  uint64_t subsetOffset;
+  uint64_t materialOffset;
+  uint64_t lodOffset;
+};
+static_assert(sizeof(MeshCacheHeader) % 8 == 0);
+static_assert(sizeof(MeshSubset) == 12);
+
+constexpr char kMagic[8] = {'C', 'G', '2', 'M', 'E', 'S', 'H', '\0'};
+constexpr uint64_t kAlignment = 16;
+
+uint64_t AlignUp(uint64_t value) {
+  return (value + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+// 更新時刻と大きさ（見つからなければ false）
+bool GetSourceStamp(const std::string &path, int64_t &outTimestamp,
+                    uint64_t &outSize) {
+  std::error_code ec;
+  const auto time = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    return false;
+  }
+  const auto size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return false;
+  }
+  outTimestamp = int64_t(time.time_since_epoch().count());
+  outSize = uint64_t(size);
+  return true;
+}
+
+bool HashFile(const std::string &path, uint64_t &outHash) {
+  MappedFile file;
+  if (!file.Open(path)) {
+    return false;
+  }
+  outHash = HashBytes(file.Data(), file.Size());
+  return true;
+}
+
+// 元ファイルの更新時刻だけ書き換える（中身が同じと確かめた後、次から
+// ハッシュを取り直さずに済むように）
+bool RestampSource(const std::string &cachePath, int64_t timestamp) {
+  std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.seekp(std::streamoff(offsetof(MeshCacheHeader, sourceTimestamp)));
+  file.write(reinterpret_cast<const char *>(&timestamp), sizeof(timestamp));
+  return bool(file);
+}
+
+// [offset, offset + size) がファイル内に収まるか
+bool InRange(uint64_t offset, uint64_t size, uint64_t fileSize) {
+  return offset <= fileSize && size <= fileSize - offset;
+}
+
+// 全インデックスが vertexCount 未満か
+template <class Index>
+bool IndicesInRange(const void *data, uint32_t indexCount,
+                    uint32_t vertexCount) {
+  const Index *indices = static_cast<const Index *>(data);
+  Index maxIndex = 0;
+  for (uint32_t i = 0; i < indexCount; ++i) {
+    maxIndex = (std::max)(maxIndex, indices[i]);
+  }
+  return indexCount == 0 || uint32_t(maxIndex) < vertexCount;
+}
+
+} // namespace
+
+uint64_t HashMeshCacheSettings(VertexFormat vertexFormat,
+                               const MeshLodSettings &lod) {
+  // 設定を増やしたらここにも足す
+  struct Key {
+    uint32_t vertexFormat;
+    uint32_t lodCount;
+    float triangleRatio;
+    float maxError;
+  };
+  const Key key = {uint32_t(vertexFormat), lod.lodCount, lod.triangleRatio,
+                   lod.maxError};
+  return HashBytes(&key, sizeof(key));
+}
+
+std::string MakeMeshCachePath(const std::string &sourcePath,
+                              uint64_t settingsHash) {
+  char suffix[32];
+  std::snprintf(suffix, sizeof(suffix), ".%016llx.cg2mesh",
+                static_cast<unsigned long long>(settingsHash));
+  std::filesystem::path path(sourcePath);
+  path.replace_extension(suffix);
+  return path.string();
+}
+
+uint64_t HashBytes(const void *data, size_t size) {
+  constexpr uint64_t kMul1 = 0x9E3779B185EBCA87ull;
+  constexpr uint64_t kMul2 = 0xC2B2AE3D27D4EB4Full;
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  uint64_t h = 0x27D4EB2F165667C5ull ^ (uint64_t(size) * kMul1);
+
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t w;
+    std::memcpy(&w, p + i, 8);
+    h ^= std::rotl(w * kMul2, 31) * kMul1;
+    h = std::rotl(h, 27) * kMul1 + 0x85EBCA77C2B2AE63ull;
+  }
+  if (i < size) {
+    uint64_t w = 0;
+    std::memcpy(&w, p + i, size - i);
+    h ^= std::rotl(w * kMul2, 31) * kMul1;
+  }
+
+  // 最後にかき混ぜる
+  h ^= h >> 33;
+  h *= kMul2;
+  h ^= h >> 29;
+  h *= kMul1;
+  h ^= h >> 32;
+  return h;
+}
+
+bool WriteMeshCache(const std::string &cachePath, const std::string &sourcePath,
+                    const MeshCacheData &data) {
+  MeshCacheHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kMeshCacheVersion;
+  header.headerSize = sizeof(MeshCacheHeader);
+  if (!GetSourceStamp(sourcePath, header.sourceTimestamp, header.sourceSize) ||
+      !HashFile(sourcePath, header.sourceHash)) {
+    return false;
+  }
+
+  header.vertexCount = data.vertexCount;
+  header.vertexStride = uint32_t(VertexStride(data.vertexFormat));
+  header.vertexFormat = uint32_t(data.vertexFormat);
+  header.quantizationScale[0] = data.quantization.scale.x;
+  header.quantizationScale[1] = data.quantization.scale.y;
+  header.quantizationScale[2] = data.quantization.scale.z;
+  header.quantizationOffset[0] = data.quantization.offset.x;
+  header.quantizationOffset[1] = data.quantization.offset.y;
+  header.quantizationOffset[2] = data.quantization.offset.z;
+  header.indexCount = data.indexCount;
+  header.indexSize = data.indexSize;
+  header.subsetCount = data.subsetCount;
+  header.lodCount = data.lodCount;
+  header.lodSettingCount = data.lodSettings.lodCount;
+  header.lodTriangleRatio = data.lodSettings.triangleRatio;
+  header.lodMaxError = data.lodSettings.maxError;
+  header.materialCount = uint32_t(data.texturePaths.size());
+  std::vector<char> strings;
+  for (const std::string &path : data.texturePaths) {
+    const uint32_t length = uint32_t(path.size());
+    const char *bytes = reinterpret_cast<const char *>(&length);
+    strings.insert(strings.end(), bytes, bytes + sizeof(length));
+    strings.insert(strings.end(), path.begin(), path.end());
+  }
+  header.materialBytes = strings.size();
+  header.boundsMin[0] = data.bounds.min.x;
+  header.boundsMin[1] = data.bounds.min.y;
+  header.boundsMin[2] = data.bounds.min.z;
+  header.boundsMax[0] = data.bounds.max.x;
+  header.boundsMax[1] = data.bounds.max.y;
+  header.boundsMax[2] = data.bounds.max.z;
+  header.sphereCenter[0] = data.boundingSphere.center.x;
+  header.sphereCenter[1] = data.boundingSphere.center.y;
+  header.sphereCenter[2] = data.boundingSphere.center.z;
+  header.sphereRadius = data.boundingSphere.radius;
+  header.acmr[0] = data.optimizeReport.before.acmr;
+  header.acmr[1] = data.optimizeReport.after.acmr;
+  header.atvr[0] = data.optimizeReport.before.atvr;
+  header.atvr[1] = data.optimizeReport.after.atvr;
+
+  const uint64_t vertexBytes = uint64_t(data.vertexCount) * header.vertexStride;
+  const uint64_t indexBytes = uint64_t(data.indexCount) * data.indexSize;
+  const uint64_t subsetBytes =
+      uint64_t(data.subsetCount) * data.lodCount * sizeof(MeshSubset);
+  const uint64_t lodBytes = uint64_t(data.lodCount) * sizeof(float);
+  header.vertexOffset = AlignUp(sizeof(MeshCacheHeader));
+  header.indexOffset = AlignUp(header.vertexOffset + vertexBytes);
+  header.subsetOffset = AlignUp(header.indexOffset + indexBytes);
+  header.lodOffset = AlignUp(header.subsetOffset + subsetBytes);
+  header.materialOffset = AlignUp(header.lodOffset + lodBytes);
+
+  // 一時ファイルに書いてから置き換える（途中で落ちても壊れたキャッシュを残さない）
+  const std::string tempPath = cachePath + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    const char zeros[kAlignment] = {};
+    auto writeAt = [&](uint64_t offset, const void *src, uint64_t size) {
+      const uint64_t pos = uint64_t(file.tellp());
+      file.write(zeros, std::streamsize(offset - pos));
+      if (size > 0) {
+        file.write(static_cast<const char *>(src), std::streamsize(size));
+      }
+    };
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writeAt(header.vertexOffset, data.vertexData, vertexBytes);
+    writeAt(header.indexOffset, data.indices, indexBytes);
+    writeAt(header.subsetOffset, data.subsets, subsetBytes);
+    const float noError = 0.0f; // lodErrors 省略時（LOD0 のみ）
+    assert(data.lodErrors || data.lodCount == 1);
+    writeAt(header.lodOffset, data.lodErrors ? data.lodErrors : &noError,
+            lodBytes);
+    writeAt(header.materialOffset, strings.data(), strings.size());
+    if (!file) {
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tempPath, cachePath, ec);
+  if (ec) {
+    std::filesystem::remove(tempPath, ec);
+    return false;
+  }
+  return true;
+}
+
+bool MeshCacheFile::Open(const std::string &cachePath,
+                         const std::string &sourcePath) {
+  Close();
+  if (!file_.Open(cachePath) || file_.Size() < sizeof(MeshCacheHeader)) {
+    Close();
+    return false;
+  }
+
+  MeshCacheHeader header;
+  std::memcpy(&header, file_.Data(), sizeof(header));
+  const uint64_t fileSize = file_.Size();
+  const bool valid =
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+      header.version == kMeshCacheVersion &&
+      header.headerSize == sizeof(MeshCacheHeader) &&
+      header.vertexFormat <= uint32_t(VertexFormat::Quantized) &&
+      header.vertexStride ==
+          VertexStride(static_cast<VertexFormat>(header.vertexFormat)) &&
+      (header.indexSize == 2 || header.indexSize == 4) &&
+      header.vertexOffset % kAlignment == 0 &&
+      header.indexOffset % kAlignment == 0 &&
+      header.subsetOffset % kAlignment == 0 &&
+      header.lodOffset % kAlignment == 0 && header.lodCount >= 1 &&
+      InRange(header.vertexOffset,
+              uint64_t(header.vertexCount) * header.vertexStride, fileSize) &&
+      InRange(header.indexOffset,
+              uint64_t(header.indexCount) * header.indexSize, fileSize) &&
+      InRange(header.subsetOffset,
+              uint64_t(header.subsetCount) * header.lodCount *
+                  sizeof(MeshSubset),
+              fileSize) &&
+      InRange(header.lodOffset, uint64_t(header.lodCount) * sizeof(float),
+              fileSize) &&
+      InRange(header.materialOffset, header.materialBytes, fileSize);
+  if (!valid) {
+    Close();
+    return false;
+  }
+
+  // 元ファイルとの照合（時刻が同じなら内容は見ない）
+  int64_t timestamp = 0;
+  uint64_t size = 0;
+  if (GetSourceStamp(sourcePath, timestamp, size)) {
+    if (size != header.sourceSize) {
+      Close();
+      return false;
+    }
+    if (timestamp != header.sourceTimestamp) {
+      uint64_t hash = 0;
+      if (!HashFile(sourcePath, hash) || hash != header.sourceHash) {
+        Close();
+        return false;
+      }
+      // 中身は同じ（触っただけ）：時刻を書き換えて次からはハッシュを省く。
+      // マップ中は書けない環境があるので、一度閉じてから書いて開き直す
+      file_.Close();
+      RestampSource(cachePath, timestamp); // 書けなくても読み込みは続ける
+      if (!file_.Open(cachePath) || file_.Size() != fileSize) {
+        Close();
+        return false;
+      }
+    }
+  }
+
+  // マテリアルのパス
+  const uint8_t *base = file_.Data();
+  std::vector<std::string> texturePaths(header.materialCount);
+  {
+    const uint8_t *p = base + header.materialOffset;
+    const uint8_t *const end = p + header.materialBytes;
+    for (std::string &path : texturePaths) {
+      uint32_t length = 0;
+      if (end - p < ptrdiff_t(sizeof(length))) {
+        Close();
+        return false;
+      }
+      std::memcpy(&length, p, sizeof(length));
+      p += sizeof(length);
+      if (uint64_t(end - p) < length) {
+        Close();
+        return false;
+      }
+      path.assign(reinterpret_cast<const char *>(p), length);
+      p += length;
+    }
+  }
+
+  // 部分メッシュが IB とマテリアルの範囲内か
+  const MeshSubset *subsets =
+      reinterpret_cast<const MeshSubset *>(base + header.subsetOffset);
+  for (uint64_t i = 0; i < uint64_t(header.subsetCount) * header.lodCount;
+       ++i) {
+    if (uint64_t(subsets[i].indexStart) + subsets[i].indexCount >
+            header.indexCount ||
+        subsets[i].materialIndex >= int32_t(header.materialCount) ||
+        subsets[i].materialIndex < -1) {
+      Close();
+      return false;
+    }
+  }
+
+  // 範囲外のインデックスは GPU で読み出し違反になるので、壊れたものとして扱う
+  const void *indices = base + header.indexOffset;
+  const bool indicesValid =
+      header.indexSize == sizeof(uint16_t)
+          ? IndicesInRange<uint16_t>(indices, header.indexCount,
+                                     header.vertexCount)
+          : IndicesInRange<uint32_t>(indices, header.indexCount,
+                                     header.vertexCount);
+  if (!indicesValid) {
+    Close();
+    return false;
+  }
+
+  data_.vertexData = base + header.vertexOffset;
+  data_.vertexCount = header.vertexCount;
+  data_.vertexFormat = static_cast<VertexFormat>(header.vertexFormat);
+  data_.quantization.scale = {header.quantizationScale[0],
+                              header.quantizationScale[1],
+                              header.quantizationScale[2]};
+  data_.quantization.offset = {header.quantizationOffset[0],
+                               header.quantizationOffset[1],
+                               header.quantizationOffset[2]};
+  data_.indices = indices;
+  data_.indexCount = header.indexCount;
+  data_.indexSize = header.indexSize;
+  data_.subsets = subsets;
+  data_.subsetCount = header.subsetCount;
+  data_.lodCount = header.lodCount;
+  data_.lodErrors = reinterpret_cast<const float *>(base + header.lodOffset);
+  data_.lodSettings.lodCount = header.lodSettingCount;
+  data_.lodSettings.triangleRatio = header.lodTriangleRatio;
+  data_.lodSettings.maxError = header.lodMaxError;
+  data_.bounds.min = {header.boundsMin[0], header.boundsMin[1],
+                      header.boundsMin[2]};
+  data_.bounds.max = {header.boundsMax[0], header.boundsMax[1],
+                      header.boundsMax[2]};
+  data_.boundingSphere.center = {header.sphereCenter[0],
+                                 header.sphereCenter[1],
+                                 header.sphereCenter[2]};
+  data_.boundingSphere.radius = header.sphereRadius;
+  data_.optimizeReport.before = {header.acmr[0], header.atvr[0]};
+  data_.optimizeReport.after = {header.acmr[1], header.atvr[1]};
+  data_.texturePaths = std::move(texturePaths);
+  return true;
+}
+
+void MeshCacheFile::Close() {
+  file_.Close();
+  data_ = MeshCacheData{};
+}
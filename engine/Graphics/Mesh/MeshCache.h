@@ -0,0 +1,81 @@
+#pragma once
+#include "File/MappedFile.h"
+#include "Mesh/MeshOptimize.h"
+#include "Mesh/MeshSimplify.h"
+#include "VertexFormat/VertexFormat.h"
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//==================================
+// バイナリメッシュキャッシュ（.cg2mesh）
+//==================================
+// OBJ を解析・溶接・最適化した結果（VB / IB の中身そのもの、境界、部分メッシュ、
+// LOD、マテリアルごとのテクスチャのパス）を保存する。読み込みはメモリマップしたまま Data() の
+// ポインタを返すだけなので、頂点ごとの処理はない（VB は頂点フォーマットで
+// 詰めた後の形で持つので、Compact / Quantized も詰め直さない）。
+// 元ファイルの更新時刻が同じならそのまま使い、違えば内容のハッシュで確かめる
+// （同じなら時刻を書き直すので、ハッシュを取るのはその 1 回だけ）。
+// 中身を変える設定（頂点フォーマット / LOD）はファイル名のハッシュで分けるので、
+// 設定の違うモデルが同じキャッシュを書き合うことはない。
+
+// 形式を変えたら上げる（古いキャッシュは読まずに作り直す）
+constexpr uint32_t kMeshCacheVersion = 5;
+
+// キャッシュの中身（読み込み時はマップした領域を指す）
+struct MeshCacheData {
+  // VB の中身（vertexFormat で詰めた形、1 頂点 VertexStride(vertexFormat) byte）
+  const void *vertexData = nullptr;
+  uint32_t vertexCount = 0;
+  VertexFormat vertexFormat = VertexFormat::Standard;
+  VertexQuantization quantization{}; // Quantized のときの scale/offset
+  const void *indices = nullptr; // indexSize が 2 なら uint16_t、4 なら uint32_t
+  uint32_t indexCount = 0;
+  uint32_t indexSize = 4;
+  const MeshSubset *subsets = nullptr; // subsetCount * lodCount 個
+  uint32_t subsetCount = 0;            // 1 LOD あたり
+
+  // LOD（subsets は [LOD][部分メッシュ] の順、誤差はメッシュ座標）
+  uint32_t lodCount = 1;
+  const float *lodErrors = nullptr;
+  MeshLodSettings lodSettings{}; // 作ったときの設定（違えば作り直す）
+
+  AABB bounds{};
+  SphereData boundingSphere{};
+  MeshOptimizeReport optimizeReport{};
+  // マテリアルごとのテクスチャ（MeshSubset::materialIndex で引く、なければ空）
+  std::vector<std::string> texturePaths;
+};
+
+// キャッシュの中身を変える設定のハッシュ（MakeMeshCachePath に渡す）
+uint64_t HashMeshCacheSettings(VertexFormat vertexFormat,
+                               const MeshLodSettings &lod);
+
+// "dir/teapot.obj" -> "dir/teapot.<settingsHash の 16 進>.cg2mesh"
+std::string MakeMeshCachePath(const std::string &sourcePath,
+                              uint64_t settingsHash);
+
+// 内容のハッシュ（64bit、8 byte ずつ混ぜる）
+uint64_t HashBytes(const void *data, size_t size);
+
+// sourcePath の更新時刻と内容のハッシュを添えて書く（一時ファイル経由で置き換え）
+bool WriteMeshCache(const std::string &cachePath, const std::string &sourcePath,
+                    const MeshCacheData &data);
+
+class MeshCacheFile {
+public:
+  // 形式・版・元ファイルが一致しなければ false。
+  // インデックスが頂点数を超えるもの（壊れたファイル）も読まない。
+  // 元ファイルが見つからない場合はキャッシュだけで読む
+  bool Open(const std::string &cachePath, const std::string &sourcePath);
+  void Close();
+
+  // Open 中だけ有効
+  const MeshCacheData &Data() const { return data_; }
+
+private:
+  MappedFile file_;
+  MeshCacheData data_;
+};
@@ -0,0 +1,489 @@
+#include "MeshOptimize.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+//==================================
+// Forsyth のスコア
+//==================================
+// 直前の三角形の頂点は少し下げ（同じ辺ばかり続けないため）、キャッシュの
+// 奥ほど下げる。残りの三角形が少ない頂点は早く使い切るよう上げる。
+
+constexpr int kCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+// これ以上の残り三角形数は同じスコア
+constexpr uint32_t kMaxValence = 32;
+constexpr uint32_t kNone = UINT32_MAX;
+
+struct ScoreTable {
+  float cache[kCacheSize];
+  float valence[kMaxValence + 1];
+
+  ScoreTable() {
+    for (int i = 0; i < kCacheSize; ++i) {
+      if (i < 3) {
+        cache[i] = kLastTriScore;
+      } else {
+        const float s = 1.0f - float(i - 3) / float(kCacheSize - 3);
+        cache[i] = std::pow(s, kCacheDecayPower);
+      }
+    }
+    valence[0] = 0.0f;
+    for (uint32_t i = 1; i <= kMaxValence; ++i) {
+      valence[i] = kValenceBoostScale * std::pow(float(i), -kValenceBoostPower);
+    }
+  }
+
+  float Score(int cachePosition, uint32_t remaining) const {
+    if (remaining == 0) {
+      return -1.0f; // もう使わない
+    }
+    float score = cachePosition >= 0 ? cache[cachePosition] : 0.0f;
+    score += valence[remaining < kMaxValence ? remaining : kMaxValence];
+    return score;
+  }
+};
+
+const ScoreTable &Scores() {
+  static const ScoreTable table;
+  return table;
+}
+
+// FIFO キャッシュの見積もり：追い出されるまでに cacheSize 回の取り込みが
+// あったかで判定する
+class FifoCache {
+public:
+  FifoCache(size_t vertexCount, uint32_t cacheSize)
+      : timestamps_(vertexCount, 0), timestamp_(cacheSize + 1),
+        size_(cacheSize) {}
+
+  // 取り込んだら 1（外れ）、入っていれば 0
+  uint32_t Touch(uint32_t v) {
+    assert(v < timestamps_.size());
+    if (timestamp_ - timestamps_[v] > size_) {
+      timestamps_[v] = timestamp_++;
+      return 1;
+    }
+    return 0;
+  }
+  // 全部追い出した状態にする
+  void Reset() { timestamp_ += size_ + 1; }
+
+private:
+  std::vector<uint32_t> timestamps_;
+  uint32_t timestamp_;
+  uint32_t size_;
+};
+
+template <class Index>
+VertexCacheStats AnalyzeVertexCacheT(const Index *indices, size_t indexCount,
+                                     size_t vertexCount, uint32_t cacheSize) {
+  VertexCacheStats stats;
+  if (indexCount < 3 || vertexCount == 0) {
+    return stats;
+  }
+
+  FifoCache cache(vertexCount, cacheSize);
+  size_t misses = 0;
+  for (size_t i = 0; i < indexCount; ++i) {
+    misses += cache.Touch(uint32_t(indices[i]));
+  }
+  stats.acmr = float(misses) / float(indexCount / 3);
+  stats.atvr = float(misses) / float(vertexCount);
+  return stats;
+}
+
+template <class Index>
+void OptimizeVertexCacheT(Index *indices, size_t indexCount,
+                          size_t vertexCount) {
+  const size_t triCount = indexCount / 3;
+  if (triCount == 0 || vertexCount == 0) {
+    return;
+  }
+  const ScoreTable &table = Scores();
+
+  // 頂点 -> 三角形の隣接表（先頭 remaining[v] 個が未出力）
+  std::vector<uint32_t> remaining(vertexCount, 0);
+  for (size_t i = 0; i < triCount * 3; ++i) {
+    assert(indices[i] < vertexCount);
+    ++remaining[indices[i]];
+  }
+  std::vector<uint32_t> offsets(vertexCount + 1, 0);
+  for (size_t v = 0; v < vertexCount; ++v) {
+    offsets[v + 1] = offsets[v] + remaining[v];
+  }
+  std::vector<uint32_t> adjacency(triCount * 3);
+  {
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triCount; ++t) {
+      for (int k = 0; k < 3; ++k) {
+        adjacency[fill[indices[t * 3 + k]]++] = uint32_t(t);
+      }
+    }
+  }
+
+  std::vector<int> cachePosition(vertexCount, -1);
+  std::vector<float> vertexScore(vertexCount);
+  for (size_t v = 0; v < vertexCount; ++v) {
+    vertexScore[v] = table.Score(-1, remaining[v]);
+  }
+  std::vector<float> triScore(triCount);
+  std::vector<uint8_t> emitted(triCount, 0);
+  uint32_t bestTri = 0;
+  for (size_t t = 0; t < triCount; ++t) {
+    triScore[t] = vertexScore[indices[t * 3]] +
+                  vertexScore[indices[t * 3 + 1]] +
+                  vertexScore[indices[t * 3 + 2]];
+    if (triScore[t] > triScore[bestTri]) {
+      bestTri = uint32_t(t);
+    }
+  }
+
+  std::vector<Index> output(triCount * 3);
+  std::vector<uint32_t> cache, nextCache;
+  cache.reserve(kCacheSize + 3);
+  nextCache.reserve(kCacheSize + 3);
+  size_t scanCursor = 0;
+
+  for (size_t out = 0; out < triCount; ++out) {
+    if (bestTri == kNone) {
+      // キャッシュ内に候補がなければ入力順で次の未出力三角形
+      while (emitted[scanCursor]) {
+        ++scanCursor;
+      }
+      bestTri = uint32_t(scanCursor);
+    }
+
+    const uint32_t t = bestTri;
+    emitted[t] = 1;
+    const uint32_t tri[3] = {uint32_t(indices[t * 3]),
+                             uint32_t(indices[t * 3 + 1]),
+                             uint32_t(indices[t * 3 + 2])};
+    for (int k = 0; k < 3; ++k) {
+      output[out * 3 + k] = Index(tri[k]);
+
+      // 隣接表の未出力部分から外す
+      const uint32_t v = tri[k];
+      uint32_t *adj = adjacency.data() + offsets[v];
+      uint32_t &count = remaining[v];
+      for (uint32_t i = 0; i < count; ++i) {
+        if (adj[i] == t) {
+          adj[i] = adj[count - 1];
+          adj[count - 1] = t;
+          --count;
+          break;
+        }
+      }
+    }
+
+    // 今の三角形を先頭にしてキャッシュを更新
+    nextCache.clear();
+    for (int k = 0; k < 3; ++k) {
+      bool dup = false;
+      for (uint32_t c : nextCache) {
+        dup |= c == tri[k];
+      }
+      if (!dup) {
+        nextCache.push_back(tri[k]);
+      }
+    }
+    for (uint32_t c : cache) {
+      if (c != tri[0] && c != tri[1] && c != tri[2]) {
+        nextCache.push_back(c);
+      }
+    }
+    for (size_t i = kCacheSize; i < nextCache.size(); ++i) {
+      cachePosition[nextCache[i]] = -1; // 追い出し
+    }
+    for (size_t i = 0; i < nextCache.size(); ++i) {
+      const uint32_t v = nextCache[i];
+      cachePosition[v] = i < size_t(kCacheSize) ? int(i) : -1;
+      vertexScore[v] = table.Score(cachePosition[v], remaining[v]);
+    }
+
+    // スコアが変わった頂点に接する三角形だけ計算し直し、最良を選ぶ
+    bestTri = kNone;
+    float bestScore = -1.0f;
+    for (uint32_t v : nextCache) {
+      const uint32_t *adj = adjacency.data() + offsets[v];
+      for (uint32_t i = 0; i < remaining[v]; ++i) {
+        const uint32_t u = adj[i];
+        const float s = vertexScore[indices[u * 3]] +
+                        vertexScore[indices[u * 3 + 1]] +
+                        vertexScore[indices[u * 3 + 2]];
+        triScore[u] = s;
+        if (s > bestScore || (s == bestScore && u < bestTri)) {
+          bestScore = s;
+          bestTri = u;
+        }
+      }
+    }
+
+    if (nextCache.size() > size_t(kCacheSize)) {
+      nextCache.resize(kCacheSize);
+    }
+    cache.swap(nextCache);
+  }
+
+  for (size_t i = 0; i < triCount * 3; ++i) {
+    indices[i] = output[i];
+  }
+}
+
+//==================================
+// 重ね描きの削減（Tipsify の後段と同じ考え方）
+//==================================
+// 1. キャッシュ順の中で 3 頂点とも外れる三角形を切れ目にする（そこから先の
+//    順番を入れ替えてもキャッシュ効率はほとんど変わらない）
+// 2. 各まとまりをさらに、先頭から冷えたキャッシュで数えた ACMR が
+//    まとまり全体の threshold 倍以下になった所で切る
+// 3. まとまりの面積重みの中心と法線から「メッシュの中心からどれだけ外を
+//    向いているか」を求め、大きい順（同じなら元の順）に並べる
+
+template <class Index>
+void OptimizeOverdrawT(const std::vector<VertexData> &vertices, Index *indices,
+                       size_t indexCount, float threshold) {
+  const size_t triCount = indexCount / 3;
+  if (triCount < 2 || vertices.empty()) {
+    return;
+  }
+
+  FifoCache cache(vertices.size(), kVertexCacheSize);
+  auto touchTriangle = [&](size_t t) {
+    return cache.Touch(uint32_t(indices[t * 3])) +
+           cache.Touch(uint32_t(indices[t * 3 + 1])) +
+           cache.Touch(uint32_t(indices[t * 3 + 2]));
+  };
+
+  // 1. 3 頂点とも外れる所で切る
+  std::vector<uint32_t> hard;
+  hard.push_back(0);
+  for (size_t t = 0; t < triCount; ++t) {
+    if (touchTriangle(t) == 3 && t > 0) {
+      hard.push_back(uint32_t(t));
+    }
+  }
+  hard.push_back(uint32_t(triCount));
+
+  // 2. ACMR が悪くならない所でさらに切る
+  std::vector<uint32_t> clusters; // 各まとまりの先頭（最後に triCount）
+  for (size_t h = 0; h + 1 < hard.size(); ++h) {
+    const uint32_t start = hard[h], end = hard[h + 1];
+    cache.Reset();
+    uint32_t misses = 0;
+    for (uint32_t t = start; t < end; ++t) {
+      misses += touchTriangle(t);
+    }
+    const float limit = threshold * float(misses) / float(end - start);
+
+    clusters.push_back(start);
+    cache.Reset();
+    uint32_t runMisses = 0, runTris = 0;
+    for (uint32_t t = start; t + 1 < end; ++t) {
+      runMisses += touchTriangle(t);
+      ++runTris;
+      if (float(runMisses) <= limit * float(runTris)) {
+        clusters.push_back(t + 1);
+        cache.Reset();
+        runMisses = runTris = 0;
+      }
+    }
+  }
+  const size_t clusterCount = clusters.size();
+  clusters.push_back(uint32_t(triCount));
+
+  // 3. まとまりごとの面積重みの中心と法線（e1 × e2 が表）
+  struct ClusterShape {
+    Vector3 center{0.0f, 0.0f, 0.0f}; // 面積 × 中心の和
+    Vector3 normal{0.0f, 0.0f, 0.0f}; // e1 × e2 の和（面積 × 2 × 法線）
+    float area = 0.0f;
+  };
+  std::vector<ClusterShape> shapes(clusterCount);
+  ClusterShape mesh;
+  for (size_t c = 0; c < clusterCount; ++c) {
+    ClusterShape &shape = shapes[c];
+    for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+      const Vector4 &a = vertices[indices[t * 3]].position;
+      const Vector4 &b = vertices[indices[t * 3 + 1]].position;
+      const Vector4 &d = vertices[indices[t * 3 + 2]].position;
+      const float e1x = b.x - a.x, e1y = b.y - a.y, e1z = b.z - a.z;
+      const float e2x = d.x - a.x, e2y = d.y - a.y, e2z = d.z - a.z;
+      const Vector3 n = {e1y * e2z - e1z * e2y, e1z * e2x - e1x * e2z,
+                         e1x * e2y - e1y * e2x};
+      const float area = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+      shape.center.x += area * (a.x + b.x + d.x) / 3.0f;
+      shape.center.y += area * (a.y + b.y + d.y) / 3.0f;
+      shape.center.z += area * (a.z + b.z + d.z) / 3.0f;
+      shape.normal.x += n.x;
+      shape.normal.y += n.y;
+      shape.normal.z += n.z;
+      shape.area += area;
+    }
+    mesh.center.x += shape.center.x;
+    mesh.center.y += shape.center.y;
+    mesh.center.z += shape.center.z;
+    mesh.area += shape.area;
+  }
+  if (mesh.area <= 0.0f) {
+    return; // 全部縮退
+  }
+  const Vector3 meshCenter = {mesh.center.x / mesh.area,
+                              mesh.center.y / mesh.area,
+                              mesh.center.z / mesh.area};
+
+  std::vector<float> sortKey(clusterCount, 0.0f);
+  for (size_t c = 0; c < clusterCount; ++c) {
+    const ClusterShape &shape = shapes[c];
+    const float length = std::sqrt(shape.normal.x * shape.normal.x +
+                                   shape.normal.y * shape.normal.y +
+                                   shape.normal.z * shape.normal.z);
+    if (shape.area <= 0.0f || length <= 0.0f) {
+      continue;
+    }
+    const float cx = shape.center.x / shape.area - meshCenter.x;
+    const float cy = shape.center.y / shape.area - meshCenter.y;
+    const float cz = shape.center.z / shape.area - meshCenter.z;
+    sortKey[c] =
+        (cx * shape.normal.x + cy * shape.normal.y + cz * shape.normal.z) /
+        length;
+  }
+
+  std::vector<uint32_t> order(clusterCount);
+  for (size_t c = 0; c < clusterCount; ++c) {
+    order[c] = uint32_t(c);
+  }
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return sortKey[a] > sortKey[b];
+  });
+
+  std::vector<Index> output;
+  output.reserve(triCount * 3);
+  for (uint32_t c : order) {
+    output.insert(output.end(), indices + size_t(clusters[c]) * 3,
+                  indices + size_t(clusters[c + 1]) * 3);
+  }
+  std::copy(output.begin(), output.end(), indices);
+}
+
+template <class Index>
+void OptimizeVertexFetchT(std::vector<VertexData> &vertices, Index *indices,
+                          size_t indexCount) {
+  const size_t vertexCount = vertices.size();
+  std::vector<uint32_t> remap(vertexCount, kNone);
+  std::vector<VertexData> reordered;
+  reordered.reserve(vertexCount);
+
+  for (size_t i = 0; i < indexCount; ++i) {
+    const Index v = indices[i];
+    assert(v < vertexCount);
+    if (remap[v] == kNone) {
+      remap[v] = uint32_t(reordered.size());
+      reordered.push_back(vertices[v]);
+    }
+    indices[i] = Index(remap[v]);
+  }
+  for (size_t v = 0; v < vertexCount; ++v) {
+    if (remap[v] == kNone) {
+      reordered.push_back(vertices[v]);
+    }
+  }
+  vertices.swap(reordered);
+}
+
+template <class Index>
+MeshOptimizeReport OptimizeMeshT(std::vector<VertexData> &vertices,
+                                 std::vector<Index> &indices,
+                                 const MeshSubset *subsets,
+                                 size_t subsetCount) {
+  MeshOptimizeReport report;
+  report.before = AnalyzeVertexCacheT(indices.data(), indices.size(),
+                                      vertices.size(), kVertexCacheSize);
+  if (subsets) {
+    // 三角形は部分メッシュの範囲内でだけ動かす
+    for (size_t i = 0; i < subsetCount; ++i) {
+      assert(size_t(subsets[i].indexStart) + subsets[i].indexCount <=
+             indices.size());
+      OptimizeVertexCacheT(indices.data() + subsets[i].indexStart,
+                           subsets[i].indexCount, vertices.size());
+      OptimizeOverdrawT(vertices, indices.data() + subsets[i].indexStart,
+                        subsets[i].indexCount, kOverdrawThreshold);
+    }
+  } else {
+    OptimizeVertexCacheT(indices.data(), indices.size(), vertices.size());
+    OptimizeOverdrawT(vertices, indices.data(), indices.size(),
+                      kOverdrawThreshold);
+  }
+  OptimizeVertexFetchT(vertices, indices.data(), indices.size());
+  report.after = AnalyzeVertexCacheT(indices.data(), indices.size(),
+                                     vertices.size(), kVertexCacheSize);
+  return report;
+}
+
+} // namespace
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t *indices, size_t indexCount,
+                                    size_t vertexCount, uint32_t cacheSize) {
+  return AnalyzeVertexCacheT(indices, indexCount, vertexCount, cacheSize);
+}
+
+VertexCacheStats AnalyzeVertexCache(const uint16_t *indices, size_t indexCount,
+                                    size_t vertexCount, uint32_t cacheSize) {
+  return AnalyzeVertexCacheT(indices, indexCount, vertexCount, cacheSize);
+}
+
+void OptimizeVertexCache(uint32_t *indices, size_t indexCount,
+                         size_t vertexCount) {
+  OptimizeVertexCacheT(indices, indexCount, vertexCount);
+}
+
+void OptimizeVertexCache(uint16_t *indices, size_t indexCount,
+                         size_t vertexCount) {
+  OptimizeVertexCacheT(indices, indexCount, vertexCount);
+}
+
+void OptimizeOverdraw(const std::vector<VertexData> &vertices,
+                      uint32_t *indices, size_t indexCount, float threshold) {
+  OptimizeOverdrawT(vertices, indices, indexCount, threshold);
+}
+
+void OptimizeOverdraw(const std::vector<VertexData> &vertices,
+                      uint16_t *indices, size_t indexCount, float threshold) {
+  OptimizeOverdrawT(vertices, indices, indexCount, threshold);
+}
+
+void OptimizeVertexFetch(std::vector<VertexData> &vertices, uint32_t *indices,
+                         size_t indexCount) {
+  OptimizeVertexFetchT(vertices, indices, indexCount);
+}
+
+void OptimizeVertexFetch(std::vector<VertexData> &vertices, uint16_t *indices,
+                         size_t indexCount) {
+  OptimizeVertexFetchT(vertices, indices, indexCount);
+}
+
+MeshOptimizeReport OptimizeMesh(std::vector<VertexData> &vertices,
+                                std::vector<uint32_t> &indices) {
+  return OptimizeMeshT(vertices, indices, nullptr, 0);
+}
+
+MeshOptimizeReport OptimizeMesh(std::vector<VertexData> &vertices,
+                                std::vector<uint16_t> &indices) {
+  return OptimizeMeshT(vertices, indices, nullptr, 0);
+}
+
+MeshOptimizeReport OptimizeMesh(std::vector<VertexData> &vertices,
+                                std::vector<uint32_t> &indices,
+                                const MeshSubset *subsets, size_t subsetCount) {
+  return OptimizeMeshT(vertices, indices, subsets, subsetCount);
+}
+
+MeshOptimizeReport OptimizeMesh(std::vector<VertexData> &vertices,
+                                std::vector<uint16_t> &indices,
+                                const MeshSubset *subsets, size_t subsetCount) {
+  return OptimizeMeshT(vertices, indices, subsets, subsetCount);
+}
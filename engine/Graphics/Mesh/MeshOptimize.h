@@ -0,0 +1,74 @@
+#pragma once
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// インデックス付きメッシュの並べ替え（D3D 非依存）
+//==================================
+// 1. 頂点キャッシュ最適化：Forsyth の方式で三角形の順番を並べ替え、
+//    変換後頂点キャッシュに当たりやすくする
+// 2. 重ね描きの削減：1 の順番をキャッシュの切れ目でまとまりに分け、
+//    外を向いたまとまりから先に描く（奥が深度テストで弾かれやすくなる）
+// 3. 頂点フェッチ最適化：インデックスで最初に使われる順に頂点を並べ直す
+// どれも入力だけで結果が決まる（同じ入力なら同じ出力）。
+
+// 頂点キャッシュの効率（FIFO キャッシュでの見積もり）
+struct VertexCacheStats {
+  float acmr = 0.0f; // 三角形 1 枚あたりの頂点変換回数（0.5 〜 3）
+  float atvr = 0.0f; // 頂点 1 個あたりの変換回数（1 が理想）
+};
+
+// 既定のキャッシュサイズ（見積もり用。実 GPU の値とは限らない）
+constexpr uint32_t kVertexCacheSize = 16;
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t *indices, size_t indexCount,
+                                    size_t vertexCount,
+                                    uint32_t cacheSize = kVertexCacheSize);
+VertexCacheStats AnalyzeVertexCache(const uint16_t *indices, size_t indexCount,
+                                    size_t vertexCount,
+                                    uint32_t cacheSize = kVertexCacheSize);
+
+// 三角形の順番を並べ替える（その場で書き換え）
+void OptimizeVertexCache(uint32_t *indices, size_t indexCount,
+                         size_t vertexCount);
+void OptimizeVertexCache(uint16_t *indices, size_t indexCount,
+                         size_t vertexCount);
+
+// 重ね描きを減らすための並べ替えで許す ACMR の悪化（1.05 なら 5% まで）
+constexpr float kOverdrawThreshold = 1.05f;
+
+// OptimizeVertexCache 済みの三角形列をまとまりに分け、メッシュの中心から
+// 見て外を向いたまとまりほど先になるよう並べ替える（その場で書き換え）。
+// まとまりの中の順番は変えない。threshold を大きくするほど細かく分ける
+void OptimizeOverdraw(const std::vector<VertexData> &vertices,
+                      uint32_t *indices, size_t indexCount,
+                      float threshold = kOverdrawThreshold);
+void OptimizeOverdraw(const std::vector<VertexData> &vertices,
+                      uint16_t *indices, size_t indexCount,
+                      float threshold = kOverdrawThreshold);
+
+// 頂点を最初に使われる順へ並べ直し、インデックスを付け替える
+// （使われていない頂点は元の順で末尾へ）
+void OptimizeVertexFetch(std::vector<VertexData> &vertices, uint32_t *indices,
+                         size_t indexCount);
+void OptimizeVertexFetch(std::vector<VertexData> &vertices, uint16_t *indices,
+                         size_t indexCount);
+
+// 上の 3 つを続けて行い、前後の効率を返す
+struct MeshOptimizeReport {
+  VertexCacheStats before;
+  VertexCacheStats after;
+};
+MeshOptimizeReport OptimizeMesh(std::vector<VertexData> &vertices,
+                                std::vector<uint32_t> &indices);
+MeshOptimizeReport OptimizeMesh(std::vector<VertexData> &vertices,
+                                std::vector<uint16_t> &indices);
+// 部分メッシュ付き（三角形は各範囲の中でだけ並べ替え、範囲は変わらない）
+MeshOptimizeReport OptimizeMesh(std::vector<VertexData> &vertices,
+                                std::vector<uint32_t> &indices,
+                                const MeshSubset *subsets, size_t subsetCount);
+MeshOptimizeReport OptimizeMesh(std::vector<VertexData> &vertices,
+                                std::vector<uint16_t> &indices,
+                                const MeshSubset *subsets, size_t subsetCount);
@@ -0,0 +1,692 @@
+#include "MeshSimplify.h"
+#include "MeshOptimize.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+
+namespace {
+
+constexpr uint32_t kNone = UINT32_MAX;
+constexpr float kNoCollapse = std::numeric_limits<float>::infinity();
+// 縁の平面の重み（面の平面より強くして縁の形を保つ）
+constexpr double kBorderWeight = 10.0;
+// これより減らなければ次の LOD は作らない
+constexpr float kMinLodReduction = 0.9f;
+
+struct Vec3d {
+  double x, y, z;
+};
+
+Vec3d Sub(const Vec3d &a, const Vec3d &b) {
+  return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+Vec3d Cross(const Vec3d &a, const Vec3d &b) {
+  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+          a.x * b.y - a.y * b.x};
+}
+double Dot(const Vec3d &a, const Vec3d &b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+double Length(const Vec3d &a) { return std::sqrt(Dot(a, a)); }
+
+// 平面までの距離の二乗和（面積で重み付け、weight は重みの合計）
+struct Quadric {
+  double a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+  double b0 = 0, b1 = 0, b2 = 0, c = 0;
+  double weight = 0;
+
+  // n・p + d = 0（n は正規化済み）
+  void AddPlane(const Vec3d &n, double d, double w) {
+    a00 += w * n.x * n.x;
+    a11 += w * n.y * n.y;
+    a22 += w * n.z * n.z;
+    a01 += w * n.x * n.y;
+    a02 += w * n.x * n.z;
+    a12 += w * n.y * n.z;
+    b0 += w * n.x * d;
+    b1 += w * n.y * d;
+    b2 += w * n.z * d;
+    c += w * d * d;
+    weight += w;
+  }
+
+  void Add(const Quadric &q) {
+    a00 += q.a00;
+    a11 += q.a11;
+    a22 += q.a22;
+    a01 += q.a01;
+    a02 += q.a02;
+    a12 += q.a12;
+    b0 += q.b0;
+    b1 += q.b1;
+    b2 += q.b2;
+    c += q.c;
+    weight += q.weight;
+  }
+
+  // 重み付きの二乗和（重みで割る前）
+  double Evaluate(const Vec3d &p) const {
+    const double e = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z +
+                     2.0 * (a01 * p.x * p.y + a02 * p.x * p.z +
+                            a12 * p.y * p.z) +
+                     2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+    return e > 0.0 ? e : 0.0;
+  }
+};
+
+enum class PositionKind : uint8_t {
+  Manifold, // 内部
+  Border,   // 開いた縁の上（縁に沿ってだけ動かす）
+  Locked,   // 動かさない（非多様体の辺 / lockBorder の縁）
+};
+
+uint64_t EdgeKey(uint32_t a, uint32_t b) {
+  return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+
+// 縮約の候補（from の位置を to の位置へ寄せる）
+// 積んだときの両端の版を覚えておき、どちらかが縮約で変わっていたら捨てる
+struct Collapse {
+  uint32_t from;
+  uint32_t to;
+  uint32_t fromVersion;
+  uint32_t toVersion;
+  float error;
+};
+
+// キューには「誤差のビット列 << 32 | 候補の番号」だけを置く（ヒープを小さく
+// 保つため）。誤差は 0 以上なので、ビット列の大小が誤差の大小と一致する
+uint64_t QueueKey(float error, uint32_t slot) {
+  uint32_t bits;
+  std::memcpy(&bits, &error, sizeof(bits));
+  return (uint64_t(bits) << 32) | slot;
+}
+
+// 同じ位置の頂点をまとめたもの（頂点だけで決まるので、部分メッシュ / LOD
+// をまたいでメッシュごとに 1 回だけ作る）
+struct PositionGroups {
+  std::vector<uint32_t> positionOf;
+  // 位置ごとの頂点（CSR）
+  std::vector<uint32_t> vertexOffsets;
+  std::vector<uint32_t> vertices;
+  std::vector<Vec3d> positions; // [0,1] へ正規化
+  double extent = 1.0;
+
+  void Build(const VertexData *source, size_t vertexCount);
+};
+
+void PositionGroups::Build(const VertexData *source, size_t vertexCount) {
+  std::vector<uint32_t> order(vertexCount);
+  std::iota(order.begin(), order.end(), 0u);
+  auto key = [source](uint32_t v) {
+    const Vector4 &p = source[v].position;
+    return std::make_tuple(p.x, p.y, p.z);
+  };
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return key(a) < key(b) || (key(a) == key(b) && a < b);
+  });
+
+  positionOf.assign(vertexCount, kNone);
+  vertexOffsets.clear();
+  vertices.clear();
+  vertices.reserve(vertexCount);
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i == 0 || key(order[i]) != key(order[i - 1])) {
+      vertexOffsets.push_back(uint32_t(vertices.size()));
+    }
+    positionOf[order[i]] = uint32_t(vertexOffsets.size() - 1);
+    vertices.push_back(order[i]);
+  }
+  vertexOffsets.push_back(uint32_t(vertices.size()));
+
+  // 誤差をメッシュの大きさに対する比で扱うため [0,1] へ
+  double lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+  for (size_t v = 0; v < vertexCount; ++v) {
+    const Vector4 &p = source[v].position;
+    const double c[3] = {p.x, p.y, p.z};
+    for (int k = 0; k < 3; ++k) {
+      lo[k] = v == 0 ? c[k] : (std::min)(lo[k], c[k]);
+      hi[k] = v == 0 ? c[k] : (std::max)(hi[k], c[k]);
+    }
+  }
+  extent = (std::max)({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+  if (!(extent > 0.0)) {
+    extent = 1.0;
+  }
+  const size_t positionCount = vertexOffsets.size() - 1;
+  positions.resize(positionCount);
+  for (size_t p = 0; p < positionCount; ++p) {
+    const Vector4 &v = source[vertices[vertexOffsets[p]]].position;
+    positions[p] = {(v.x - lo[0]) / extent, (v.y - lo[1]) / extent,
+                    (v.z - lo[2]) / extent};
+  }
+}
+
+class Simplifier {
+public:
+  Simplifier(const VertexData *vertices, const PositionGroups &groups,
+             bool lockBorder)
+      : vertices_(vertices), positionOf_(groups.positionOf),
+        positionVertexOffsets_(groups.vertexOffsets),
+        positionVertices_(groups.vertices), positions_(groups.positions),
+        extent_(groups.extent), lockBorder_(lockBorder) {}
+
+  // 戻り値は実際の最大誤差（メッシュ座標）
+  float Run(const uint32_t *indices, size_t indexCount,
+            size_t targetIndexCount, float targetError,
+            std::vector<uint32_t> &result);
+
+private:
+  // 位置の種類と二次誤差を求め、位置で見た辺（重複なし）を edges_ に残す
+  void Classify(const std::vector<uint32_t> &indices);
+  void BuildAdjacency(const std::vector<uint32_t> &indices);
+  float Cost(uint32_t from, uint32_t to) const;
+  // a-b の縮約を安いほうの向きで積む（誤差の上限を超えるものは積まない）
+  void Push(uint32_t a, uint32_t b);
+  bool IsBorderEdge(uint32_t from, uint32_t to,
+                    const std::vector<uint32_t> &indices) const;
+  bool HasFlips(uint32_t from, uint32_t to,
+                const std::vector<uint32_t> &indices) const;
+  uint32_t PickVertex(uint32_t vertex, uint32_t to,
+                      const std::vector<uint32_t> &indices) const;
+  // from を to へ寄せ、周りの三角形と to の縮約候補を更新する
+  void Apply(uint32_t from, uint32_t to, std::vector<uint32_t> &indices);
+
+  bool Degenerate(const uint32_t *tri) const {
+    const uint32_t p0 = positionOf_[tri[0]];
+    const uint32_t p1 = positionOf_[tri[1]];
+    const uint32_t p2 = positionOf_[tri[2]];
+    return p0 == p1 || p1 == p2 || p0 == p2;
+  }
+
+  const VertexData *vertices_;
+  const std::vector<uint32_t> &positionOf_;
+  const std::vector<uint32_t> &positionVertexOffsets_;
+  const std::vector<uint32_t> &positionVertices_;
+  const std::vector<Vec3d> &positions_;
+  double extent_;
+  bool lockBorder_;
+
+  std::vector<PositionKind> kinds_;
+  std::vector<Quadric> quadrics_;
+
+  // 位置 -> 生きている三角形（縮約のたびに寄せた先へつなぎ替える）
+  std::vector<std::vector<uint32_t>> triangles_;
+  std::vector<uint8_t> removed_;
+  size_t liveIndexCount_ = 0;
+
+  std::vector<uint64_t> edges_;
+  // 縮約の候補と空き番号、誤差の小さい順のヒープ（QueueKey）
+  std::vector<Collapse> candidates_;
+  std::vector<uint32_t> freeCandidates_;
+  std::vector<uint64_t> queue_;
+  float errorLimit_ = 0.0f;
+  std::vector<uint32_t> versions_; // 位置ごと、縮約で変わるたびに進める
+  std::vector<uint32_t> neighbors_; // Apply の作業用
+};
+
+void Simplifier::Classify(const std::vector<uint32_t> &indices) {
+  const size_t positionCount = positions_.size();
+  kinds_.assign(positionCount, PositionKind::Manifold);
+  quadrics_.assign(positionCount, Quadric{});
+
+  // 位置で見た辺の本数（1 本なら縁、3 本以上なら非多様体）
+  std::vector<uint64_t> &edges = edges_;
+  edges.clear();
+  edges.reserve(indices.size());
+  for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+    if (Degenerate(&indices[t])) {
+      continue;
+    }
+    for (int k = 0; k < 3; ++k) {
+      edges.push_back(EdgeKey(positionOf_[indices[t + k]],
+                              positionOf_[indices[t + (k + 1) % 3]]));
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  std::vector<uint64_t> borderEdges;
+  for (size_t i = 0; i < edges.size();) {
+    size_t j = i;
+    while (j < edges.size() && edges[j] == edges[i]) {
+      ++j;
+    }
+    const uint32_t a = uint32_t(edges[i] >> 32);
+    const uint32_t b = uint32_t(edges[i]);
+    if (j - i == 1) {
+      borderEdges.push_back(edges[i]);
+      for (uint32_t p : {a, b}) {
+        if (kinds_[p] == PositionKind::Manifold) {
+          kinds_[p] = lockBorder_ ? PositionKind::Locked : PositionKind::Border;
+        }
+      }
+    } else if (j - i > 2) {
+      kinds_[a] = kinds_[b] = PositionKind::Locked;
+    }
+    i = j;
+  }
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  // 面の平面と、縁に沿って面に垂直な平面
+  for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+    if (Degenerate(&indices[t])) {
+      continue;
+    }
+    const uint32_t p[3] = {positionOf_[indices[t]],
+                           positionOf_[indices[t + 1]],
+                           positionOf_[indices[t + 2]]};
+    Vec3d n = Cross(Sub(positions_[p[1]], positions_[p[0]]),
+                    Sub(positions_[p[2]], positions_[p[0]]));
+    const double area2 = Length(n);
+    if (area2 <= 0.0) {
+      continue;
+    }
+    n = {n.x / area2, n.y / area2, n.z / area2};
+    const double d = -Dot(n, positions_[p[0]]);
+    for (int k = 0; k < 3; ++k) {
+      quadrics_[p[k]].AddPlane(n, d, area2 * 0.5);
+    }
+
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t a = p[k];
+      const uint32_t b = p[(k + 1) % 3];
+      if (!std::binary_search(borderEdges.begin(), borderEdges.end(),
+                              EdgeKey(a, b))) {
+        continue;
+      }
+      const Vec3d edge = Sub(positions_[b], positions_[a]);
+      Vec3d en = Cross(edge, n);
+      const double length = Length(en);
+      if (length <= 0.0) {
+        continue;
+      }
+      en = {en.x / length, en.y / length, en.z / length};
+      const double ed = -Dot(en, positions_[a]);
+      const double w = Dot(edge, edge) * kBorderWeight;
+      quadrics_[a].AddPlane(en, ed, w);
+      quadrics_[b].AddPlane(en, ed, w);
+    }
+  }
+}
+
+void Simplifier::BuildAdjacency(const std::vector<uint32_t> &indices) {
+  triangles_.assign(positions_.size(), {});
+  for (size_t t = 0; t < indices.size(); t += 3) {
+    for (int k = 0; k < 3; ++k) {
+      triangles_[positionOf_[indices[t + k]]].push_back(uint32_t(t / 3));
+    }
+  }
+  removed_.assign(indices.size() / 3, 0);
+  liveIndexCount_ = indices.size();
+}
+
+float Simplifier::Cost(uint32_t from, uint32_t to) const {
+  const PositionKind kind = kinds_[from];
+  if (kind == PositionKind::Locked ||
+      (kind == PositionKind::Border && kinds_[to] == PositionKind::Manifold)) {
+    return kNoCollapse;
+  }
+  // 継ぎ目の頂点は、少なくとも同じ数の頂点がある位置へだけ寄せる
+  // （片側の UV / 法線しかない位置へ寄せると継ぎ目が崩れる）
+  const uint32_t fromCount =
+      positionVertexOffsets_[from + 1] - positionVertexOffsets_[from];
+  const uint32_t toCount =
+      positionVertexOffsets_[to + 1] - positionVertexOffsets_[to];
+  if (fromCount > toCount) {
+    return kNoCollapse;
+  }
+
+  const Quadric &qf = quadrics_[from];
+  const Quadric &qt = quadrics_[to];
+  const double weight = qf.weight + qt.weight;
+  if (weight <= 0.0) {
+    return 0.0f;
+  }
+  const Vec3d &p = positions_[to];
+  return float(std::sqrt((qf.Evaluate(p) + qt.Evaluate(p)) / weight));
+}
+
+void Simplifier::Push(uint32_t a, uint32_t b) {
+  const float ab = Cost(a, b);
+  const float ba = Cost(b, a);
+  if (ab == kNoCollapse && ba == kNoCollapse) {
+    return;
+  }
+  const uint32_t from = ab <= ba ? a : b;
+  const uint32_t to = ab <= ba ? b : a;
+  const float error = ab <= ba ? ab : ba;
+  // 上限を超えた候補は、両端が変わらない限り（変われば積み直す）使えない
+  if (error > errorLimit_) {
+    return;
+  }
+  uint32_t slot;
+  if (freeCandidates_.empty()) {
+    slot = uint32_t(candidates_.size());
+    candidates_.emplace_back();
+  } else {
+    slot = freeCandidates_.back();
+    freeCandidates_.pop_back();
+  }
+  candidates_[slot] = {from, to, versions_[from], versions_[to], error};
+  queue_.push_back(QueueKey(error, slot));
+  std::push_heap(queue_.begin(), queue_.end(), std::greater<uint64_t>());
+}
+
+bool Simplifier::IsBorderEdge(uint32_t from, uint32_t to,
+                              const std::vector<uint32_t> &indices) const {
+  uint32_t shared = 0;
+  for (uint32_t t : triangles_[from]) {
+    if (removed_[t]) {
+      continue;
+    }
+    const uint32_t *tri = &indices[size_t(t) * 3];
+    for (int k = 0; k < 3; ++k) {
+      shared += positionOf_[tri[k]] == to;
+    }
+  }
+  return shared == 1;
+}
+
+bool Simplifier::HasFlips(uint32_t from, uint32_t to,
+                          const std::vector<uint32_t> &indices) const {
+  for (uint32_t t : triangles_[from]) {
+    if (removed_[t]) {
+      continue;
+    }
+    const uint32_t *tri = &indices[size_t(t) * 3];
+    uint32_t p[3];
+    bool hasTo = false;
+    for (int k = 0; k < 3; ++k) {
+      p[k] = positionOf_[tri[k]];
+      hasTo |= p[k] == to;
+    }
+    if (hasTo) {
+      continue; // 潰れて消える三角形
+    }
+    Vec3d moved[3];
+    for (int k = 0; k < 3; ++k) {
+      moved[k] = positions_[p[k] == from ? to : p[k]];
+    }
+    const Vec3d before =
+        Cross(Sub(positions_[p[1]], positions_[p[0]]),
+              Sub(positions_[p[2]], positions_[p[0]]));
+    const Vec3d after =
+        Cross(Sub(moved[1], moved[0]), Sub(moved[2], moved[0]));
+    if (Dot(before, after) <= 0.0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t Simplifier::PickVertex(uint32_t vertex, uint32_t to,
+                                const std::vector<uint32_t> &indices) const {
+  // vertex と三角形を共有している to の頂点（同じ UV / 法線の側）
+  const uint32_t from = positionOf_[vertex];
+  for (uint32_t t : triangles_[from]) {
+    if (removed_[t]) {
+      continue;
+    }
+    const uint32_t *tri = &indices[size_t(t) * 3];
+    if (tri[0] != vertex && tri[1] != vertex && tri[2] != vertex) {
+      continue;
+    }
+    for (int k = 0; k < 3; ++k) {
+      if (positionOf_[tri[k]] == to) {
+        return tri[k];
+      }
+    }
+  }
+
+  // なければ UV / 法線が最も近い頂点
+  const VertexData &a = vertices_[vertex];
+  uint32_t best = positionVertices_[positionVertexOffsets_[to]];
+  float bestDistance = std::numeric_limits<float>::max();
+  for (uint32_t i = positionVertexOffsets_[to];
+       i < positionVertexOffsets_[to + 1]; ++i) {
+    const VertexData &b = vertices_[positionVertices_[i]];
+    const float du = a.texcoord.x - b.texcoord.x;
+    const float dv = a.texcoord.y - b.texcoord.y;
+    const float nx = a.normal.x - b.normal.x;
+    const float ny = a.normal.y - b.normal.y;
+    const float nz = a.normal.z - b.normal.z;
+    const float distance = du * du + dv * dv + nx * nx + ny * ny + nz * nz;
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = positionVertices_[i];
+    }
+  }
+  return best;
+}
+
+void Simplifier::Apply(uint32_t from, uint32_t to,
+                       std::vector<uint32_t> &indices) {
+  // 行き先は三角形を書き換える前に決める（継ぎ目の頂点は 1 つずつ）
+  const uint32_t vertexBegin = positionVertexOffsets_[from];
+  const uint32_t vertexEnd = positionVertexOffsets_[from + 1];
+  uint32_t remapSmall[8];
+  std::vector<uint32_t> remapLarge;
+  uint32_t *remap = remapSmall;
+  if (vertexEnd - vertexBegin > std::size(remapSmall)) {
+    remapLarge.resize(vertexEnd - vertexBegin);
+    remap = remapLarge.data();
+  }
+  for (uint32_t i = vertexBegin; i < vertexEnd; ++i) {
+    remap[i - vertexBegin] = PickVertex(positionVertices_[i], to, indices);
+  }
+  quadrics_[to].Add(quadrics_[from]);
+
+  std::vector<uint32_t> &toTriangles = triangles_[to];
+  for (uint32_t t : triangles_[from]) {
+    if (removed_[t]) {
+      continue;
+    }
+    uint32_t *tri = &indices[size_t(t) * 3];
+    bool hadTo = false;
+    for (int k = 0; k < 3; ++k) {
+      if (positionOf_[tri[k]] == from) {
+        const uint32_t *slot =
+            std::find(&positionVertices_[vertexBegin],
+                      &positionVertices_[0] + vertexEnd, tri[k]);
+        tri[k] = remap[slot - &positionVertices_[vertexBegin]];
+      } else {
+        hadTo |= positionOf_[tri[k]] == to;
+      }
+    }
+    if (Degenerate(tri)) {
+      removed_[t] = 1;
+      liveIndexCount_ -= 3;
+    } else if (!hadTo) {
+      toTriangles.push_back(t);
+    }
+  }
+  triangles_[from].clear();
+  triangles_[from].shrink_to_fit();
+  toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(),
+                                   [this](uint32_t t) { return removed_[t]; }),
+                    toTriangles.end());
+
+  // from / to を含む候補は古くなる。to の周りの辺は積み直す
+  ++versions_[from];
+  ++versions_[to];
+  neighbors_.clear();
+  for (uint32_t t : toTriangles) {
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t p = positionOf_[indices[size_t(t) * 3 + k]];
+      if (p != to) {
+        neighbors_.push_back(p);
+      }
+    }
+  }
+  std::sort(neighbors_.begin(), neighbors_.end());
+  neighbors_.erase(std::unique(neighbors_.begin(), neighbors_.end()),
+                   neighbors_.end());
+  for (uint32_t p : neighbors_) {
+    Push(to, p);
+  }
+}
+
+float Simplifier::Run(const uint32_t *indices, size_t indexCount,
+                      size_t targetIndexCount, float targetError,
+                      std::vector<uint32_t> &result) {
+  result.assign(indices, indices + indexCount);
+  if (indexCount <= targetIndexCount || positions_.empty()) {
+    return 0.0f;
+  }
+  Classify(result);
+
+  // 最初から潰れている三角形は捨てる
+  size_t kept = 0;
+  for (size_t t = 0; t < result.size(); t += 3) {
+    if (!Degenerate(&result[t])) {
+      std::copy_n(&result[t], 3, &result[kept]);
+      kept += 3;
+    }
+  }
+  result.resize(kept);
+  errorLimit_ = float(double(targetError) / extent_);
+
+  // 辺ごとの候補を誤差順の優先度付きキューへ（縮約のたびに全部を
+  // 並べ直さず、変わった周りだけ積み直す。古い候補は取り出したときに捨てる）
+  BuildAdjacency(result);
+  versions_.assign(positions_.size(), 0);
+  candidates_.clear();
+  freeCandidates_.clear();
+  queue_.clear();
+  candidates_.reserve(edges_.size());
+  queue_.reserve(edges_.size());
+  for (uint64_t edge : edges_) {
+    Push(uint32_t(edge >> 32), uint32_t(edge));
+  }
+
+  float maxError = 0.0f;
+  while (liveIndexCount_ > targetIndexCount && !queue_.empty()) {
+    std::pop_heap(queue_.begin(), queue_.end(), std::greater<uint64_t>());
+    const uint32_t slot = uint32_t(queue_.back());
+    queue_.pop_back();
+    const Collapse c = candidates_[slot];
+    freeCandidates_.push_back(slot);
+    if (c.fromVersion != versions_[c.from] || c.toVersion != versions_[c.to]) {
+      continue;
+    }
+    if (kinds_[c.from] == PositionKind::Border &&
+        !IsBorderEdge(c.from, c.to, result)) {
+      continue;
+    }
+    if (HasFlips(c.from, c.to, result)) {
+      continue;
+    }
+    Apply(c.from, c.to, result);
+    maxError = (std::max)(maxError, c.error);
+  }
+
+  size_t write = 0;
+  for (size_t t = 0; t < result.size(); t += 3) {
+    if (!removed_[t / 3]) {
+      std::copy_n(&result[t], 3, &result[write]);
+      write += 3;
+    }
+  }
+  result.resize(write);
+  return float(double(maxError) * extent_);
+}
+
+} // namespace
+
+void SimplifyMesh(const VertexData *vertices, size_t vertexCount,
+                  const uint32_t *indices, size_t indexCount,
+                  size_t targetIndexCount, float targetError,
+                  std::vector<uint32_t> &outIndices, float *outError,
+                  bool lockBorder) {
+  assert(indexCount % 3 == 0);
+  float error = 0.0f;
+  if (indexCount <= targetIndexCount || vertexCount == 0) {
+    outIndices.assign(indices, indices + indexCount);
+  } else {
+    PositionGroups groups;
+    groups.Build(vertices, vertexCount);
+    error = Simplifier(vertices, groups, lockBorder)
+                .Run(indices, indexCount, targetIndexCount, targetError,
+                     outIndices);
+  }
+  if (outError) {
+    *outError = error;
+  }
+}
+
+uint32_t BuildLodChain(const VertexData *vertices, size_t vertexCount,
+                       std::vector<uint32_t> &indices,
+                       std::vector<MeshSubset> &subsets,
+                       const MeshLodSettings &settings,
+                       std::vector<float> &outErrors) {
+  outErrors.assign(1, 0.0f);
+  const size_t subsetCount = subsets.size();
+  if (settings.lodCount <= 1 || subsetCount == 0 || vertexCount == 0) {
+    return 1;
+  }
+
+  // 同じ位置の頂点のまとまりは頂点だけで決まるので、全 LOD・全部分メッシュ
+  // で 1 回だけ作る
+  PositionGroups groups;
+  groups.Build(vertices, vertexCount);
+  // 許す誤差をメッシュ座標へ
+  const float maxError = settings.maxError * float(groups.extent);
+
+  // 部分メッシュが複数あるときは境目の縁を動かさない（隙間が出ないように）
+  const bool lockBorder = subsetCount > 1;
+  std::vector<uint32_t> simplified;
+  std::vector<MeshSubset> next(subsetCount);
+  for (uint32_t lod = 1; lod < settings.lodCount; ++lod) {
+    const size_t lodStart = indices.size();
+    const float budget = maxError - outErrors.back();
+    size_t previousTotal = 0;
+    size_t total = 0;
+    float lodError = 0.0f;
+
+    // 1 つ前の LOD から簡略化（誤差は足していく）
+    for (size_t s = 0; s < subsetCount; ++s) {
+      const MeshSubset previous = subsets[(lod - 1) * subsetCount + s];
+      const size_t target =
+          size_t(float(previous.indexCount / 3) * settings.triangleRatio) * 3;
+      const float error =
+          Simplifier(vertices, groups, lockBorder)
+              .Run(indices.data() + previous.indexStart, previous.indexCount,
+                   target, budget, simplified);
+      OptimizeVertexCache(simplified.data(), simplified.size(), vertexCount);
+
+      next[s].indexStart = uint32_t(indices.size());
+      next[s].indexCount = uint32_t(simplified.size());
+      next[s].materialIndex = previous.materialIndex;
+      indices.insert(indices.end(), simplified.begin(), simplified.end());
+      previousTotal += previous.indexCount;
+      total += simplified.size();
+      lodError = (std::max)(lodError, error);
+    }
+
+    // ほとんど減らなければ打ち切り
+    if (total == 0 || float(total) > float(previousTotal) * kMinLodReduction) {
+      indices.resize(lodStart);
+      break;
+    }
+    subsets.insert(subsets.end(), next.begin(), next.end());
+    outErrors.push_back(outErrors.back() + lodError);
+  }
+  return uint32_t(outErrors.size());
+}
+
+uint32_t SelectLod(const float *lodErrors, uint32_t lodCount,
+                   float pixelsPerUnit, float thresholdPixels) {
+  uint32_t lod = 0;
+  for (uint32_t i = 1; i < lodCount; ++i) {
+    if (lodErrors[i] * pixelsPerUnit > thresholdPixels) {
+      break;
+    }
+    lod = i;
+  }
+  return lod;
+}
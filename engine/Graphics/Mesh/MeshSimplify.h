@@ -0,0 +1,51 @@
+#pragma once
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// メッシュの簡略化と LOD（D3D 非依存）
+//==================================
+// 二次誤差（Garland-Heckbert）による辺の縮約。頂点は動かさず既存の頂点へ
+// 寄せる（half-edge collapse）ので、どの LOD も同じ VB を共有できる。
+//   ・同じ位置の頂点（UV / 法線の継ぎ目）はまとめて動かし、継ぎ目の外へは
+//     寄せない
+//   ・開いた縁の頂点は縁に沿ってだけ動かす（lockBorder なら動かさない）
+//   ・面が裏返る縮約はしない
+// 誤差はメッシュ座標での距離（元の面からの RMS 距離の見積もり）。
+
+// indices（三角形リスト）を targetIndexCount 以下になるまで縮約して
+// outIndices へ返す。誤差が targetError を超える縮約はしないので、
+// 目標に届かないこともある。outError には実際の最大誤差を返す（nullptr 可）
+void SimplifyMesh(const VertexData *vertices, size_t vertexCount,
+                  const uint32_t *indices, size_t indexCount,
+                  size_t targetIndexCount, float targetError,
+                  std::vector<uint32_t> &outIndices, float *outError = nullptr,
+                  bool lockBorder = false);
+
+// LOD の作り方
+struct MeshLodSettings {
+  uint32_t lodCount = 4;      // LOD0 を含む最大数（1 なら作らない）
+  float triangleRatio = 0.5f; // 1 段ごとの三角形数の目標比
+  float maxError = 0.01f;     // 許す誤差（メッシュの AABB の最大辺に対する比）
+
+  bool operator==(const MeshLodSettings &) const = default;
+};
+
+// indices の部分メッシュ（subsets、LOD0）ごとに 1 段ずつ簡略化し、
+// LOD1 以降を indices の末尾へ追加する。
+// subsets は [LOD][部分メッシュ] の並びになり、outErrors には LOD ごとの
+// 誤差（メッシュ座標、LOD0 は 0）を返す。減らなくなったらそこで止めるので、
+// 戻り値（実際の LOD 数）は settings.lodCount 以下
+uint32_t BuildLodChain(const VertexData *vertices, size_t vertexCount,
+                       std::vector<uint32_t> &indices,
+                       std::vector<MeshSubset> &subsets,
+                       const MeshLodSettings &settings,
+                       std::vector<float> &outErrors);
+
+// 画面上の誤差が thresholdPixels 以下に収まる最も粗い LOD。
+// pixelsPerUnit はメッシュ座標 1 あたりのピクセル数
+// （ProjectedSphereRadius / ローカル境界球の半径）
+uint32_t SelectLod(const float *lodErrors, uint32_t lodCount,
+                   float pixelsPerUnit, float thresholdPixels);
@@ -0,0 +1,69 @@
+#include "MeshWeld.h"
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kEmpty = UINT32_MAX;
+
+// 36 byte をワード単位で混ぜる
+uint32_t HashVertex(const VertexData &v) {
+  uint32_t words[sizeof(VertexData) / 4];
+  std::memcpy(words, &v, sizeof(words));
+  uint32_t h = 2166136261u;
+  for (uint32_t w : words) {
+    h = (h ^ w) * 16777619u;
+    h ^= h >> 15;
+  }
+  return h;
+}
+
+bool SameVertex(const VertexData &a, const VertexData &b) {
+  return std::memcmp(&a, &b, sizeof(VertexData)) == 0;
+}
+
+} // namespace
+
+void WeldVertices(const VertexData *vertices, size_t count,
+                  std::vector<VertexData> &outVertices,
+                  std::vector<uint32_t> &outIndices) {
+  static_assert(sizeof(VertexData) % 4 == 0);
+  outVertices.clear();
+  outIndices.resize(count);
+
+  // 開番地法のハッシュ表（中身は outVertices の番号、負荷率 0.5 以下）
+  size_t capacity = 16;
+  while (capacity < count * 2) {
+    capacity <<= 1;
+  }
+  std::vector<uint32_t> table(capacity, kEmpty);
+  const size_t mask = capacity - 1;
+
+  for (size_t i = 0; i < count; ++i) {
+    const VertexData &v = vertices[i];
+    size_t slot = HashVertex(v) & mask;
+    for (;;) {
+      const uint32_t found = table[slot];
+      if (found == kEmpty) {
+        table[slot] = uint32_t(outVertices.size());
+        outIndices[i] = uint32_t(outVertices.size());
+        outVertices.push_back(v);
+        break;
+      }
+      if (SameVertex(outVertices[found], v)) {
+        outIndices[i] = found;
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+}
+
+void PackIndices16(const uint32_t *indices, size_t count,
+                   std::vector<uint16_t> &out) {
+  out.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    assert(indices[i] <= 0xFFFF);
+    out[i] = uint16_t(indices[i]);
+  }
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 頂点の溶接（インデックス化、D3D 非依存）
+//==================================
+// 位置・UV・法線がビット単位で同じ頂点を 1 つにまとめ、三角形リストを
+// 頂点配列 + インデックス配列に直す。頂点は最初に出てきた順に並ぶ。
+
+void WeldVertices(const VertexData *vertices, size_t count,
+                  std::vector<VertexData> &outVertices,
+                  std::vector<uint32_t> &outIndices);
+
+// 16bit インデックスで足りるか（頂点数 65536 以下）
+inline bool FitsIndex16(size_t vertexCount) { return vertexCount <= 0x10000; }
+
+// 32bit -> 16bit（FitsIndex16 を満たすこと）
+void PackIndices16(const uint32_t *indices, size_t count,
+                   std::vector<uint16_t> &out);
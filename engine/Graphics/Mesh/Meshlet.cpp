@@ -0,0 +1,498 @@
+#include "Meshlet.h"
+#include "Math/Math.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t kNone = UINT32_MAX;
+constexpr uint8_t kNotInMeshlet = 0xFF;
+// 法線がこれ以上ばらつく塊は裏面カリングしない（コーンの広がりが約 84 度超）
+constexpr float kMinConeSpread = 0.1f;
+
+Vector3 PositionOf(const VertexData &vertex) {
+  return {vertex.position.x, vertex.position.y, vertex.position.z};
+}
+
+// 三角形ごとの前面の法線と重心。
+// D3D の既定（時計回りが表）と左手系なので Cross(e1, e2) が表向き
+struct TriangleInfo {
+  Vector3 normal;   // 面積 0 なら 0
+  Vector3 centroid;
+};
+
+//==================================
+// 塊を育てる
+//==================================
+class MeshletBuilder {
+public:
+  MeshletBuilder(const VertexData *vertices, size_t vertexCount,
+                 const uint32_t *indices, size_t indexCount,
+                 uint32_t maxVertices, uint32_t maxTriangles)
+      : vertices_(vertices), indices_(indices),
+        triangleCount_(indexCount / 3), maxVertices_(maxVertices),
+        maxTriangles_(maxTriangles), localIndex_(vertexCount, kNotInMeshlet),
+        emitted_(triangleCount_, false) {
+    BuildTriangles_();
+    BuildAdjacency_(vertexCount);
+  }
+
+  void Build(MeshletData &out) {
+    uint32_t seed = kNone;
+    for (;;) {
+      if (seed == kNone) {
+        seed = FirstUnused_();
+        if (seed == kNone) {
+          break;
+        }
+      }
+      Add_(seed);
+
+      // 隣り合う三角形で埋める。無くなったら近くの島をつなぐ
+      while (triangles_.size() < maxTriangles_) {
+        uint32_t next = PickAdjacent_();
+        if (next == kNone) {
+          next = PickNearby_();
+        }
+        if (next == kNone) {
+          break;
+        }
+        Add_(next);
+      }
+
+      seed = PickSeed_();
+      Flush_(out);
+    }
+  }
+
+private:
+  void BuildTriangles_() {
+    triangleInfo_.resize(triangleCount_);
+    for (size_t t = 0; t < triangleCount_; ++t) {
+      const Vector3 p0 = PositionOf(vertices_[indices_[t * 3 + 0]]);
+      const Vector3 p1 = PositionOf(vertices_[indices_[t * 3 + 1]]);
+      const Vector3 p2 = PositionOf(vertices_[indices_[t * 3 + 2]]);
+      const Vector3 n = Cross(Subtract(p1, p0), Subtract(p2, p0));
+      const float length = Length(n);
+      triangleInfo_[t].normal =
+          length > 0.0f ? Multiply(n, 1.0f / length) : Vector3{0, 0, 0};
+      triangleInfo_[t].centroid =
+          Multiply(Add(Add(p0, p1), p2), 1.0f / 3.0f);
+    }
+  }
+
+  // 頂点 → 三角形（CSR）と、頂点ごとの未使用の三角形の数
+  void BuildAdjacency_(size_t vertexCount) {
+    adjacencyOffset_.assign(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount_ * 3; ++i) {
+      ++adjacencyOffset_[indices_[i] + 1];
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+      adjacencyOffset_[v + 1] += adjacencyOffset_[v];
+    }
+    adjacency_.resize(triangleCount_ * 3);
+    std::vector<uint32_t> fill(adjacencyOffset_.begin(),
+                               adjacencyOffset_.end() - 1);
+    for (size_t i = 0; i < triangleCount_ * 3; ++i) {
+      adjacency_[fill[indices_[i]]++] = uint32_t(i / 3);
+    }
+    liveTriangles_.resize(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+      liveTriangles_[v] = adjacencyOffset_[v + 1] - adjacencyOffset_[v];
+    }
+  }
+
+  uint32_t NewVertexCount_(uint32_t triangle) const {
+    uint32_t count = 0;
+    for (int k = 0; k < 3; ++k) {
+      count += localIndex_[indices_[triangle * 3 + k]] == kNotInMeshlet;
+    }
+    // 同じ頂点を 2 回使う縮退三角形でも数え過ぎない（上限判定が安全側になるだけ）
+    return count;
+  }
+
+  bool Fits_(uint32_t triangle) const {
+    return meshletVertices_.size() + NewVertexCount_(triangle) <=
+           maxVertices_;
+  }
+
+  // 新しい頂点が少ないもの → 塊の中心に近く向きの揃ったもの
+  uint32_t PickAdjacent_() const {
+    const Vector3 center = Multiply(centroidSum_, 1.0f / triangles_.size());
+    const float axisLength = Length(normalSum_);
+    const Vector3 axis = axisLength > 0.0f
+                             ? Multiply(normalSum_, 1.0f / axisLength)
+                             : Vector3{0, 0, 0};
+
+    uint32_t best = kNone;
+    uint32_t bestNew = 4;
+    float bestCost = std::numeric_limits<float>::max();
+    for (uint32_t vertex : meshletVertices_) {
+      if (liveTriangles_[vertex] == 0) {
+        continue;
+      }
+      for (uint32_t a = adjacencyOffset_[vertex];
+           a < adjacencyOffset_[vertex + 1]; ++a) {
+        const uint32_t triangle = adjacency_[a];
+        if (emitted_[triangle]) {
+          continue;
+        }
+        const uint32_t newCount = NewVertexCount_(triangle);
+        if (meshletVertices_.size() + newCount > maxVertices_ ||
+            newCount > bestNew) {
+          continue;
+        }
+        const TriangleInfo &info = triangleInfo_[triangle];
+        const Vector3 d = Subtract(info.centroid, center);
+        // 向きが逆の三角形ほど遠い扱い（コーンを細く保つ）
+        const float cost = Dot(d, d) * (2.0f - Dot(info.normal, axis));
+        if (newCount < bestNew || cost < bestCost) {
+          best = triangle;
+          bestNew = newCount;
+          bestCost = cost;
+        }
+      }
+    }
+    return best;
+  }
+
+  // まだ使っていない最初の三角形（無ければ kNone）。
+  // cursor_ より前はすべて使ったので、呼ぶたびに先頭から数え直さない
+  uint32_t FirstUnused_() {
+    while (cursor_ < triangleCount_ && emitted_[cursor_]) {
+      ++cursor_;
+    }
+    return cursor_ < triangleCount_ ? uint32_t(cursor_) : kNone;
+  }
+
+  // 隣に無ければ、使い終わった三角形を 1 枚挟んだ先（塊の頂点の隣の頂点）
+  // から塊の中心に最も近いものを選ぶ。それも無ければ、まだ使っていない
+  // 最初の三角形が塊の近くにあれば続けて入れる（近くの島をつなぐ。
+  // インデックスは頂点キャッシュ最適化済みで、近い三角形が近くに並ぶ）
+  uint32_t PickNearby_() {
+    // 塊と頂点を共有しない三角形は 3 頂点とも新しい
+    if (meshletVertices_.size() + 3 > maxVertices_) {
+      return kNone;
+    }
+    const Vector3 center = Multiply(centroidSum_, 1.0f / triangles_.size());
+    uint32_t best = kNone;
+    float bestDistance = std::numeric_limits<float>::max();
+    for (uint32_t vertex : meshletVertices_) {
+      for (uint32_t a = adjacencyOffset_[vertex];
+           a < adjacencyOffset_[vertex + 1]; ++a) {
+        const uint32_t between = adjacency_[a];
+        for (int k = 0; k < 3; ++k) {
+          const uint32_t next = indices_[between * 3 + k];
+          if (localIndex_[next] != kNotInMeshlet || liveTriangles_[next] == 0) {
+            continue;
+          }
+          for (uint32_t b = adjacencyOffset_[next];
+               b < adjacencyOffset_[next + 1]; ++b) {
+            const uint32_t triangle = adjacency_[b];
+            if (emitted_[triangle] || !Fits_(triangle)) {
+              continue;
+            }
+            const Vector3 d =
+                Subtract(triangleInfo_[triangle].centroid, center);
+            const float distance = Dot(d, d);
+            if (distance < bestDistance ||
+                (distance == bestDistance && triangle < best)) {
+              best = triangle;
+              bestDistance = distance;
+            }
+          }
+        }
+      }
+    }
+    if (best != kNone) {
+      return best;
+    }
+
+    const uint32_t t = FirstUnused_();
+    if (t == kNone || !Fits_(t)) {
+      return kNone;
+    }
+    const Vector3 c = triangleInfo_[t].centroid;
+    const Vector3 extent = Subtract(boxMax_, boxMin_);
+    const float slack = Length(extent) * 0.5f;
+    if (c.x < boxMin_.x - slack || c.y < boxMin_.y - slack ||
+        c.z < boxMin_.z - slack || c.x > boxMax_.x + slack ||
+        c.y > boxMax_.y + slack || c.z > boxMax_.z + slack) {
+      return kNone;
+    }
+    return t;
+  }
+
+  // 次の塊の種：今の塊の縁で、残りの三角形が最も少ない頂点の三角形
+  // （穴を残さず端から埋めていく）
+  uint32_t PickSeed_() const {
+    uint32_t best = kNone;
+    uint32_t bestLive = UINT32_MAX;
+    for (uint32_t vertex : meshletVertices_) {
+      const uint32_t live = liveTriangles_[vertex];
+      if (live == 0 || live >= bestLive) {
+        continue;
+      }
+      for (uint32_t a = adjacencyOffset_[vertex];
+           a < adjacencyOffset_[vertex + 1]; ++a) {
+        if (!emitted_[adjacency_[a]]) {
+          best = adjacency_[a];
+          bestLive = live;
+          break;
+        }
+      }
+    }
+    return best;
+  }
+
+  void Add_(uint32_t triangle) {
+    assert(!emitted_[triangle] && Fits_(triangle));
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t vertex = indices_[triangle * 3 + k];
+      if (localIndex_[vertex] == kNotInMeshlet) {
+        localIndex_[vertex] = uint8_t(meshletVertices_.size());
+        meshletVertices_.push_back(vertex);
+      }
+      --liveTriangles_[vertex];
+    }
+    emitted_[triangle] = true;
+    triangles_.push_back(triangle);
+
+    const TriangleInfo &info = triangleInfo_[triangle];
+    centroidSum_ = Add(centroidSum_, info.centroid);
+    normalSum_ = Add(normalSum_, info.normal);
+    if (triangles_.size() == 1) {
+      boxMin_ = boxMax_ = info.centroid;
+    } else {
+      boxMin_ = {(std::min)(boxMin_.x, info.centroid.x),
+                 (std::min)(boxMin_.y, info.centroid.y),
+                 (std::min)(boxMin_.z, info.centroid.z)};
+      boxMax_ = {(std::max)(boxMax_.x, info.centroid.x),
+                 (std::max)(boxMax_.y, info.centroid.y),
+                 (std::max)(boxMax_.z, info.centroid.z)};
+    }
+  }
+
+  // 今の塊を書き出して空にする
+  void Flush_(MeshletData &out) {
+    Meshlet meshlet;
+    meshlet.vertexOffset = uint32_t(out.vertices.size());
+    meshlet.triangleOffset = uint32_t(out.triangles.size());
+    meshlet.vertexCount = uint32_t(meshletVertices_.size());
+    meshlet.triangleCount = uint32_t(triangles_.size());
+    out.vertices.insert(out.vertices.end(), meshletVertices_.begin(),
+                        meshletVertices_.end());
+    for (uint32_t triangle : triangles_) {
+      for (int k = 0; k < 3; ++k) {
+        out.triangles.push_back(localIndex_[indices_[triangle * 3 + k]]);
+      }
+    }
+    const MeshletBounds bounds = ComputeBounds_();
+    out.meshlets.push_back(meshlet);
+    out.bounds.push_back(bounds);
+    out.spheres.Push(bounds.sphere);
+
+    for (uint32_t vertex : meshletVertices_) {
+      localIndex_[vertex] = kNotInMeshlet;
+    }
+    meshletVertices_.clear();
+    triangles_.clear();
+    centroidSum_ = {0, 0, 0};
+    normalSum_ = {0, 0, 0};
+  }
+
+  MeshletBounds ComputeBounds_() const {
+    MeshletBounds bounds;
+
+    // 境界球（中心は AABB の中心、半径は最遠頂点まで）
+    Vector3 lo = PositionOf(vertices_[meshletVertices_[0]]);
+    Vector3 hi = lo;
+    for (uint32_t vertex : meshletVertices_) {
+      const Vector3 p = PositionOf(vertices_[vertex]);
+      lo = {(std::min)(lo.x, p.x), (std::min)(lo.y, p.y),
+            (std::min)(lo.z, p.z)};
+      hi = {(std::max)(hi.x, p.x), (std::max)(hi.y, p.y),
+            (std::max)(hi.z, p.z)};
+    }
+    const Vector3 center = Multiply(Add(lo, hi), 0.5f);
+    float radiusSq = 0.0f;
+    for (uint32_t vertex : meshletVertices_) {
+      const Vector3 d = Subtract(PositionOf(vertices_[vertex]), center);
+      radiusSq = (std::max)(radiusSq, Dot(d, d));
+    }
+    bounds.sphere.center = center;
+    bounds.sphere.radius = std::sqrt(radiusSq);
+    bounds.coneApex = center;
+
+    // 法線コーン：軸は面法線の平均、広がりは軸から最も離れた法線
+    Vector3 axis = {0, 0, 0};
+    for (uint32_t triangle : triangles_) {
+      axis = Add(axis, triangleInfo_[triangle].normal);
+    }
+    const float axisLength = Length(axis);
+    if (axisLength <= 0.0f) {
+      return bounds;
+    }
+    axis = Multiply(axis, 1.0f / axisLength);
+    bounds.coneAxis = axis;
+
+    float minDot = 1.0f;
+    for (uint32_t triangle : triangles_) {
+      const Vector3 &n = triangleInfo_[triangle].normal;
+      if (Dot(n, n) > 0.0f) {
+        minDot = (std::min)(minDot, Dot(n, axis));
+      }
+    }
+    if (minDot <= kMinConeSpread) {
+      return bounds; // 法線が半球を超えて散らばる：判定しない
+    }
+
+    // 頂点はすべての三角形の平面より後ろになるよう軸に沿って下げる
+    // （カメラがどの平面の表側にも無いときだけ裏向きと判定できる）
+    float maxT = 0.0f;
+    for (uint32_t triangle : triangles_) {
+      const Vector3 &n = triangleInfo_[triangle].normal;
+      const float dn = Dot(axis, n);
+      if (dn <= 0.0f) {
+        continue;
+      }
+      const Vector3 p0 = PositionOf(vertices_[indices_[triangle * 3]]);
+      maxT = (std::max)(maxT, Dot(Subtract(center, p0), n) / dn);
+    }
+    bounds.coneApex = Subtract(center, Multiply(axis, maxT));
+    bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    return bounds;
+  }
+
+  const VertexData *vertices_;
+  const uint32_t *indices_;
+  size_t triangleCount_;
+  uint32_t maxVertices_;
+  uint32_t maxTriangles_;
+
+  std::vector<TriangleInfo> triangleInfo_;
+  std::vector<uint32_t> adjacencyOffset_;
+  std::vector<uint32_t> adjacency_;
+  std::vector<uint32_t> liveTriangles_;
+  std::vector<uint8_t> localIndex_; // VB の番号 → 今の塊での番号
+  std::vector<bool> emitted_;
+  size_t cursor_ = 0; // これより前の三角形はすべて使った
+
+  // 今の塊
+  std::vector<uint32_t> meshletVertices_;
+  std::vector<uint32_t> triangles_;
+  Vector3 centroidSum_ = {0, 0, 0};
+  Vector3 normalSum_ = {0, 0, 0};
+  Vector3 boxMin_ = {0, 0, 0};
+  Vector3 boxMax_ = {0, 0, 0};
+};
+
+} // namespace
+
+void MeshletData::Clear() {
+  meshlets.clear();
+  bounds.clear();
+  vertices.clear();
+  triangles.clear();
+  spheres.Clear();
+  subsetMeshletStart.clear();
+}
+
+void BuildMeshlets(const VertexData *vertices, size_t vertexCount,
+                   const uint32_t *indices, size_t indexCount,
+                   MeshletData &out, uint32_t maxVertices,
+                   uint32_t maxTriangles) {
+  assert(maxVertices >= 3 && maxVertices < kNotInMeshlet);
+  assert(maxTriangles >= 1);
+  if (indexCount < 3 || vertexCount == 0) {
+    return;
+  }
+  MeshletBuilder builder(vertices, vertexCount, indices, indexCount,
+                         maxVertices, maxTriangles);
+  builder.Build(out);
+}
+
+void BuildMeshlets(const VertexData *vertices, size_t vertexCount,
+                   const uint32_t *indices, const MeshSubset *subsets,
+                   size_t subsetCount, MeshletData &out, uint32_t maxVertices,
+                   uint32_t maxTriangles) {
+  out.Clear();
+  out.subsetMeshletStart.reserve(subsetCount + 1);
+  for (size_t i = 0; i < subsetCount; ++i) {
+    out.subsetMeshletStart.push_back(uint32_t(out.meshlets.size()));
+    BuildMeshlets(vertices, vertexCount, indices + subsets[i].indexStart,
+                  subsets[i].indexCount, out, maxVertices, maxTriangles);
+  }
+  out.subsetMeshletStart.push_back(uint32_t(out.meshlets.size()));
+}
+
+MeshletStats AnalyzeMeshlets(const MeshletData &data, uint32_t maxVertices,
+                             uint32_t maxTriangles) {
+  MeshletStats stats;
+  stats.meshletCount = uint32_t(data.meshlets.size());
+  if (data.meshlets.empty()) {
+    return stats;
+  }
+
+  size_t vertexSum = 0;
+  uint32_t cullable = 0;
+  for (size_t i = 0; i < data.meshlets.size(); ++i) {
+    vertexSum += data.meshlets[i].vertexCount;
+    stats.triangleCount += data.meshlets[i].triangleCount;
+    cullable += data.bounds[i].coneCutoff < 1.0f;
+  }
+  std::vector<uint32_t> unique(data.vertices);
+  std::sort(unique.begin(), unique.end());
+  unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+  const float count = float(stats.meshletCount);
+  stats.averageVertices = float(vertexSum) / count;
+  stats.averageTriangles = float(stats.triangleCount) / count;
+  stats.vertexFill = stats.averageVertices / float(maxVertices);
+  stats.triangleFill = stats.averageTriangles / float(maxTriangles);
+  stats.vertexDuplication = float(vertexSum) / float(unique.size());
+  stats.coneCullableRatio = float(cullable) / count;
+  return stats;
+}
+
+size_t CullMeshlets(const MeshletData &data, const Frustum &localFrustum,
+                    const Vector3 &localCameraPosition, uint32_t *outVisible,
+                    MeshletCullStats *outStats) {
+  // 視錐台は境界球の一括判定で、残ったものだけ法線コーンを見る
+  const size_t inFrustum = CullSpheres(localFrustum, data.spheres, outVisible);
+
+  size_t visible = 0;
+  uint32_t visibleTriangles = 0;
+  uint32_t inFrustumTriangles = 0;
+  for (size_t i = 0; i < inFrustum; ++i) {
+    const uint32_t index = outVisible[i];
+    const MeshletBounds &bounds = data.bounds[index];
+    inFrustumTriangles += data.meshlets[index].triangleCount;
+    if (bounds.coneCutoff < 1.0f) {
+      const Vector3 toApex = Subtract(bounds.coneApex, localCameraPosition);
+      const float distance = Length(toApex);
+      if (Dot(toApex, bounds.coneAxis) >= bounds.coneCutoff * distance) {
+        continue;
+      }
+    }
+    outVisible[visible++] = index;
+    visibleTriangles += data.meshlets[index].triangleCount;
+  }
+
+  if (outStats) {
+    uint32_t total = 0;
+    for (const Meshlet &meshlet : data.meshlets) {
+      total += meshlet.triangleCount;
+    }
+    outStats->visibleMeshlets = uint32_t(visible);
+    outStats->frustumCulled = uint32_t(data.meshlets.size() - inFrustum);
+    outStats->backfaceCulled = uint32_t(inFrustum - visible);
+    outStats->visibleTriangles = visibleTriangles;
+    outStats->totalTriangles = total;
+    outStats->frustumCulledTriangles = total - inFrustumTriangles;
+    outStats->backfaceCulledTriangles = inFrustumTriangles - visibleTriangles;
+  }
+  return visible;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "Math/Frustum.h"
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// メッシュレット（D3D 非依存）
+//==================================
+// インデックス付きメッシュを小さな塊（既定 64 頂点 / 124 三角形）に分け、
+// 塊ごとに境界球と法線コーンを持たせる。塊単位で視錐台カリングと
+// 裏面カリングができる（今は CPU、後で GPU の増幅シェーダーへ移せる形）。
+//   ・頂点は VB の番号の表（vertices）を塊ごとに持ち、三角形は塊の中での
+//     番号（0..maxVertices-1）を 1 バイトずつ持つ
+//   ・塊は隣接する三角形から、新しい頂点が少なく向きの揃ったものを
+//     優先して貪欲に育てる
+
+// メッシュシェーダーでよく使われる上限（124 は 1 塊を 128 スレッドに収める値）
+constexpr uint32_t kMeshletMaxVertices = 64;
+constexpr uint32_t kMeshletMaxTriangles = 124;
+
+struct Meshlet {
+  uint32_t vertexOffset = 0;   // MeshletData::vertices の先頭
+  uint32_t triangleOffset = 0; // MeshletData::triangles の先頭（バイト）
+  uint32_t vertexCount = 0;
+  uint32_t triangleCount = 0;
+};
+
+// 塊の境界と法線コーン。
+// normalize(coneApex - カメラ位置) と coneAxis の内積が coneCutoff 以上なら
+// 塊のすべての三角形が裏を向いている（coneCutoff = 1 は判定しない）
+struct MeshletBounds {
+  SphereData sphere{};
+  Vector3 coneApex = {0.0f, 0.0f, 0.0f};
+  Vector3 coneAxis = {0.0f, 0.0f, 1.0f};
+  float coneCutoff = 1.0f;
+};
+
+struct MeshletData {
+  std::vector<Meshlet> meshlets;
+  std::vector<MeshletBounds> bounds; // meshlets と同じ並び
+  std::vector<uint32_t> vertices;    // 塊の頂点 → VB の番号
+  std::vector<uint8_t> triangles;    // 塊の中の番号 3 つで 1 三角形
+  // 境界球（一括カリング用に bounds から写したもの）
+  SphereBoundsSoA spheres;
+  // 部分メッシュ i の塊は [subsetMeshletStart[i], subsetMeshletStart[i + 1])
+  std::vector<uint32_t> subsetMeshletStart;
+
+  size_t Size() const { return meshlets.size(); }
+  void Clear();
+};
+
+// indices（三角形リスト）を塊に分けて out の末尾へ追加する
+void BuildMeshlets(const VertexData *vertices, size_t vertexCount,
+                   const uint32_t *indices, size_t indexCount,
+                   MeshletData &out,
+                   uint32_t maxVertices = kMeshletMaxVertices,
+                   uint32_t maxTriangles = kMeshletMaxTriangles);
+// 部分メッシュごとに分ける（塊は部分メッシュをまたがない）。out は作り直す
+void BuildMeshlets(const VertexData *vertices, size_t vertexCount,
+                   const uint32_t *indices, const MeshSubset *subsets,
+                   size_t subsetCount, MeshletData &out,
+                   uint32_t maxVertices = kMeshletMaxVertices,
+                   uint32_t maxTriangles = kMeshletMaxTriangles);
+
+// 塊の埋まり具合
+struct MeshletStats {
+  uint32_t meshletCount = 0;
+  uint32_t triangleCount = 0;
+  float averageVertices = 0.0f;
+  float averageTriangles = 0.0f;
+  float vertexFill = 0.0f;   // 平均頂点数 / maxVertices
+  float triangleFill = 0.0f; // 平均三角形数 / maxTriangles
+  // 頂点の重複（塊の頂点数の合計 / 使われている VB の頂点数）
+  float vertexDuplication = 0.0f;
+  // 裏面カリングできる塊（coneCutoff < 1）の割合
+  float coneCullableRatio = 0.0f;
+};
+MeshletStats AnalyzeMeshlets(const MeshletData &data,
+                             uint32_t maxVertices = kMeshletMaxVertices,
+                             uint32_t maxTriangles = kMeshletMaxTriangles);
+
+// カリングの結果
+struct MeshletCullStats {
+  uint32_t visibleMeshlets = 0;
+  uint32_t frustumCulled = 0;  // 視錐台の外
+  uint32_t backfaceCulled = 0; // 法線コーンで裏向き
+  uint32_t visibleTriangles = 0;
+  uint32_t totalTriangles = 0;
+  uint32_t frustumCulledTriangles = 0;  // frustumCulled の塊の三角形数
+  uint32_t backfaceCulledTriangles = 0; // backfaceCulled の塊の三角形数
+  float microseconds = 0.0f; // 計測する側が入れる
+};
+
+// 見えている塊の番号を昇順で outVisible に詰め、その個数を返す
+// （outVisible は塊の数分の領域が必要）。
+// frustum とカメラ位置はメッシュ座標（world * view * proj から作った視錐台と、
+// ワールドのカメラ位置を world の逆行列で戻したもの）
+size_t CullMeshlets(const MeshletData &data, const Frustum &localFrustum,
+                    const Vector3 &localCameraPosition, uint32_t *outVisible,
+                    MeshletCullStats *outStats = nullptr);
@@ -1,18 +1,18 @@
 #include "Model3D.h"
+#include "Math/Frustum.h"
+#include "Math/TransformBatch.h"
+#include "Model3D/ModelManager.h"
+#include "PipelineManager.h"
+#include "RenderQueue/RenderQueue.h"
+#include "UploadRing/UploadRing.h"
 #include "imgui/imgui.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
-#include <cstring> // ← 追加: std::memcpy
-#include <fstream>
-#include <numbers>
-#include <sstream>
-
-static constexpr float kPi = std::numbers::pi_v<float>;
 
 Model3D::~Model3D() {
-  if (vb_.resource)
-    vb_.resource->Release();
+  ReleaseMesh_();
   if (cbWvp_.resource)
     cbWvp_.resource->Release();
   if (cbMat_.resource)
@@ -24,23 +24,36 @@ Model3D::~Model3D() {
 void Model3D::Initialize(ID3D12Device *device) {
   device_ = device;
 
-  // WVP CB
-  cbWvp_.resource = CreateBufferResource(device_, sizeof(TransformationMatrix));
-  cbWvp_.resource->Map(0, nullptr, reinterpret_cast<void **>(&cbWvp_.mapped));
+  if (uploadRing_) {
+    // CB は Draw のたびにリングから切り出すので、値は CPU 側に持つ
+    cbWvp_.mapped = &ringConstants_.wvp;
+    cbMat_.mapped = &ringConstants_.material;
+    cbLight_.mapped = &ringConstants_.light;
+  } else {
+    cbWvp_.resource =
+        CreateBufferResource(device_, sizeof(TransformationMatrix));
+    cbWvp_.resource->Map(0, nullptr,
+                         reinterpret_cast<void **>(&cbWvp_.mapped));
+    cbMat_.resource = CreateBufferResource(device_, sizeof(Material));
+    cbMat_.resource->Map(0, nullptr,
+                         reinterpret_cast<void **>(&cbMat_.mapped));
+    // Light CB（各Modelが自前で持つ）
+    cbLight_.resource =
+        CreateBufferResource(device_, sizeof(DirectionalLight));
+    cbLight_.resource->Map(0, nullptr,
+                           reinterpret_cast<void **>(&cbLight_.mapped));
+  }
+
+  // WVP
   cbWvp_.mapped->WVP = MakeIdentity4x4();
   cbWvp_.mapped->World = MakeIdentity4x4();
 
-  // Material CB
-  cbMat_.resource = CreateBufferResource(device_, sizeof(Material));
-  cbMat_.resource->Map(0, nullptr, reinterpret_cast<void **>(&cbMat_.mapped));
+  // Material
   cbMat_.mapped->color = {1, 1, 1, 1};
   cbMat_.mapped->lightingMode = 2; // 既定 HalfLambert
   cbMat_.mapped->uvTransform = MakeIdentity4x4();
 
-  // Light CB（各Modelが自前で持つ）
-  cbLight_.resource = CreateBufferResource(device_, sizeof(DirectionalLight));
-  cbLight_.resource->Map(0, nullptr,
-                         reinterpret_cast<void **>(&cbLight_.mapped));
+  // Light
   cbLight_.mapped->color = {1, 1, 1, 1};
   cbLight_.mapped->direction = {0.0f, -1.0f, 0.0f};
   cbLight_.mapped->intensity = 1.0f;
@@ -51,205 +64,295 @@ void Model3D::Initialize(ID3D12Device *device) {
 
 bool Model3D::LoadObjGeometryLikeFunction(const std::string &directoryPath,
                                           const std::string &filename) {
-  std::vector<VertexData> verts;
-  MaterialData mtl;
-  if (!LoadObjToVertices_(directoryPath, filename, verts, mtl)) {
+  ReleaseMesh_();
+  // このインスタンス専用のメッシュ
+  ModelMesh *mesh = new ModelMesh();
+  if (!mesh->Load(device_, directoryPath, filename, meshSettings_)) {
+    delete mesh;
     return false;
   }
-  materialFile_ = mtl;
-  UploadVB_(verts);
+  AttachMesh_(mesh, nullptr);
   return true;
 }
 
-void Model3D::EnsureSphericalUVIfMissing() {
-  if (!vb_.resource || vb_.vertexCount == 0)
-    return;
+bool Model3D::LoadObjGeometryLikeFunction(ModelManager &models,
+                                          const std::string &directoryPath,
+                                          const std::string &filename) {
+  ReleaseMesh_();
+  ModelMesh *mesh = models.Acquire(directoryPath, filename, meshSettings_);
+  if (!mesh) {
+    return false;
+  }
+  AttachMesh_(mesh, &models);
+  return true;
+}
+
+void Model3D::AttachMesh_(ModelMesh *mesh, ModelManager *owner) {
+  mesh_ = mesh;
+  meshOwner_ = owner;
+  subsetSrv_.assign(mesh_->GetSubsetCount(), D3D12_GPU_DESCRIPTOR_HANDLE{});
+  currentLod_ = 0;
+  worldSphere_ = mesh_->GetLocalBoundingSphere();
+}
 
-  VertexData *vtx = nullptr;
-  vb_.resource->Map(0, nullptr, reinterpret_cast<void **>(&vtx));
-  if (!vtx)
+void Model3D::ReleaseMesh_() {
+  if (!mesh_)
     return;
+  if (meshOwner_) {
+    meshOwner_->Release(mesh_);
+  } else {
+    delete mesh_;
+  }
+  mesh_ = nullptr;
+  meshOwner_ = nullptr;
+  subsetSrv_.clear();
+}
 
-  bool allZero = true;
-  for (uint32_t i = 0; i < vb_.vertexCount; ++i) {
-    if (std::abs(vtx[i].texcoord.x) > 1e-8f ||
-        std::abs(vtx[i].texcoord.y) > 1e-8f) {
-      allZero = false;
-      break;
-    }
+const ModelMesh &Model3D::Mesh_() const {
+  // 読み込み前は空のメッシュとして振る舞う
+  static const ModelMesh kEmpty;
+  return mesh_ ? *mesh_ : kEmpty;
+}
+
+const std::string &Model3D::GetSubmeshTexturePath(size_t index) const {
+  return Mesh_().GetSubsetTexturePath(index);
+}
+
+void Model3D::SetSubmeshTexture(size_t index,
+                                D3D12_GPU_DESCRIPTOR_HANDLE srv) {
+  assert(index < subsetSrv_.size());
+  subsetSrv_[index] = srv;
+}
+
+void Model3D::EnsureSphericalUVIfMissing() {
+  if (mesh_ && mesh_->EnsureSphericalUVIfMissing()) {
+    cbMat_.mapped->uvTransform = MakeIdentity4x4();
   }
-  if (!allZero) {
-    vb_.resource->Unmap(0, nullptr);
-    return;
+}
+
+void Model3D::EnableRaycast(uint32_t workerCount) {
+  meshSettings_.buildBvh = true;
+  meshSettings_.bvhWorkerCount = workerCount;
+  if (mesh_) {
+    mesh_->EnableRaycast(workerCount);
   }
+}
+
+void Model3D::EnableMeshlets() {
+  meshSettings_.buildMeshlets = true;
+  if (mesh_) {
+    mesh_->EnableMeshlets();
+  }
+}
 
-  for (uint32_t i = 0; i < vb_.vertexCount; ++i) {
-    const float x = vtx[i].position.x;
-    const float y = vtx[i].position.y;
-    const float z = vtx[i].position.z;
+const MeshletCullStats &Model3D::CullMeshlets(const Matrix4x4 &view,
+                                              const Matrix4x4 &proj) {
+  const MeshletData &meshlets = Mesh_().GetMeshlets();
+  meshletVisible_.resize(meshlets.Size());
+  const auto start = std::chrono::steady_clock::now();
+
+  // 視錐台とカメラ位置をメッシュ座標へ移して判定する
+  const Matrix4x4 world = MakeAffineMatrix(transform_);
+  const Frustum localFrustum =
+      MakeFrustum(Multiply(world, Multiply(view, proj)));
+  const Matrix4x4 cameraWorld = InverseAffine(view);
+  const Vector3 cameraPosition = {cameraWorld.m[3][0], cameraWorld.m[3][1],
+                                  cameraWorld.m[3][2]};
+  const Vector3 localCamera =
+      Vector3Transform(cameraPosition, InverseAffine(world));
+
+  ::CullMeshlets(meshlets, localFrustum, localCamera, meshletVisible_.data(),
+                 &meshletCullStats_);
+  meshletCullStats_.microseconds =
+      std::chrono::duration<float, std::micro>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+  return meshletCullStats_;
+}
 
-    const float r = (std::max)(1e-6f, std::sqrt(x * x + y * y + z * z));
-    const float theta = std::atan2(z, x); // [-pi, pi]
-    const float phi =
-        std::asin(std::clamp(y / r, -1.0f, 1.0f)); // [-pi/2, pi/2]
+bool Model3D::Raycast(const RayQuery &worldRay, RayHit *outHit) const {
+  const TriangleBvh &bvh = Mesh_().GetBvh();
+  if (bvh.Empty())
+    return false;
 
-    float u = 0.5f + (theta / (2.0f * kPi));
-    float v = 0.5f - (phi / (1.0f * kPi));
+  // t はワールドでも物体空間でも同じ値になる（diff を正規化しないため）
+  const Matrix4x4 world = MakeAffineMatrix(transform_);
+  const Matrix4x4 inv = InverseAffine(world);
+  RayQuery local = worldRay;
+  local.origin = Vector3Transform(worldRay.origin, inv);
+  local.diff = TransformNormal(worldRay.diff, inv);
 
-    if (u < 0.0f)
-      u += 1.0f;
-    if (u > 1.0f)
-      u -= 1.0f;
+  RayHit localHit;
+  if (!bvh.RaycastClosest(local, &localHit))
+    return false;
 
-    vtx[i].texcoord = {u, v};
+  if (outHit) {
+    outHit->t = localHit.t;
+    outHit->distance = std::abs(localHit.t) * Length(worldRay.diff);
+    outHit->point = Add(worldRay.origin, Multiply(worldRay.diff, localHit.t));
+    // 法線は逆転置行列で戻す
+    outHit->normal =
+        Normalize(TransformNormal(localHit.normal, Transpose(inv)));
   }
+  return true;
+}
 
-  vb_.resource->Unmap(0, nullptr);
-  cbMat_.mapped->uvTransform = MakeIdentity4x4();
+bool Model3D::RaycastAny(const RayQuery &worldRay) const {
+  const TriangleBvh &bvh = Mesh_().GetBvh();
+  if (bvh.Empty())
+    return false;
+
+  const Matrix4x4 inv = InverseAffine(MakeAffineMatrix(transform_));
+  RayQuery local = worldRay;
+  local.origin = Vector3Transform(worldRay.origin, inv);
+  local.diff = TransformNormal(worldRay.diff, inv);
+  return bvh.RaycastAny(local);
 }
 
 void Model3D::Update(const Matrix4x4 &view, const Matrix4x4 &proj) {
-  Matrix4x4 world = MakeAffineMatrix(transform_.scale, transform_.rotation,
-                                     transform_.translation);
+  Matrix4x4 world = MakeAffineMatrix(transform_);
   cbWvp_.mapped->World = world;
   cbWvp_.mapped->WVP = Multiply(world, Multiply(view, proj));
+  if (Mesh_().GetVertexFormat() == VertexFormat::Quantized) {
+    cbWvp_.mapped->WVP =
+        Multiply(Mesh_().GetDequantizeMatrix(), cbWvp_.mapped->WVP);
+  }
+  worldSphere_ = TransformSphere(Mesh_().GetLocalBoundingSphere(), world);
 }
 
-void Model3D::Draw(ID3D12GraphicsCommandList *cmdList) {
-  if (!vb_.resource)
-    return;
-
-  cmdList->IASetVertexBuffers(0, 1, &vb_.view);
-  cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-  // RootParam: 0:Material, 1:WVP, 2:SRV, 3:Light
-  cmdList->SetGraphicsRootConstantBufferView(
-      0, cbMat_.resource->GetGPUVirtualAddress());
-  cmdList->SetGraphicsRootConstantBufferView(
-      1, cbWvp_.resource->GetGPUVirtualAddress());
-  cmdList->SetGraphicsRootDescriptorTable(2, textureSrv_);
-  cmdList->SetGraphicsRootConstantBufferView(
-      3, cbLight_.resource->GetGPUVirtualAddress());
-
-  cmdList->DrawInstanced(vb_.vertexCount, 1, 0, 0);
+uint32_t Model3D::SelectLod(const Matrix4x4 &view, const Matrix4x4 &proj,
+                            float viewportHeight) {
+  const ModelMesh &mesh = Mesh_();
+  const uint32_t lodCount = mesh.GetLodCount();
+  const float localRadius = mesh.GetLocalBoundingSphere().radius;
+  if (forcedLod_ >= 0) {
+    currentLod_ = (std::min)(uint32_t(forcedLod_), lodCount - 1);
+    return currentLod_;
+  }
+  if (lodCount <= 1 || localRadius <= 0.0f) {
+    currentLod_ = 0;
+    return currentLod_;
+  }
+  // ワールドの拡大縮小は投影半径 / ローカル半径に含まれる
+  const float radiusPixels =
+      ProjectedSphereRadius(worldSphere_, view, proj, viewportHeight);
+  currentLod_ = ::SelectLod(mesh.GetLodErrors(), lodCount,
+                            radiusPixels / localRadius, lodThreshold_);
+  return currentLod_;
 }
 
-// =========================
-// 内部：OBJローダ（移植）
-// =========================
-
-bool Model3D::LoadObjToVertices_(const std::string &directoryPath,
-                                 const std::string &filename,
-                                 std::vector<VertexData> &outVertices,
-                                 MaterialData &outMtl) {
-  std::vector<Vector4> positions;
-  std::vector<Vector3> normals;
-  std::vector<Vector2> texcoords;
+void Model3D::UpdateBatch(Model3D *const *models, size_t count,
+                          const Matrix4x4 &view, const Matrix4x4 &proj,
+                          uint32_t workerCount) {
+  thread_local TransformBatchSoA transforms;
+  thread_local std::vector<TransformationMatrix> results;
 
-  std::ifstream file(directoryPath + "/" + filename);
-  if (!file.is_open()) {
-    return false;
+  transforms.Resize(count);
+  results.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    transforms.Set(i, models[i]->transform_);
   }
 
-  std::string line;
-  while (std::getline(file, line)) {
-    std::string id;
-    std::istringstream s(line);
-    s >> id;
-
-    if (id == "v") {
-      Vector4 p{};
-      s >> p.x >> p.y >> p.z;
-      p.x = -p.x;
-      p.w = 1.0f;
-      positions.push_back(p); // 左手系へ
-    } else if (id == "vt") {
-      Vector2 t{};
-      s >> t.x >> t.y;
-      t.y = 1.0f - t.y;
-      texcoords.push_back(t);
-    } else if (id == "vn") {
-      Vector3 n{};
-      s >> n.x >> n.y >> n.z;
-      n.x = -n.x;
-      normals.push_back(n);
-    } else if (id == "f") {
-      VertexData tri[3];
-      for (int vi = 0; vi < 3; ++vi) {
-        std::string vd;
-        s >> vd;
-        std::string idx[3] = {"", "", ""};
-        size_t prev = 0, pos;
-        int field = 0;
-        while (field < 2 && (pos = vd.find('/', prev)) != std::string::npos) {
-          idx[field++] = vd.substr(prev, pos - prev);
-          prev = pos + 1;
-        }
-        if (prev < vd.size() && field < 3)
-          idx[field++] = vd.substr(prev);
-
-        int pi = std::stoi(idx[0]);
-        int ti = (!idx[1].empty()) ? std::stoi(idx[1]) : 0;
-        int ni = (!idx[2].empty()) ? std::stoi(idx[2]) : 0;
-
-        Vector4 p = positions[pi - 1];
-        Vector2 t = (ti > 0 && ti - 1 < (int)texcoords.size())
-                        ? texcoords[ti - 1]
-                        : Vector2{0, 0};
-        Vector3 n = (ni > 0 && ni - 1 < (int)normals.size()) ? normals[ni - 1]
-                                                             : Vector3{0, 0, 0};
-        tri[vi] = {p, t, n};
-      }
-      // 面の向きを反転して格納（既存実装と同じ）
-      outVertices.push_back(tri[2]);
-      outVertices.push_back(tri[1]);
-      outVertices.push_back(tri[0]);
-    } else if (id == "mtllib") {
-      std::string mtlName;
-      s >> mtlName;
-      outMtl = LoadMaterialTemplateFile_(directoryPath, mtlName);
+  ComputeTransformationMatrices(transforms, Multiply(view, proj),
+                                results.data(), workerCount);
+
+  for (size_t i = 0; i < count; ++i) {
+    const ModelMesh &mesh = models[i]->Mesh_();
+    if (mesh.GetVertexFormat() == VertexFormat::Quantized) {
+      results[i].WVP = Multiply(mesh.GetDequantizeMatrix(), results[i].WVP);
     }
+    if (models[i]->cbWvp_.mapped) {
+      *models[i]->cbWvp_.mapped = results[i];
+    }
+    models[i]->worldSphere_ =
+        TransformSphere(mesh.GetLocalBoundingSphere(), results[i].World);
+  }
+}
+
+bool Model3D::ConstantAddresses_(D3D12_GPU_VIRTUAL_ADDRESS &material,
+                                 D3D12_GPU_VIRTUAL_ADDRESS &wvp,
+                                 D3D12_GPU_VIRTUAL_ADDRESS &light) {
+  if (uploadRing_) {
+    // 今の値をリングへ写す（溢れたら描かない。数は UploadRing の統計に出る）
+    material = uploadRing_->PushConstants(*cbMat_.mapped);
+    wvp = uploadRing_->PushConstants(*cbWvp_.mapped);
+    light = uploadRing_->PushConstants(*cbLight_.mapped);
+    return material != 0 && wvp != 0 && light != 0;
   }
+  material = cbMat_.resource->GetGPUVirtualAddress();
+  wvp = cbWvp_.resource->GetGPUVirtualAddress();
+  light = cbLight_.resource->GetGPUVirtualAddress();
   return true;
 }
 
-void Model3D::UploadVB_(const std::vector<VertexData> &vertices) {
-  vb_.vertexCount = static_cast<uint32_t>(vertices.size());
-  if (vb_.vertexCount == 0)
+void Model3D::Draw(ID3D12GraphicsCommandList *cmdList) {
+  if (!mesh_ || mesh_->GetVertexCount() == 0)
     return;
 
-  const size_t sizeBytes = sizeof(VertexData) * vb_.vertexCount;
-  vb_.resource = CreateBufferResource(device_, sizeBytes);
+  D3D12_GPU_VIRTUAL_ADDRESS matAddress, wvpAddress, lightAddress;
+  if (!ConstantAddresses_(matAddress, wvpAddress, lightAddress))
+    return;
 
-  void *mapped = nullptr;
-  vb_.resource->Map(0, nullptr, &mapped);
-  std::memcpy(mapped, vertices.data(), sizeBytes);
-  vb_.resource->Unmap(0, nullptr);
+  // VB / IB は共有メッシュのもの
+  cmdList->IASetVertexBuffers(0, 1, &mesh_->GetVertexBufferView());
+  cmdList->IASetIndexBuffer(&mesh_->GetIndexBufferView());
+  cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-  vb_.view.BufferLocation = vb_.resource->GetGPUVirtualAddress();
-  vb_.view.SizeInBytes = static_cast<UINT>(sizeBytes);
-  vb_.view.StrideInBytes = sizeof(VertexData);
+  // RootParam: 0:Material, 1:WVP, 2:SRV, 3:Light
+  cmdList->SetGraphicsRootConstantBufferView(0, matAddress);
+  cmdList->SetGraphicsRootConstantBufferView(1, wvpAddress);
+  cmdList->SetGraphicsRootConstantBufferView(3, lightAddress);
+
+  // 部分メッシュごとに描く（同じ SRV が続く間は積み直さない）
+  const MeshSubset *lod = mesh_->GetSubsets(currentLod_);
+  UINT64 boundSrv = 0;
+  for (uint32_t i = 0; i < mesh_->GetSubsetCount(); ++i) {
+    if (lod[i].indexCount == 0)
+      continue;
+    const D3D12_GPU_DESCRIPTOR_HANDLE srv = GetSubmeshSrv(i);
+    if (boundSrv == 0 || srv.ptr != boundSrv) {
+      cmdList->SetGraphicsRootDescriptorTable(2, srv);
+      boundSrv = srv.ptr;
+    }
+    cmdList->DrawIndexedInstanced(lod[i].indexCount, 1, lod[i].indexStart, 0,
+                                  0);
+  }
 }
 
-MaterialData
-Model3D::LoadMaterialTemplateFile_(const std::string &directoryPath,
-                                   const std::string &filename) {
-  MaterialData materialData{};
-  std::string line;
-  std::ifstream file(directoryPath + "/" + filename);
-  assert(file.is_open());
-
-  while (std::getline(file, line)) {
-    std::string identifier;
-    std::istringstream s(line);
-    s >> identifier;
-    if (identifier == "map_Kd") {
-      std::string textureFilename;
-      s >> textureFilename;
-      materialData.textureFilePath = directoryPath + "/" + textureFilename;
-    }
+void Model3D::Submit(RenderQueue &queue, PipelineManager &pipelines,
+                     const Matrix4x4 &view) {
+  if (!mesh_ || mesh_->GetVertexCount() == 0)
+    return;
+
+  // VB の並びと入力レイアウトを合わせる（形式ごとに PSO が違う）
+  GraphicsPipeline *pipeline =
+      pipelines.Get(Object3DPipelineKey(mesh_->GetVertexFormat()));
+  assert(pipeline);
+  if (!pipeline)
+    return;
+
+  DrawPacket packet;
+  if (!ConstantAddresses_(packet.material, packet.wvp, packet.light))
+    return;
+  packet.pipeline = pipeline;
+  packet.vbv = mesh_->GetVertexBufferView();
+  packet.ibv = mesh_->GetIndexBufferView();
+
+  // 奥行きは境界球の中心のビュー空間 z（Update で更新したもの）
+  const Vector3 &c = worldSphere_.center;
+  const float viewZ = c.x * view.m[0][2] + c.y * view.m[1][2] +
+                      c.z * view.m[2][2] + view.m[3][2];
+
+  const MeshSubset *lod = mesh_->GetSubsets(currentLod_);
+  for (uint32_t i = 0; i < mesh_->GetSubsetCount(); ++i) {
+    if (lod[i].indexCount == 0)
+      continue;
+    packet.srv = GetSubmeshSrv(i);
+    packet.sortKey = queue.MakeSortKey(pipeline, packet.srv, viewZ);
+    packet.indexCount = lod[i].indexCount;
+    packet.startIndex = lod[i].indexStart;
+    queue.Submit(packet);
   }
-  return materialData;
 }
 
 // -------------------------------
@@ -1,11 +1,18 @@
 #pragma once
 #include "Math/Math.h"
 #include "Math/MathTypes.h"
+#include "Model3D/ModelMesh.h"
 #include "function/function.h"
 #include <array>
 #include <d3d12.h>
 #include <string>
 #include <vector>
+class ModelManager;
+class UploadRing;
+class RenderQueue;
+class GraphicsPipeline;
+class PipelineManager;
+
 // -------------------------------
 // 非スコープ enum: 無修飾で使える
 // -------------------------------
@@ -15,6 +22,8 @@ enum LightingMode {
   HalfLambert = 2, // ハーフランバート
 };
 
+// 置くモデル 1 つ分（Transform と CB）。VB / IB などのメッシュは ModelMesh で、
+// ModelManager から読めば同じモデルどうしで共有する
 class Model3D {
 public:
   // -------------------------------
@@ -36,22 +45,73 @@ public:
   Model3D() = default;
   explicit Model3D(const struct LightingConfig &cfg) : initialLighting_(cfg) {}
   ~Model3D();
+  Model3D(const Model3D &) = delete;
+  Model3D &operator=(const Model3D &) = delete;
 
-  // Device依存リソースの作成（CB・VBなど）
+  // Device依存リソースの作成（CB）
   void Initialize(ID3D12Device *device);
 
-  // OBJ読み込み（function.hの挙動に合わせた軽量版）
+  // CB を自前のリソースでなく UploadRing から毎フレーム切り出す（Initialize 前に
+  // 指定）。Mat() / Light() などは CPU 側の値になり、Draw のたびにリングへ写す
+  void UseUploadRing(UploadRing *ring) { uploadRing_ = ring; }
+
+  // VB の頂点フォーマット（読み込み前に指定。Compact / Quantized は
+  // InputLayoutType::Object3DCompact / Object3DQuantized の PSO で描画する）
+  void SetVertexFormat(VertexFormat format) {
+    meshSettings_.vertexFormat = format;
+  }
+  // 読み込み済みならメッシュが実際に使っているフォーマット
+  VertexFormat GetVertexFormat() const {
+    return mesh_ ? mesh_->GetVertexFormat() : meshSettings_.vertexFormat;
+  }
+
+  // OBJ読み込み（このインスタンス専用のメッシュを作る。
+  // 解析・キャッシュの扱いは ModelMesh::Load）
   bool LoadObjGeometryLikeFunction(const std::string &directoryPath,
                                    const std::string &filename);
+  // ModelManager から共有メッシュを借りる（同じモデルは 1 回だけ解析 /
+  // アップロード、破棄時に返す）。models はこのモデルより長く生かす
+  bool LoadObjGeometryLikeFunction(ModelManager &models,
+                                   const std::string &directoryPath,
+                                   const std::string &filename);
+  // 使っているメッシュ（読み込み前は nullptr）
+  const ModelMesh *GetMesh() const { return mesh_; }
+
+  // .cg2mesh キャッシュを使うか（既定 true、読み込み前に指定）
+  void SetMeshCacheEnabled(bool enabled) {
+    meshSettings_.cacheEnabled = enabled;
+  }
 
-  // UV未設定(=0,0)に対し簡易的な球面UVを焼き込む
+  // メッシュの読み込み（共有メッシュなら最初に読んだときのもの）
+  using MeshLoadStats = ::MeshLoadStats;
+  const MeshLoadStats &GetMeshLoadStats() const {
+    return Mesh_().GetLoadStats();
+  }
+
+  // UV未設定(=0,0)に対し簡易的な球面UVを焼き込む（共有メッシュなら全員に効く）
   void EnsureSphericalUVIfMissing();
 
   // モデルに適用するSRV(GPUハンドル)をセット
+  // （個別に指定していない部分メッシュはこれを使う）
   void SetTexture(D3D12_GPU_DESCRIPTOR_HANDLE srvGPUHandle) {
     textureSrv_ = srvGPUHandle;
   }
 
+  // ---- 部分メッシュ（o / g / usemtl ごと、VB / IB は共有）----
+  // 同じマテリアルの部分メッシュは隣り合うよう並べ替えてある
+  size_t GetSubmeshCount() const { return Mesh_().GetSubsetCount(); }
+  const MeshSubset &GetSubmesh(size_t index) const {
+    return Mesh_().GetSubsets(0)[index];
+  }
+  // .mtl の map_Kd（なければ空）。TextureManager で読んで SetSubmeshTexture へ
+  const std::string &GetSubmeshTexturePath(size_t index) const;
+  // SRV はインスタンスごと（メッシュを共有していても別のテクスチャにできる）
+  void SetSubmeshTexture(size_t index, D3D12_GPU_DESCRIPTOR_HANDLE srv);
+  // 部分メッシュを描くときの SRV（個別の指定がなければ SetTexture のもの）
+  D3D12_GPU_DESCRIPTOR_HANDLE GetSubmeshSrv(size_t index) const {
+    return subsetSrv_[index].ptr ? subsetSrv_[index] : textureSrv_;
+  }
+
   // 構造体でまとめて渡す版（宣言時 or 後から）
   Model3D &SetLightingConfig(const LightingConfig &cfg) {
     initialLighting_ = cfg;
@@ -79,22 +139,86 @@ public:
 
   // 外から Transform / CB を直接いじりたい場合のアクセサ
   Transform &T() { return transform_; }
+  const Transform &GetTransform() const { return transform_; }
   Material *Mat() { return cbMat_.mapped; }
   DirectionalLight *Light() { return cbLight_.mapped; }
 
+  // 頂点キャッシュ最適化の前後（ACMR / ATVR、OBJ 読み込み時）
+  const MeshOptimizeReport &GetMeshOptimizeReport() const {
+    return Mesh_().GetMeshOptimizeReport();
+  }
+
+  // 境界ボリューム（ローカルは OBJ 読み込み時、ワールド球は Update で更新）
+  const AABB &GetLocalAABB() const { return Mesh_().GetLocalAABB(); }
+  const SphereData &GetLocalBoundingSphere() const {
+    return Mesh_().GetLocalBoundingSphere();
+  }
+  const SphereData &GetWorldBoundingSphere() const { return worldSphere_; }
+
+  // ---- レイキャスト（ピッキング）----
+  // CPU 側に三角形のコピーを残して BVH を作る（BVH はメッシュと共有）。
+  // 読み込み前に呼べば読み込み時に、読み込み後なら VB を読み戻して構築する
+  void EnableRaycast(uint32_t workerCount = 1);
+  // ワールド空間のレイで最も近い交差（Transform の逆行列で物体空間へ移して判定、
+  // 結果はワールド空間で返す）
+  bool Raycast(const RayQuery &worldRay, RayHit *outHit = nullptr) const;
+  // どれかに当たるか（遮蔽判定用）
+  bool RaycastAny(const RayQuery &worldRay) const;
+  const TriangleBvh &GetBvh() const { return Mesh_().GetBvh(); }
+
+  // ---- メッシュレット（LOD0 を 64 頂点 / 124 三角形の塊に分ける）----
+  // 塊ごとの境界球と法線コーンで視錐台 / 裏面カリングする。読み込み前に
+  // 呼べば読み込み時に、読み込み後なら VB / IB を読み戻して作る
+  void EnableMeshlets();
+  const MeshletData &GetMeshlets() const { return Mesh_().GetMeshlets(); }
+  const MeshletStats &GetMeshletStats() const {
+    return Mesh_().GetMeshletStats();
+  }
+  // 今のカメラで塊をカリングし、結果と所要時間を返す（描画は変えない。
+  // 見えた塊は GetVisibleMeshlets の先頭 visibleMeshlets 個）
+  const MeshletCullStats &CullMeshlets(const Matrix4x4 &view,
+                                       const Matrix4x4 &proj);
+  const uint32_t *GetVisibleMeshlets() const { return meshletVisible_.data(); }
+
+  // ---- LOD（VB は共有、LOD ごとに IB の範囲が違う）----
+  // 読み込み時に作る LOD（読み込み前に指定。lodCount = 1 で作らない）
+  void SetLodSettings(const MeshLodSettings &settings) {
+    meshSettings_.lod = settings;
+  }
+  // 画面上で許す誤差（ピクセル）
+  void SetLodThreshold(float pixels) { lodThreshold_ = pixels; }
+  // 固定する LOD（-1 で自動）
+  void ForceLod(int lod) { forcedLod_ = lod; }
+  // 境界球の投影半径から LOD を選ぶ（Update の後、Draw の前に呼ぶ）
+  uint32_t SelectLod(const Matrix4x4 &view, const Matrix4x4 &proj,
+                     float viewportHeight);
+  uint32_t GetLodCount() const { return Mesh_().GetLodCount(); }
+  uint32_t GetCurrentLod() const { return currentLod_; }
+  uint32_t GetLodTriangleCount(uint32_t lod) const {
+    return Mesh_().GetLodTriangleCount(lod);
+  }
+
   // 行列更新（view/projection は外部カメラから）
   void Update(const Matrix4x4 &view, const Matrix4x4 &proj);
 
-  // 描画（RootParam: 0:Material, 1:WVP, 2:SRV, 3:Light）
+  // 複数モデルの行列をまとめて更新（view*proj は 1 回だけ計算し、
+  // TransformBatch の SIMD 経路で World/WVP を求めて各 CB へ書き込む）
+  static void UpdateBatch(Model3D *const *models, size_t count,
+                          const Matrix4x4 &view, const Matrix4x4 &proj,
+                          uint32_t workerCount = 1);
+
+  // 描画（部分メッシュごとに DrawIndexedInstanced、SRV は変わるときだけ積む。
+  // RootParam: 0:Material, 1:WVP, 2:SRV, 3:Light）
   void Draw(ID3D12GraphicsCommandList *cmdList);
 
+  // Draw の代わりに部分メッシュごとの DrawPacket を queue へ積む
+  // （PSO はメッシュの頂点形式から pipelines で引く。奥行きは view から、
+  // 並べ替えと状態の省略は queue 側）
+  void Submit(RenderQueue &queue, PipelineManager &pipelines,
+              const Matrix4x4 &view);
+
 private:
   // ========== 内部ユーティリティ ==========
-  struct VB {
-    ID3D12Resource *resource = nullptr;
-    D3D12_VERTEX_BUFFER_VIEW view{};
-    uint32_t vertexCount = 0;
-  };
   struct CB_WVP {
     ID3D12Resource *resource = nullptr;
     TransformationMatrix *mapped = nullptr;
@@ -107,19 +231,24 @@ private:
     ID3D12Resource *resource = nullptr;
     DirectionalLight *mapped = nullptr;
   };
+  // UploadRing を使うときの CB の中身（mapped はここを指す）
+  struct RingConstants {
+    TransformationMatrix wvp;
+    Material material;
+    DirectionalLight light;
+  };
 
-  // OBJローダ（最小移植）
-  bool LoadObjToVertices_(const std::string &directoryPath,
-                          const std::string &filename,
-                          std::vector<VertexData> &outVertices,
-                          MaterialData &outMtl);
-
-  // 頂点配列から VB を生成しアップロード
-  void UploadVB_(const std::vector<VertexData> &vertices);
+  // 読んだメッシュを使い始める（owner は共有元、専用なら nullptr）
+  void AttachMesh_(ModelMesh *mesh, ModelManager *owner);
+  // 今のメッシュを返す / 破棄する
+  void ReleaseMesh_();
+  // 今のメッシュ（読み込み前は空のメッシュ）
+  const ModelMesh &Mesh_() const;
 
-  // .mtl 読み
-  MaterialData LoadMaterialTemplateFile_(const std::string &directoryPath,
-                                         const std::string &filename);
+  // 描画に使う CB のアドレス（UploadRing ならここで切り出す。溢れたら false）
+  bool ConstantAddresses_(D3D12_GPU_VIRTUAL_ADDRESS &material,
+                          D3D12_GPU_VIRTUAL_ADDRESS &wvp,
+                          D3D12_GPU_VIRTUAL_ADDRESS &light);
 
   // ライティング初期値/現在値をCBへ反映
   void ApplyLightingIfReady_();
@@ -127,15 +256,36 @@ private:
 private:
   // ========== メンバ ==========
   ID3D12Device *device_ = nullptr;
-  VB vb_{};
   CB_WVP cbWvp_{};
   CB_Material cbMat_{};
   CB_Light cbLight_{};
+  UploadRing *uploadRing_ = nullptr; // nullptr なら CB は自前のリソース
+  RingConstants ringConstants_{};
   D3D12_GPU_DESCRIPTOR_HANDLE textureSrv_{}; // 外部で選択
 
+  // メッシュ（meshOwner_ が nullptr なら専用で、破棄時に delete）
+  ModelMesh *mesh_ = nullptr;
+  ModelManager *meshOwner_ = nullptr;
+  // 読み込み時の設定（頂点フォーマット / LOD / キャッシュ / BVH など）
+  ModelMeshSettings meshSettings_{};
+
   Transform transform_{{1, 1, 1}, {0, 0, 0}, {0, 0, 0}};
-  MaterialData materialFile_{};
   bool visible_ = false;
 
+  // 部分メッシュごとの SRV（ptr == 0 は textureSrv_ を使う）
+  std::vector<D3D12_GPU_DESCRIPTOR_HANDLE> subsetSrv_;
+
+  // LOD（選ぶのはインスタンスごと）
+  float lodThreshold_ = 1.0f;
+  int forcedLod_ = -1;
+  uint32_t currentLod_ = 0;
+
+  // ワールドの境界球（Update で更新）
+  SphereData worldSphere_{};
+
+  // メッシュレットのカリング結果
+  MeshletCullStats meshletCullStats_{};
+  std::vector<uint32_t> meshletVisible_;
+
   LightingConfig initialLighting_{};
 };
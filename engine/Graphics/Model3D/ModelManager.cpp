@@ -0,0 +1,74 @@
+#include "ModelManager.h"
+#include <cassert>
+#include <cstdio>
+
+void ModelManager::Term() {
+  cache_.clear();
+  meshToKey_.clear();
+  device_ = nullptr;
+}
+
+std::string ModelManager::MakeKey_(const std::string &sourcePath,
+                                   const ModelMeshSettings &settings) {
+  // ファイル名に含まれない区切り（'|'）でつなぐ。設定はディスクキャッシュと
+  // 同じハッシュ（float をビット列のまま扱うので to_string の丸めで別の設定が
+  // 同じキーにならない）
+  char hash[32];
+  std::snprintf(hash, sizeof(hash), "|%016llx",
+                static_cast<unsigned long long>(
+                    HashMeshCacheSettings(settings.vertexFormat, settings.lod)));
+  return sourcePath + hash;
+}
+
+ModelMesh *ModelManager::Acquire(const std::string &directoryPath,
+                                 const std::string &filename,
+                                 const ModelMeshSettings &settings) {
+  assert(device_);
+  const std::string key = MakeKey_(directoryPath + "/" + filename, settings);
+
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    ModelMesh *mesh = it->second.mesh.get();
+    if (settings.buildBvh) {
+      mesh->EnableRaycast(settings.bvhWorkerCount);
+    }
+    if (settings.buildMeshlets) {
+      mesh->EnableMeshlets();
+    }
+    ++it->second.refCount;
+    return mesh;
+  }
+
+  // 新規：読めなかったものは登録しない
+  auto mesh = std::make_unique<ModelMesh>();
+  if (!mesh->Load(device_, directoryPath, filename, settings)) {
+    return nullptr;
+  }
+  ModelMesh *raw = mesh.get();
+  cache_[key] = Entry{std::move(mesh), 1};
+  meshToKey_[raw] = key;
+  return raw;
+}
+
+void ModelManager::Release(ModelMesh *mesh) {
+  if (!mesh)
+    return;
+  auto itKey = meshToKey_.find(mesh);
+  assert(itKey != meshToKey_.end()); // このマネージャのメッシュではない
+  if (itKey == meshToKey_.end())
+    return;
+
+  auto it = cache_.find(itKey->second);
+  assert(it != cache_.end() && it->second.refCount > 0);
+  if (--it->second.refCount == 0) {
+    cache_.erase(it);
+    meshToKey_.erase(itKey);
+  }
+}
+
+uint32_t ModelManager::GetRefCount(const ModelMesh *mesh) const {
+  auto itKey = meshToKey_.find(mesh);
+  if (itKey == meshToKey_.end())
+    return 0;
+  return cache_.at(itKey->second).refCount;
+}
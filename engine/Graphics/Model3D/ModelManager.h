@@ -0,0 +1,48 @@
+#pragma once
+#include "Model3D/ModelMesh.h"
+#include <d3d12.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+//==================================
+// 共有メッシュの管理
+//==================================
+// 同じパス・同じ読み込み設定のメッシュは 1 回だけ解析 / アップロードし、
+// 参照数で共有する。最後の Release で VB / IB ごと破棄する。
+class ModelManager {
+public:
+  ModelManager() = default;
+  ~ModelManager() { Term(); }
+  ModelManager(const ModelManager &) = delete;
+  ModelManager &operator=(const ModelManager &) = delete;
+
+  void Init(ID3D12Device *device) { device_ = device; }
+  // 残っているメッシュもすべて破棄（GPU が使い終わってから呼ぶ）
+  void Term();
+
+  // 読み込み済みなら参照数を増やして返す。失敗したら nullptr。
+  // settings の buildBvh / buildMeshlets は共有中のメッシュにも後から足す
+  ModelMesh *Acquire(const std::string &directoryPath,
+                     const std::string &filename,
+                     const ModelMeshSettings &settings = {});
+  // 参照数を減らし、0 なら破棄する
+  void Release(ModelMesh *mesh);
+
+  size_t GetMeshCount() const { return cache_.size(); }
+  uint32_t GetRefCount(const ModelMesh *mesh) const;
+
+private:
+  struct Entry {
+    std::unique_ptr<ModelMesh> mesh;
+    uint32_t refCount = 0;
+  };
+
+  // パスとメッシュの中身が変わる設定（頂点フォーマット / LOD）から作るキー
+  static std::string MakeKey_(const std::string &sourcePath,
+                              const ModelMeshSettings &settings);
+
+  ID3D12Device *device_ = nullptr; // 非所有
+  std::unordered_map<std::string, Entry> cache_;
+  std::unordered_map<const ModelMesh *, std::string> meshToKey_;
+};
@@ -0,0 +1,399 @@
+#include "ModelMesh.h"
+#include "Math/Frustum.h"
+#include "Mesh/MeshWeld.h"
+#include "ObjLoader/ObjLoader.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+static constexpr float kPi = std::numbers::pi_v<float>;
+
+// 部分メッシュをマテリアル順に並べ替え（同じマテリアル内はファイル順のまま）、
+// インデックスも範囲ごと移す
+static void SortSubsetsByMaterial(std::vector<uint32_t> &indices,
+                                  std::vector<MeshSubset> &subsets) {
+  std::vector<MeshSubset> sorted = subsets;
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const MeshSubset &a, const MeshSubset &b) {
+                     return a.materialIndex < b.materialIndex;
+                   });
+  std::vector<uint32_t> reordered;
+  reordered.reserve(indices.size());
+  for (MeshSubset &subset : sorted) {
+    const uint32_t start = static_cast<uint32_t>(reordered.size());
+    reordered.insert(reordered.end(), indices.begin() + subset.indexStart,
+                     indices.begin() + subset.indexStart + subset.indexCount);
+    subset.indexStart = start;
+  }
+  indices.swap(reordered);
+  subsets.swap(sorted);
+}
+
+ModelMesh::~ModelMesh() {
+  if (vb_.resource)
+    vb_.resource->Release();
+  if (ib_.resource)
+    ib_.resource->Release();
+}
+
+bool ModelMesh::Load(ID3D12Device *device, const std::string &directoryPath,
+                     const std::string &filename,
+                     const ModelMeshSettings &settings) {
+  assert(!vb_.resource && !ib_.resource); // 読み込みは 1 回だけ
+  device_ = device;
+  settings_ = settings;
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::string sourcePath = directoryPath + "/" + filename;
+  const std::string cachePath = MakeMeshCachePath(
+      sourcePath, HashMeshCacheSettings(settings_.vertexFormat, settings_.lod));
+
+  // キャッシュが有効ならマップした領域をそのまま使う
+  MeshCacheFile cache;
+  if (settings_.cacheEnabled && cache.Open(cachePath, sourcePath) &&
+      cache.Data().lodSettings == settings_.lod &&
+      cache.Data().vertexFormat == settings_.vertexFormat) {
+    ApplyMesh_(cache.Data(), nullptr);
+    loadStats_.fromCache = true;
+    loadStats_.milliseconds = std::chrono::duration<float, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+    return true;
+  }
+  cache.Close(); // 作り直したキャッシュで置き換えるため
+
+  ModelData model;
+  if (!LoadObjFile(directoryPath, filename, model)) {
+    return false;
+  }
+
+  // 同じ頂点をまとめてインデックス化
+  std::vector<VertexData> vertices;
+  std::vector<uint32_t> indices;
+  WeldVertices(model.vertices.data(), model.vertices.size(), vertices,
+               indices);
+
+  // 部分メッシュ（usemtl などがなければ全体で 1 つ）
+  std::vector<MeshSubset> subsets = model.subsets;
+  if (subsets.empty() && !indices.empty()) {
+    subsets.push_back({0, static_cast<uint32_t>(indices.size()), -1});
+  }
+  SortSubsetsByMaterial(indices, subsets);
+
+  MeshCacheData mesh;
+  // 頂点キャッシュ / フェッチ順に並べ替え（三角形は部分メッシュ内でだけ動く）
+  mesh.optimizeReport =
+      OptimizeMesh(vertices, indices, subsets.data(), subsets.size());
+
+  // VB に載せる形へ詰める（キャッシュにもこの形で書くので、次からは
+  // 詰め直さない）
+  std::vector<uint8_t> encoded;
+  mesh.vertexFormat = settings_.vertexFormat;
+  if (mesh.vertexFormat == VertexFormat::Standard) {
+    mesh.vertexData = vertices.data();
+  } else {
+    EncodeVertices(vertices.data(), vertices.size(), mesh.vertexFormat,
+                   encoded, &mesh.quantization);
+    mesh.vertexData = encoded.data();
+  }
+  mesh.vertexCount = static_cast<uint32_t>(vertices.size());
+
+  // LOD1 以降を IB の後ろへ（VB は共有）
+  std::vector<float> lodErrors;
+  mesh.subsetCount = static_cast<uint32_t>(subsets.size());
+  mesh.lodCount = BuildLodChain(vertices.data(), vertices.size(), indices,
+                                subsets, settings_.lod, lodErrors);
+  mesh.lodErrors = lodErrors.data();
+  mesh.lodSettings = settings_.lod;
+
+  // 頂点数が 65536 以下なら 16bit に詰める
+  std::vector<uint16_t> indices16;
+  if (FitsIndex16(vertices.size())) {
+    PackIndices16(indices.data(), indices.size(), indices16);
+    mesh.indices = indices16.data();
+    mesh.indexSize = sizeof(uint16_t);
+  } else {
+    mesh.indices = indices.data();
+    mesh.indexSize = sizeof(uint32_t);
+  }
+  mesh.indexCount = static_cast<uint32_t>(indices.size());
+
+  mesh.subsets = subsets.data();
+  mesh.bounds = ComputeAABB(vertices.data(), vertices.size());
+  mesh.boundingSphere = ComputeBoundingSphere(vertices.data(), vertices.size());
+  for (const MaterialData &material : model.materials) {
+    mesh.texturePaths.push_back(material.textureFilePath);
+  }
+
+  // 書けなくても読み込み自体は続ける
+  if (settings_.cacheEnabled) {
+    WriteMeshCache(cachePath, sourcePath, mesh);
+  }
+  ApplyMesh_(mesh, vertices.data());
+  loadStats_.fromCache = false;
+  loadStats_.milliseconds = std::chrono::duration<float, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+  return true;
+}
+
+void ModelMesh::ApplyMesh_(const MeshCacheData &mesh,
+                           const VertexData *sourceVertices) {
+  meshReport_ = mesh.optimizeReport;
+  subsetCount_ = mesh.subsetCount;
+  lodCount_ = mesh.lodCount;
+  subsets_.assign(mesh.subsets,
+                  mesh.subsets + size_t(mesh.subsetCount) * mesh.lodCount);
+  lodErrors_.assign(mesh.lodErrors, mesh.lodErrors + mesh.lodCount);
+  texturePaths_ = mesh.texturePaths;
+
+  // LOD0 は IB の先頭に詰めてある
+  lod0IndexCount_ = 0;
+  for (uint32_t i = 0; i < subsetCount_; ++i) {
+    lod0IndexCount_ = (std::max)(lod0IndexCount_, subsets_[i].indexStart +
+                                                      subsets_[i].indexCount);
+  }
+
+  localAABB_ = mesh.bounds;
+  localSphere_ = mesh.boundingSphere;
+
+  if (settings_.buildBvh || settings_.buildMeshlets) {
+    // 詰める前の頂点がなければ（キャッシュから読んだとき）VB の中身から戻す
+    std::vector<VertexData> decoded;
+    const VertexData *vertices = sourceVertices;
+    if (!vertices) {
+      if (mesh.vertexFormat == VertexFormat::Standard) {
+        vertices = static_cast<const VertexData *>(mesh.vertexData);
+      } else {
+        DecodeVertices(mesh.vertexData, mesh.vertexCount, mesh.vertexFormat,
+                       mesh.quantization, decoded);
+        vertices = decoded.data();
+      }
+    }
+
+    // どちらも LOD0 の 32bit インデックスで作る
+    std::vector<uint32_t> widened;
+    const uint32_t *indices = static_cast<const uint32_t *>(mesh.indices);
+    if (mesh.indexSize == sizeof(uint16_t)) {
+      const uint16_t *src = static_cast<const uint16_t *>(mesh.indices);
+      widened.assign(src, src + lod0IndexCount_);
+      indices = widened.data();
+    }
+    if (settings_.buildBvh) {
+      BuildBvh_(vertices, mesh.vertexCount, indices, lod0IndexCount_);
+    }
+    if (settings_.buildMeshlets) {
+      BuildMeshlets_(vertices, mesh.vertexCount, indices);
+    }
+  }
+
+  UploadVB_(mesh.vertexData, mesh.vertexCount, mesh.vertexFormat,
+            mesh.quantization);
+  UploadIB_(mesh.indices, mesh.indexCount, mesh.indexSize);
+}
+
+const std::string &ModelMesh::GetSubsetTexturePath(size_t index) const {
+  static const std::string kEmpty;
+  assert(index < subsetCount_);
+  const int32_t material = subsets_[index].materialIndex;
+  return material >= 0 ? texturePaths_[material] : kEmpty;
+}
+
+uint32_t ModelMesh::GetLodTriangleCount(uint32_t lod) const {
+  assert(lod < lodCount_);
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < subsetCount_; ++i) {
+    count += subsets_[size_t(lod) * subsetCount_ + i].indexCount / 3;
+  }
+  return count;
+}
+
+bool ModelMesh::EnsureSphericalUVIfMissing() {
+  std::vector<VertexData> vtx;
+  if (!ReadBackVB_(vtx))
+    return false;
+
+  bool allZero = true;
+  for (const VertexData &vertex : vtx) {
+    if (std::abs(vertex.texcoord.x) > 1e-8f ||
+        std::abs(vertex.texcoord.y) > 1e-8f) {
+      allZero = false;
+      break;
+    }
+  }
+  if (!allZero)
+    return false;
+
+  for (VertexData &vertex : vtx) {
+    const float x = vertex.position.x;
+    const float y = vertex.position.y;
+    const float z = vertex.position.z;
+
+    const float r = (std::max)(1e-6f, std::sqrt(x * x + y * y + z * z));
+    const float theta = std::atan2(z, x); // [-pi, pi]
+    const float phi =
+        std::asin(std::clamp(y / r, -1.0f, 1.0f)); // [-pi/2, pi/2]
+
+    float u = 0.5f + (theta / (2.0f * kPi));
+    float v = 0.5f - (phi / (1.0f * kPi));
+
+    if (u < 0.0f)
+      u += 1.0f;
+    if (u > 1.0f)
+      u -= 1.0f;
+
+    vertex.texcoord = {u, v};
+  }
+
+  RewriteVB_(vtx);
+  return true;
+}
+
+void ModelMesh::EnableRaycast(uint32_t workerCount) {
+  settings_.buildBvh = true;
+  settings_.bvhWorkerCount = workerCount;
+  if (!vb_.resource || vb_.vertexCount == 0 || !bvh_.Empty()) {
+    return;
+  }
+
+  // 読み込み済みなら VB / IB（アップロードヒープ）から読み戻す
+  std::vector<VertexData> vtx;
+  std::vector<uint32_t> indices;
+  if (!ReadBackVB_(vtx) || !ReadBackIB_(indices))
+    return;
+  BuildBvh_(vtx.data(), vtx.size(), indices.data(), lod0IndexCount_);
+}
+
+void ModelMesh::BuildBvh_(const VertexData *vertices, size_t vertexCount,
+                          const uint32_t *indices, size_t indexCount) {
+  std::vector<Vector3> positions(vertexCount);
+  for (size_t i = 0; i < vertexCount; ++i) {
+    positions[i] = {vertices[i].position.x, vertices[i].position.y,
+                    vertices[i].position.z};
+  }
+  bvh_.Build(positions.data(), indices, indexCount / 3,
+             settings_.bvhWorkerCount);
+}
+
+void ModelMesh::EnableMeshlets() {
+  settings_.buildMeshlets = true;
+  if (!vb_.resource || vb_.vertexCount == 0 || meshlets_.Size() != 0) {
+    return;
+  }
+
+  std::vector<VertexData> vtx;
+  std::vector<uint32_t> indices;
+  if (!ReadBackVB_(vtx) || !ReadBackIB_(indices))
+    return;
+  BuildMeshlets_(vtx.data(), vtx.size(), indices.data());
+}
+
+void ModelMesh::BuildMeshlets_(const VertexData *vertices, size_t vertexCount,
+                               const uint32_t *indices) {
+  // LOD0 の部分メッシュごとに分ける（塊は部分メッシュをまたがない）
+  BuildMeshlets(vertices, vertexCount, indices, subsets_.data(),
+                subsetCount_, meshlets_);
+  meshletStats_ = AnalyzeMeshlets(meshlets_);
+}
+
+// =========================
+// 内部：VB アップロード
+// =========================
+
+void ModelMesh::UploadVB_(const void *vertexData, size_t vertexCount,
+                          VertexFormat format,
+                          const VertexQuantization &quantization) {
+  vb_.vertexCount = static_cast<uint32_t>(vertexCount);
+  vertexFormat_ = format;
+  quantization_ = quantization;
+  dequantize_ = MakeDequantizeMatrix(quantization_);
+  if (vb_.vertexCount == 0)
+    return;
+
+  const size_t sizeBytes = VertexStride(vertexFormat_) * vertexCount;
+  vb_.resource = CreateBufferResource(device_, sizeBytes);
+
+  void *mapped = nullptr;
+  vb_.resource->Map(0, nullptr, &mapped);
+  std::memcpy(mapped, vertexData, sizeBytes);
+  vb_.resource->Unmap(0, nullptr);
+
+  vb_.view.BufferLocation = vb_.resource->GetGPUVirtualAddress();
+  vb_.view.SizeInBytes = static_cast<UINT>(sizeBytes);
+  vb_.view.StrideInBytes = static_cast<UINT>(VertexStride(vertexFormat_));
+}
+
+void ModelMesh::UploadIB_(const void *indices, size_t indexCount,
+                        uint32_t indexSize) {
+  assert(indexSize == sizeof(uint16_t) || indexSize == sizeof(uint32_t));
+  ib_.indexCount = static_cast<uint32_t>(indexCount);
+  if (ib_.indexCount == 0)
+    return;
+
+  const size_t sizeBytes = size_t(indexSize) * indexCount;
+  ib_.view.Format = indexSize == sizeof(uint16_t) ? DXGI_FORMAT_R16_UINT
+                                                  : DXGI_FORMAT_R32_UINT;
+  ib_.resource = CreateBufferResource(device_, sizeBytes);
+
+  void *mapped = nullptr;
+  ib_.resource->Map(0, nullptr, &mapped);
+  std::memcpy(mapped, indices, sizeBytes);
+  ib_.resource->Unmap(0, nullptr);
+
+  ib_.view.BufferLocation = ib_.resource->GetGPUVirtualAddress();
+  ib_.view.SizeInBytes = static_cast<UINT>(sizeBytes);
+}
+
+bool ModelMesh::ReadBackIB_(std::vector<uint32_t> &outIndices) const {
+  if (!ib_.resource || ib_.indexCount == 0)
+    return false;
+
+  void *mapped = nullptr;
+  ib_.resource->Map(0, nullptr, &mapped);
+  if (!mapped)
+    return false;
+
+  outIndices.resize(ib_.indexCount);
+  if (ib_.view.Format == DXGI_FORMAT_R16_UINT) {
+    const uint16_t *src = static_cast<const uint16_t *>(mapped);
+    for (uint32_t i = 0; i < ib_.indexCount; ++i) {
+      outIndices[i] = src[i];
+    }
+  } else {
+    std::memcpy(outIndices.data(), mapped, sizeof(uint32_t) * ib_.indexCount);
+  }
+  ib_.resource->Unmap(0, nullptr);
+  return true;
+}
+
+bool ModelMesh::ReadBackVB_(std::vector<VertexData> &outVertices) const {
+  if (!vb_.resource || vb_.vertexCount == 0)
+    return false;
+
+  void *mapped = nullptr;
+  vb_.resource->Map(0, nullptr, &mapped);
+  if (!mapped)
+    return false;
+
+  DecodeVertices(mapped, vb_.vertexCount, vertexFormat_, quantization_,
+                 outVertices);
+  vb_.resource->Unmap(0, nullptr);
+  return true;
+}
+
+void ModelMesh::RewriteVB_(const std::vector<VertexData> &vertices) {
+  assert(vertices.size() == vb_.vertexCount);
+
+  std::vector<uint8_t> encoded;
+  EncodeVertices(vertices.data(), vertices.size(), vertexFormat_, encoded,
+                 &quantization_);
+  dequantize_ = MakeDequantizeMatrix(quantization_);
+
+  void *mapped = nullptr;
+  vb_.resource->Map(0, nullptr, &mapped);
+  std::memcpy(mapped, encoded.data(), encoded.size());
+  vb_.resource->Unmap(0, nullptr);
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include "Math/Math.h"
+#include "Math/MathTypes.h"
+#include "Math/TriangleBvh.h"
+#include "Mesh/MeshCache.h"
+#include "Mesh/MeshOptimize.h"
+#include "Mesh/MeshSimplify.h"
+#include "Mesh/Meshlet.h"
+#include "VertexFormat/VertexFormat.h"
+#include "function/function.h"
+#include <d3d12.h>
+#include <string>
+#include <vector>
+
+// 読み込みの設定（vertexFormat と lod が違えば別のメッシュとして扱う）
+struct ModelMeshSettings {
+  VertexFormat vertexFormat = VertexFormat::Standard;
+  MeshLodSettings lod{};
+  bool cacheEnabled = true; // .cg2mesh を使うか
+  // 読み込み時に作る CPU 側のデータ（後から Enable* でも作れる）
+  bool buildBvh = false;
+  uint32_t bvhWorkerCount = 1;
+  bool buildMeshlets = false;
+};
+
+// 直近の読み込み（キャッシュから読んだか / かかった時間）
+struct MeshLoadStats {
+  bool fromCache = false;
+  float milliseconds = 0.0f;
+};
+
+//==================================
+// 共有メッシュ（VB / IB と読み込み結果）
+//==================================
+// 同じモデルを置く Model3D はこれを共有し、Transform や CB だけを個別に持つ。
+// 共有は ModelManager が参照数で管理する。
+class ModelMesh {
+public:
+  ModelMesh() = default;
+  ~ModelMesh();
+  ModelMesh(const ModelMesh &) = delete;
+  ModelMesh &operator=(const ModelMesh &) = delete;
+
+  // OBJ読み込み（CPU 側に展開し、同じ頂点を溶接・頂点キャッシュ向けに
+  // 並べ替えてから VB / IB を作る）。
+  // 隣に有効な .cg2mesh があればそれをマップして VB / IB へそのまま写し、
+  // なければ解析後に書き出す
+  bool Load(ID3D12Device *device, const std::string &directoryPath,
+            const std::string &filename, const ModelMeshSettings &settings);
+
+  const ModelMeshSettings &GetSettings() const { return settings_; }
+  const MeshLoadStats &GetLoadStats() const { return loadStats_; }
+  const MeshOptimizeReport &GetMeshOptimizeReport() const {
+    return meshReport_;
+  }
+
+  // ---- 描画 ----
+  const D3D12_VERTEX_BUFFER_VIEW &GetVertexBufferView() const {
+    return vb_.view;
+  }
+  const D3D12_INDEX_BUFFER_VIEW &GetIndexBufferView() const {
+    return ib_.view;
+  }
+  uint32_t GetVertexCount() const { return vb_.vertexCount; }
+  // VB に実際に詰めたフォーマット（復元行列や PSO の選択はこちらで判断する）
+  VertexFormat GetVertexFormat() const { return vertexFormat_; }
+  // Quantized のときに WVP の前に掛ける復元行列（それ以外は単位行列）
+  const Matrix4x4 &GetDequantizeMatrix() const { return dequantize_; }
+
+  // ---- 部分メッシュ（[LOD][部分メッシュ] の並び）----
+  uint32_t GetSubsetCount() const { return subsetCount_; } // 1 LOD あたり
+  const MeshSubset *GetSubsets(uint32_t lod) const {
+    return subsets_.data() + size_t(lod) * subsetCount_;
+  }
+  // .mtl の map_Kd（なければ空）
+  const std::string &GetSubsetTexturePath(size_t index) const;
+
+  // ---- LOD ----
+  uint32_t GetLodCount() const { return lodCount_; }
+  const float *GetLodErrors() const { return lodErrors_.data(); }
+  uint32_t GetLodTriangleCount(uint32_t lod) const;
+
+  // ---- 境界ボリューム（ローカル）----
+  const AABB &GetLocalAABB() const { return localAABB_; }
+  const SphereData &GetLocalBoundingSphere() const { return localSphere_; }
+
+  // ---- CPU 側のデータ（LOD0 から作る）----
+  // 読み込み後に呼ぶと VB / IB を読み戻して作る。作ってあれば何もしない
+  void EnableRaycast(uint32_t workerCount = 1);
+  const TriangleBvh &GetBvh() const { return bvh_; }
+  void EnableMeshlets();
+  const MeshletData &GetMeshlets() const { return meshlets_; }
+  const MeshletStats &GetMeshletStats() const { return meshletStats_; }
+
+  // UV未設定(=0,0)に対し簡易的な球面UVを焼き込む（共有している全員に効く）。
+  // 書き換えたら true
+  bool EnsureSphericalUVIfMissing();
+
+private:
+  struct VB {
+    ID3D12Resource *resource = nullptr;
+    D3D12_VERTEX_BUFFER_VIEW view{};
+    uint32_t vertexCount = 0;
+  };
+  struct IB {
+    ID3D12Resource *resource = nullptr;
+    D3D12_INDEX_BUFFER_VIEW view{};
+    uint32_t indexCount = 0;
+  };
+
+  // 解析済み / キャッシュのメッシュを境界・BVH・VB / IB に反映。
+  // sourceVertices は詰める前の頂点（キャッシュから読んだときは nullptr、
+  // BVH / メッシュレットが要るなら VB の中身から戻す）
+  void ApplyMesh_(const MeshCacheData &mesh, const VertexData *sourceVertices);
+
+  // format で詰め済みの頂点から VB を生成しアップロード（そのまま memcpy）
+  void UploadVB_(const void *vertexData, size_t vertexCount,
+                 VertexFormat format, const VertexQuantization &quantization);
+  // インデックスから IB を生成（indexSize は 2 か 4）
+  void UploadIB_(const void *indices, size_t indexCount, uint32_t indexSize);
+  // IB を読み戻して 32bit で返す
+  bool ReadBackIB_(std::vector<uint32_t> &outIndices) const;
+  // VB（アップロードヒープ）を読み戻して VertexData に戻す
+  bool ReadBackVB_(std::vector<VertexData> &outVertices) const;
+  // 同じ頂点数の配列で VB の中身を書き換える
+  void RewriteVB_(const std::vector<VertexData> &vertices);
+
+  // インデックス付き三角形リストから BVH を構築
+  void BuildBvh_(const VertexData *vertices, size_t vertexCount,
+                 const uint32_t *indices, size_t indexCount);
+  // LOD0 の部分メッシュからメッシュレットを作る
+  void BuildMeshlets_(const VertexData *vertices, size_t vertexCount,
+                      const uint32_t *indices);
+
+  ID3D12Device *device_ = nullptr;
+  ModelMeshSettings settings_{};
+  VB vb_{};
+  IB ib_{};
+
+  // 頂点フォーマット（Quantized のときは復元行列を WVP の前に掛ける）
+  // UploadVB_ で決まり、読み戻し / 書き換えもこれで行う
+  VertexFormat vertexFormat_ = VertexFormat::Standard;
+  VertexQuantization quantization_{};
+  Matrix4x4 dequantize_ = MakeIdentity4x4();
+
+  MeshOptimizeReport meshReport_{};
+  MeshLoadStats loadStats_{};
+
+  // 部分メッシュ（IB の範囲、[LOD][部分メッシュ]）とマテリアルごとの
+  // テクスチャのパス
+  std::vector<MeshSubset> subsets_;
+  uint32_t subsetCount_ = 0; // 1 LOD あたり
+  std::vector<std::string> texturePaths_;
+
+  // LOD
+  uint32_t lodCount_ = 1;
+  std::vector<float> lodErrors_; // メッシュ座標での誤差
+  uint32_t lod0IndexCount_ = 0;  // レイキャスト / メッシュレットは LOD0 で作る
+
+  // カリング用の境界ボリューム
+  AABB localAABB_{};
+  SphereData localSphere_{};
+
+  // ピッキング用 / メッシュレット（有効にしたときのみ）
+  TriangleBvh bvh_;
+  MeshletData meshlets_;
+  MeshletStats meshletStats_{};
+};
@@ -0,0 +1,561 @@
+#include "ObjLoader.h"
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+//==================================
+// 字句解析（ファイル全体のバッファを指したまま読む）
+//==================================
+
+bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char *SkipSpaces(const char *p, const char *end) {
+  while (p < end && IsSpace(*p)) {
+    ++p;
+  }
+  return p;
+}
+
+const char *SkipToken(const char *p, const char *end) {
+  while (p < end && !IsSpace(*p)) {
+    ++p;
+  }
+  return p;
+}
+
+// 空白区切りの次のトークン（行末なら空）
+std::string_view NextToken(const char *&p, const char *end) {
+  p = SkipSpaces(p, end);
+  const char *begin = p;
+  p = SkipToken(p, end);
+  return std::string_view(begin, size_t(p - begin));
+}
+
+// 数値 1 つ（読めなければ 0、istream と同じく先頭の '+' も受け付ける）
+float ParseFloat(const char *&p, const char *end) {
+  p = SkipSpaces(p, end);
+  if (p < end && *p == '+') {
+    ++p;
+  }
+  float value = 0.0f;
+  const std::from_chars_result r = std::from_chars(p, end, value);
+  if (r.ec != std::errc()) {
+    value = 0.0f;
+  }
+  p = SkipToken(r.ptr, end);
+  return value;
+}
+
+// 整数 1 つ（読めなければ 0 = 省略扱い）
+int ParseIndex(const char *&p, const char *end) {
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+  int64_t value = 0;
+  while (p < end && unsigned(*p - '0') < 10u) {
+    value = (std::min)(value * 10 + (*p - '0'), int64_t(INT32_MAX));
+    ++p;
+  }
+  return int(negative ? -value : value);
+}
+
+// 1 始まり / 負数は末尾からの相対（-1 が直前）を 0 始まりへ。範囲外は -1
+int ResolveIndex(int index, size_t count) {
+  if (index > 0) {
+    return size_t(index) <= count ? index - 1 : -1;
+  }
+  if (index < 0) {
+    return size_t(-int64_t(index)) <= count ? int(count) + index : -1;
+  }
+  return -1;
+}
+
+// 面の 1 頂点 "p" / "p/t" / "p//n" / "p/t/n"（省略は 0）
+void ParseFaceCorner(const char *&p, const char *end, int idx[3]) {
+  p = SkipSpaces(p, end);
+  idx[0] = idx[1] = idx[2] = 0;
+  for (int field = 0; field < 3; ++field) {
+    idx[field] = ParseIndex(p, end);
+    if (p >= end || *p != '/') {
+      break;
+    }
+    ++p;
+  }
+  p = SkipToken(p, end);
+}
+
+// v / vt / vn の 1 行（左手系への変換込み）
+Vector4 ParsePosition(const char *&p, const char *end) {
+  Vector4 pos{};
+  pos.x = ParseFloat(p, end);
+  pos.y = ParseFloat(p, end);
+  pos.z = ParseFloat(p, end);
+  pos.x = -pos.x;
+  pos.w = 1.0f;
+  return pos;
+}
+
+Vector2 ParseTexcoord(const char *&p, const char *end) {
+  Vector2 t{};
+  t.x = ParseFloat(p, end);
+  t.y = ParseFloat(p, end);
+  t.y = 1.0f - t.y;
+  return t;
+}
+
+Vector3 ParseNormal(const char *&p, const char *end) {
+  Vector3 n{};
+  n.x = ParseFloat(p, end);
+  n.y = ParseFloat(p, end);
+  n.z = ParseFloat(p, end);
+  n.x = -n.x;
+  return n;
+}
+
+// 行頭の識別子ごとの行数を数えて出力配列を確保しておく
+void ReserveFromHeaders(const char *p, const char *end,
+                        std::vector<Vector4> &positions,
+                        std::vector<Vector2> &texcoords,
+                        std::vector<Vector3> &normals,
+                        std::vector<VertexData> &vertices) {
+  size_t v = 0, vt = 0, vn = 0, f = 0;
+  while (p < end) {
+    p = SkipSpaces(p, end);
+    if (end - p >= 2) {
+      if (p[0] == 'v' && IsSpace(p[1])) {
+        ++v;
+      } else if (p[0] == 'v' && p[1] == 't') {
+        ++vt;
+      } else if (p[0] == 'v' && p[1] == 'n') {
+        ++vn;
+      } else if (p[0] == 'f' && IsSpace(p[1])) {
+        ++f;
+      }
+    }
+    const void *nl = std::memchr(p, '\n', size_t(end - p));
+    p = nl ? static_cast<const char *>(nl) + 1 : end;
+  }
+  positions.reserve(v);
+  texcoords.reserve(vt);
+  normals.reserve(vn);
+  vertices.reserve(vertices.size() + f * 3);
+}
+
+//==================================
+// 部分メッシュ（o / g / usemtl）
+//==================================
+
+// 区切りの位置（その時点までの面の数）。hasMaterial なら以降の面の
+// マテリアルを切り替え、そうでなければ区切るだけ
+struct SubsetMarker {
+  size_t face = 0;
+  bool hasMaterial = false;
+  std::string_view material;
+};
+
+int32_t FindMaterial(const std::vector<MaterialData> &materials,
+                     std::string_view name) {
+  for (size_t i = 0; i < materials.size(); ++i) {
+    if (materials[i].name == name) {
+      return int32_t(i);
+    }
+  }
+  return -1;
+}
+
+// 区切りから部分メッシュを作る（面のない範囲は捨てる）
+void BuildSubsets(const std::vector<SubsetMarker> &markers, size_t faceCount,
+                  size_t firstVertex, ModelData &outModel) {
+  std::string_view material;
+  bool hasMaterial = false;
+  size_t start = 0;
+  auto flush = [&](size_t endFace) {
+    if (endFace > start) {
+      MeshSubset subset;
+      subset.indexStart = uint32_t(firstVertex + start * 3);
+      subset.indexCount = uint32_t((endFace - start) * 3);
+      subset.materialIndex =
+          hasMaterial ? FindMaterial(outModel.materials, material) : -1;
+      outModel.subsets.push_back(subset);
+    }
+    start = endFace;
+  };
+  for (const SubsetMarker &marker : markers) {
+    flush(marker.face);
+    if (marker.hasMaterial) {
+      material = marker.material;
+      hasMaterial = true;
+    }
+  }
+  flush(faceCount);
+}
+
+// mtllib 1 つ分：マテリアルを追加し、最後の map_Kd を代表にする（従来どおり）
+void ApplyMaterialLibrary(const std::string &directoryPath,
+                          std::string_view filename, ModelData &outModel) {
+  const size_t first = outModel.materials.size();
+  LoadMaterialLibrary(directoryPath, std::string(filename),
+                      outModel.materials);
+  outModel.material = MaterialData{};
+  for (size_t i = first; i < outModel.materials.size(); ++i) {
+    if (!outModel.materials[i].textureFilePath.empty()) {
+      outModel.material = outModel.materials[i];
+    }
+  }
+}
+
+//==================================
+// 並列読み込み（行境界でチャンクに分け、番号の解決は 2 パス目）
+//==================================
+
+// 1 チャンクの最小バイト数（小さいファイルは分けない）
+constexpr size_t kMinChunkBytes = size_t(1) << 20;
+// 番号の省略
+constexpr int32_t kNoIndex = INT32_MIN;
+
+// 1 面分の番号（[頂点][p/t/n]）。relative の bit (頂点*3+種類) が立っていれば
+// チャンク先頭からの位置なので、2 パス目にチャンクの先頭番号を足す
+struct FaceRecord {
+  int32_t index[3][3];
+  uint32_t localCount[3]; // この面の時点でチャンク内にある v / vt / vn の数
+  uint16_t relative;
+};
+
+struct ObjChunk {
+  const char *begin = nullptr;
+  const char *end = nullptr;
+  std::vector<Vector4> positions;
+  std::vector<Vector2> texcoords;
+  std::vector<Vector3> normals;
+  std::vector<FaceRecord> faces;
+  std::vector<SubsetMarker> markers; // face はチャンク内の番号
+  std::vector<std::string_view> mtllibs;
+
+  // 2 パス目で使う通し番号の先頭
+  size_t base[3] = {0, 0, 0};
+  size_t faceBase = 0;
+  bool ok = true;
+};
+
+// count 個の仕事を count 本（0 番は呼び出しスレッド）で実行する
+template <class F> void RunChunks(size_t count, const F &job) {
+  std::vector<std::thread> threads;
+  threads.reserve(count > 0 ? count - 1 : 0);
+  for (size_t i = 1; i < count; ++i) {
+    threads.emplace_back([&job, i] { job(i); });
+  }
+  if (count > 0) {
+    job(0);
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+}
+
+// 1 パス目：チャンク内の記録を読むだけ（負の番号はチャンク内の位置へ）
+void ParseChunk(ObjChunk &chunk) {
+  const char *p = chunk.begin;
+  while (p < chunk.end) {
+    const void *nl = std::memchr(p, '\n', size_t(chunk.end - p));
+    const char *lineEnd = nl ? static_cast<const char *>(nl) : chunk.end;
+    const char *next = nl ? lineEnd + 1 : chunk.end;
+
+    const std::string_view id = NextToken(p, lineEnd);
+    if (id == "v") {
+      chunk.positions.push_back(ParsePosition(p, lineEnd));
+    } else if (id == "vt") {
+      chunk.texcoords.push_back(ParseTexcoord(p, lineEnd));
+    } else if (id == "vn") {
+      chunk.normals.push_back(ParseNormal(p, lineEnd));
+    } else if (id == "f") {
+      FaceRecord face{};
+      face.localCount[0] = uint32_t(chunk.positions.size());
+      face.localCount[1] = uint32_t(chunk.texcoords.size());
+      face.localCount[2] = uint32_t(chunk.normals.size());
+      for (int vi = 0; vi < 3; ++vi) {
+        int idx[3];
+        ParseFaceCorner(p, lineEnd, idx);
+        for (int k = 0; k < 3; ++k) {
+          if (idx[k] > 0) {
+            face.index[vi][k] = idx[k] - 1;
+          } else if (idx[k] < 0) {
+            face.index[vi][k] = int32_t(face.localCount[k]) + idx[k];
+            face.relative |= uint16_t(1u << (vi * 3 + k));
+          } else {
+            face.index[vi][k] = kNoIndex;
+          }
+        }
+      }
+      chunk.faces.push_back(face);
+    } else if (id == "usemtl") {
+      chunk.markers.push_back({chunk.faces.size(), true, NextToken(p, lineEnd)});
+    } else if (id == "o" || id == "g") {
+      chunk.markers.push_back({chunk.faces.size(), false, {}});
+    } else if (id == "mtllib") {
+      chunk.mtllibs.push_back(NextToken(p, lineEnd));
+    }
+    p = next;
+  }
+}
+
+// 2 パス目：通し番号へ解決して out（このチャンクの先頭）へ書く
+void ResolveChunk(ObjChunk &chunk, const std::vector<Vector4> &positions,
+                  const std::vector<Vector2> &texcoords,
+                  const std::vector<Vector3> &normals, VertexData *out) {
+  for (const FaceRecord &face : chunk.faces) {
+    VertexData tri[3];
+    for (int vi = 0; vi < 3; ++vi) {
+      int64_t resolved[3];
+      for (int k = 0; k < 3; ++k) {
+        // 逐次版と同じく、その面より前に出てきた番号だけを有効とする
+        const int64_t limit = int64_t(chunk.base[k] + face.localCount[k]);
+        int64_t i = face.index[vi][k];
+        if (i == kNoIndex) {
+          i = -1;
+        } else if (face.relative & (1u << (vi * 3 + k))) {
+          i += int64_t(chunk.base[k]);
+        }
+        resolved[k] = (i >= 0 && i < limit) ? i : -1;
+      }
+      if (resolved[0] < 0) {
+        chunk.ok = false; // 位置の番号が不正
+        return;
+      }
+      tri[vi] = {positions[size_t(resolved[0])],
+                 resolved[1] >= 0 ? texcoords[size_t(resolved[1])]
+                                  : Vector2{0, 0},
+                 resolved[2] >= 0 ? normals[size_t(resolved[2])]
+                                  : Vector3{0, 0, 0}};
+    }
+    // 面の向きを反転して格納（逐次版と同じ）
+    out[0] = tri[2];
+    out[1] = tri[1];
+    out[2] = tri[0];
+    out += 3;
+  }
+}
+
+bool ParseObjChunked(std::string_view text, const std::string &directoryPath,
+                     ModelData &outModel, size_t chunkCount) {
+  // 行境界で分割
+  std::vector<ObjChunk> chunks(chunkCount);
+  const char *const begin = text.data();
+  const char *const end = begin + text.size();
+  const char *cursor = begin;
+  for (size_t c = 0; c < chunkCount; ++c) {
+    chunks[c].begin = cursor;
+    const char *split = begin + text.size() * (c + 1) / chunkCount;
+    split = (std::max)(split, cursor);
+    const void *nl = split < end ? std::memchr(split, '\n', size_t(end - split))
+                                 : nullptr;
+    cursor = (c + 1 == chunkCount || !nl) ? end
+                                          : static_cast<const char *>(nl) + 1;
+    chunks[c].end = cursor;
+  }
+
+  RunChunks(chunkCount, [&chunks](size_t c) { ParseChunk(chunks[c]); });
+
+  // 各チャンクの先頭番号を決めて頂点属性を連結
+  size_t total[3] = {0, 0, 0};
+  size_t faceCount = 0;
+  for (ObjChunk &chunk : chunks) {
+    chunk.base[0] = total[0];
+    chunk.base[1] = total[1];
+    chunk.base[2] = total[2];
+    chunk.faceBase = faceCount;
+    total[0] += chunk.positions.size();
+    total[1] += chunk.texcoords.size();
+    total[2] += chunk.normals.size();
+    faceCount += chunk.faces.size();
+  }
+  std::vector<Vector4> positions;
+  std::vector<Vector2> texcoords;
+  std::vector<Vector3> normals;
+  positions.reserve(total[0]);
+  texcoords.reserve(total[1]);
+  normals.reserve(total[2]);
+  for (const ObjChunk &chunk : chunks) {
+    positions.insert(positions.end(), chunk.positions.begin(),
+                     chunk.positions.end());
+    texcoords.insert(texcoords.end(), chunk.texcoords.begin(),
+                     chunk.texcoords.end());
+    normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+  }
+
+  const size_t first = outModel.vertices.size();
+  outModel.vertices.resize(first + faceCount * 3);
+  VertexData *out = outModel.vertices.data() + first;
+  RunChunks(chunkCount, [&](size_t c) {
+    ResolveChunk(chunks[c], positions, texcoords, normals,
+                 out + chunks[c].faceBase * 3);
+  });
+
+  // mtllib はファイル順に読む（代表のマテリアルは最後のもの、逐次版と同じ）
+  std::vector<SubsetMarker> markers;
+  for (const ObjChunk &chunk : chunks) {
+    for (std::string_view mtllib : chunk.mtllibs) {
+      ApplyMaterialLibrary(directoryPath, mtllib, outModel);
+    }
+    for (SubsetMarker marker : chunk.markers) {
+      marker.face += chunk.faceBase;
+      markers.push_back(marker);
+    }
+  }
+  BuildSubsets(markers, faceCount, first, outModel);
+
+  for (const ObjChunk &chunk : chunks) {
+    if (!chunk.ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool ReadFileToBuffer(const std::string &path, std::string &outBuffer) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    return false;
+  }
+  const std::streamoff size = file.tellg();
+  if (size < 0) {
+    return false;
+  }
+  outBuffer.resize(size_t(size));
+  file.seekg(0);
+  file.read(outBuffer.data(), size);
+  return file.gcount() == size;
+}
+
+bool LoadObjFile(const std::string &directoryPath, const std::string &filename,
+                 ModelData &outModel, uint32_t workerCount) {
+  std::string buffer;
+  if (!ReadFileToBuffer(directoryPath + "/" + filename, buffer)) {
+    return false;
+  }
+  return ParseObj(buffer, directoryPath, outModel, workerCount);
+}
+
+bool ParseObj(std::string_view text, const std::string &directoryPath,
+              ModelData &outModel, uint32_t workerCount) {
+  const size_t chunkCount =
+      (std::min)(size_t(workerCount), text.size() / kMinChunkBytes);
+  if (chunkCount > 1) {
+    return ParseObjChunked(text, directoryPath, outModel, chunkCount);
+  }
+
+  std::vector<Vector4> positions;
+  std::vector<Vector3> normals;
+  std::vector<Vector2> texcoords;
+
+  std::vector<SubsetMarker> markers;
+
+  const char *p = text.data();
+  const char *const end = p + text.size();
+  ReserveFromHeaders(p, end, positions, texcoords, normals, outModel.vertices);
+  const size_t first = outModel.vertices.size();
+
+  while (p < end) {
+    const void *nl = std::memchr(p, '\n', size_t(end - p));
+    const char *lineEnd = nl ? static_cast<const char *>(nl) : end;
+    const char *next = nl ? lineEnd + 1 : end;
+
+    const std::string_view id = NextToken(p, lineEnd);
+    if (id == "v") {
+      positions.push_back(ParsePosition(p, lineEnd));
+    } else if (id == "vt") {
+      texcoords.push_back(ParseTexcoord(p, lineEnd));
+    } else if (id == "vn") {
+      normals.push_back(ParseNormal(p, lineEnd));
+    } else if (id == "f") {
+      VertexData tri[3];
+      for (int vi = 0; vi < 3; ++vi) {
+        int idx[3];
+        ParseFaceCorner(p, lineEnd, idx);
+        const int pi = ResolveIndex(idx[0], positions.size());
+        const int ti = ResolveIndex(idx[1], texcoords.size());
+        const int ni = ResolveIndex(idx[2], normals.size());
+        if (pi < 0) {
+          return false; // 位置の番号が不正
+        }
+        tri[vi] = {positions[pi], ti >= 0 ? texcoords[ti] : Vector2{0, 0},
+                   ni >= 0 ? normals[ni] : Vector3{0, 0, 0}};
+      }
+      // 面の向きを反転して格納（既存実装と同じ）
+      outModel.vertices.push_back(tri[2]);
+      outModel.vertices.push_back(tri[1]);
+      outModel.vertices.push_back(tri[0]);
+    } else if (id == "usemtl") {
+      const size_t face = (outModel.vertices.size() - first) / 3;
+      markers.push_back({face, true, NextToken(p, lineEnd)});
+    } else if (id == "o" || id == "g") {
+      markers.push_back({(outModel.vertices.size() - first) / 3, false, {}});
+    } else if (id == "mtllib") {
+      ApplyMaterialLibrary(directoryPath, NextToken(p, lineEnd), outModel);
+    }
+    p = next;
+  }
+  BuildSubsets(markers, (outModel.vertices.size() - first) / 3, first,
+               outModel);
+  return true;
+}
+
+bool LoadMaterialLibrary(const std::string &directoryPath,
+                         const std::string &filename,
+                         std::vector<MaterialData> &outMaterials) {
+  std::string line;
+  std::ifstream file(directoryPath + "/" + filename);
+  assert(file.is_open());
+  if (!file.is_open()) {
+    return false;
+  }
+
+  // このファイルの newmtl で追加した要素。outMaterials には前のライブラリの
+  // マテリアルも入っているので、最初の newmtl までの属性はどれにも付けない
+  constexpr size_t kNoMaterial = ~size_t(0);
+  size_t current = kNoMaterial;
+  while (std::getline(file, line)) {
+    std::string identifier;
+    std::istringstream s(line);
+    s >> identifier;
+    if (identifier == "newmtl") {
+      MaterialData material{};
+      s >> material.name;
+      current = outMaterials.size();
+      outMaterials.push_back(material);
+    } else if (identifier == "map_Kd" && current != kNoMaterial) {
+      std::string textureFilename;
+      s >> textureFilename;
+      outMaterials[current].textureFilePath =
+          directoryPath + "/" + textureFilename;
+    }
+  }
+  return true;
+}
+
+MaterialData LoadMaterialTemplateFile(const std::string &directoryPath,
+                                      const std::string &filename) {
+  std::vector<MaterialData> materials;
+  LoadMaterialLibrary(directoryPath, filename, materials);
+
+  // 最後の map_Kd を持つマテリアル
+  MaterialData materialData{};
+  for (const MaterialData &material : materials) {
+    if (!material.textureFilePath.empty()) {
+      materialData = material;
+    }
+  }
+  return materialData;
+}
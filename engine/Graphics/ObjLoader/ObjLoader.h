@@ -0,0 +1,39 @@
+#pragma once
+#include "struct.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//==================================
+// OBJ / MTL 読み込み（D3D 非依存）
+//==================================
+// 左手系へ変換して三角形リスト（非インデックス）として返す。
+//   位置・法線の x を反転 / v を 1-v / 面の巻き順を反転
+// ファイルは一度に読み込み、バッファを指したまま from_chars で解析する
+// （確保するのは出力配列だけ）。面の番号は負数（末尾からの相対）も可。
+// workerCount > 1 なら行境界で分けたチャンクを並列に読み、面の番号は
+// 全チャンクの頂点数が出そろってから解決する（結果は逐次版と同じ）。
+// o / g / usemtl で区切った範囲を ModelData::subsets に、mtllib の全
+// マテリアルを ModelData::materials に入れる。
+
+// OBJ 読み込み（ファイルが開けない・位置の番号が不正なら false）
+bool LoadObjFile(const std::string &directoryPath, const std::string &filename,
+                 ModelData &outModel, uint32_t workerCount = 1);
+
+// メモリ上の OBJ テキストを解析（mtllib は directoryPath から読む）
+bool ParseObj(std::string_view text, const std::string &directoryPath,
+              ModelData &outModel, uint32_t workerCount = 1);
+
+// ファイル全体を 1 回で読む
+bool ReadFileToBuffer(const std::string &path, std::string &outBuffer);
+
+// .mtl の全マテリアルを outMaterials の末尾へ追加（newmtl / map_Kd のみ対応、
+// 最初の newmtl より前の属性は無視する）
+bool LoadMaterialLibrary(const std::string &directoryPath,
+                         const std::string &filename,
+                         std::vector<MaterialData> &outMaterials);
+
+// .mtl 読み（最後の map_Kd のみ）
+MaterialData LoadMaterialTemplateFile(const std::string &directoryPath,
+                                      const std::string &filename);
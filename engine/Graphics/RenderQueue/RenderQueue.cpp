@@ -0,0 +1,149 @@
+#include "RenderQueue.h"
+#include "GraphicsPipeline/GraphicsPipeline.h"
+#include <cassert>
+#include <chrono>
+
+namespace {
+
+// SRV の GPU ハンドルをキーの texture 欄（24bit）へ畳む。
+// 同じハンドルが同じ値になればよい（違うテクスチャが重なっても並びが
+// 少し崩れるだけで、描画結果は変わらない）
+uint32_t FoldTexture(UINT64 ptr) {
+  uint64_t h = ptr * 0x9E3779B97F4A7C15ull;
+  return uint32_t(h >> 40);
+}
+
+// 積み直しの省略はビュー全体が同じときだけ（同じバッファでも範囲や
+// ストライド・形式が違えば別物）
+bool SameView(const D3D12_VERTEX_BUFFER_VIEW &a,
+              const D3D12_VERTEX_BUFFER_VIEW &b) {
+  return a.BufferLocation == b.BufferLocation &&
+         a.SizeInBytes == b.SizeInBytes && a.StrideInBytes == b.StrideInBytes;
+}
+bool SameView(const D3D12_INDEX_BUFFER_VIEW &a,
+              const D3D12_INDEX_BUFFER_VIEW &b) {
+  return a.BufferLocation == b.BufferLocation &&
+         a.SizeInBytes == b.SizeInBytes && a.Format == b.Format;
+}
+
+} // namespace
+
+void RenderQueue::Begin() {
+  packets_.clear();
+  pipelineIds_.clear();
+}
+
+uint64_t RenderQueue::MakeSortKey(const GraphicsPipeline *pipeline,
+                                  D3D12_GPU_DESCRIPTOR_HANDLE srv, float viewZ,
+                                  bool backToFront) {
+  auto it = pipelineIds_.find(pipeline);
+  if (it == pipelineIds_.end()) {
+    // キーの pipeline 欄に入る数まで（1 フレームにそこまで PSO は使わない）
+    assert(pipelineIds_.size() < (size_t(1) << DrawSortKey::kPipelineBits));
+    it = pipelineIds_
+             .emplace(pipeline, static_cast<uint32_t>(pipelineIds_.size()))
+             .first;
+  }
+  const float range = farZ_ - nearZ_;
+  const float depth01 = range > 0.0f ? (viewZ - nearZ_) / range : 0.0f;
+  return DrawSortKey::Make(it->second, FoldTexture(srv.ptr),
+                           DrawSortKey::QuantizeDepth(depth01, backToFront));
+}
+
+void RenderQueue::Execute(ID3D12GraphicsCommandList *cmdList) {
+  stats_ = {};
+  stats_.packets = static_cast<uint32_t>(packets_.size());
+  if (packets_.empty())
+    return;
+
+  const auto sortStart = std::chrono::steady_clock::now();
+  order_.resize(packets_.size());
+  for (size_t i = 0; i < packets_.size(); ++i) {
+    order_[i] = {packets_[i].sortKey, static_cast<uint32_t>(i)};
+  }
+  RadixSortByKey(order_, scratch_);
+  stats_.sortMicroseconds = std::chrono::duration<double, std::micro>(
+                                std::chrono::steady_clock::now() - sortStart)
+                                .count();
+
+  // 積んである状態（最初は何も分からないので必ず積む）
+  const GraphicsPipeline *boundPipeline = nullptr;
+  ID3D12RootSignature *boundRoot = nullptr;
+  bool rootBound = false;
+  D3D12_GPU_VIRTUAL_ADDRESS boundCbv[4] = {};
+  UINT64 boundSrv = 0;
+  D3D12_VERTEX_BUFFER_VIEW boundVb{};
+  D3D12_INDEX_BUFFER_VIEW boundIb{};
+  bool buffersBound = false;
+
+  auto bindCbv = [&](UINT param, D3D12_GPU_VIRTUAL_ADDRESS address) {
+    if (boundCbv[param] == address) {
+      ++stats_.elidedBinds;
+      return;
+    }
+    cmdList->SetGraphicsRootConstantBufferView(param, address);
+    boundCbv[param] = address;
+    ++stats_.cbvBinds;
+  };
+
+  cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+  for (const SortItem &item : order_) {
+    const DrawPacket &packet = packets_[item.index];
+    if (!packet.pipeline || packet.indexCount == 0)
+      continue;
+    if (packet.material == 0 || packet.wvp == 0 || packet.light == 0) {
+      // 積まずに描くと前のパケットの CBV をそのまま使ってしまう
+      assert(false && "DrawPacket の CBV が 0");
+      ++stats_.rejectedPackets;
+      continue;
+    }
+
+    if (!rootBound || packet.pipeline->Root() != boundRoot) {
+      // ルートシグネチャを替えるとルート引数は全部無効になる
+      boundRoot = packet.pipeline->Root();
+      rootBound = true;
+      cmdList->SetGraphicsRootSignature(boundRoot);
+      ++stats_.rootSignatureChanges;
+      boundCbv[0] = boundCbv[1] = boundCbv[2] = boundCbv[3] = 0;
+      boundSrv = 0;
+    }
+    if (packet.pipeline != boundPipeline) {
+      boundPipeline = packet.pipeline;
+      cmdList->SetPipelineState(packet.pipeline->PSO());
+      ++stats_.pipelineChanges;
+    }
+
+    // RootParam: 0:Material, 1:WVP, 2:SRV, 3:Light
+    bindCbv(0, packet.material);
+    bindCbv(1, packet.wvp);
+    bindCbv(3, packet.light);
+    if (packet.srv.ptr != boundSrv) {
+      cmdList->SetGraphicsRootDescriptorTable(2, packet.srv);
+      boundSrv = packet.srv.ptr;
+      ++stats_.tableBinds;
+    } else {
+      ++stats_.elidedBinds;
+    }
+
+    if (!buffersBound || !SameView(packet.vbv, boundVb)) {
+      cmdList->IASetVertexBuffers(0, 1, &packet.vbv);
+      boundVb = packet.vbv;
+      ++stats_.bufferBinds;
+    } else {
+      ++stats_.elidedBinds;
+    }
+    if (!buffersBound || !SameView(packet.ibv, boundIb)) {
+      cmdList->IASetIndexBuffer(&packet.ibv);
+      boundIb = packet.ibv;
+      ++stats_.bufferBinds;
+    } else {
+      ++stats_.elidedBinds;
+    }
+    buffersBound = true;
+
+    cmdList->DrawIndexedInstanced(packet.indexCount, 1, packet.startIndex,
+                                  packet.baseVertex, 0);
+    ++stats_.draws;
+  }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "RenderQueue/SortKey.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <unordered_map>
+#include <vector>
+
+class GraphicsPipeline;
+
+// 1 回の DrawIndexedInstanced に要るもの（RootParam は Object3d と同じ並び）
+// CBV は省略できない（0 だと前の描画の値が残るので、そのパケットは描かない）
+struct DrawPacket {
+  uint64_t sortKey = 0; // RenderQueue::MakeSortKey で作る
+  GraphicsPipeline *pipeline = nullptr;
+  D3D12_GPU_VIRTUAL_ADDRESS material = 0; // 0: Material
+  D3D12_GPU_VIRTUAL_ADDRESS wvp = 0;      // 1: WVP
+  D3D12_GPU_DESCRIPTOR_HANDLE srv{};      // 2: SRV
+  D3D12_GPU_VIRTUAL_ADDRESS light = 0;    // 3: Light
+  D3D12_VERTEX_BUFFER_VIEW vbv{};
+  D3D12_INDEX_BUFFER_VIEW ibv{};
+  uint32_t indexCount = 0;
+  uint32_t startIndex = 0;
+  int32_t baseVertex = 0;
+};
+
+//==================================
+// 描画キュー
+//==================================
+// Begin → Submit（オブジェクトごと）→ Execute。
+// Execute でキーを基数ソートし、直前と同じ PSO / ルートシグネチャ /
+// ルート CBV / SRV テーブル / VB / IB（ビュー全体が同じとき）は積み直さずに描く。
+// 積んだ内容は Execute まで生きている必要がある（CB は UploadRing か各自のもの）
+class RenderQueue {
+public:
+  struct Stats {
+    uint32_t packets = 0;
+    uint32_t draws = 0;
+    uint32_t pipelineChanges = 0;      // SetPipelineState
+    uint32_t rootSignatureChanges = 0; // SetGraphicsRootSignature
+    uint32_t cbvBinds = 0;             // SetGraphicsRootConstantBufferView
+    uint32_t tableBinds = 0;           // SetGraphicsRootDescriptorTable
+    uint32_t bufferBinds = 0;          // IASetVertexBuffers / IASetIndexBuffer
+    uint32_t elidedBinds = 0;          // 同じ値なので積まなかった数
+    uint32_t rejectedPackets = 0;      // CBV が欠けていて描かなかった数
+    double sortMicroseconds = 0.0;
+  };
+
+  // フレームの始め（前フレームの分と PSO の番号を捨てる。
+  // 統計は次の Execute まで残す）
+  void Begin();
+
+  // depth の量子化に使う範囲（ビュー空間の z）
+  void SetDepthRange(float nearZ, float farZ) {
+    nearZ_ = nearZ;
+    farZ_ = farZ;
+  }
+
+  // pipeline / テクスチャ / ビュー空間の z からキーを作る
+  uint64_t MakeSortKey(const GraphicsPipeline *pipeline,
+                       D3D12_GPU_DESCRIPTOR_HANDLE srv, float viewZ,
+                       bool backToFront = false);
+
+  void Submit(const DrawPacket &packet) { packets_.push_back(packet); }
+
+  // 並べ替えて cmdList に積む
+  void Execute(ID3D12GraphicsCommandList *cmdList);
+
+  size_t Size() const { return packets_.size(); }
+  const Stats &GetStats() const { return stats_; } // 直近の Execute
+
+private:
+  std::vector<DrawPacket> packets_;
+  std::vector<SortItem> order_;
+  std::vector<SortItem> scratch_;
+
+  // PSO ごとの番号（キーの上位に入れる。フレームの中で出てきた順に振り、
+  // Begin で捨てる。作り直した PSO のアドレスが溜まり続けないように）
+  std::unordered_map<const GraphicsPipeline *, uint32_t> pipelineIds_;
+
+  float nearZ_ = 0.1f;
+  float farZ_ = 1000.0f;
+
+  Stats stats_{};
+};
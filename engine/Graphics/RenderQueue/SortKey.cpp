@@ -0,0 +1,55 @@
+#include "SortKey.h"
+#include <algorithm>
+#include <array>
+
+uint32_t DrawSortKey::QuantizeDepth(float depth01, bool backToFront) {
+  // NaN も 0 に寄せる
+  const float clamped = (depth01 > 0.0f) ? (std::min)(depth01, 1.0f) : 0.0f;
+  const uint32_t depth = uint32_t(clamped * float(kDepthMax) + 0.5f);
+  return backToFront ? kDepthMax - depth : depth;
+}
+
+void RadixSortByKey(std::vector<SortItem> &items,
+                    std::vector<SortItem> &scratch) {
+  const size_t count = items.size();
+  if (count < 2) {
+    return;
+  }
+  scratch.resize(count);
+
+  // 全桁のヒストグラムを 1 回の走査で作る
+  std::array<std::array<uint32_t, 256>, 8> histograms{};
+  for (const SortItem &item : items) {
+    for (int pass = 0; pass < 8; ++pass) {
+      ++histograms[pass][(item.key >> (pass * 8)) & 0xFF];
+    }
+  }
+
+  SortItem *src = items.data();
+  SortItem *dst = scratch.data();
+  for (int pass = 0; pass < 8; ++pass) {
+    std::array<uint32_t, 256> &histogram = histograms[pass];
+    // 全要素が同じ値の桁は並びが変わらない
+    const uint32_t firstByte = uint32_t(src[0].key >> (pass * 8)) & 0xFF;
+    if (histogram[firstByte] == count) {
+      continue;
+    }
+
+    uint32_t offset = 0;
+    for (uint32_t &bucket : histogram) {
+      const uint32_t n = bucket;
+      bucket = offset;
+      offset += n;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      const uint32_t byte = uint32_t(src[i].key >> (pass * 8)) & 0xFF;
+      dst[histogram[byte]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+
+  // 奇数回入れ替えたら結果は scratch 側にある
+  if (src != items.data()) {
+    items.swap(scratch);
+  }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 描画の並べ替えキー（D3D 非依存）
+//==================================
+// 64bit の上位から pipeline(16) / texture(24) / depth(24)。
+// 小さい順に描くと、同じ PSO・同じテクスチャがまとまり、その中は手前から奥へ
+// 並ぶ（半透明など奥から描きたいものは depth を反転して渡す）。
+namespace DrawSortKey {
+
+constexpr uint32_t kPipelineBits = 16;
+constexpr uint32_t kTextureBits = 24;
+constexpr uint32_t kDepthBits = 24;
+constexpr uint32_t kDepthMax = (1u << kDepthBits) - 1;
+
+constexpr uint64_t Make(uint32_t pipeline, uint32_t texture, uint32_t depth) {
+  return (uint64_t(pipeline & 0xFFFFu) << (kTextureBits + kDepthBits)) |
+         (uint64_t(texture & 0xFFFFFFu) << kDepthBits) |
+         uint64_t(depth & kDepthMax);
+}
+
+// depth01（0 = near, 1 = far、範囲外は詰める）を depth の段階に量子化
+uint32_t QuantizeDepth(float depth01, bool backToFront = false);
+
+constexpr uint32_t Pipeline(uint64_t key) {
+  return uint32_t(key >> (kTextureBits + kDepthBits));
+}
+constexpr uint32_t Texture(uint64_t key) {
+  return uint32_t(key >> kDepthBits) & 0xFFFFFFu;
+}
+constexpr uint32_t Depth(uint64_t key) { return uint32_t(key) & kDepthMax; }
+
+} // namespace DrawSortKey
+
+// 並べ替える要素（index は呼び出し側の配列の番号）
+struct SortItem {
+  uint64_t key;
+  uint32_t index;
+};
+
+// key の昇順に基数ソート（8bit ずつ LSD、安定）。
+// 全要素で同じ値になる桁は飛ばすので、上位が空いているキーは速い。
+// scratch は作業用（容量を使い回す）
+void RadixSortByKey(std::vector<SortItem> &items,
+                    std::vector<SortItem> &scratch);
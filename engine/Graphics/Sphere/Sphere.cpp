@@ -1,11 +1,11 @@
 #include "Sphere.h"
 #include <cassert>
-#include <cmath>
+#include <cstring>
+#include "Math/Frustum.h"
 #include "Math/Math.h"
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+#include "SphereGeometry.h"
+#include "RenderQueue/RenderQueue.h"
+#include "UploadRing/UploadRing.h"
 
 Sphere::~Sphere() {
   if (vb_.resource)
@@ -26,133 +26,118 @@ void Sphere::Initialize(ID3D12Device *device, float radius, UINT sliceCount,
 
   // メッシュ生成
   BuildGeometry(radius, sliceCount, stackCount);
+  localAABB_.min = {-radius, -radius, -radius};
+  localAABB_.max = {radius, radius, radius};
+  localSphere_.center = {0.0f, 0.0f, 0.0f};
+  localSphere_.radius = radius;
+  worldSphere_ = localSphere_;
   UploadVB_();
   UploadIB_();
 
+  if (uploadRing_) {
+    // CB は Draw のたびにリングから切り出すので、値は CPU 側に持つ
+    cbWvp_.mapped = &ringConstants_.wvp;
+    cbMat_.mapped = &ringConstants_.material;
+    cbLight_.mapped = &ringConstants_.light;
+  } else {
+    cbWvp_.resource =
+        CreateBufferResource(device_, sizeof(TransformationMatrix));
+    cbWvp_.resource->Map(0, nullptr,
+                         reinterpret_cast<void **>(&cbWvp_.mapped));
+    cbMat_.resource = CreateBufferResource(device_, sizeof(Material));
+    cbMat_.resource->Map(0, nullptr,
+                         reinterpret_cast<void **>(&cbMat_.mapped));
+    // Light CB（球ごとに持つ）
+    cbLight_.resource =
+        CreateBufferResource(device_, sizeof(DirectionalLight));
+    cbLight_.resource->Map(0, nullptr,
+                           reinterpret_cast<void **>(&cbLight_.mapped));
+  }
+
   // CB: WVP
-  cbWvp_.resource = CreateBufferResource(device_, sizeof(TransformationMatrix));
-  cbWvp_.resource->Map(0, nullptr, reinterpret_cast<void **>(&cbWvp_.mapped));
   cbWvp_.mapped->WVP = MakeIdentity4x4();
   cbWvp_.mapped->World = MakeIdentity4x4();
 
   // CB: Material
-  cbMat_.resource = CreateBufferResource(device_, sizeof(Material));
-  cbMat_.resource->Map(0, nullptr, reinterpret_cast<void **>(&cbMat_.mapped));
   cbMat_.mapped->color = {1, 1, 1, 1};
   cbMat_.mapped->uvTransform = MakeIdentity4x4();
   cbMat_.mapped->lightingMode = 2; // HalfLambert 既定
 
-  // CB: Light（球ごとに持つ）
-  cbLight_.resource = CreateBufferResource(device_, sizeof(DirectionalLight));
-  cbLight_.resource->Map(0, nullptr,
-                         reinterpret_cast<void **>(&cbLight_.mapped));
+  // CB: Light
   cbLight_.mapped->color = {1, 1, 1, 1};
   cbLight_.mapped->direction = {0.0f, -1.0f, 0.0f};
   cbLight_.mapped->intensity = 1.0f;
 }
 
 void Sphere::Update(const Matrix4x4 &view, const Matrix4x4 &proj) {
-  Matrix4x4 world = MakeAffineMatrix(transform_.scale, transform_.rotation,
-                                     transform_.translation);
+  Matrix4x4 world = MakeAffineMatrix(transform_);
   cbWvp_.mapped->World = world;
   cbWvp_.mapped->WVP = Multiply(world, Multiply(view, proj));
+  worldSphere_ = TransformSphere(localSphere_, world);
 }
 
 void Sphere::Draw(ID3D12GraphicsCommandList *cmdList) {
   if (!vb_.resource || !ib_.resource)
     return;
 
+  D3D12_GPU_VIRTUAL_ADDRESS matAddress, wvpAddress, lightAddress;
+  if (!ConstantAddresses_(matAddress, wvpAddress, lightAddress))
+    return;
+
   cmdList->IASetVertexBuffers(0, 1, &vb_.view);
   cmdList->IASetIndexBuffer(&ib_.view);
   cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
   // RootParam: 0:Material, 1:WVP, 2:SRV, 3:Light
-  cmdList->SetGraphicsRootConstantBufferView(
-      0, cbMat_.resource->GetGPUVirtualAddress());
-  cmdList->SetGraphicsRootConstantBufferView(
-      1, cbWvp_.resource->GetGPUVirtualAddress());
+  cmdList->SetGraphicsRootConstantBufferView(0, matAddress);
+  cmdList->SetGraphicsRootConstantBufferView(1, wvpAddress);
   cmdList->SetGraphicsRootDescriptorTable(2, textureSrv_);
-  cmdList->SetGraphicsRootConstantBufferView(
-      3, cbLight_.resource->GetGPUVirtualAddress());
+  cmdList->SetGraphicsRootConstantBufferView(3, lightAddress);
 
   cmdList->DrawIndexedInstanced(ib_.indexCount, 1, 0, 0, 0);
 }
 
-void Sphere::BuildGeometry(float radius, UINT sliceCount, UINT stackCount) {
-  vertices_.clear();
-  indices_.clear();
-
-  // 上極点
-  vertices_.push_back({Vector4(0, +radius, 0, 1), Vector2(0.0f, 0.0f)});
-
-  // 中間リング（緯度）
-  for (UINT lat = 1; lat < stackCount; ++lat) {
-    float phi = lat * (float(M_PI) / float(stackCount));
-    float v = float(lat) / float(stackCount);
-
-    for (UINT lon = 0; lon <= sliceCount; ++lon) {
-      float theta = lon * (2.0f * float(M_PI) / float(sliceCount));
-      float u = float(lon) / float(sliceCount);
-
-      float x = radius * sinf(phi) * cosf(theta);
-      float y = radius * cosf(phi);
-      float z = radius * sinf(phi) * sinf(theta);
-
-      vertices_.push_back({Vector4(x, y, z, 1), Vector2(u, v)});
-    }
-  }
-
-  // 下極点
-  vertices_.push_back({Vector4(0, -radius, 0, 1), Vector2(0.0f, 1.0f)});
-
-  // 法線（位置の正規化）
-  for (auto &v : vertices_) {
-    float len =
-        std::sqrt(v.position.x * v.position.x + v.position.y * v.position.y +
-                  v.position.z * v.position.z);
-    if (len > 0.0f) {
-      v.normal.x = v.position.x / len;
-      v.normal.y = v.position.y / len;
-      v.normal.z = v.position.z / len;
-    } else {
-      v.normal = {0.0f, 1.0f, 0.0f};
-    }
-  }
-
-  // インデックス
-  UINT ringVerts = sliceCount + 1;
+void Sphere::Submit(RenderQueue &queue, GraphicsPipeline *pipeline,
+                    const Matrix4x4 &view) {
+  if (!vb_.resource || !ib_.resource)
+    return;
 
-  // 上極ファン（i と i+1 を入れ替え）
-  for (UINT i = 1; i <= sliceCount; ++i) {
-    indices_.push_back(0);
-    indices_.push_back(i + 1);
-    indices_.push_back(i);
-  }
+  DrawPacket packet;
+  if (!ConstantAddresses_(packet.material, packet.wvp, packet.light))
+    return;
+  packet.pipeline = pipeline;
+  packet.srv = textureSrv_;
+  packet.vbv = vb_.view;
+  packet.ibv = ib_.view;
+  packet.indexCount = ib_.indexCount;
+
+  const Vector3 &c = worldSphere_.center;
+  const float viewZ = c.x * view.m[0][2] + c.y * view.m[1][2] +
+                      c.z * view.m[2][2] + view.m[3][2];
+  packet.sortKey = queue.MakeSortKey(pipeline, textureSrv_, viewZ);
+  queue.Submit(packet);
+}
 
-  // 中間帯のクアッド
-  for (UINT i = 0; i < stackCount - 2; ++i) {
-    for (UINT j = 0; j < sliceCount; ++j) {
-      UINT a = 1 + i * ringVerts + j;
-      UINT b = 1 + i * ringVerts + j + 1;
-      UINT c = 1 + (i + 1) * ringVerts + j;
-      UINT d = 1 + (i + 1) * ringVerts + j + 1;
-      indices_.push_back(a);
-      indices_.push_back(b);
-      indices_.push_back(d);
-      indices_.push_back(a);
-      indices_.push_back(d);
-      indices_.push_back(c);
-    }
+bool Sphere::ConstantAddresses_(D3D12_GPU_VIRTUAL_ADDRESS &material,
+                                D3D12_GPU_VIRTUAL_ADDRESS &wvp,
+                                D3D12_GPU_VIRTUAL_ADDRESS &light) {
+  if (uploadRing_) {
+    // 今の値をリングへ写す（溢れたら描かない）
+    material = uploadRing_->PushConstants(*cbMat_.mapped);
+    wvp = uploadRing_->PushConstants(*cbWvp_.mapped);
+    light = uploadRing_->PushConstants(*cbLight_.mapped);
+    return material != 0 && wvp != 0 && light != 0;
   }
+  material = cbMat_.resource->GetGPUVirtualAddress();
+  wvp = cbWvp_.resource->GetGPUVirtualAddress();
+  light = cbLight_.resource->GetGPUVirtualAddress();
+  return true;
+}
 
-  // 下極ファン
-  UINT southPoleIndex = UINT(vertices_.size() - 1);
-  UINT baseIndex = southPoleIndex - ringVerts;
-  for (UINT i = 0; i < sliceCount; ++i) {
-    indices_.push_back(southPoleIndex);
-    indices_.push_back(baseIndex + i);
-    indices_.push_back(baseIndex + i + 1);
-  }
+void Sphere::BuildGeometry(float radius, UINT sliceCount, UINT stackCount) {
+  BuildSphereGeometry(radius, sliceCount, stackCount, vertices_, indices_);
+  // 頂点キャッシュ / フェッチ順に並べ替え
+  meshReport_ = OptimizeMesh(vertices_, indices_);
 }
 
 void Sphere::UploadVB_() {
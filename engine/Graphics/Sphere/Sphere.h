@@ -2,9 +2,14 @@
 #include "function/function.h"
 #include "struct.h"
 #include "Math/MathTypes.h"
+#include "Mesh/MeshOptimize.h"
 #include <d3d12.h>
 #include <vector>
 
+class UploadRing;
+class RenderQueue;
+class GraphicsPipeline;
+
 class Sphere {
 public:
   Sphere() = default;
@@ -14,11 +19,17 @@ public:
   void Initialize(ID3D12Device *device, float radius = 0.5f,
                   UINT sliceCount = 16, UINT stackCount = 16);
 
+  // CB を UploadRing から毎フレーム切り出す（Initialize 前に指定）
+  void UseUploadRing(UploadRing *ring) { uploadRing_ = ring; }
+
   // 毎フレームの行列更新（外部カメラの View/Proj を渡す）
   void Update(const Matrix4x4 &view, const Matrix4x4 &proj);
 
   // 描画（RootParam: 0:Material, 1:WVP, 2:SRV, 3:Light）
   void Draw(ID3D12GraphicsCommandList *cmdList);
+  // Draw の代わりに DrawPacket を queue へ積む（奥行きは view から）
+  void Submit(RenderQueue &queue, GraphicsPipeline *pipeline,
+              const Matrix4x4 &view);
 
   // 外からテクスチャSRV(GPUハンドル)をセット
   void SetTexture(D3D12_GPU_DESCRIPTOR_HANDLE srvGPUHandle) {
@@ -27,14 +38,39 @@ public:
 
   // 外から調整したいとき用のアクセサ
   Transform &T() { return transform_; }
+  const Transform &GetTransform() const { return transform_; }
   Material *Mat() { return cbMat_.mapped; }
   DirectionalLight *Light() { return cbLight_.mapped; }
 
+  // 境界ボリューム（ローカルは Initialize 時、ワールド球は Update で更新）
+  const AABB &GetLocalAABB() const { return localAABB_; }
+  const SphereData &GetLocalBoundingSphere() const { return localSphere_; }
+  const SphereData &GetWorldBoundingSphere() const { return worldSphere_; }
+
+  // インスタンス描画用（InstancedRenderer が VB / IB / SRV を借りる）
+  const D3D12_VERTEX_BUFFER_VIEW &GetVertexBufferView() const {
+    return vb_.view;
+  }
+  const D3D12_INDEX_BUFFER_VIEW &GetIndexBufferView() const {
+    return ib_.view;
+  }
+  uint32_t GetIndexCount() const { return ib_.indexCount; }
+  D3D12_GPU_DESCRIPTOR_HANDLE GetTexture() const { return textureSrv_; }
+
+  // 頂点キャッシュ最適化の前後（ACMR / ATVR）
+  const MeshOptimizeReport &GetMeshOptimizeReport() const {
+    return meshReport_;
+  }
+
 private:
   // メッシュ生成
   void BuildGeometry(float radius, UINT sliceCount, UINT stackCount);
   void UploadVB_();
   void UploadIB_();
+  // 描画に使う CB のアドレス（UploadRing ならここで切り出す。溢れたら false）
+  bool ConstantAddresses_(D3D12_GPU_VIRTUAL_ADDRESS &material,
+                          D3D12_GPU_VIRTUAL_ADDRESS &wvp,
+                          D3D12_GPU_VIRTUAL_ADDRESS &light);
 
   struct VB {
     ID3D12Resource *resource = nullptr;
@@ -58,6 +94,12 @@ private:
     ID3D12Resource *resource = nullptr;
     DirectionalLight *mapped = nullptr;
   };
+  // UploadRing を使うときの CB の中身（mapped はここを指す）
+  struct RingConstants {
+    TransformationMatrix wvp;
+    Material material;
+    DirectionalLight light;
+  };
 
 private:
   ID3D12Device *device_ = nullptr;
@@ -72,8 +114,17 @@ private:
   CB_WVP cbWvp_{};
   CB_Material cbMat_{};
   CB_Light cbLight_{};
+  UploadRing *uploadRing_ = nullptr; // nullptr なら CB は自前のリソース
+  RingConstants ringConstants_{};
   D3D12_GPU_DESCRIPTOR_HANDLE textureSrv_{};
 
   // 変換
   Transform transform_{{1, 1, 1}, {0, 0, 0}, {0, 0, 0}};
+
+  // カリング用の境界ボリューム
+  AABB localAABB_{};
+  SphereData localSphere_{};
+  SphereData worldSphere_{};
+
+  MeshOptimizeReport meshReport_{};
 };
@@ -0,0 +1,75 @@
+#include "SphereGeometry.h"
+#include <cmath>
+#include <numbers>
+
+static constexpr float kPi = std::numbers::pi_v<float>;
+
+void BuildSphereGeometry(float radius, uint32_t sliceCount,
+                         uint32_t stackCount,
+                         std::vector<VertexData> &outVertices,
+                         std::vector<uint16_t> &outIndices) {
+  outVertices.clear();
+  outIndices.clear();
+
+  // 法線は単位球上の向き（半径 0 でも潰れない）
+  // 上極点
+  outVertices.push_back(
+      {Vector4(0, +radius, 0, 1), Vector2(0.0f, 0.0f), Vector3(0, 1, 0)});
+
+  // 中間リング（緯度）
+  for (uint32_t lat = 1; lat < stackCount; ++lat) {
+    float phi = lat * (kPi / float(stackCount));
+    float v = float(lat) / float(stackCount);
+
+    for (uint32_t lon = 0; lon <= sliceCount; ++lon) {
+      float theta = lon * (2.0f * kPi / float(sliceCount));
+      float u = float(lon) / float(sliceCount);
+
+      float nx = std::sin(phi) * std::cos(theta);
+      float ny = std::cos(phi);
+      float nz = std::sin(phi) * std::sin(theta);
+
+      outVertices.push_back({Vector4(radius * nx, radius * ny, radius * nz, 1),
+                             Vector2(u, v), Vector3(nx, ny, nz)});
+    }
+  }
+
+  // 下極点
+  outVertices.push_back(
+      {Vector4(0, -radius, 0, 1), Vector2(0.0f, 1.0f), Vector3(0, -1, 0)});
+
+  // インデックス
+  uint32_t ringVerts = sliceCount + 1;
+
+  // 上極ファン（i と i+1 を入れ替え）
+  for (uint32_t i = 1; i <= sliceCount; ++i) {
+    outIndices.push_back(0);
+    outIndices.push_back(i + 1);
+    outIndices.push_back(i);
+  }
+
+  // 中間帯のクアッド
+  for (uint32_t i = 0; i < stackCount - 2; ++i) {
+    for (uint32_t j = 0; j < sliceCount; ++j) {
+      uint32_t a = 1 + i * ringVerts + j;
+      uint32_t b = 1 + i * ringVerts + j + 1;
+      uint32_t c = 1 + (i + 1) * ringVerts + j;
+      uint32_t d = 1 + (i + 1) * ringVerts + j + 1;
+      outIndices.push_back(a);
+      outIndices.push_back(b);
+      outIndices.push_back(d);
+      outIndices.push_back(a);
+      outIndices.push_back(d);
+      outIndices.push_back(c);
+    }
+  }
+
+  // 下極ファン
+  uint32_t southPoleIndex = uint32_t(outVertices.size() - 1);
+  uint32_t baseIndex = southPoleIndex - ringVerts;
+  for (uint32_t i = 0; i < sliceCount; ++i) {
+    outIndices.push_back(southPoleIndex);
+    outIndices.push_back(baseIndex + i);
+    outIndices.push_back(baseIndex + i + 1);
+  }
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "struct.h"
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 球メッシュ生成（D3D 非依存）
+//==================================
+// 上下の極点 + (stackCount-1) 本の緯度リング（経度方向は sliceCount+1 頂点で
+// UV の継ぎ目を閉じる）。法線は位置の正規化、インデックスは左手系の表向き。
+void BuildSphereGeometry(float radius, uint32_t sliceCount,
+                         uint32_t stackCount,
+                         std::vector<VertexData> &outVertices,
+                         std::vector<uint16_t> &outIndices);
@@ -1,7 +1,15 @@
 #include "Sprite2D.h"
+#include "UploadRing/UploadRing.h"
+#include "Window/Window.h"
 #include <cassert>
 
 // ---- 内部ユーティリティ ----
+// 既定解像度（Window::kDefaultWidth/Height）の射影はコンパイル時に確定させておく
+// それ以外のサイズは SetScreenSize でサイズが変わったときだけ作り直す
+static constexpr Matrix4x4 kDefaultScreenProj = MakeOrthographicMatrix(
+    0.0f, 0.0f, float(Window::kDefaultWidth), float(Window::kDefaultHeight),
+    0.0f, 100.0f);
+
 static void WriteQuadVertices(ID3D12Resource *vb) {
   VertexData *v = nullptr;
   vb->Map(0, nullptr, reinterpret_cast<void **>(&v));
@@ -62,18 +70,23 @@ void Sprite2D::Initialize(ID3D12Device *device, float screenWidth,
                           float screenHeight) {
   Release();
   device_ = device;
-  screenW_ = screenWidth;
-  screenH_ = screenHeight;
+
+  if (uploadRing_) {
+    // CB は Draw のたびにリングから切り出すので、値は CPU 側に持つ
+    cbWVP_.map = &ringWvp_;
+    cbMat_.map = &ringMat_;
+  } else {
+    cbWVP_.res = CreateBufferResource(device_, sizeof(TransformationMatrix));
+    cbWVP_.res->Map(0, nullptr, reinterpret_cast<void **>(&cbWVP_.map));
+    cbMat_.res = CreateBufferResource(device_, sizeof(Material));
+    cbMat_.res->Map(0, nullptr, reinterpret_cast<void **>(&cbMat_.map));
+  }
 
   // CB: WVP
-  cbWVP_.res = CreateBufferResource(device_, sizeof(TransformationMatrix));
-  cbWVP_.res->Map(0, nullptr, reinterpret_cast<void **>(&cbWVP_.map));
   cbWVP_.map->World = MakeIdentity4x4();
   cbWVP_.map->WVP = MakeIdentity4x4();
 
   // CB: Material（lightingMode=0, color=白, uvTransform=I）
-  cbMat_.res = CreateBufferResource(device_, sizeof(Material));
-  cbMat_.res->Map(0, nullptr, reinterpret_cast<void **>(&cbMat_.map));
   cbMat_.map->color = {1, 1, 1, 1};
   cbMat_.map->lightingMode = 0; // スプライトは既定でライティング無し
   cbMat_.map->uvTransform = MakeIdentity4x4();
@@ -94,16 +107,23 @@ void Sprite2D::Initialize(ID3D12Device *device, float screenWidth,
 
   // ビュー/プロジェクション（左上基準の直交）
   view_ = MakeIdentity4x4();
-  proj_ = MakeOrthographicMatrix(0.0f, 0.0f, screenW_, screenH_, 0.0f, 100.0f);
+  screenW_ = float(Window::kDefaultWidth);
+  screenH_ = float(Window::kDefaultHeight);
+  proj_ = kDefaultScreenProj;
+  SetScreenSize(screenWidth, screenHeight);
 
   // 既定サイズ
   SetSize(transform_.scale.x, transform_.scale.y); // 初期scaleを反映
 }
 
 void Sprite2D::SetScreenSize(float w, float h) {
+  // 射影は今のサイズの分を持っているので、同じなら作り直さない
+  if (w == screenW_ && h == screenH_) {
+    return;
+  }
   screenW_ = w;
   screenH_ = h;
-  proj_ = MakeOrthographicMatrix(0.0f, 0.0f, screenW_, screenH_, 0.0f, 100.0f);
+  proj_ = MakeOrthographicMatrix(0.0f, 0.0f, w, h, 0.0f, 100.0f);
 }
 
 void Sprite2D::SetSize(float w, float h) {
@@ -114,8 +134,7 @@ void Sprite2D::SetSize(float w, float h) {
 
 // ---- 毎フレーム ----
 void Sprite2D::Update() {
-  Matrix4x4 world = MakeAffineMatrix(transform_.scale, transform_.rotation,
-                                     transform_.translation);
+  Matrix4x4 world = MakeAffineMatrix(transform_);
   cbWVP_.map->World = world;
   cbWVP_.map->WVP = Multiply(world, Multiply(view_, proj_));
 }
@@ -126,15 +145,25 @@ void Sprite2D::Draw(ID3D12GraphicsCommandList *cmdList) const {
     return;
   assert(cmdList);
 
+  D3D12_GPU_VIRTUAL_ADDRESS matAddress, wvpAddress;
+  if (uploadRing_) {
+    // 今の値をリングへ写す（溢れたら描かない）
+    matAddress = uploadRing_->PushConstants(*cbMat_.map);
+    wvpAddress = uploadRing_->PushConstants(*cbWVP_.map);
+    if (matAddress == 0 || wvpAddress == 0)
+      return;
+  } else {
+    matAddress = cbMat_.res->GetGPUVirtualAddress();
+    wvpAddress = cbWVP_.res->GetGPUVirtualAddress();
+  }
+
   cmdList->IASetVertexBuffers(0, 1, &vb_.view);
   cmdList->IASetIndexBuffer(&ib_.view);
   cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
   // RootParam: 0=Material, 1=WVP, 2=SRV
-  cmdList->SetGraphicsRootConstantBufferView(
-      0, cbMat_.res->GetGPUVirtualAddress());
-  cmdList->SetGraphicsRootConstantBufferView(
-      1, cbWVP_.res->GetGPUVirtualAddress());
+  cmdList->SetGraphicsRootConstantBufferView(0, matAddress);
+  cmdList->SetGraphicsRootConstantBufferView(1, wvpAddress);
   cmdList->SetGraphicsRootDescriptorTable(2, srv_);
 
   cmdList->DrawIndexedInstanced(6, 1, 0, 0, 0);
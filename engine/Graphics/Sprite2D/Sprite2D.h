@@ -8,6 +8,8 @@
 
 #include "imgui/imgui.h"
 
+class UploadRing;
+
 class Sprite2D {
 public:
   Sprite2D() = default;
@@ -15,6 +17,8 @@ public:
 
   // 画面サイズは直交投影行列の生成に使用
   void Initialize(ID3D12Device *device, float screenWidth, float screenHeight);
+  // CB を UploadRing から毎フレーム切り出す（Initialize 前に指定）
+  void UseUploadRing(UploadRing *ring) { uploadRing_ = ring; }
   void Update();
   void Draw(ID3D12GraphicsCommandList *cmdList) const;
 
@@ -60,11 +64,15 @@ private:
   IB ib_{};
   CBW cbWVP_{};
   CBM cbMat_{};
+  // UploadRing を使うときの CB の中身（map はここを指す）
+  UploadRing *uploadRing_ = nullptr;
+  TransformationMatrix ringWvp_{};
+  Material ringMat_{};
 
   D3D12_GPU_DESCRIPTOR_HANDLE srv_{};
 
   Matrix4x4 view_{}; // 恒等
-  Matrix4x4 proj_{}; // 直交投影
+  Matrix4x4 proj_{}; // 直交投影（screenW_ x screenH_ の分）
 
   // 表示パラメータ（pxベース）
   Transform transform_{{100, 100, 1}, {0, 0, 0}, {0, 0, 0}};
@@ -0,0 +1,130 @@
+#include "SpriteBatch.h"
+#include "Math/Math.h"
+#include "UploadRing/UploadRing.h"
+#include "function/function.h"
+#include <cassert>
+#include <chrono>
+
+SpriteBatch::~SpriteBatch() {
+  if (indexBuffer_)
+    indexBuffer_->Release();
+}
+
+void SpriteBatch::Initialize(ID3D12Device *device, UploadRing *ring,
+                             float screenWidth, float screenHeight,
+                             uint32_t maxSprites) {
+  assert(device && ring);
+  assert(maxSprites > 0 &&
+         maxSprites * kSpriteVerticesPerQuad <= 65536); // 16bit 添字
+  device_ = device;
+  ring_ = ring;
+  maxSprites_ = maxSprites;
+
+  // IB（全スプライト共通。頂点はスプライトごとに 4 つずつ並ぶ）
+  const size_t indexCount = size_t(maxSprites_) * kSpriteIndicesPerQuad;
+  indexBuffer_ = CreateBufferResource(device_, sizeof(uint16_t) * indexCount);
+  uint16_t *indices = nullptr;
+  indexBuffer_->Map(0, nullptr, reinterpret_cast<void **>(&indices));
+  for (uint32_t i = 0; i < maxSprites_; ++i) {
+    for (uint32_t k = 0; k < kSpriteIndicesPerQuad; ++k) {
+      indices[i * kSpriteIndicesPerQuad + k] =
+          uint16_t(i * kSpriteVerticesPerQuad + kSpriteQuadIndices[k]);
+    }
+  }
+  indexBuffer_->Unmap(0, nullptr);
+  ibv_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
+  ibv_.SizeInBytes = UINT(sizeof(uint16_t) * indexCount);
+  ibv_.Format = DXGI_FORMAT_R16_UINT;
+
+  // 共通の CB の中身（描くときに UploadRing へ写す）
+  SetScreenSize(screenWidth, screenHeight);
+  material_.color = {1, 1, 1, 1};
+  material_.lightingMode = 0; // スプライトは既定でライティング無し
+  material_.uvTransform = MakeIdentity4x4();
+  light_.color = {1, 1, 1, 1};
+  light_.direction = {0.0f, -1.0f, 0.0f};
+  light_.intensity = 1.0f;
+}
+
+void SpriteBatch::SetScreenSize(float width, float height) {
+  // Sprite2D と同じ左上原点の直交投影
+  transform_.World = MakeIdentity4x4();
+  transform_.WVP =
+      MakeOrthographicMatrix(0.0f, 0.0f, width, height, 0.0f, 100.0f);
+}
+
+void SpriteBatch::Begin() {
+  quads_.Clear();
+  runs_.clear();
+  dropped_ = 0;
+}
+
+void SpriteBatch::Draw(D3D12_GPU_DESCRIPTOR_HANDLE srv,
+                       const SpriteDraw &sprite) {
+  const uint32_t index = static_cast<uint32_t>(quads_.Size());
+  if (index >= maxSprites_) {
+    ++dropped_;
+    return;
+  }
+  quads_.Push(sprite);
+
+  // 直前と同じテクスチャなら同じ範囲に足す
+  if (!runs_.empty() && runs_.back().srv.ptr == srv.ptr) {
+    ++runs_.back().spriteCount;
+  } else {
+    runs_.push_back({srv, index, 1});
+  }
+}
+
+void SpriteBatch::End(ID3D12GraphicsCommandList *cmdList) {
+  stats_ = {};
+  stats_.sprites = static_cast<uint32_t>(quads_.Size());
+  stats_.dropped = dropped_;
+  if (quads_.Size() == 0)
+    return;
+
+  // 頂点をリングへ直接展開する
+  const UploadAllocation vertices =
+      ring_->Allocate(sizeof(SpriteVertex) * kSpriteVerticesPerQuad *
+                      quads_.Size());
+  const D3D12_GPU_VIRTUAL_ADDRESS transformAddress =
+      ring_->PushConstants(transform_);
+  const D3D12_GPU_VIRTUAL_ADDRESS materialAddress =
+      ring_->PushConstants(material_);
+  const D3D12_GPU_VIRTUAL_ADDRESS lightAddress = ring_->PushConstants(light_);
+  if (!vertices || transformAddress == 0 || materialAddress == 0 ||
+      lightAddress == 0) {
+    stats_.dropped += stats_.sprites;
+    return;
+  }
+
+  const auto expandStart = std::chrono::steady_clock::now();
+  ExpandSpriteQuads(quads_, 0, quads_.Size(),
+                    static_cast<SpriteVertex *>(vertices.cpu));
+  stats_.expandMicroseconds =
+      std::chrono::duration<double, std::micro>(
+          std::chrono::steady_clock::now() - expandStart)
+          .count();
+
+  D3D12_VERTEX_BUFFER_VIEW vbv{};
+  vbv.BufferLocation = vertices.gpu;
+  vbv.SizeInBytes = UINT(vertices.size);
+  vbv.StrideInBytes = sizeof(SpriteVertex);
+
+  cmdList->IASetVertexBuffers(0, 1, &vbv);
+  cmdList->IASetIndexBuffer(&ibv_);
+  cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+  cmdList->SetGraphicsRootConstantBufferView(0, materialAddress);
+  cmdList->SetGraphicsRootConstantBufferView(1, transformAddress);
+  cmdList->SetGraphicsRootConstantBufferView(3, lightAddress);
+
+  // テクスチャが続く範囲ごとに 1 回（IB は先頭から、頂点は baseVertex でずらす）
+  for (const Run &run : runs_) {
+    cmdList->SetGraphicsRootDescriptorTable(2, run.srv);
+    cmdList->DrawIndexedInstanced(run.spriteCount * kSpriteIndicesPerQuad, 1,
+                                  0,
+                                  INT(run.firstSprite * kSpriteVerticesPerQuad),
+                                  0);
+    ++stats_.drawCalls;
+  }
+}
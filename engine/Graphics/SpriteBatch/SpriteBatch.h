@@ -0,0 +1,71 @@
+#pragma once
+#include "SpriteBatch/SpriteQuads.h"
+#include "struct.h"
+#include <d3d12.h>
+#include <vector>
+
+class UploadRing;
+
+//==================================
+// スプライトのまとめ描き
+//==================================
+// Begin → Draw（1 枚ずつ）→ End。End で全スプライトの頂点を UploadRing から
+// 切り出した動的 VB へ展開し、共有の静的 IB で、同じテクスチャが続く範囲
+// ごとに 1 回だけ DrawIndexedInstanced する（並びは Draw した順のまま）。
+// 描画には "sprite" の PSO（InputLayoutType::Sprite）を呼び出し側で設定しておく。
+// RootParam: 0:Material, 1:WVP（直交投影）, 2:SRV, 3:Light
+class SpriteBatch {
+public:
+  SpriteBatch() = default;
+  ~SpriteBatch();
+  SpriteBatch(const SpriteBatch &) = delete;
+  SpriteBatch &operator=(const SpriteBatch &) = delete;
+
+  // maxSprites は 1 フレームの上限（IB は 16bit なので 16384 まで）
+  void Initialize(ID3D12Device *device, UploadRing *ring, float screenWidth,
+                  float screenHeight, uint32_t maxSprites = 8192);
+  void SetScreenSize(float width, float height);
+
+  // 全スプライト共通のマテリアル（色は頂点色と掛ける。既定はライティングなし）
+  Material &Mat() { return material_; }
+
+  void Begin();
+  // 上限を超えた分は捨てて数える
+  void Draw(D3D12_GPU_DESCRIPTOR_HANDLE srv, const SpriteDraw &sprite);
+  // 展開して描く（VB が UploadRing に入らなければ何も描かない）
+  void End(ID3D12GraphicsCommandList *cmdList);
+
+  struct Stats {
+    uint32_t sprites = 0;
+    uint32_t drawCalls = 0; // テクスチャが切り替わる回数 + 1
+    uint32_t dropped = 0;   // 上限・リングの溢れで描かなかった数
+    double expandMicroseconds = 0.0;
+  };
+  const Stats &GetStats() const { return stats_; } // 直近の End
+
+private:
+  // 同じテクスチャが続く範囲
+  struct Run {
+    D3D12_GPU_DESCRIPTOR_HANDLE srv;
+    uint32_t firstSprite;
+    uint32_t spriteCount;
+  };
+
+  ID3D12Device *device_ = nullptr;
+  UploadRing *ring_ = nullptr;
+  uint32_t maxSprites_ = 0;
+
+  SpriteQuadsSoA quads_;
+  std::vector<Run> runs_;
+  uint32_t dropped_ = 0;
+
+  // 共有の IB（0,1,2,1,3,2 を maxSprites_ 回。baseVertex でずらして使う）
+  ID3D12Resource *indexBuffer_ = nullptr;
+  D3D12_INDEX_BUFFER_VIEW ibv_{};
+
+  TransformationMatrix transform_{}; // World = 単位, WVP = 直交投影
+  Material material_{};
+  DirectionalLight light_{};
+
+  Stats stats_{};
+};
@@ -0,0 +1,173 @@
+#include "SpriteQuads.h"
+#include "Math/SimdSinCos.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 左下, 左上, 右下, 右上（ローカルの 0..1 座標。y は下向き）
+constexpr float kCornerX[kSpriteVerticesPerQuad] = {0.0f, 0.0f, 1.0f, 1.0f};
+constexpr float kCornerY[kSpriteVerticesPerQuad] = {1.0f, 0.0f, 1.0f, 0.0f};
+
+void ExpandOneScalar(const SpriteQuadsSoA &q, size_t i, SpriteVertex *out) {
+  const float s = std::sin(q.rotation[i]);
+  const float c = std::cos(q.rotation[i]);
+  for (uint32_t k = 0; k < kSpriteVerticesPerQuad; ++k) {
+    const float lx = (kCornerX[k] - q.anchorX[i]) * q.width[i];
+    const float ly = (kCornerY[k] - q.anchorY[i]) * q.height[i];
+    out[k].position = {q.x[i] + lx * c - ly * s, q.y[i] + lx * s + ly * c};
+    out[k].texcoord = {kCornerX[k] ? q.u1[i] : q.u0[i],
+                       kCornerY[k] ? q.v1[i] : q.v0[i]};
+    out[k].color = q.color[i];
+  }
+}
+
+#if CG2_SIMD_SSE2
+
+// 4 レーン分の入力（SoA の途中を指すか、端数を詰めた一時領域を指す）
+struct SpriteLanes4 {
+  const float *x, *y, *width, *height, *rotation, *anchorX, *anchorY;
+  const float *u0, *v0, *u1, *v1;
+  const uint32_t *color;
+};
+
+SpriteLanes4 LanesAt(const SpriteQuadsSoA &q, size_t i) {
+  return {&q.x[i],       &q.y[i],       &q.width[i],   &q.height[i],
+          &q.rotation[i], &q.anchorX[i], &q.anchorY[i], &q.u0[i],
+          &q.v0[i],       &q.u1[i],      &q.v1[i],      &q.color[i]};
+}
+
+// 端数（1～3 枚）を 4 レーンに詰める。空きは最後のスプライトの複製
+struct PaddedSpriteLanes4 {
+  float value[11][4];
+  uint32_t color[4];
+
+  PaddedSpriteLanes4(const SpriteQuadsSoA &q, size_t begin, size_t count) {
+    const std::vector<float> *src[11] = {
+        &q.x,       &q.y,       &q.width, &q.height, &q.rotation, &q.anchorX,
+        &q.anchorY, &q.u0,      &q.v0,    &q.u1,     &q.v1};
+    for (size_t lane = 0; lane < 4; ++lane) {
+      const size_t i = begin + (std::min)(lane, count - 1);
+      for (size_t f = 0; f < 11; ++f) {
+        value[f][lane] = (*src[f])[i];
+      }
+      color[lane] = q.color[i];
+    }
+  }
+
+  SpriteLanes4 Lanes() const {
+    return {value[0], value[1], value[2], value[3], value[4],  value[5],
+            value[6], value[7], value[8], value[9], value[10], color};
+  }
+};
+
+// 4 枚（レーン = スプライト）をまとめて展開し、スプライト順に書く
+void ExpandBlock4(const SpriteLanes4 &q, SpriteVertex *out) {
+  __m128 s, c;
+  SimdMath::SinCos4(_mm_loadu_ps(q.rotation), s, c);
+
+  const __m128 x = _mm_loadu_ps(q.x);
+  const __m128 y = _mm_loadu_ps(q.y);
+  const __m128 w = _mm_loadu_ps(q.width);
+  const __m128 h = _mm_loadu_ps(q.height);
+  const __m128 ax = _mm_loadu_ps(q.anchorX);
+  const __m128 ay = _mm_loadu_ps(q.anchorY);
+  const __m128 u0 = _mm_loadu_ps(q.u0);
+  const __m128 v0 = _mm_loadu_ps(q.v0);
+  const __m128 u1 = _mm_loadu_ps(q.u1);
+  const __m128 v1 = _mm_loadu_ps(q.v1);
+
+  // 角の x は 0 か 1 なので (corner - anchor) * size は 2 通りずつ
+  const __m128 left = _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), ax), w);
+  const __m128 right = _mm_add_ps(left, w);
+  const __m128 top = _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), ay), h);
+  const __m128 bottom = _mm_add_ps(top, h);
+
+  // corner[k] = (X, Y, U, V) × 4 レーン → 転置して 1 頂点 16 byte ずつに
+  __m128 corner[kSpriteVerticesPerQuad][4];
+  for (uint32_t k = 0; k < kSpriteVerticesPerQuad; ++k) {
+    const __m128 lx = kCornerX[k] ? right : left;
+    const __m128 ly = kCornerY[k] ? bottom : top;
+    __m128 px = _mm_add_ps(x, _mm_sub_ps(_mm_mul_ps(lx, c), _mm_mul_ps(ly, s)));
+    __m128 py = _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(lx, s), _mm_mul_ps(ly, c)));
+    __m128 tu = kCornerX[k] ? u1 : u0;
+    __m128 tv = kCornerY[k] ? v1 : v0;
+    _MM_TRANSPOSE4_PS(px, py, tu, tv);
+    corner[k][0] = px;
+    corner[k][1] = py;
+    corner[k][2] = tu;
+    corner[k][3] = tv;
+  }
+
+  for (uint32_t lane = 0; lane < 4; ++lane) {
+    SpriteVertex *v = out + lane * kSpriteVerticesPerQuad;
+    const uint32_t color = q.color[lane];
+    for (uint32_t k = 0; k < kSpriteVerticesPerQuad; ++k) {
+      _mm_storeu_ps(&v[k].position.x, corner[k][lane]);
+      v[k].color = color;
+    }
+  }
+}
+
+#endif // CG2_SIMD_SSE2
+
+} // namespace
+
+void SpriteQuadsSoA::Clear() {
+  for (std::vector<float> *v : {&x, &y, &width, &height, &rotation, &anchorX,
+                                &anchorY, &u0, &v0, &u1, &v1}) {
+    v->clear();
+  }
+  color.clear();
+}
+
+void SpriteQuadsSoA::Push(const SpriteDraw &sprite) {
+  x.push_back(sprite.position.x);
+  y.push_back(sprite.position.y);
+  width.push_back(sprite.size.x);
+  height.push_back(sprite.size.y);
+  rotation.push_back(sprite.rotation);
+  anchorX.push_back(sprite.anchor.x);
+  anchorY.push_back(sprite.anchor.y);
+  u0.push_back(sprite.uvMin.x);
+  v0.push_back(sprite.uvMin.y);
+  u1.push_back(sprite.uvMax.x);
+  v1.push_back(sprite.uvMax.y);
+  color.push_back(PackSpriteColor(sprite.color));
+}
+
+uint32_t PackSpriteColor(const Vector4 &color) {
+  auto toByte = [](float v) {
+    return uint32_t((std::clamp)(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+  };
+  return toByte(color.x) | (toByte(color.y) << 8) | (toByte(color.z) << 16) |
+         (toByte(color.w) << 24);
+}
+
+void ExpandSpriteQuads(const SpriteQuadsSoA &quads, size_t begin, size_t end,
+                       SpriteVertex *out) {
+#if CG2_SIMD_SSE2
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    ExpandBlock4(LanesAt(quads, i), out + (i - begin) * kSpriteVerticesPerQuad);
+  }
+  if (i < end) {
+    // 端数も同じカーネルで展開し（sin/cos の近似を揃える）、必要な分だけ写す
+    const size_t rest = end - i;
+    const PaddedSpriteLanes4 padded(quads, i, rest);
+    SpriteVertex tail[4 * kSpriteVerticesPerQuad];
+    ExpandBlock4(padded.Lanes(), tail);
+    std::copy(tail, tail + rest * kSpriteVerticesPerQuad,
+              out + (i - begin) * kSpriteVerticesPerQuad);
+  }
+#else
+  ExpandSpriteQuadsScalar(quads, begin, end, out);
+#endif
+}
+
+void ExpandSpriteQuadsScalar(const SpriteQuadsSoA &quads, size_t begin,
+                             size_t end, SpriteVertex *out) {
+  for (size_t i = begin; i < end; ++i) {
+    ExpandOneScalar(quads, i, out + (i - begin) * kSpriteVerticesPerQuad);
+  }
+}
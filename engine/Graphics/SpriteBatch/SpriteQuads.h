@@ -0,0 +1,60 @@
+#pragma once
+#include "Math/MathTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// スプライトの四角形展開（D3D 非依存）
+//==================================
+// SpriteBatch が 1 フレーム分のスプライトを SoA で持ち、ここで 4 頂点ずつに
+// 展開して動的 VB へ書く。x86 / x64 では 4 枚ずつ SSE2 で回転・拡縮し
+// （端数も 4 枚に詰めて同じ経路を通すので、並び位置で結果は変わらない）、
+// 頂点を並び順どおりに書き出す（書き込み結合のアップロードヒープでもよい）。
+
+// Object3d.VS の VERTEX_SPRITE と対応（20 byte）
+struct SpriteVertex {
+  Vector2 position; // 画面座標（px、左上原点）
+  Vector2 texcoord;
+  uint32_t color; // RGBA8（R が下位バイト）
+};
+static_assert(sizeof(SpriteVertex) == 20, "InputLayoutType::Sprite と合わせる");
+
+// 1 枚分の指定
+struct SpriteDraw {
+  Vector2 position{0.0f, 0.0f}; // anchor の置き場所（px）
+  Vector2 size{100.0f, 100.0f}; // px
+  float rotation = 0.0f;        // ラジアン（anchor 周り、Sprite2D と同じ向き）
+  Vector2 anchor{0.0f, 0.0f};   // 0..1（0,0 = 左上）
+  Vector2 uvMin{0.0f, 0.0f};
+  Vector2 uvMax{1.0f, 1.0f};
+  Vector4 color{1.0f, 1.0f, 1.0f, 1.0f};
+};
+
+// 成分ごとに連続配置したスプライト列
+struct SpriteQuadsSoA {
+  std::vector<float> x, y, width, height, rotation, anchorX, anchorY;
+  std::vector<float> u0, v0, u1, v1;
+  std::vector<uint32_t> color;
+
+  size_t Size() const { return x.size(); }
+  void Clear();
+  void Push(const SpriteDraw &sprite);
+};
+
+// 0..1 の色を RGBA8 に詰める
+uint32_t PackSpriteColor(const Vector4 &color);
+
+// 四角形の頂点の並び（左下, 左上, 右下, 右上）と
+// 三角形 2 枚の添字（0,1,2 / 1,3,2）。Sprite2D と同じ巻き方
+constexpr uint32_t kSpriteVerticesPerQuad = 4;
+constexpr uint32_t kSpriteIndicesPerQuad = 6;
+constexpr uint16_t kSpriteQuadIndices[kSpriteIndicesPerQuad] = {0, 1, 2,
+                                                                1, 3, 2};
+
+// quads[begin, end) を out へ 4 頂点ずつ書く（out は (end - begin) * 4 個分）
+void ExpandSpriteQuads(const SpriteQuadsSoA &quads, size_t begin, size_t end,
+                       SpriteVertex *out);
+// 比較用のスカラー版（std::sin / std::cos。非 x86 ではこちらを使う）
+void ExpandSpriteQuadsScalar(const SpriteQuadsSoA &quads, size_t begin,
+                             size_t end, SpriteVertex *out);
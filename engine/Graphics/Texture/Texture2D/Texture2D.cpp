@@ -1,10 +1,13 @@
 #include "Texture2D.h"
 #include "DescriptorHeap/DescriptorHeap.h"
 #include "DescriptorHeap/DescriptorHelpers.h"
+#include "UploadManager/UploadManager.h"
 #include "function/function.h"
+#include <vector>
 
 void Texture2D::LoadFromFile(ID3D12Device *device, DescriptorHeap &srvHeap,
-                             const std::string &path, bool srgb) {
+                             const std::string &path, bool srgb,
+                             UploadManager *uploader) {
   Term();
 
   // ---- 1) 画像読み込み（存在しなければ白1x1）----
@@ -36,33 +39,50 @@ void Texture2D::LoadFromFile(ID3D12Device *device, DescriptorHeap &srvHeap,
   if (srgb)
     metadata_.format = DirectX::MakeSRGB(metadata_.format);
 
-  // ---- 2) GPUテクスチャ作成（Upload書き戻しor DefaultでもOK）----
-  D3D12_RESOURCE_DESC desc{};
-  desc.Dimension = D3D12_RESOURCE_DIMENSION(metadata_.dimension);
-  desc.Width = (UINT)metadata_.width;
-  desc.Height = (UINT)metadata_.height;
-  desc.DepthOrArraySize = (UINT16)metadata_.arraySize;
-  desc.MipLevels = (UINT16)metadata_.mipLevels;
-  desc.Format = metadata_.format;
-  desc.SampleDesc.Count = 1;
-
-  D3D12_HEAP_PROPERTIES heap{};
-  heap.Type = D3D12_HEAP_TYPE_CUSTOM;
-  heap.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_WRITE_BACK;
-  heap.MemoryPoolPreference = D3D12_MEMORY_POOL_L0;
+  // ---- 2) GPUテクスチャ作成 ----
+  if (uploader) {
+    // DEFAULT ヒープに作り、ミップはコピーキューで写す（まとめて流れる）
+    resource_ = CreateDefaultTextureResource(device, metadata_);
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources(metadata_.mipLevels);
+    for (size_t mip = 0; mip < metadata_.mipLevels; ++mip) {
+      const DirectX::Image *img = mipImages_.GetImage(mip, 0, 0);
+      subresources[mip].pData = img->pixels;
+      subresources[mip].RowPitch = LONG_PTR(img->rowPitch);
+      subresources[mip].SlicePitch = LONG_PTR(img->slicePitch);
+    }
+    uploader->UploadTexture(resource_, subresources.data(),
+                            UINT(subresources.size()));
+    uploader_ = uploader;
+    uploadToken_ = uploader->PendingToken();
+  } else {
+    // CPU から書ける CUSTOM ヒープに直接書く（UploadManager が無いとき）
+    D3D12_RESOURCE_DESC desc{};
+    desc.Dimension = D3D12_RESOURCE_DIMENSION(metadata_.dimension);
+    desc.Width = (UINT)metadata_.width;
+    desc.Height = (UINT)metadata_.height;
+    desc.DepthOrArraySize = (UINT16)metadata_.arraySize;
+    desc.MipLevels = (UINT16)metadata_.mipLevels;
+    desc.Format = metadata_.format;
+    desc.SampleDesc.Count = 1;
 
-  hr = device->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &desc,
-                                       D3D12_RESOURCE_STATE_GENERIC_READ,
-                                       nullptr, IID_PPV_ARGS(&resource_));
-  assert(SUCCEEDED(hr));
+    D3D12_HEAP_PROPERTIES heap{};
+    heap.Type = D3D12_HEAP_TYPE_CUSTOM;
+    heap.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_WRITE_BACK;
+    heap.MemoryPoolPreference = D3D12_MEMORY_POOL_L0;
 
-  // ---- 3) サブリソースに書き込み ----
-  for (size_t mip = 0; mip < metadata_.mipLevels; ++mip) {
-    const DirectX::Image *img = mipImages_.GetImage(mip, 0, 0);
-    hr = resource_->WriteToSubresource((UINT)mip, nullptr, img->pixels,
-                                       (UINT)img->rowPitch,
-                                       (UINT)img->slicePitch);
+    hr = device->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &desc,
+                                         D3D12_RESOURCE_STATE_GENERIC_READ,
+                                         nullptr, IID_PPV_ARGS(&resource_));
     assert(SUCCEEDED(hr));
+
+    // ---- 3) サブリソースに書き込み ----
+    for (size_t mip = 0; mip < metadata_.mipLevels; ++mip) {
+      const DirectX::Image *img = mipImages_.GetImage(mip, 0, 0);
+      hr = resource_->WriteToSubresource((UINT)mip, nullptr, img->pixels,
+                                         (UINT)img->rowPitch,
+                                         (UINT)img->slicePitch);
+      assert(SUCCEEDED(hr));
+    }
   }
 
   // ---- 4) SRV作成 ----
@@ -72,17 +92,32 @@ void Texture2D::LoadFromFile(ID3D12Device *device, DescriptorHeap &srvHeap,
 
 
 void Texture2D::createSRV(ID3D12Device *device, DescriptorHeap &srvHeap) {
-  cpuSrv_ = CreateSRV2D(device, srvHeap, resource_, metadata_.format,
-                        static_cast<UINT>(metadata_.mipLevels));
-  // 直近の割り当てインデックスの GPU ハンドルを取得
-  gpuSrv_ = srvHeap.GPUAt(srvHeap.Used() - 1);
+  // 常駐領域から 1 つ確保（Term で返す）
+  srvHeap_ = &srvHeap;
+  srvHandle_ = srvHeap.Allocate();
+  cpuSrv_ = srvHeap.CPU(srvHandle_);
+  gpuSrv_ = srvHeap.GPU(srvHandle_);
+  CreateSRV2DAt(device, cpuSrv_, resource_, metadata_.format,
+                static_cast<UINT>(metadata_.mipLevels));
 }
 
 void Texture2D::Term() {
+  // コピー中のリソースは消せないので待つ（通常はとっくに終わっている）
+  if (uploader_) {
+    uploader_->Wait(uploadToken_);
+    uploader_ = nullptr;
+  }
+  uploadToken_ = {};
   if (resource_) {
     resource_->Release();
     resource_ = nullptr;
   }
+  // SRV の番号は GPU が読み終えてからヒープに戻る
+  if (srvHeap_) {
+    srvHeap_->Free(srvHandle_);
+    srvHeap_ = nullptr;
+  }
+  srvHandle_ = {};
   path_.clear();
   cpuSrv_ = {};
   gpuSrv_ = {};
@@ -1,5 +1,7 @@
 #pragma once
+#include "DescriptorHeap/DescriptorAllocator.h"
 #include "DirectXTex/DirectXTex.h"
+#include "UploadManager/UploadManager.h"
 #include <cassert>
 #include <d3d12.h>
 #include <string>
@@ -10,11 +12,17 @@ class Texture2D {
 public:
   Texture2D() = default;
   ~Texture2D() { Term(); }
+  // リソースと SRV を所有するのでコピーしない
+  Texture2D(const Texture2D &) = delete;
+  Texture2D &operator=(const Texture2D &) = delete;
 
   // ファイルから読み込んで GPU リソース + SRV を作成
   // srgb=true ならフォーマットを DirectX::MakeSRGB で寄せる
+  // uploader があれば DEFAULT ヒープに作ってコピーキューで写す（GPU 側の
+  // 待ちは UploadManager::Submit が入れる）。無ければ CPU から直接書く
   void LoadFromFile(ID3D12Device *device, DescriptorHeap &srvHeap,
-                    const std::string &path, bool srgb = true);
+                    const std::string &path, bool srgb = true,
+                    UploadManager *uploader = nullptr);
 
   void Term();
 
@@ -25,6 +33,10 @@ public:
   const DirectX::TexMetadata &Metadata() const { return metadata_; }
   const std::string &Path() const { return path_; }
   bool IsLoaded() const { return resource_ != nullptr; }
+  // コピーキューでの転送が終わったか（CPU から直接書いたときは常に true）
+  bool IsUploaded() const {
+    return !uploader_ || uploader_->IsComplete(uploadToken_);
+  }
 
 private:
   // 内部ユーティリティ（実体は既存の関数群を利用）
@@ -36,6 +48,10 @@ private:
   DirectX::ScratchImage mipImages_;
   DirectX::TexMetadata metadata_{};
 
+  UploadManager *uploader_ = nullptr; // 非所有（転送の完了待ち用）
+  UploadToken uploadToken_{};
+  DescriptorHeap *srvHeap_ = nullptr; // 非所有（SRV を返す先）
+  DescriptorHandle srvHandle_{};
   D3D12_CPU_DESCRIPTOR_HANDLE cpuSrv_{};
   D3D12_GPU_DESCRIPTOR_HANDLE gpuSrv_{};
 };
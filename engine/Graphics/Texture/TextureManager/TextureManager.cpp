@@ -7,6 +7,7 @@ void TextureManager::Term() {
   cache_.clear();
   device_ = nullptr;
   srvHeap_ = nullptr;
+  uploader_ = nullptr;
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::Load(const std::string &path,
@@ -17,7 +18,7 @@ D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::Load(const std::string &path,
   }
   // 新規 or 未ロード
   Texture2D &tex = cache_[path]; // 生成（未ロード）
-  tex.LoadFromFile(device_, *srvHeap_, path, srgb);
+  tex.LoadFromFile(device_, *srvHeap_, path, srgb, uploader_);
   return tex.GpuSrv();
 }
 
@@ -38,7 +39,7 @@ TextureManager::TextureID TextureManager::LoadID(const std::string &path,
     auto itTex = cache_.find(path);
     if (itTex == cache_.end() || !itTex->second.IsLoaded()) {
       Texture2D &tex = cache_[path];
-      tex.LoadFromFile(device_, *srvHeap_, path, srgb);
+      tex.LoadFromFile(device_, *srvHeap_, path, srgb, uploader_);
     }
     return itId->second;
   }
@@ -46,7 +47,7 @@ TextureManager::TextureID TextureManager::LoadID(const std::string &path,
   // まだIDが無ければ生成・ロード
   Texture2D &tex = cache_[path];
   if (!tex.IsLoaded()) {
-    tex.LoadFromFile(device_, *srvHeap_, path, srgb); // SRV作成まで内部で実施
+    tex.LoadFromFile(device_, *srvHeap_, path, srgb, uploader_); // SRV作成まで内部で実施
   }
   TextureID id = nextId_++;
   pathToId_[path] = id;
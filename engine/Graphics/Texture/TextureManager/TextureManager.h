@@ -5,14 +5,18 @@
 #include <unordered_map>
 
 class DescriptorHeap;
+class UploadManager;
 
 class TextureManager {
 public:
   using TextureID = int;
 
-  void Init(ID3D12Device *device, DescriptorHeap *srvHeap) {
+  // uploader を渡すと DEFAULT ヒープに作り、コピーキューでまとめて写す
+  void Init(ID3D12Device *device, DescriptorHeap *srvHeap,
+            UploadManager *uploader = nullptr) {
     device_ = device;
     srvHeap_ = srvHeap;
+    uploader_ = uploader;
   }
   void Term();
 
@@ -32,6 +36,7 @@ public:
 private:
   ID3D12Device *device_ = nullptr;    // 非所有
   DescriptorHeap *srvHeap_ = nullptr; // 非所有（可視ヒープ）
+  UploadManager *uploader_ = nullptr;  // 非所有（無ければ CPU から直接書く）
   std::unordered_map<std::string, Texture2D> cache_;
 
   int nextId_ = 1;
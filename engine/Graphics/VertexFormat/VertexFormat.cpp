@@ -0,0 +1,257 @@
+#include "VertexFormat.h"
+#include "Math/Frustum.h"
+#include "Math/Math.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+size_t VertexStride(VertexFormat format) {
+  switch (format) {
+  case VertexFormat::Standard:
+    return sizeof(VertexData);
+  case VertexFormat::Compact:
+    return sizeof(VertexCompact);
+  case VertexFormat::Quantized:
+    return sizeof(VertexQuantized);
+  }
+  return sizeof(VertexData);
+}
+
+//==================================
+// 成分ごとの変換
+//==================================
+
+uint16_t FloatToHalf(float value) {
+  uint32_t f = std::bit_cast<uint32_t>(value);
+  const uint32_t sign = (f >> 16) & 0x8000u;
+  f &= 0x7FFFFFFFu;
+
+  uint32_t h;
+  if (f >= (127u + 16u) << 23) {
+    // 65536 以上・Inf・NaN（65520 以上は下の丸めで Inf になる）
+    h = (f > 0x7F800000u) ? 0x7E00u : 0x7C00u;
+  } else if (f < 113u << 23) {
+    // half の非正規化数：加算の丸め（最近接偶数）に任せて仮数を取り出す
+    const float magic = std::bit_cast<float>(uint32_t(126u) << 23);
+    const float sum = std::bit_cast<float>(f) + magic;
+    h = std::bit_cast<uint32_t>(sum) - (uint32_t(126u) << 23);
+  } else {
+    // 指数を付け替え、下位 13 bit を最近接偶数で丸める
+    const uint32_t mantissaOdd = (f >> 13) & 1u;
+    f += (uint32_t(15 - 127) << 23) + 0xFFFu + mantissaOdd;
+    h = f >> 13;
+  }
+  return uint16_t(h | sign);
+}
+
+float HalfToFloat(uint16_t half) {
+  const uint32_t shiftedExp = 0x7C00u << 13;
+  uint32_t f = uint32_t(half & 0x7FFFu) << 13;
+  const uint32_t exp = f & shiftedExp;
+  f += uint32_t(127 - 15) << 23;
+  if (exp == shiftedExp) {
+    // Inf / NaN
+    f += uint32_t(128 - 16) << 23;
+  } else if (exp == 0) {
+    // 非正規化数
+    f += 1u << 23;
+    f = std::bit_cast<uint32_t>(std::bit_cast<float>(f) -
+                                std::bit_cast<float>(uint32_t(113u) << 23));
+  }
+  f |= uint32_t(half & 0x8000u) << 16;
+  return std::bit_cast<float>(f);
+}
+
+uint16_t FloatToUnorm16(float value) {
+  // NaN は 0 にする
+  const float v = (value > 0.0f) ? (std::min)(value, 1.0f) : 0.0f;
+  return uint16_t(v * 65535.0f + 0.5f);
+}
+
+float Unorm16ToFloat(uint16_t value) { return float(value) / 65535.0f; }
+
+int16_t FloatToSnorm16(float value) {
+  const float v = (value > -1.0f) ? (std::min)(value, 1.0f) : -1.0f;
+  return int16_t(std::lround(v * 32767.0f));
+}
+
+float Snorm16ToFloat(int16_t value) {
+  // -32768 と -32767 はどちらも -1（D3D の SNORM と同じ）
+  return (std::max)(float(value) / 32767.0f, -1.0f);
+}
+
+void EncodeOctahedral(const Vector3 &normal, int16_t out[2]) {
+  const float l1 =
+      std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+  float x = 0.0f;
+  float y = 0.0f;
+  if (l1 > 0.0f) {
+    x = normal.x / l1;
+    y = normal.y / l1;
+    if (normal.z < 0.0f) {
+      // 下半球は外側の三角形へ折り返す
+      const float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+      const float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+      x = fx;
+      y = fy;
+    }
+  }
+  out[0] = FloatToSnorm16(x);
+  out[1] = FloatToSnorm16(y);
+}
+
+Vector3 DecodeOctahedral(const int16_t encoded[2]) {
+  // Object3d.VS.hlsl の DecodeOctahedral と同じ式
+  Vector3 n = {Snorm16ToFloat(encoded[0]), Snorm16ToFloat(encoded[1]), 0.0f};
+  n.z = 1.0f - std::abs(n.x) - std::abs(n.y);
+  const float t = std::clamp(-n.z, 0.0f, 1.0f);
+  n.x -= (n.x >= 0.0f ? 1.0f : -1.0f) * t;
+  n.y -= (n.y >= 0.0f ? 1.0f : -1.0f) * t;
+  return Normalize(n);
+}
+
+//==================================
+// 頂点単位
+//==================================
+
+VertexCompact EncodeVertexCompact(const VertexData &vertex) {
+  VertexCompact v{};
+  v.position[0] = vertex.position.x;
+  v.position[1] = vertex.position.y;
+  v.position[2] = vertex.position.z;
+  v.texcoord[0] = FloatToHalf(vertex.texcoord.x);
+  v.texcoord[1] = FloatToHalf(vertex.texcoord.y);
+  EncodeOctahedral(vertex.normal, v.normal);
+  return v;
+}
+
+VertexData DecodeVertexCompact(const VertexCompact &vertex) {
+  VertexData v{};
+  v.position = {vertex.position[0], vertex.position[1], vertex.position[2],
+                1.0f};
+  v.texcoord = {HalfToFloat(vertex.texcoord[0]),
+                HalfToFloat(vertex.texcoord[1])};
+  v.normal = DecodeOctahedral(vertex.normal);
+  return v;
+}
+
+VertexQuantization ComputeVertexQuantization(const VertexData *vertices,
+                                             size_t count) {
+  VertexQuantization q;
+  if (count == 0) {
+    return q;
+  }
+  const AABB aabb = ComputeAABB(vertices, count);
+  q.offset = aabb.min;
+  q.scale = Subtract(aabb.max, aabb.min);
+  return q;
+}
+
+namespace {
+
+// scale が 0 の軸（平らなメッシュ）は 0 に詰める
+uint16_t QuantizeAxis(float value, float offset, float scale) {
+  return scale > 0.0f ? FloatToUnorm16((value - offset) / scale) : 0;
+}
+
+} // namespace
+
+VertexQuantized EncodeVertexQuantized(const VertexData &vertex,
+                                      const VertexQuantization &quantization) {
+  VertexQuantized v{};
+  v.position[0] = QuantizeAxis(vertex.position.x, quantization.offset.x,
+                               quantization.scale.x);
+  v.position[1] = QuantizeAxis(vertex.position.y, quantization.offset.y,
+                               quantization.scale.y);
+  v.position[2] = QuantizeAxis(vertex.position.z, quantization.offset.z,
+                               quantization.scale.z);
+  v.position[3] = 0;
+  v.texcoord[0] = FloatToHalf(vertex.texcoord.x);
+  v.texcoord[1] = FloatToHalf(vertex.texcoord.y);
+  EncodeOctahedral(vertex.normal, v.normal);
+  return v;
+}
+
+VertexData DecodeVertexQuantized(const VertexQuantized &vertex,
+                                 const VertexQuantization &quantization) {
+  VertexData v{};
+  v.position = {quantization.offset.x + Unorm16ToFloat(vertex.position[0]) *
+                                            quantization.scale.x,
+                quantization.offset.y + Unorm16ToFloat(vertex.position[1]) *
+                                            quantization.scale.y,
+                quantization.offset.z + Unorm16ToFloat(vertex.position[2]) *
+                                            quantization.scale.z,
+                1.0f};
+  v.texcoord = {HalfToFloat(vertex.texcoord[0]),
+                HalfToFloat(vertex.texcoord[1])};
+  v.normal = DecodeOctahedral(vertex.normal);
+  return v;
+}
+
+Matrix4x4 MakeDequantizeMatrix(const VertexQuantization &quantization) {
+  return Multiply(MakeScaleMatrix(quantization.scale),
+                  MakeTranslateMatrix(quantization.offset));
+}
+
+//==================================
+// 配列単位
+//==================================
+
+void EncodeVertices(const VertexData *vertices, size_t count,
+                    VertexFormat format, std::vector<uint8_t> &out,
+                    VertexQuantization *outQuantization) {
+  out.resize(VertexStride(format) * count);
+  switch (format) {
+  case VertexFormat::Standard:
+    if (count > 0) {
+      std::memcpy(out.data(), vertices, out.size());
+    }
+    break;
+  case VertexFormat::Compact: {
+    VertexCompact *dst = reinterpret_cast<VertexCompact *>(out.data());
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = EncodeVertexCompact(vertices[i]);
+    }
+    break;
+  }
+  case VertexFormat::Quantized: {
+    const VertexQuantization q = ComputeVertexQuantization(vertices, count);
+    VertexQuantized *dst = reinterpret_cast<VertexQuantized *>(out.data());
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = EncodeVertexQuantized(vertices[i], q);
+    }
+    if (outQuantization) {
+      *outQuantization = q;
+    }
+    break;
+  }
+  }
+}
+
+void DecodeVertices(const void *data, size_t count, VertexFormat format,
+                    const VertexQuantization &quantization,
+                    std::vector<VertexData> &out) {
+  out.resize(count);
+  switch (format) {
+  case VertexFormat::Standard:
+    if (count > 0) {
+      std::memcpy(out.data(), data, sizeof(VertexData) * count);
+    }
+    break;
+  case VertexFormat::Compact: {
+    const VertexCompact *src = static_cast<const VertexCompact *>(data);
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = DecodeVertexCompact(src[i]);
+    }
+    break;
+  }
+  case VertexFormat::Quantized: {
+    const VertexQuantized *src = static_cast<const VertexQuantized *>(data);
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = DecodeVertexQuantized(src[i], quantization);
+    }
+    break;
+  }
+  }
+}
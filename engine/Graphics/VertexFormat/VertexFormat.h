@@ -0,0 +1,95 @@
+#pragma once
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 圧縮頂点フォーマット（D3D 非依存）
+//==================================
+// VertexData（36 byte）を VB に載せる前に詰め直す。
+//   Compact   : float3 位置 / half2 UV / 八面体 snorm16 法線 = 20 byte
+//   Quantized : unorm16 位置（メッシュごとの scale/offset） / half2 UV /
+//               八面体 snorm16 法線 = 16 byte
+// 復元は Object3d.VS.hlsl と同じ式（Decode* は CPU 側で結果を確かめる用）。
+// Quantized の scale/offset は MakeDequantizeMatrix で WVP に掛けて渡すので
+// VS で余分な定数は要らない。
+
+enum class VertexFormat {
+  Standard,  // VertexData そのまま
+  Compact,   // VertexCompact
+  Quantized, // VertexQuantized
+};
+
+struct VertexCompact {
+  float position[3];
+  uint16_t texcoord[2]; // half
+  int16_t normal[2];    // 八面体 snorm16
+};
+static_assert(sizeof(VertexCompact) == 20);
+
+struct VertexQuantized {
+  uint16_t position[4]; // unorm16（w は未使用）
+  uint16_t texcoord[2]; // half
+  int16_t normal[2];    // 八面体 snorm16
+};
+static_assert(sizeof(VertexQuantized) == 16);
+
+// 位置 = offset + unorm * scale
+struct VertexQuantization {
+  Vector3 scale = {1.0f, 1.0f, 1.0f};
+  Vector3 offset = {0.0f, 0.0f, 0.0f};
+};
+
+// 1 頂点あたりのバイト数
+size_t VertexStride(VertexFormat format);
+
+//==================================
+// 成分ごとの変換
+//==================================
+
+// float <-> half（最近接偶数丸め、範囲外は ±Inf）
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t half);
+
+// [0,1] <-> unorm16 / [-1,1] <-> snorm16（範囲外はクランプ）
+uint16_t FloatToUnorm16(float value);
+float Unorm16ToFloat(uint16_t value);
+int16_t FloatToSnorm16(float value);
+float Snorm16ToFloat(int16_t value);
+
+// 単位ベクトル <-> 八面体 snorm16x2（長さ 0 は +Z として扱う）
+void EncodeOctahedral(const Vector3 &normal, int16_t out[2]);
+Vector3 DecodeOctahedral(const int16_t encoded[2]);
+
+//==================================
+// 頂点単位
+//==================================
+
+VertexCompact EncodeVertexCompact(const VertexData &vertex);
+VertexData DecodeVertexCompact(const VertexCompact &vertex);
+
+// 全頂点の AABB から scale/offset を決める
+VertexQuantization ComputeVertexQuantization(const VertexData *vertices,
+                                             size_t count);
+VertexQuantized EncodeVertexQuantized(const VertexData &vertex,
+                                      const VertexQuantization &quantization);
+VertexData DecodeVertexQuantized(const VertexQuantized &vertex,
+                                 const VertexQuantization &quantization);
+
+// unorm 位置をメッシュ座標へ戻す行列（S * T、行ベクトル）
+Matrix4x4 MakeDequantizeMatrix(const VertexQuantization &quantization);
+
+//==================================
+// 配列単位（VB へそのまま書ける形）
+//==================================
+
+// out を VertexStride(format) * count バイトに詰める。
+// Quantized のときは outQuantization に scale/offset を返す（nullptr 可）
+void EncodeVertices(const VertexData *vertices, size_t count,
+                    VertexFormat format, std::vector<uint8_t> &out,
+                    VertexQuantization *outQuantization = nullptr);
+// EncodeVertices の逆（data は VertexStride(format) * count バイト）
+void DecodeVertices(const void *data, size_t count, VertexFormat format,
+                    const VertexQuantization &quantization,
+                    std::vector<VertexData> &out);